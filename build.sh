@@ -7,6 +7,17 @@
 : ${CMAKE_FLAGS=""}
 : ${CONFIGURE_FLAGS=""}
 
+# Compression support links against the system libraries, so it's opt-in.
+ARGS=()
+for ARG in "$@"; do
+  case "$ARG" in
+    --with-zlib) WITH_ZLIB=1 ;;
+    --with-zstd) WITH_ZSTD=1 ;;
+    *) ARGS+=("$ARG") ;;
+  esac
+done
+set -- "${ARGS[@]}"
+
  # We specifically rename this and LDFLAGS, because exotic build environments export these to subprocesses.
 COMPILE_FLAGS="$CFLAGS -I`pwd`/lib/prefix/include -I`pwd`/lib/prefix/include/uchardet -I`pwd`/lib/lite-xl/resources/include -fPIC"
 LINK_FLAGS="$LDFLAGS -lm -L`pwd`/lib/prefix/lib -L`pwd`/lib/prefix/lib64"  
@@ -27,4 +38,16 @@ if [[ "$@" != "-liconv" ]]; then
   LINK_FLAGS="$LINK_FLAGS -liconv"
 fi
 
+# Optional transparent decompression of gzip and zstd files.
+if [[ -n "$WITH_ZLIB" ]]; then
+  COMPILE_FLAGS="$COMPILE_FLAGS -DENCODING_ZLIB"
+  LINK_FLAGS="$LINK_FLAGS -lz"
+fi
+if [[ -n "$WITH_ZSTD" ]]; then
+  COMPILE_FLAGS="$COMPILE_FLAGS -DENCODING_ZSTD"
+  LINK_FLAGS="$LINK_FLAGS -lzstd"
+fi
+
+[[ "$BIN" != *.dll ]] && LINK_FLAGS="$LINK_FLAGS -lpthread"
+
 $CC -shared -o $BIN $COMPILE_FLAGS -fPIC src/encoding.c $LINK_FLAGS  $@
@@ -19,12 +19,33 @@ encoding = {}
 ---| '"GBK"'
 ---| '"GEORGIAN-ACADEMY"'
 ---| '"HZ"'
+---| '"IBM037"'
+---| '"IBM273"'
+---| '"IBM277"'
+---| '"IBM278"'
+---| '"IBM280"'
+---| '"IBM284"'
+---| '"IBM285"'
+---| '"IBM297"'
+---| '"IBM500"'
 ---| '"IBM850"'
 ---| '"IBM852"'
 ---| '"IBM855"'
 ---| '"IBM857"'
 ---| '"IBM862"'
 ---| '"IBM864"'
+---| '"IBM871"'
+---| '"IBM1047"'
+---| '"IBM1140"'
+---| '"IBM1141"'
+---| '"IBM1142"'
+---| '"IBM1143"'
+---| '"IBM1144"'
+---| '"IBM1145"'
+---| '"IBM1146"'
+---| '"IBM1147"'
+---| '"IBM1148"'
+---| '"IBM1149"'
 ---| '"ISO-2022-JP"'
 ---| '"ISO-2022-KR"'
 ---| '"ISO-8859-1"'
@@ -70,33 +91,152 @@ encoding = {}
 ---| '"WINDOWS-1258"'
 
 ---
----Try and detect the encoding to best of capabilities for given file given or
----returns nil and error message on failure.
+---Growable byte array accepted by the conversion functions as input and output
+---so that multiple steps can be chained without creating intermediate strings.
+---@class encoding.buffer
+local buffer = {}
+
+---
+---Append a string or the contents of another buffer.
+---@param data string | encoding.buffer
+---@return encoding.buffer self
+function buffer:append(data) end
+
+---
+---Empty the buffer keeping its allocated memory.
+---@return encoding.buffer self
+function buffer:clear() end
+
+---
+---Make sure the buffer can hold at least the given amount of bytes.
+---@param capacity integer
+---@return encoding.buffer self
+function buffer:reserve(capacity) end
+
+---
+---Create a read only view over a range of the buffer without copying it,
+---indexes work the same as on string.sub().
+---@param i? integer
+---@param j? integer
+---@return encoding.buffer view
+function buffer:sub(i, j) end
+
+---
+---Get the contents of the buffer, or a range of it, as a string.
+---@param i? integer
+---@param j? integer
+---@return string
+function buffer:tostring(i, j) end
+
+---
+---Skip the byte order marks at the start of the buffer if any.
+---@param charset? encoding.charset Only look for the bom of this charset.
+---@return encoding.buffer view The buffer itself if no bom was found.
+---@return encoding.charset | nil charset
+function buffer:strip_bom(charset) end
+
+---
+---Split the utf8 contents of the buffer into lines the same way Lite XL does
+---when loading a document.
+---@return string[] lines Each line ending with a newline.
+---@return boolean crlf True if carriage returns were removed.
+function buffer:lines() end
+
+---
+---Replace the contents of the buffer with the ones of a file.
 ---@param filename string
----@return string | nil charset
+---@return encoding.buffer | nil self
+---@return string errmsg
+function buffer:read(filename) end
+
+---
+---Write the contents of the buffer into a file.
+---@param filename string
+---@return boolean | nil written
 ---@return string errmsg
-function encoding.detect(filename) end
+function buffer:write(filename) end
+
+---
+---Create a new buffer.
+---@param initial? string | encoding.buffer | integer Contents to copy or initial capacity.
+---@return encoding.buffer
+function encoding.buffer(initial) end
+
+---@class encoding.candidate
+---@field charset encoding.charset
+---@field confidence number @From 0 to 1.
+---@field source "bom" | "utf8" | "ebcdic" | "uchardet" @What detected the charset.
+---@field language? string @Language guessed by uchardet if any.
+
+---@alias encoding.detect_engine
+---|>'"bom"'
+---| '"utf8"'
+---| '"ebcdic"'
+---| '"uchardet"'
+
+---@class encoding.detect_options
+---@field candidates integer @Return up to this amount of ranked candidates.
+---@field engines encoding.detect_engine[] @Detection engines to run in order, all of them by default.
+
+---
+---Try and detect the encoding to best of capabilities for given file given or
+---returns nil and error message on failure. When candidates are asked a list
+---ranked by confidence is returned instead of a single charset.
+---@param filename string
+---@param options? encoding.detect_options
+---@return string | encoding.candidate[] | nil charset
+---@return boolean | string bom_or_errmsg
+function encoding.detect(filename, options) end
 
 ---
 ---Same as encoding.detect() but for strings.
----@param text string
+---@param text string | encoding.buffer
 ---@return string | nil charset
 ---@return string errmsg
 function encoding.detect_string(text) end
 
+---
+---Hashes to compute along a conversion, set the fields wanted to true.
+---@class encoding.hash_options
+---@field input boolean @The raw input, boms included.
+---@field output boolean @The converted output.
+
+---
+---XXH64 digests as 64 bit integers of the hashes asked for.
+---@class encoding.hashes
+---@field input? integer
+---@field output? integer
+
 ---@class encoding.convert_options
----@field handle_to_bom boolean @If applicable adds the byte order marks.
----@field handle_from_bom boolean @If applicable strips the byte order marks.
+---@field handle_to_bom boolean @If applicable starts the output with the byte order marks of tocharset.
+---@field handle_from_bom boolean @If present skips the byte order marks of fromcharset.
 ---@field strict boolean @When true fail if errors found.
+---@field output encoding.buffer @Buffer which contents get replaced by the result.
+---@field max_output integer @Maximum size in bytes of the result, overrides the global cap.
+---@field partial boolean @Return the output converted until max_output was reached.
+---@field on_unencodable "translit" | "entity" | "replace" @Replace characters that can't be encoded instead of failing, only when converting from UTF-8.
+---@field normalize "NFC" | "NFD" @Unicode normalization of the result when converting to UTF-8.
+---@field hash encoding.hash_options @Hash the input and the result in the same pass.
 
 ---
 ---Converts the given text from one encoding into another.
 ---@param tocharset encoding.charset
 ---@param fromcharset encoding.charset
----@param text string
+---@param text string | encoding.buffer
 ---@param options? encoding.convert_options
----@return string | nil converted_text
----@return string errmsg
+---
+---When the result would go over the output limit nil is returned without
+---converting anything if the smallest possible output is already too big,
+---or with partial the output converted so far and the consumed input bytes.
+---
+---With on_unencodable, characters the output charset lacks are replaced by an
+---ascii lookalike (translit), a numeric character reference (entity) or a
+---question mark (replace) and the amount of substitutions is returned.
+---
+---With hash the digests follow, after the substitutions or nil.
+---@return string | encoding.buffer | nil converted_text
+---@return string | integer | nil errmsg_or_substitutions
+---@return integer | encoding.hashes | nil consumed_or_hashes
 function encoding.convert(tocharset, fromcharset, text, options) end
 
 ---
@@ -106,8 +246,492 @@ function encoding.convert(tocharset, fromcharset, text, options) end
 function encoding.get_charset_bom(charset) end
 
 ---
----Remove the byte order marks from the given text.
----@param text string A string that may contain a byte order marks.
+---Find the byte order marks at the start of the given text without copying
+---it, the content starts right after the returned length.
+---@param text string | encoding.buffer A string that may contain a byte order marks.
 ---@param charset? encoding.charset Charset to scan, if nil scan all charsets with bom.
----@return string cleaned_text
+---@return integer bom_length Zero if no bom was found.
+---@return encoding.charset | nil charset Charset of the bom found.
 function encoding.strip_bom(text, charset) end
+
+---@class encoding.search_options
+---@field charset encoding.charset @Charset of the file, detected if not given.
+---@field limit integer @Maximum amount of matches to return.
+
+---@class encoding.search_match
+---@field line integer @Line of the match.
+---@field col integer @Byte column of the match on the utf8 decoded line.
+---@field offset integer @Raw byte offset of the match on the file, or of its line for stateful charsets.
+
+---
+---Search a file for the given utf8 text without decoding the whole file, the
+---text is encoded into the file charset and matched against its raw bytes.
+---@param filename string
+---@param text string
+---@param options? encoding.search_options
+---@return encoding.search_match[] | nil matches
+---@return string charset_or_errmsg
+function encoding.search(filename, text, options) end
+
+---@class encoding.grep_options
+---@field threads integer @Amount of worker threads, defaults to the cpu count.
+---@field limit integer @Stop searching after this amount of matches.
+---@field max_size integer @Skip files bigger than this amount of bytes.
+---@field exclude string[] @File or directory names to skip.
+---@field hidden boolean @Also search files and directories starting with a dot.
+
+---@class encoding.grep_match : encoding.search_match
+---@field file string @Path of the file where the match was found.
+---@field charset encoding.charset @Detected charset of the file.
+---@field text string @The whole matching line decoded to utf8.
+
+---
+---A directory search running on background threads.
+---@class encoding.grep_job
+local grep_job = {}
+
+---
+---Retrieve the matches found since the last call. When no worker thread could
+---be started the next few files are searched first, on the calling thread.
+---@param max? integer Maximum amount of matches to retrieve.
+---@return encoding.grep_match[] matches
+---@return boolean done True when the search finished and nothing is left to poll.
+function grep_job:poll(max) end
+
+---
+---Stop searching, already found matches can still be polled.
+function grep_job:cancel() end
+
+---
+---Get the progress of the search.
+---@return integer files_searched
+---@return integer files_skipped
+---@return integer matches
+function grep_job:status() end
+
+---
+---Search all files inside a directory for the given utf8 text using a pool of
+---worker threads, each file charset is detected and cached and the text is
+---searched for on the raw bytes as done by encoding.search().
+---@param root string
+---@param text string
+---@param options? encoding.grep_options
+---@return encoding.grep_job job
+function encoding.grep(root, text, options) end
+
+---@alias encoding.isa
+---| "scalar" # Portable code, used when no other instruction set is available.
+---| "sse2"   # x86 SSE2, always present on x86_64.
+---| "avx2"   # x86 AVX2, chosen at runtime when the cpu supports it.
+---| "neon"   # ARM NEON, always present on aarch64.
+
+---@class encoding.stats
+---@field arena_reserved integer @Bytes held by the native temporaries arena.
+---@field arena_used integer @Bytes of the arena currently in use.
+---@field arena_peak integer @Highest amount of arena bytes used at once.
+---@field arena_allocations integer @Amount of blocks requested by the arena to the Lua allocator.
+---@field iconv_opens integer @Amount of iconv descriptors opened.
+---@field iconv_cache_hits integer @Conversions that reused a cached iconv descriptor.
+---@field detector_allocations integer @Amount of reusable uchardet detectors created.
+---@field backend_tunings integer @Charset pairs benchmarked to choose their backend.
+---@field snapshot_hits integer @Documents loaded from a decoded snapshot.
+---@field snapshot_writes integer @Decoded snapshots written.
+---@field prefetch_hits integer @Documents loaded from their prefetched text.
+---@field prefetch_misses integer @Documents asked for that were not prefetched in time.
+---@field prefetch_memory integer @Bytes taken by the prefetched texts.
+---@field backends table<string,encoding.backend> @Backend chosen for each "FROM>TO" charset pair.
+---@field isa encoding.isa @Instruction set chosen for the vectorized kernels, ENCODING_ISA can force one.
+---@field kernels table<string,encoding.isa> @Instruction set of the variant running each kernel.
+
+---
+---Retrieve counters about the native memory and resources in use.
+---@return encoding.stats
+function encoding.stats() end
+
+---@alias encoding.backend
+---| "iconv"  # The linked iconv, usually the bundled libiconv.
+---| "system" # The C library iconv, on glibc when libiconv is linked too.
+---| "native" # Built in kernels for a few charsets.
+
+---@class encoding.settings
+---@field max_output integer @Soft cap in bytes of the output of each conversion call, 0 disables it.
+---@field backend encoding.backend | "auto" @Backend to prefer, "auto" benchmarks iconv and native on the first use of each charset pair and keeps the fastest, "system" is only used when asked for.
+---@field backend_cache string @File where the backend chosen for each charset pair is kept between sessions.
+---@field snapshot_dir string @Existing directory where decoded snapshots are kept.
+---@field snapshot_max_size integer @Bytes the snapshots can take, least recently used are deleted past it, 0 stops taking them.
+---@field prefetch_memory integer @Bytes the prefetched documents can take, least recently requested are dropped past it.
+---@field prefetch_max_size integer @Files bigger than this are not prefetched.
+---@field known_groups string[] @Names of the regions of the charsets known by name, not returned.
+---@field known_charsets { charset: string, name: string }[][] @Charsets of each of those regions, listed first by encoding.charsets(), not returned.
+
+---
+---Change the global settings of the library.
+---@param options? encoding.settings
+---@return encoding.settings settings The current settings
+function encoding.configure(options) end
+
+---
+---Private copy of the raw bytes of a file that can be decoded again with
+---different charsets without reading the file.
+---@class encoding.source
+---@operator len: integer
+local source = {}
+
+---
+---Detect the charset of the source using its first 100KB.
+---@param options? encoding.detect_options
+---@return encoding.charset | encoding.candidate[] | nil charset
+---@return boolean | string bom_or_errmsg
+function source:detect(options) end
+
+---@class encoding.decode_options
+---@field strict boolean @When true fail if errors found.
+---@field normalize "NFC" | "NFD" @Unicode normalization of the decoded text.
+---@field snapshot boolean @Keep a snapshot of the lines for encoding.load_snapshot().
+---@field hash encoding.hash_options @Hash the raw bytes and the decoded text in the same pass.
+
+---
+---Decode the whole source into lines split like lite-xl does, skipping the
+---byte order marks of the charset when present.
+---@param charset encoding.charset
+---@param options? encoding.decode_options
+---@return string[] | nil lines
+---@return boolean | string crlf_or_errmsg
+---@return boolean bom
+---@return encoding.hashes? hashes @When the hash option was given.
+function source:decode(charset, options) end
+
+---
+---Decode only a range of lines, useful to preview the visible part of a
+---document with another charset.
+---@param charset encoding.charset
+---@param first integer
+---@param last integer
+---@return string[] | nil lines
+---@return integer | string line_count_or_errmsg
+function source:preview(charset, first, last) end
+
+---
+---Load a private copy of the raw bytes of a file.
+---@param filename string
+---@return encoding.source | nil source
+---@return string errmsg
+function encoding.open(filename) end
+
+---@class encoding.snapshot_info
+---@field charset encoding.charset @Charset the lines were decoded from.
+---@field bom boolean @True if a bom was skipped.
+---@field crlf boolean @True if carriage returns were removed from the line endings.
+
+---
+---Load the lines of a file from the snapshot taken when it was last decoded,
+---only if the file didn't change since then.
+---@param filename string
+---@param options? { normalize: "NFC" | "NFD" }
+---@return string[] | nil lines
+---@return encoding.snapshot_info | string info_or_errmsg
+function encoding.load_snapshot(filename, options) end
+
+---@class encoding.prefetch_options
+---@field priority integer @Files with a higher one are decoded first, defaults to 0.
+---@field charset encoding.charset @Decode with this charset instead of detecting it.
+
+---
+---Queue files likely to be opened soon to be detected and decoded on
+---background threads, files already queued are requested again. Only files
+---up to the configured prefetch_max_size are decoded. Files decoded, or that
+---failed to, are decoded again when they changed since.
+---@param paths string | string[]
+---@param options? encoding.prefetch_options
+function encoding.prefetch(paths, options) end
+
+---@class encoding.prefetch_info : encoding.snapshot_info
+---@field size integer @Size of the file decoded.
+
+---
+---Take the lines of a prefetched file. It never waits, a file still being
+---decoded fails with "still being prefetched" so it can be asked for again
+---later or decoded by the caller. Files changed since they were prefetched
+---are not used.
+---@param filename string
+---@param options? { charset: encoding.charset, normalize: "NFC" | "NFD" }
+---@return string[] | nil lines
+---@return encoding.prefetch_info | string info_or_errmsg
+function encoding.prefetched(filename, options) end
+
+---@class encoding.batch_options
+---@field threads integer @Amount of worker threads, defaults to the cpu count.
+---@field max_size integer @Files bigger than this amount of bytes are not decoded.
+---@field max_memory integer @The workers stop after decoding this amount of bytes of text, the rest is decoded by job:take().
+---@field normalize "NFC" | "NFD" @Normalize the lines returned by job:poll().
+
+---@class encoding.batch_document : encoding.prefetch_info
+---@field filename string
+---@field lines string[] | nil @Nil when the file couldn't be decoded.
+---@field error string | nil @Why the file couldn't be decoded.
+
+---
+---Files being detected and decoded on background threads.
+---@class encoding.batch_job
+---@operator len: integer
+local batch_job = {}
+
+---
+---Retrieve the documents decoded since the last call, in the order the files
+---were given.
+---@param max? integer Maximum amount of documents to retrieve.
+---@return encoding.batch_document[] documents
+---@return boolean done True when all the documents were retrieved.
+function batch_job:poll(max) end
+
+---
+---Retrieve a document right away, decoding it on the calling thread if no
+---worker started with it yet or waiting for the one that did.
+---@param filename string
+---@param options? { charset: encoding.charset, normalize: "NFC" | "NFD" }
+---@return string[] | nil lines
+---@return encoding.prefetch_info | string info_or_errmsg
+function batch_job:take(filename, options) end
+
+---
+---Stop decoding, already decoded documents can still be retrieved.
+function batch_job:cancel() end
+
+---
+---Detect and decode a list of files concurrently on a pool of worker threads
+---in the order given, so the files needed first, like the active document of
+---a restored session, should come first.
+---@param paths string[]
+---@param options? encoding.batch_options
+---@return encoding.batch_job job
+function encoding.open_batch(paths, options) end
+
+---@class encoding.save_document
+---@field filename string @Path of the file to write.
+---@field lines string[] @The utf8 lines, each one ending with a newline.
+---@field charset? encoding.charset @Charset to write the document in, defaults to UTF-8.
+---@field bom? boolean @Write the byte order mark of the charset first.
+---@field crlf? boolean @Write the newlines as \r\n.
+
+---@class encoding.save_options
+---@field threads integer @Amount of worker threads, defaults to the cpu count.
+---@field on_unencodable "translit" | "entity" | "replace" @Substitute the characters the charset can't represent instead of failing.
+
+---@class encoding.save_result
+---@field index integer @Position of the document in the list given.
+---@field filename string
+---@field size integer | nil @Bytes written.
+---@field substitutions integer | nil @Characters substituted as on_unencodable asked.
+---@field error string | nil @Why the document couldn't be saved.
+---@field line integer | nil @First line that couldn't be encoded.
+
+---
+---Documents being encoded and written on background threads.
+---@class encoding.save_job
+local save_job = {}
+
+---
+---Retrieve the results of the documents saved since the last call, in the
+---order the documents were given.
+---@param max? integer Maximum amount of results to retrieve.
+---@return encoding.save_result[] results
+---@return boolean done True when all the documents were saved and their results retrieved.
+function save_job:poll(max) end
+
+---
+---Stop saving, the documents not started yet are reported as not saved.
+function save_job:cancel() end
+
+---
+---Save a list of documents on a pool of worker threads. The lines are copied
+---right away so the documents can be edited meanwhile, then each document is
+---encoded to its charset and written to a temporary file renamed over the
+---original one, so a file is never left half written.
+---@param documents encoding.save_document[]
+---@param options? encoding.save_options
+---@return encoding.save_job job
+function encoding.save_batch(documents, options) end
+
+---@class encoding.segment
+---@field charset encoding.charset
+---@field offset integer @Position of the first byte of the segment.
+---@field length integer @Amount of bytes in the segment.
+---@field confidence number @From 0 to 1, 0 when the fallback was used.
+
+---@class encoding.segment_options
+---@field block_size integer @Bytes classified by each job, 16KB by default.
+---@field threads integer @Amount of threads used, all cpus by default.
+---@field charsets encoding.charset[] @Legacy charsets that can be reported.
+---@field fallback encoding.charset @Charset of undetected lines, ISO-8859-1 by default.
+
+---
+---Split text mixing several ascii compatible charsets into segments at line
+---boundaries, plain ascii lines join the segments around them.
+---@param text string | encoding.buffer
+---@param options? encoding.segment_options
+---@return encoding.segment[] | nil segments
+---@return string errmsg
+function encoding.segments(text, options) end
+
+---
+---Convert text mixing several charsets into UTF-8, each segment found as
+---with encoding.segments() is decoded with its own charset.
+---@param text string | encoding.buffer
+---@param options? encoding.segment_options
+---@return string | nil converted_text
+---@return encoding.segment[] | string segments_or_errmsg
+function encoding.decode_mixed(text, options) end
+
+---
+---Decode a source mixing several charsets into lines.
+---@param options? encoding.segment_options
+---@return string[] | nil lines
+---@return boolean | string crlf_or_errmsg
+---@return encoding.segment[] segments
+function source:decode_mixed(options) end
+
+---@class encoding.read_lines_options
+---@field charset encoding.charset @Charset of the file, detected if not given.
+---@field window integer @Decompressed bytes used for detection, 64KB by default.
+---@field hash encoding.hash_options @Hash the decompressed bytes and the decoded text as they are read.
+
+---@class encoding.read_lines_info
+---@field charset encoding.charset
+---@field bom boolean @If byte order marks were skipped.
+---@field crlf boolean @If carriage returns were removed from line endings.
+---@field compression "none" | "gzip" | "zstd"
+---@field size integer @Amount of decompressed bytes read.
+---@field hashes? encoding.hashes @When the hash option was given.
+
+---
+---Read a file into lines decoded as UTF-8, decompressing it on the fly when
+---it is gzip or zstd and the support was compiled in. The charset is detected
+---from the first decompressed window and the rest is decoded chunk by chunk.
+---@param filename string
+---@param options? encoding.read_lines_options
+---@return string[] | nil lines
+---@return encoding.read_lines_info | string info_or_errmsg
+function encoding.read_lines(filename, options) end
+
+---
+---Reader of a file that only grows, like a log, which decodes just the bytes
+---appended since the previous read keeping the shift state of the charset.
+---@class encoding.tail
+---@operator len: integer @Amount of raw bytes consumed.
+local tail = {}
+
+---
+---Decode the bytes appended to the file since the last read, a character
+---when the file got shorter or any byte already read changed, meaning it was
+---rewritten.
+---when the file got shorter or its start changed, meaning it was rewritten.
+---@return string[] | nil lines @New lines, empty if nothing was appended.
+---@return boolean | string continued_or_errmsg @True if the first line replaces the last one previously returned, since it had no newline yet.
+function tail:read() end
+
+---
+---Create a reader for the bytes appended to a file from the given offset on,
+---the line that offset falls in is decoded again so it can be continued.
+---@param filename string
+---@param charset encoding.charset
+---@param offset? integer @Amount of bytes already loaded, the current size by default.
+---@return encoding.tail | nil tail
+---@return string errmsg
+function encoding.tail(filename, charset, offset) end
+
+---
+---Map of a file as blocks of whole lines with their hashes, to reload only
+---the lines that changed after another program modified the file.
+---@class encoding.blocks
+---@operator len: integer @Amount of blocks.
+local blocks = {}
+
+---
+---Compare the file with the map, decode only the blocks that changed and
+---update the map to the current file. Apply the result to the document by
+---replacing deleted lines from start with the returned lines.
+---@return integer | nil start @First document line that changed.
+---@return integer | string deleted_or_errmsg @Amount of lines removed from start.
+---@return string[] lines @Lines inserted at start.
+function blocks:update() end
+
+---
+---Create the block map of a file, not possible with stateful charsets.
+---@param filename string
+---@param charset encoding.charset @The charset the document was decoded from.
+---@param options? { normalize: "NFC" | "NFD" }
+---@return encoding.blocks | nil blocks
+---@return string errmsg
+function encoding.blocks(filename, charset, options) end
+
+---@class encoding.charset_entry
+---@field charset encoding.charset @Canonical name of the charset.
+---@field name string @Friendly name, the charset itself when unknown.
+---@field group string @Region of the charset, "EBCDIC" or "Other".
+---@field aliases string[] @Other names accepted by iconv.
+---@field bom boolean @If the charset has byte order marks.
+---@field fast boolean @If the native search and split fast paths support it.
+
+---
+---Get the catalogue of charsets supported by iconv, built once and cached.
+---Known charsets come first in the same order of the plugin list.
+---@return encoding.charset_entry[]
+function encoding.charsets() end
+
+---
+---Find the charsets best matching a partial name, alias or region name,
+---ignoring case and punctuation. Without text the known charsets are given.
+---@param text? string
+---@param max? integer Maximum amount of results, 50 by default, 0 for all.
+---@return encoding.charset_entry[]
+function encoding.suggest(text, max) end
+
+---
+---Normalize UTF-8 text to the given Unicode normalization form. A quick check
+---runs first and text already normalized is returned as it is, without copy.
+---@param text string | encoding.buffer
+---@param form "NFC" | "NFD"
+---@return string | encoding.buffer normalized_text
+---@return boolean changed
+function encoding.normalize(text, form) end
+
+---
+---Conversion of text given in chunks, the shift state of stateful charsets
+---and characters split between chunks are carried from one call to the next.
+---ISO-2022-JP, ISO-2022-KR and HZ are converted natively from and into UTF-8.
+---@class encoding.converter
+local converter = {}
+
+---@class encoding.converter_options
+---@field strict boolean @When true fail if errors found.
+---@field handle_to_bom boolean @Start the output with the bom of tocharset if any.
+---@field on_unencodable "translit" | "entity" | "replace" @Replace characters that can't be encoded instead of failing, only when converting from UTF-8.
+---@field hash boolean @Hash the input and the output along the conversion, see converter:hashes().
+
+---
+---Convert the next chunk of text.
+---@param text string | encoding.buffer
+---@param final? boolean @True on the last chunk to flush the shift state.
+---@return string | nil converted_text
+---@return string | integer errmsg_or_substitutions
+function converter:convert(text, final) end
+
+---
+---Go back to the initial shift state, dropping any carried over bytes.
+function converter:reset() end
+
+---
+---XXH64 of everything converted since the converter was created or reset,
+---nil when it wasn't created with the hash option.
+---@return integer | nil input_hash
+---@return integer output_hash
+function converter:hashes() end
+
+---
+---Create a converter for text given in chunks, like the lines of a file.
+---@param tocharset encoding.charset
+---@param fromcharset encoding.charset
+---@param options? encoding.converter_options
+---@return encoding.converter | nil converter
+---@return string errmsg
+function encoding.converter(tocharset, fromcharset, options) end
@@ -1,6 +1,7 @@
 --mod-version:4 --priority:5
 local core = require "core"
 local common = require "core.common"
+local config = require "core.config"
 local command = require "core.command"
 local style = require "core.style"
 local Doc = require "core.doc"
@@ -11,6 +12,65 @@ local StatusView = require "core.statusview"
 ---@type encoding
 local encoding = require "libraries.encoding"
 
+config.plugins.encodings = common.merge({
+  -- Maximum size in bytes of the output of each single conversion, like the
+  -- decoding of a whole file or of the lines appended to it, 0 to disable.
+  max_output = 512 * 1024 * 1024,
+  -- Keep the raw bytes of documents up to this size to reload them quickly
+  -- with another encoding, 0 to disable.
+  retain_original_size = 64 * 1024 * 1024,
+  -- What to do with characters the document encoding can't represent when
+  -- saving: false to fail, "translit", "entity" or "replace".
+  on_unencodable = false,
+  -- Unicode normalization applied to loaded documents: false, "NFC" or "NFD".
+  normalize = false,
+  -- Conversion backend: "auto" benchmarks iconv and the native kernels on the
+  -- first use of each charset pair and keeps the fastest, "iconv", "system" or
+  -- "native" prefer that one. The C library iconv, "system", is opt-in.
+  backend = "auto",
+  -- Keep a decoded snapshot of documents from this size on, so reopening them
+  -- unchanged skips the conversion, 0 to disable.
+  snapshot_min_size = 16 * 1024 * 1024,
+  -- Disk space in bytes the snapshots can take, least recently used first out.
+  snapshot_max_size = 1024 * 1024 * 1024,
+  -- Reload documents whose file only grew, like logs, by decoding just the
+  -- appended bytes. The bytes already loaded are hashed again on each reload
+  -- to tell a rewrite, which is reloaded whole.
+  tail_reload = false,
+  -- Keep a map of the blocks of documents from this size on, so reloading them
+  -- after another program changed the file decodes only the changed lines,
+  -- 0 to disable. Used instead of the append only reload when kept.
+  block_reload_min_size = 1024 * 1024,
+  -- Detect and decode on background threads the files likely to be opened
+  -- next, the ones selected or hovered in the tree view and the neighbours of
+  -- the active document, up to this size. 0 to disable.
+  prefetch_max_size = 4 * 1024 * 1024,
+  -- Memory in bytes the prefetched documents can take.
+  prefetch_memory = 64 * 1024 * 1024,
+  -- Detect and decode the documents opened on startup, like the ones of the
+  -- restored session, concurrently on worker threads. Only files up to
+  -- prefetch_max_size and prefetch_memory bytes of text in total.
+  parallel_restore = true,
+  -- Run the plain searches of find in project through encodings.grep, on
+  -- worker threads and in the encoding of each file.
+  project_search = true
+}, config.plugins.encodings)
+
+local snapshot_dir = USERDIR .. PATHSEP .. "encoding_snapshots"
+if config.plugins.encodings.snapshot_min_size > 0 then
+  common.mkdirp(snapshot_dir)
+end
+
+encoding.configure({
+  max_output = config.plugins.encodings.max_output,
+  backend = config.plugins.encodings.backend,
+  backend_cache = USERDIR .. PATHSEP .. "encoding_backends.txt",
+  snapshot_dir = snapshot_dir,
+  snapshot_max_size = config.plugins.encodings.snapshot_max_size,
+  prefetch_max_size = config.plugins.encodings.prefetch_max_size,
+  prefetch_memory = config.plugins.encodings.prefetch_memory
+})
+
 local encodings = {}
 
 ---@class encodings.encoding
@@ -25,7 +85,8 @@ encodings.groups = {
   "East Asian",
   "SE & SW Asian",
   "Middle Eastern",
-  "Unicode"
+  "Unicode",
+  "EBCDIC"
 }
 
 ---Supported iconv encodings grouped by region.
@@ -110,9 +171,36 @@ encodings.list = {
     { charset = "UCS-2BE",  name = "Unicode" },
     { charset = "UTF-32LE", name = "Unicode" },
     { charset = "UTF-32BE", name = "Unicode" }
+  },
+  -- EBCDIC
+  {
+    { charset = "IBM037",  name = "US/Canada"            },
+    { charset = "IBM1140", name = "US/Canada Euro"       },
+    { charset = "IBM1047", name = "Open Systems"         },
+    { charset = "IBM500",  name = "International"        },
+    { charset = "IBM1148", name = "International Euro"   },
+    { charset = "IBM273",  name = "Germany/Austria"      },
+    { charset = "IBM1141", name = "Germany/Austria Euro" },
+    { charset = "IBM277",  name = "Denmark/Norway"       },
+    { charset = "IBM1142", name = "Denmark/Norway Euro"  },
+    { charset = "IBM278",  name = "Finland/Sweden"       },
+    { charset = "IBM1143", name = "Finland/Sweden Euro"  },
+    { charset = "IBM297",  name = "France"               },
+    { charset = "IBM1147", name = "France Euro"          },
+    { charset = "IBM871",  name = "Iceland"              },
+    { charset = "IBM1149", name = "Iceland Euro"         },
+    { charset = "IBM280",  name = "Italy"                },
+    { charset = "IBM1144", name = "Italy Euro"           },
+    { charset = "IBM284",  name = "Spain"                },
+    { charset = "IBM1145", name = "Spain Euro"           },
+    { charset = "IBM285",  name = "United Kingdom"       },
+    { charset = "IBM1146", name = "United Kingdom Euro"  }
   }
 };
 
+-- listed first and named after them by encoding.charsets() and suggest()
+encoding.configure({ known_groups = encodings.groups, known_charsets = encodings.list })
+
 ---Get the list of encodings associated to a region.
 ---@param label string
 ---@return encodings.encoding[] | nil
@@ -137,78 +225,585 @@ function encodings.get_all()
 end
 
 ---Open a commandview to select a charset and executes the given callback,
+---the optional preview receives the best matching charset as the user types
+---and nil once the commandview is closed.
 ---@param title_label string Title displayed on the commandview
 ---@param callback fun(charset: string)
-function encodings.select_encoding(title_label, callback)
+---@param preview? fun(charset: string | nil)
+---@param candidates? encoding.candidate[] Detected charsets listed first
+function encodings.select_encoding(title_label, callback, preview, candidates)
   core.command_view:enter(title_label, {
     submit = function(_, item)
+      if preview then preview(nil) end
       callback(item.charset)
     end,
     suggest = function(text)
-      local charsets = encodings.get_all()
-      local list_labels = {}
-      local list_charset = {}
-      for _, element in ipairs(charsets) do
-        local label = element.name .. " (" .. element.charset .. ")"
-        table.insert(list_labels, label)
-        list_charset[label] = element.charset
-      end
-      local res = common.fuzzy_match(list_labels, text)
-      for i, name in ipairs(res) do
+      local res = {}
+      for i, element in ipairs(encoding.suggest(text, 100)) do
         res[i] = {
-          text = name,
-          charset = list_charset[name]
+          text = element.name == element.charset and element.charset
+            or element.name .. " (" .. element.charset .. ")",
+          info = element.group ~= "Other" and element.group or nil,
+          charset = element.charset
         }
       end
+      if text == "" and candidates then
+        local names = {}
+        for _, element in ipairs(encoding.charsets()) do names[element.charset] = element.name end
+        for i, candidate in ipairs(candidates) do
+          table.insert(res, i, {
+            text = string.format("%s (%s)", names[candidate.charset] or "Detected", candidate.charset),
+            info = string.format("%d%%", math.floor(candidate.confidence * 100 + 0.5)),
+            charset = candidate.charset
+          })
+        end
+      end
+      if preview and text ~= "" and res[1] then preview(res[1].charset) end
       return res
+    end,
+    cancel = function()
+      if preview then preview(nil) end
     end
   })
 end
 
+---Search all files of a directory for the given text regardless of their
+---encoding, the callback receives batches of matches as they are found.
+---@param root string
+---@param text string
+---@param callback fun(matches: encoding.grep_match[], done: boolean)
+---@param options? encoding.grep_options
+---@return encoding.grep_job
+function encodings.grep(root, text, callback, options)
+  local job = encoding.grep(root, text, options)
+  core.add_thread(function()
+    while true do
+      local matches, done = job:poll()
+      if #matches > 0 or done then callback(matches, done) end
+      if done then break end
+      coroutine.yield(0.05)
+    end
+  end)
+  return job
+end
+
+-- Plain searches of the project search plugin go through encodings.grep, so
+-- files in any encoding are matched on worker threads. The plugin loads after
+-- this one, its view is hooked once every plugin is loaded. encoding.grep
+-- compares the exact text, searches ignoring the case of letters are left to
+-- the plugin.
+core.add_thread(function()
+  local projectsearch = package.loaded["plugins.projectsearch"]
+  if not config.plugins.encodings.project_search or type(projectsearch) ~= "table"
+    or not projectsearch.ResultsView or not projectsearch.search_plain then
+    return
+  end
+  local ResultsView = projectsearch.ResultsView
+  local grep_next = false
+
+  local old_search_plain = projectsearch.search_plain
+  function projectsearch.search_plain(text, path, insensitive)
+    grep_next = not insensitive or text:lower() == text:upper()
+    local ok, result = pcall(old_search_plain, text, path, insensitive)
+    grep_next = false
+    if not ok then error(result, 0) end
+    return result
+  end
+
+  local old_begin_search = ResultsView.begin_search
+  function ResultsView:begin_search(path, text, fn)
+    if grep_next then self.encoding_grep, grep_next = true, false end
+    if not self.encoding_grep then return old_begin_search(self, path, text, fn) end
+    if self.encoding_job then self.encoding_job:cancel() end
+    self.search_args = { path, text, fn }
+    self.results = {}
+    self.last_file_idx = 1
+    self.query = text
+    self.searching = true
+    self.selected_idx = 0
+    self.scroll.to.y = 0
+    local results, job = self.results, nil
+    local prefix = core.project_dir .. PATHSEP
+    job = encodings.grep(path or core.project_dir, text, function(matches, done)
+      if self.encoding_job ~= job then return end
+      for _, match in ipairs(matches) do
+        local file = match.file
+        if file:sub(1, #prefix) == prefix then file = file:sub(#prefix + 1) end
+        table.insert(results, {
+          file = file, text = match.text, line = match.line, col = match.col
+        })
+      end
+      self.last_file_idx = job:status()
+      if done then
+        self.searching = false
+        self.brightness = 100
+      end
+      core.redraw = true
+    end, {
+      max_size = config.file_size_limit and config.file_size_limit * 1e6 or nil
+    })
+    self.encoding_job = job
+  end
+
+  local old_try_close = ResultsView.try_close
+  function ResultsView:try_close(...)
+    if self.encoding_job then self.encoding_job:cancel() end
+    return old_try_close(self, ...)
+  end
+end)
+
 --------------------------------------------------------------------------------
 -- Overwrite Doc methods to properly add encoding detection and conversion.
 --------------------------------------------------------------------------------
 
-local old_doc_load = Doc.load
+-- Remember what was loaded, so reloading the file after another program
+-- changed it decodes just the lines that changed, or only the appended bytes
+-- of a file that grew.
+-- Documents created in the editor have no encoding yet and are saved as UTF-8.
+-- Files that can't be followed, on errors, are just reloaded whole.
+local function follow_changes(doc, filename, size)
+  local conf = config.plugins.encodings
+  local charset = doc.encoding or "UTF-8"
+  local min_size = conf.block_reload_min_size
+  local info = min_size > 0 and system.get_file_info(filename)
+  local blocks, tail
+  if info and info.size >= min_size then
+    blocks = encoding.blocks(filename, charset, { normalize = conf.normalize or nil })
+  end
+  if not blocks and conf.tail_reload then
+    tail = encoding.tail(filename, charset, size)
+  end
+  doc.encoding_blocks, doc.encoding_tail = blocks or nil, tail or nil
+end
+
+-- The raw bytes kept of a document are stamped with the size and time of the
+-- file they were read from, they are only used while it still has them.
+local function keep_source(doc, source, filename)
+  local info = source and system.get_file_info(filename)
+  local current = info and info.size == #source
+  doc.encoding_source = current and source or nil
+  doc.encoding_source_stamp = current and { size = info.size, modified = info.modified } or nil
+end
+
+local function current_source(doc)
+  local source, stamp = doc.encoding_source, doc.encoding_source_stamp
+  local info = source and stamp and system.get_file_info(doc.abs_filename or doc.filename)
+  if info and info.size == stamp.size and info.modified == stamp.modified then
+    return source
+  end
+  doc.encoding_source, doc.encoding_source_stamp = nil, nil
+end
+
+-- Documents opened on startup, only queued until they are decoded together.
+local startup_docs
+
+-- Uses lines decoded ahead of time, from a snapshot or prefetched.
+local function load_decoded(doc, filename, lines, info, size)
+  doc:reset()
+  doc.lines, doc.crlf = lines, info.crlf
+  doc.encoding, doc.bom = info.charset, info.bom
+  doc.encoding_source = nil
+  follow_changes(doc, filename, size)
+  doc:reset_syntax()
+end
+
 function Doc:load(filename)
-  old_doc_load(self, filename)
-  local bytes = ""
-  local CHUNK_SIZE = 100*1024
-  for i, line in ipairs(self.lines) do
-    if i > 1 then bytes = bytes .. "\r\n" end
-    bytes = bytes .. self.lines[i]:sub(1, CHUNK_SIZE)
-    if #bytes >= CHUNK_SIZE then break end
+  if filename:find("%.gz$") or filename:find("%.zst$") then
+    -- decompressed and decoded on the fly, no raw copy is kept
+    local lines, info = encoding.read_lines(filename, { charset = self.encoding })
+    if not lines then error(info, 0) end
+    self:reset()
+    self.lines, self.crlf = lines, info.crlf
+    self.encoding, self.bom = info.charset, info.bom
+    self.compression = info.compression ~= "none" and info.compression or nil
+    self.encoding_source = nil
+    self.encoding_tail, self.encoding_blocks = nil, nil
+    self:reset_syntax()
+    return
   end
-  if not self.encoding then 
-    self.encoding, self.bom = encoding.detect(bytes)
-    if not self.encoding then 
-      core.warn("%s for %s; defaulting to ISO-8859-1", self.bom, filename)
-      self.encoding, self.bom = "ISO-8859-1", false 
+  local options = { normalize = config.plugins.encodings.normalize or nil }
+  if startup_docs and self.abs_filename then
+    local max_size = config.plugins.encodings.prefetch_max_size
+    local info = system.get_file_info(filename)
+    if info and info.type == "file" and (max_size <= 0 or info.size <= max_size) then
+      self:reset()
+      self.encoding_startup = true
+      table.insert(startup_docs, self)
+      return
     end
   end
-  if self.encoding ~= "UTF-8" then
-    for i, line in ipairs(self.lines) do
-      self.lines[i] = encoding.convert("UTF-8", self.encoding, self.lines[i])
+  if config.plugins.encodings.prefetch_max_size > 0 then
+    -- prefetched by absolute path, documents may be opened by a relative one,
+    -- one still being decoded is not waited for and gets decoded below
+    local lines, info = encoding.prefetched(self.abs_filename or filename, {
+      charset = self.encoding, normalize = options.normalize
+    })
+    if lines then
+      load_decoded(self, filename, lines, info, info.size)
+      return
     end
   end
-  if self.bom then self.lines[1] = self.lines[1]:sub(#encoding.bom(self.encoding) + 1) end
+  local min_snapshot = config.plugins.encodings.snapshot_min_size
+  local info = min_snapshot > 0 and system.get_file_info(filename)
+  local snapshot = info and info.size >= min_snapshot
+  if snapshot then
+    local lines, snap = encoding.load_snapshot(filename, options)
+    if lines and (not self.encoding or self.encoding == snap.charset) then
+      load_decoded(self, filename, lines, snap, info.size)
+      return
+    end
+  end
+  local source = assert(encoding.open(filename))
+  if not self.encoding then
+    self.encoding, self.bom = source:detect()
+    if not self.encoding then
+      core.warn("%s for %s; defaulting to ISO-8859-1", self.bom, filename)
+      self.encoding, self.bom = "ISO-8859-1", false
+    end
+  end
+  options.snapshot = snapshot
+  local lines, crlf, bom = source:decode(self.encoding, options)
+  if not lines then
+    core.warn("%s decoding %s as %s; defaulting to ISO-8859-1", crlf, filename, self.encoding)
+    self.encoding = "ISO-8859-1"
+    lines, crlf, bom = assert(source:decode(self.encoding, options))
+  end
+  self:reset()
+  self.lines, self.crlf, self.bom = lines, crlf, bom
+  local retain = config.plugins.encodings.retain_original_size
+  keep_source(self, #source <= retain and source, filename)
+  follow_changes(self, filename, #source)
+  self:reset_syntax()
+end
+
+---Decode the document again with another charset, using the raw bytes kept
+---when it was loaded instead of reading the file again if available.
+---@param charset string
+function Doc:reload_with_encoding(charset)
+  self.encoding = charset
+  self.encoding_tail, self.encoding_blocks = nil, nil
+  local source = current_source(self)
+  if not source then return self:reload() end
+  local lines, crlf, bom = source:decode(charset, {
+    normalize = config.plugins.encodings.normalize or nil
+  })
+  if not lines then
+    core.error("Can't reload with %s: %s", charset, crlf)
+    return
+  end
+  local sel = { self:get_selection() }
+  self:reset()
+  self.lines, self.crlf, self.bom = lines, crlf, bom
+  self.encoding_source = source
+  follow_changes(self, self.abs_filename, #source)
   self:reset_syntax()
+  self:clean()
+  self:set_selection(table.unpack(sel))
+end
+
+local old_doc_reload = Doc.reload
+function Doc:reload()
+  local blocks, tail = self.encoding_blocks, self.encoding_tail
+  if blocks and not self:is_dirty() then
+    local start, deleted, lines = blocks:update()
+    if start then
+      if deleted > 0 or #lines > 0 then
+        common.splice(self.lines, start, deleted, lines)
+        -- the undo history and the raw bytes kept no longer match the lines
+        self.undo_stack, self.redo_stack = { idx = 1 }, { idx = 1 }
+        self.encoding_source = nil
+        self:clean()
+        self:sanitize_selection()
+        self.highlighter:invalidate(start)
+      end
+      return
+    end
+  elseif tail and not self:is_dirty() then
+    local lines, continued = tail:read()
+    if lines then
+      if #lines > 0 then
+        self.encoding_source = nil
+        local first = continued and #self.lines or #self.lines + 1
+        for i, line in ipairs(lines) do
+          self.lines[first + i - 1] = line
+        end
+        self.highlighter:invalidate(first)
+      end
+      return
+    end
+  end
+  old_doc_reload(self)
 end
 
 local old_doc_save = Doc.save
-function Doc:save(filename, abs_filename)  
+function Doc:save(filename, abs_filename)
+  if self.compression and (not filename or filename == self.filename) then
+    error(string.format("Saving back %s compressed files is not supported, use save as", self.compression), 0)
+  end
   local encoded_lines, old_lines = {}, self.lines
+  local on_unencodable = config.plugins.encodings.on_unencodable or nil
+  local substitutions = 0
+  -- a single converter keeps the shift state of stateful charsets between
+  -- lines, and writes the bom along with the first one
+  local converter
+  if (self.encoding and self.encoding ~= "UTF-8") or self.bom then
+    local err
+    converter, err = encoding.converter(self.encoding or "UTF-8", "UTF-8", {
+      strict = true, handle_to_bom = self.bom, on_unencodable = on_unencodable
+    })
+    if not converter then
+      error(string.format("Can't save as %s: %s", self.encoding, err), 0)
+    end
+  end
   for i, line in ipairs(self.lines) do
-    table.insert(encoded_lines, self.encoding and self.encoding ~= "UTF-8" and assert(encoding.convert(self.encoding, "UTF-8", line, { strict = true })) or line)
+    if converter then
+      local replaced
+      line, replaced = converter:convert(line, i == #self.lines)
+      if not line then
+        error(string.format("Can't save line %d as %s: %s", i, self.encoding, replaced), 0)
+      end
+      substitutions = substitutions + (on_unencodable and replaced or 0)
+    end
+    table.insert(encoded_lines, line)
+  end
+  if substitutions > 0 then
+    core.warn("%d characters can't be represented in %s and were replaced", substitutions, self.encoding)
   end
-  if self.bom then encoded_lines[1] = encoding.bom(self.encoding) .. encoded_lines[1] end
   self.lines = encoded_lines
   local status, err = pcall(old_doc_save, self, filename, abs_filename)
   self.lines = old_lines
   if not status then error(err, 0) end
+  self.compression = nil
+  -- the file now has the bytes just encoded, not the ones kept
+  self.encoding_source = nil
+  follow_changes(self, self.abs_filename)
   return err
 end
 
+---Decode the document again detecting the charset of each block of lines,
+---for files that mix several encodings. The document is then kept as UTF-8.
+function Doc:reload_mixed_encodings()
+  local source = current_source(self) or encoding.open(self.filename)
+  if not source then return end
+  local lines, crlf, segments = source:decode_mixed()
+  if not lines then
+    core.error("Can't reload with mixed encodings: %s", crlf)
+    return
+  end
+  local sel = { self:get_selection() }
+  self:reset()
+  self.lines, self.crlf = lines, crlf
+  self.encoding, self.bom = "UTF-8", false
+  self.encoding_source = self.encoding_source and source
+  self.encoding_tail, self.encoding_blocks = nil, nil
+  -- clean only when saving it would write the same bytes, the file was all
+  -- UTF-8 already and had no bom
+  local exact = true
+  for i, segment in ipairs(segments) do
+    if (segment.charset ~= "UTF-8" and segment.charset ~= "ASCII" and segment.charset ~= "US-ASCII")
+      or (i == 1 and segment.offset > 1) then
+      exact = false
+    end
+  end
+  if not exact then self.clean_change_id = -1 end
+  self:reset_syntax()
+  self:set_selection(table.unpack(sel))
+  core.log("Decoded %d segments, the document will be saved as UTF-8", #segments)
+end
+
+--------------------------------------------------------------------------------
+-- Prefetch the files likely to be opened next.
+--------------------------------------------------------------------------------
+local PREFETCH_NEIGHBOURS = 4
+
+local function prefetchable(path)
+  local max_size = config.plugins.encodings.prefetch_max_size
+  if max_size <= 0 or path:find("%.gz$") or path:find("%.zst$") then
+    return false
+  end
+  for _, doc in ipairs(core.docs) do
+    if doc.abs_filename == path then return false end
+  end
+  local info = system.get_file_info(path)
+  return info and info.type == "file" and info.size <= max_size
+end
+
+-- The files next to the active document in its directory, someone going
+-- through them opens one of those next.
+local neighbours_of
+local function prefetch_neighbours(doc)
+  local filename = doc.abs_filename
+  if not filename or filename == neighbours_of then return end
+  neighbours_of = filename
+  local dir, name = filename:match("^(.*)[/\\]([^/\\]+)$")
+  local files = dir and system.list_dir(dir)
+  if not files then return end
+  table.sort(files)
+  local paths = {}
+  for i, file in ipairs(files) do
+    if file == name then
+      for j = i - PREFETCH_NEIGHBOURS, i + PREFETCH_NEIGHBOURS do
+        local path = j ~= i and files[j] and dir .. PATHSEP .. files[j]
+        if path and prefetchable(path) then table.insert(paths, path) end
+      end
+      break
+    end
+  end
+  if #paths > 0 then encoding.prefetch(paths) end
+end
+
+local old_set_active_view = core.set_active_view
+function core.set_active_view(view)
+  old_set_active_view(view)
+  if view:is(DocView) and not view:is(CommandView)
+    and config.plugins.encodings.prefetch_max_size > 0 then
+    prefetch_neighbours(view.doc)
+  end
+end
+
+-- The tree view items under the cursor and the mouse come first.
+core.add_thread(function()
+  local last_selected, last_hovered
+  while true do
+    local treeview = package.loaded["plugins.treeview"]
+    if type(treeview) == "table" then
+      local selected = treeview.selected_item
+      selected = selected and selected.type == "file" and selected.abs_filename
+      local hovered = treeview.hovered_item
+      hovered = hovered and hovered.type == "file" and hovered.abs_filename
+      if selected and selected ~= last_selected and prefetchable(selected) then
+        encoding.prefetch(selected, { priority = 2 })
+      end
+      if hovered and hovered ~= last_hovered and prefetchable(hovered) then
+        encoding.prefetch(hovered, { priority = 1 })
+      end
+      last_selected, last_hovered = selected, hovered
+    end
+    coroutine.yield(0.2)
+  end
+end)
+
+--------------------------------------------------------------------------------
+-- Decode the documents opened on startup concurrently.
+--------------------------------------------------------------------------------
+-- The documents opened before the editor runs, the ones of the session the
+-- workspace plugin restores and those given on the command line, are only
+-- queued when loaded. Once the workspace plugin is done, right before the
+-- first frame, they are all decoded at once on worker threads.
+
+-- The workspace plugin sets the selection of its documents while still empty.
+local old_set_selection = Doc.set_selection
+function Doc:set_selection(...)
+  if self.encoding_startup then self.encoding_startup_selection = table.pack(...) end
+  return old_set_selection(self, ...)
+end
+
+local function load_startup_docs()
+  local docs = startup_docs
+  startup_docs = nil
+  if #docs == 0 then return end
+  local conf = config.plugins.encodings
+  local paths = {}
+  for i, doc in ipairs(docs) do paths[i] = doc.abs_filename end
+  local ok, batch = pcall(encoding.open_batch, paths, {
+    max_size = conf.prefetch_max_size,
+    max_memory = conf.prefetch_memory,
+    normalize = conf.normalize or nil
+  })
+  for _, doc in ipairs(docs) do
+    local selections, selection = doc.selections, doc.encoding_startup_selection
+    doc.encoding_startup, doc.encoding_startup_selection = nil, nil
+    local lines, info
+    if ok then lines, info = batch:take(doc.abs_filename, { charset = doc.encoding }) end
+    if lines then
+      load_decoded(doc, doc.filename, lines, info, info.size)
+    else
+      core.try(doc.load, doc, doc.filename)
+    end
+    doc.selections = selections
+    if selection then
+      doc:set_selection(table.unpack(selection, 1, selection.n))
+    else
+      doc:sanitize_selection()
+    end
+  end
+  if ok then batch:cancel() end
+end
+
+if config.plugins.encodings.parallel_restore and #core.docs == 0 then
+  startup_docs = {}
+  -- the workspace plugin loads after this one, its core.run restores the
+  -- session and then calls this one
+  local old_run = core.run
+  function core.run(...)
+    core.try(load_startup_docs)
+    startup_docs = nil
+    return old_run(...)
+  end
+end
+
+--------------------------------------------------------------------------------
+-- Save all the documents in the background.
+--------------------------------------------------------------------------------
+-- Change id of the documents being saved, when they were snapshotted.
+local saving = setmetatable({}, { __mode = "k" })
+
+---Save every modified document on worker threads, each one encoded to its
+---charset and written atomically, without blocking the editor meanwhile.
+function encodings.save_all()
+  local docs, documents = {}, {}
+  for _, doc in ipairs(core.docs) do
+    if doc:is_dirty() and doc.abs_filename and not doc.compression
+      and not saving[doc] then
+      table.insert(docs, doc)
+      table.insert(documents, {
+        filename = doc.abs_filename, lines = doc.lines,
+        charset = doc.encoding, bom = doc.bom, crlf = doc.crlf
+      })
+      saving[doc] = doc:get_change_id()
+    end
+  end
+  if #docs == 0 then return end
+  local job = encoding.save_batch(documents, {
+    on_unencodable = config.plugins.encodings.on_unencodable or nil
+  })
+  core.add_thread(function()
+    local saved, done = 0, false
+    repeat
+      local results
+      results, done = job:poll()
+      for _, result in ipairs(results) do
+        local doc = docs[result.index]
+        if result.error then
+          core.error("Can't save %s%s: %s", doc.filename,
+            result.line and string.format(" line %d as %s", result.line, doc.encoding) or "",
+            result.error)
+        else
+          if result.substitutions > 0 then
+            core.warn("%d characters of %s can't be represented in %s and were replaced",
+              result.substitutions, doc.filename, doc.encoding)
+          end
+          -- edited since the snapshot, what is on disk is not up to date
+          if doc:get_change_id() == saving[doc] then doc:clean() end
+          doc.new_file = false
+          doc.encoding_source = nil
+          follow_changes(doc, doc.abs_filename)
+          saved = saved + 1
+        end
+        saving[doc] = nil
+      end
+      if not done then coroutine.yield(0.05) end
+    until done
+    core.log("Saved %d of %d documents", saved, #docs)
+  end)
+end
+
+command.add(nil, {
+  ["encodings:save-all"] = function()
+    encodings.save_all()
+  end
+})
+
 --------------------------------------------------------------------------------
 -- Register command to change current document encoding.
 --------------------------------------------------------------------------------
@@ -221,10 +816,29 @@ command.add("core.docview", {
   end,
 
   ["doc:reload-with-encoding"] = function(dv)
+    local doc, previewed = dv.doc, {}
     encodings.select_encoding("Reload With Encoding", function(charset)
-      dv.doc.encoding = charset
-      dv.doc:reload()
-    end)
+      doc:reload_with_encoding(charset)
+    end, function(charset)
+      -- decode only the visible lines straight into the view to try charsets
+      for i, line in pairs(previewed) do doc.lines[i] = line end
+      previewed = {}
+      local source = charset and not doc:is_dirty() and current_source(doc)
+      if not source then return end
+      local first, last = dv:get_visible_line_range()
+      local lines = source:preview(charset, first, last)
+      for i, line in ipairs(lines or {}) do
+        local idx = first + i - 1
+        if doc.lines[idx] then
+          previewed[idx] = doc.lines[idx]
+          doc.lines[idx] = line
+        end
+      end
+    end, current_source(doc) and doc.encoding_source:detect({ candidates = 5 }) or nil)
+  end,
+
+  ["doc:reload-with-mixed-encodings"] = function(dv)
+    dv.doc:reload_mixed_encodings()
   end
 })
 
@@ -0,0 +1,398 @@
+#!/usr/bin/env lua
+--
+-- Measures the accuracy and the latency of the charset detection, to choose
+-- the sample size and the order of the detection engines on evidence. The
+-- labeled corpus is made by converting multilingual seed texts into every
+-- known charset of the catalogue, as prose, as source code with a few
+-- translated comments and strings, and with a bom where the charset has one.
+-- Each engine order runs over samples of each size taken from the start, the
+-- middle and the end of every text.
+--
+-- The native library must be built standalone, against the Lua 5.4 headers:
+--
+--   ./build.sh -DENCODING_STANDLONE -I/usr/include/lua5.4
+--   lua5.4 scripts/detection_bench.lua [options] [seed.txt ...]
+--
+-- Options:
+--   --library PATH    native library, ./libencoding.so by default
+--   --sizes LIST      sample sizes in bytes, comma separated
+--   --positions LIST  start, middle and end, comma separated
+--   --orders LIST     engine orders to compare, engines joined by +, eg
+--                     bom+utf8+uchardet,uchardet
+--   --charsets LIST   only these charsets, comma separated
+--   --rounds N        detections timed per sample, 3 by default
+--   --confusion       confusion of every configuration, not only the default
+--   --csv PATH        write every detection as a row for further analysis
+--
+-- Extra seed files are utf8 texts, each one is used as another language.
+--
+-- A detection counts as exact when it names the charset the sample was made
+-- with, and as decoded when it decodes the sample to the same text as that
+-- charset would, since many charsets are identical for some texts.
+--
+
+local DEFAULT_ORDER = "bom+utf8+ebcdic+uchardet"
+
+local options = {
+  library = "./libencoding.so",
+  sizes = { 256, 1024, 4096, 16384, 65536, 102400 },
+  positions = { "start", "middle", "end" },
+  orders = {
+    DEFAULT_ORDER, "bom+utf8+uchardet", "bom+uchardet", "uchardet",
+    "bom", "utf8", "ebcdic"
+  },
+  charsets = nil,
+  rounds = 3,
+  confusion = false,
+  csv = nil,
+  seeds = {}
+}
+
+local seeds = {
+  { "English", "The quick brown fox jumps over the lazy dog while the committee reviews the quarterly budget and the notes of the new release." },
+  { "French", "Ça fait déjà longtemps que l'été est passé, où êtes-vous allés après la fête à Noël ? Le cœur déçu mais l'âme plutôt naïve, Louÿs rêva de crapaüter en canoë au delà des îles." },
+  { "German", "Falsches Üben von Xylophonmusik quält jeden größeren Zwerg. Die Straße führt über die Brücke zum Bahnhof, wo die Bäckerei öffnet." },
+  { "Spanish", "El pingüino Wenceslao hizo kilómetros bajo exhaustiva lluvia y frío, añoraba a su querido cachorro. ¿Dónde está la estación?" },
+  { "Portuguese", "Luís argüia à Júlia que «brações, fé, chá, óxido, pôr, zângão» eram palavras do português, então ela sorriu." },
+  { "Italian", "Quel vituperabile xenofobo zelante assaggia il whisky ed esclama: alleluja! Perché è già così tardi, più di mezzanotte?" },
+  { "Danish", "Høj bly gom vandt fræk sexquiz på wc. Blåbærsyltetøj er godt på vaflerne, og søen er kold om vinteren." },
+  { "Swedish", "Flygande bäckasiner söka hwila på mjuka tuvor. Sjösättningen av båten blev försenad på grund av vädret." },
+  { "Icelandic", "Kæmi ný öxi hér, ykist þjófum nú bæði víl og ádrepa. Sólin skín á jökulinn í dag." },
+  { "Welsh", "Parciais fy jac codi baw hud llawn dŵr ger tŷ Mabon. Mae'r ŵyn yn chwarae yn y caeau." },
+  { "Polish", "Zażółć gęślą jaźń. Pchnąć w tę łódź jeża lub ośm skrzyń fig, a potem wrócić do domu przed świętami." },
+  { "Czech", "Příliš žluťoučký kůň úpěl ďábelské ódy. Večer jsme šli do divadla a pak na večeři." },
+  { "Hungarian", "Árvíztűrő tükörfúrógép. Öt szép szűz lány őrült írót nyúz, és a kávéházban ülnek." },
+  { "Romanian", "Fumegând hipnotic sașiul azvârle mreje în bălți. Șapte țărani și-au făcut o casă lângă râu." },
+  { "Lithuanian", "Įlinkdama fechtuotojo špaga sublykčiojusi pragręžė apvalų arbūzą. Vakare lijo ir buvo šalta." },
+  { "Latvian", "Glāžšķūņa rūķīši dzērumā čiepj Baha koncertflīģeļu vākus. Rīgā šodien līst." },
+  { "Russian", "Съешь же ещё этих мягких французских булок, да выпей чаю. В чащах юга жил бы цитрус? Да, но фальшивый экземпляр!" },
+  { "Ukrainian", "Чуєш їх, доцю, га? Кумедна ж ти, прощайся без ґольфів! Жебракують філософи при ґанку церкви." },
+  { "Bulgarian", "Жълтата дюля беше щастлива, че пухът, който цъфна, замръзна като гьон. Вечерта валеше сняг." },
+  { "Greek", "Ξεσκεπάζω την ψυχοφθόρα βδελυγμία. Η γρήγορη καφέ αλεπού πηδάει πάνω από τον τεμπέλη σκύλο." },
+  { "Turkish", "Pijamalı hasta yağız şoföre çabucak güvendi. Öğrenciler kütüphanede sessizce çalışıyor." },
+  { "Hebrew", "דג סקרן שט בים מאוכזב ולפתע מצא חברה. עטלף אבק נס דרך מזגן שהתפוצץ כי חם." },
+  { "Arabic", "نص حكيم له سر قاطع وذو شأن عظيم مكتوب على ثوب أخضر ومغلف بجلد أزرق." },
+  { "Thai", "เป็นมนุษย์สุดประเสริฐเลิศคุณค่า กว่าบรรดาฝูงสัตว์เดรัจฉาน จงฝ่าฟันพัฒนาวิชาการ" },
+  { "Vietnamese", "Tiếng Việt có dấu rất đẹp. Chúng tôi đang học lập trình máy tính ở trường đại học." },
+  { "Chinese Simplified", "我能吞下玻璃而不伤身体。这是一个用于测试字符集检测的简体中文句子，我们需要更多的文字。" },
+  { "Chinese Traditional", "我能吞下玻璃而不傷身體。這是一個用於測試字元集偵測的繁體中文句子，我們需要更多的文字。" },
+  { "Japanese", "いろはにほへと ちりぬるを。私はガラスを食べられます。それは私を傷つけません。カタカナとひらがなと漢字。" },
+  { "Korean", "나는 유리를 먹을 수 있어요. 그래도 아프지 않아요. 한국어 문자 집합 검출 시험입니다." },
+  { "Armenian", "Կրնամ ապակի ուտել և ինծի անհանգիստ չըներ։ Երևանը գեղեցիկ քաղաք է։" },
+  { "Georgian", "მინას ვჭამ და არა მტკივა. ქართული ანბანი ძალიან ლამაზია." }
+}
+
+local function split(text, separator)
+  local list = {}
+  for item in text:gmatch("[^" .. separator .. "]+") do
+    table.insert(list, item)
+  end
+  return list
+end
+
+local function parse_arguments(args)
+  local i = 1
+  local function value()
+    i = i + 1
+    return args[i] or error("missing value of " .. args[i - 1])
+  end
+  while i <= #args do
+    local arg = args[i]
+    if arg == "--library" then
+      options.library = value()
+    elseif arg == "--sizes" then
+      options.sizes = {}
+      for _, size in ipairs(split(value(), ",")) do
+        table.insert(options.sizes, math.tointeger(tonumber(size)) or error("invalid size " .. size))
+      end
+    elseif arg == "--positions" then
+      options.positions = split(value(), ",")
+    elseif arg == "--orders" then
+      options.orders = split(value(), ",")
+    elseif arg == "--charsets" then
+      options.charsets = {}
+      for _, charset in ipairs(split(value(), ",")) do
+        options.charsets[charset:upper()] = true
+      end
+    elseif arg == "--rounds" then
+      options.rounds = math.tointeger(tonumber(value())) or error("invalid rounds")
+    elseif arg == "--confusion" then
+      options.confusion = true
+    elseif arg == "--csv" then
+      options.csv = value()
+    elseif arg:sub(1, 2) == "--" then
+      error("unknown option " .. arg)
+    else
+      table.insert(options.seeds, arg)
+    end
+    i = i + 1
+  end
+end
+
+local function load_library(path)
+  local open, errmsg = package.loadlib(path, "luaopen_lite_xl_encoding")
+  if not open then
+    error("can't load " .. path .. ": " .. errmsg)
+  end
+  return open()
+end
+
+---Repeats the seed up to size bytes of utf8 prose, cut at a line end.
+local function make_prose(text, size)
+  local lines, len = {}, 0
+  while len < size do
+    table.insert(lines, text .. "\n")
+    len = len + #text + 1
+  end
+  return table.concat(lines)
+end
+
+---Source code with the seed only in a few comments and strings, mostly ascii.
+local function make_code(text, size)
+  local lines, len, n = {}, 0, 0
+  while len < size do
+    n = n + 1
+    local block
+    if n % 8 == 1 then
+      block = string.format(
+        "/* %s */\nstatic const char* message_%d = \"%s\";\n", text, n, text
+      )
+    else
+      block = string.format(
+        "static int compute_%d(int value) {\n  if (value > %d)\n    return value * %d + 1;\n  return value - %d;\n}\n\n",
+        n, n * 3, n % 7 + 2, n
+      )
+    end
+    table.insert(lines, block)
+    len = len + #block
+  end
+  return table.concat(lines)
+end
+
+local function sample_of(text, size, position)
+  if #text <= size then return text end
+  if position == "start" then
+    return text:sub(1, size)
+  elseif position == "middle" then
+    local first = (#text - size) // 2 + 1
+    return text:sub(first, first + size - 1)
+  end
+  return text:sub(#text - size + 1)
+end
+
+local function percent(part, total)
+  return total > 0 and string.format("%6.2f%%", part * 100 / total) or "      -"
+end
+
+---Accumulated results of one configuration.
+local function new_stats()
+  return {
+    samples = 0, answered = 0, exact = 0, decoded = 0, time = 0,
+    times = {}, confusion = {}
+  }
+end
+
+local function percentile(values, fraction)
+  if #values == 0 then return 0 end
+  table.sort(values)
+  return values[math.max(1, math.ceil(#values * fraction))]
+end
+
+parse_arguments(arg)
+local encoding = load_library(options.library)
+
+for _, path in ipairs(options.seeds) do
+  local file = assert(io.open(path, "rb"))
+  local text = file:read("a"):gsub("\r?\n", " ")
+  file:close()
+  table.insert(seeds, { path, text })
+end
+
+local charsets = {}
+for _, entry in ipairs(encoding.charsets()) do
+  if entry.group ~= "Other"
+    and (not options.charsets or options.charsets[entry.charset:upper()])
+  then
+    table.insert(charsets, entry)
+  end
+end
+
+local max_size = 0
+for _, size in ipairs(options.sizes) do
+  max_size = math.max(max_size, size)
+end
+
+local orders = {}
+for _, order in ipairs(options.orders) do
+  table.insert(orders, { name = order, engines = split(order, "+") })
+end
+
+local results = {}
+local function stats_of(order, size, position)
+  local key = order .. " " .. size .. " " .. position
+  results[key] = results[key] or new_stats()
+  return results[key]
+end
+
+local csv = options.csv and assert(io.open(options.csv, "wb"))
+if csv then
+  csv:write("order,size,position,kind,language,charset,detected,exact,decoded,microseconds\n")
+end
+
+local corpus_size, corpus_samples = 0, 0
+local started = os.clock()
+
+for _, entry in ipairs(charsets) do
+  local charset = entry.charset
+  local bom = entry.bom and encoding.get_charset_bom(charset) or ""
+  for _, seed in ipairs(seeds) do
+    local language, text = seed[1], seed[2]
+    local kinds = {
+      { "prose", make_prose(text, max_size) },
+      { "code", make_code(text, max_size) }
+    }
+    for _, kind in ipairs(kinds) do
+      local converted = encoding.convert(charset, "UTF-8", kind[2], { strict = true })
+      -- texts the charset can't hold are skipped, ascii ones are left to UTF-8
+      -- as they read the same in every ascii compatible charset
+      if converted and (converted ~= kind[2] or charset == "UTF-8") then
+        local variants = { { kind[1], converted, options.positions } }
+        if #bom > 0 then
+          table.insert(variants, { kind[1] .. "+bom", bom .. converted, { "start" } })
+        end
+        for _, variant in ipairs(variants) do
+          local name, data, positions = variant[1], variant[2], variant[3]
+          corpus_size = corpus_size + #data
+          for _, size in ipairs(options.sizes) do
+            for _, position in ipairs(positions) do
+              local sample = sample_of(data, size, position)
+              local expected = encoding.convert("UTF-8", charset, sample, { handle_from_bom = true })
+              corpus_samples = corpus_samples + 1
+              for _, order in ipairs(orders) do
+                local detect_options = { engines = order.engines }
+                local detected = encoding.detect(sample, detect_options)
+                local start = os.clock()
+                for _ = 1, options.rounds do
+                  encoding.detect(sample, detect_options)
+                end
+                local elapsed = (os.clock() - start) / options.rounds
+                local exact = detected ~= nil and detected:upper() == charset:upper()
+                local decoded = exact
+                if detected and not exact then
+                  local output = encoding.convert("UTF-8", detected, sample, { handle_from_bom = true })
+                  decoded = output ~= nil and output == expected
+                end
+                local stats = stats_of(order.name, size, position)
+                stats.samples = stats.samples + 1
+                stats.answered = stats.answered + (detected and 1 or 0)
+                stats.exact = stats.exact + (exact and 1 or 0)
+                stats.decoded = stats.decoded + (decoded and 1 or 0)
+                stats.time = stats.time + elapsed
+                table.insert(stats.times, elapsed)
+                stats.confusion[charset] = stats.confusion[charset] or { total = 0, wrong = {} }
+                local confusion = stats.confusion[charset]
+                confusion.total = confusion.total + 1
+                if detected and not decoded then
+                  confusion.wrong[detected] = (confusion.wrong[detected] or 0) + 1
+                elseif not detected then
+                  confusion.wrong["(none)"] = (confusion.wrong["(none)"] or 0) + 1
+                end
+                if csv then
+                  csv:write(string.format(
+                    "%s,%d,%s,%s,%s,%s,%s,%s,%s,%.2f\n", order.name, size, position,
+                    name, language, charset, detected or "", exact, decoded, elapsed * 1e6
+                  ))
+                end
+              end
+            end
+          end
+        end
+      end
+    end
+  end
+end
+
+if csv then csv:close() end
+
+print(string.format(
+  "corpus: %d charsets, %d languages, %.1f MB, %d samples per engine order, %.1fs",
+  #charsets, #seeds, corpus_size / 1e6, corpus_samples, os.clock() - started
+))
+
+local function print_confusion(title, stats)
+  print()
+  print("confusion of " .. title .. ", charsets with wrong detections:")
+  local rows = {}
+  for charset, confusion in pairs(stats.confusion) do
+    local wrong, pairs_list = 0, {}
+    for detected, count in pairs(confusion.wrong) do
+      wrong = wrong + count
+      table.insert(pairs_list, { detected, count })
+    end
+    if wrong > 0 then
+      table.sort(pairs_list, function(a, b) return a[2] > b[2] end)
+      table.insert(rows, { charset, confusion.total, wrong, pairs_list })
+    end
+  end
+  table.sort(rows, function(a, b) return a[3] / a[2] > b[3] / b[2] end)
+  for _, row in ipairs(rows) do
+    local parts = {}
+    for i = 1, math.min(4, #row[4]) do
+      table.insert(parts, row[4][i][1] .. " x" .. row[4][i][2])
+    end
+    print(string.format("  %-18s %s wrong: %s", row[1], percent(row[3], row[2]), table.concat(parts, ", ")))
+  end
+end
+
+for _, order in ipairs(orders) do
+  print()
+  print("engines " .. order.name)
+  print("      size  position  answered     exact   decoded   mean us    p95 us")
+  for _, size in ipairs(options.sizes) do
+    for _, position in ipairs(options.positions) do
+      local stats = results[order.name .. " " .. size .. " " .. position]
+      if stats then
+        print(string.format(
+          "%10d  %-8s  %s  %s  %s  %8.1f  %8.1f", size, position,
+          percent(stats.answered, stats.samples), percent(stats.exact, stats.samples),
+          percent(stats.decoded, stats.samples), stats.time / stats.samples * 1e6,
+          percentile(stats.times, 0.95) * 1e6
+        ))
+      end
+    end
+  end
+end
+
+-- the smallest sample of the start of files as accurate as the biggest one
+local default = orders[1] and orders[1].name
+local best, best_size = -1, nil
+for _, size in ipairs(options.sizes) do
+  local stats = default and results[default .. " " .. size .. " start"]
+  if stats and stats.decoded / stats.samples > best then
+    best = stats.decoded / stats.samples
+  end
+end
+for _, size in ipairs(options.sizes) do
+  local stats = default and results[default .. " " .. size .. " start"]
+  if stats and not best_size and stats.decoded / stats.samples >= best - 0.005 then
+    best_size = size
+  end
+end
+if best_size then
+  print()
+  print(string.format(
+    "smallest start sample within 0.5 points of the best with %s: %d bytes",
+    default, best_size
+  ))
+end
+
+for _, order in ipairs(orders) do
+  if options.confusion or order.name == DEFAULT_ORDER then
+    for _, size in ipairs(options.sizes) do
+      local stats = results[order.name .. " " .. size .. " start"]
+      if stats and (options.confusion or size == best_size) then
+        print_confusion(order.name .. ", " .. size .. " bytes from the start", stats)
+      end
+    end
+  end
+end
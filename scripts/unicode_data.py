@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+#
+# Generates src/unicode_data.h with the tables needed for the NFC and NFD
+# normalization of encoding.normalize() from the unicodedata module.
+#
+#   python3 scripts/unicode_data.py > src/unicode_data.h
+#
+
+import unicodedata
+
+MAX = 0x110000
+S_BASE, S_COUNT = 0xAC00, 11172
+
+
+def chars():
+  for cp in range(MAX):
+    if 0xD800 <= cp <= 0xDFFF:
+      continue
+    yield cp
+
+
+def canonical_decomposition(cp):
+  decomposition = unicodedata.decomposition(chr(cp))
+  if not decomposition or decomposition.startswith("<"):
+    return None
+  return [int(part, 16) for part in decomposition.split()]
+
+
+def runs(values):
+  """Groups consecutive codepoints with the same value into ranges."""
+  result = []
+  for cp in sorted(values):
+    value = values[cp]
+    if result and result[-1][1] == cp - 1 and result[-1][2] == value:
+      result[-1][1] = cp
+    else:
+      result.append([cp, cp, value])
+  return result
+
+
+def table(name, ctype, rows, per_line):
+  print("static const %s %s[] = {" % (ctype, name))
+  for i in range(0, len(rows), per_line):
+    print("  " + " ".join(rows[i:i + per_line]))
+  print("};")
+  print()
+
+
+combining = {}
+decompositions = {}
+compositions = []
+nfc_quick_check = {}
+for cp in chars():
+  ccc = unicodedata.combining(chr(cp))
+  if ccc:
+    combining[cp] = ccc
+  decomposition = canonical_decomposition(cp)
+  if decomposition:
+    decompositions[cp] = decomposition
+    if len(decomposition) == 2 and unicodedata.normalize("NFC", "".join(map(chr, decomposition))) == chr(cp):
+      compositions.append((decomposition[0], decomposition[1], cp))
+  if unicodedata.normalize("NFC", chr(cp)) != chr(cp):
+    nfc_quick_check[cp] = 2
+for first, second, composite in compositions:
+  nfc_quick_check.setdefault(second, 1)
+# hangul vowels and trailing consonants compose with the preceding jamo
+for cp in list(range(0x1161, 0x1176)) + list(range(0x11A8, 0x11C3)):
+  nfc_quick_check.setdefault(cp, 1)
+
+pool = []
+entries = []
+for cp in sorted(decompositions):
+  entries.append("{ 0x%05X, %d, %d }," % (cp, len(pool), len(decompositions[cp])))
+  pool.extend(decompositions[cp])
+
+print("/* Generated by scripts/unicode_data.py from Unicode %s, do not edit. */" % unicodedata.unidata_version)
+print()
+print("#define UNICODE_DATA_VERSION \"%s\"" % unicodedata.unidata_version)
+print()
+print("typedef struct { unsigned int first, last; unsigned char value; } unicode_range_t;")
+print("typedef struct { unsigned int codepoint; unsigned short index; unsigned char length; } unicode_decomposition_t;")
+print("typedef struct { unsigned int first, second, composite; } unicode_composition_t;")
+print()
+print("/* Canonical combining classes other than zero. */")
+table("unicode_combining", "unicode_range_t",
+  ["{ 0x%05X, 0x%05X, %3d }," % tuple(run) for run in runs(combining)], 3)
+print("/* NFC quick check values, 1 for maybe and 2 for no, the rest are yes. */")
+table("unicode_nfc_quick_check", "unicode_range_t",
+  ["{ 0x%05X, 0x%05X, %d }," % tuple(run) for run in runs(nfc_quick_check)], 3)
+print("/* Canonical decompositions, one level deep, indexing unicode_decomposition_pool. */")
+table("unicode_decompositions", "unicode_decomposition_t", entries, 3)
+table("unicode_decomposition_pool", "unsigned int", ["0x%05X," % cp for cp in pool], 8)
+print("/* Primary composites sorted by their two characters. */")
+table("unicode_compositions", "unicode_composition_t",
+  ["{ 0x%05X, 0x%05X, 0x%05X }," % c for c in sorted(compositions)], 2)
@@ -1,256 +1,9608 @@
 #include <errno.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <uchardet.h>
 #include <string.h>
 #include <iconv.h>
 
 #ifdef _WIN32
   #include <windows.h>
+#else
+  #include <dirent.h>
+  #include <fcntl.h>
+  #include <pthread.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <sys/time.h>
+  #include <time.h>
+#endif
+
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define ENCODING_AVX2
+  #include <immintrin.h>
+#endif
+#if defined(__aarch64__)
+  #define ENCODING_NEON
+  #include <arm_neon.h>
+#endif
+
+#ifdef ENCODING_ZLIB
+  #include <zlib.h>
+#endif
+#ifdef ENCODING_ZSTD
+  #include <zstd.h>
 #endif
 
+#include "unicode_data.h"
+
 #ifdef ENCODING_STANDLONE
   #include <lua.h>
   #include <lauxlib.h>
   #include <lualib.h>
+  #define lite_xl_plugin_init(api_require)
 #else
   #define LITE_XL_PLUGIN_ENTRYPOINT
   #include <lite_xl_plugin_api.h>
 #endif
 
+/* Minimal threading primitives over pthreads and win32. */
+#ifdef _WIN32
+  typedef HANDLE thread_t;
+  typedef CRITICAL_SECTION mutex_t;
+  typedef CONDITION_VARIABLE cond_t;
+  typedef struct { void* (*func)(void*); void* data; } thread_start_t;
+  static DWORD WINAPI thread_trampoline(LPVOID data) {
+    thread_start_t start = *(thread_start_t*)data;
+    free(data);
+    start.func(start.data);
+    return 0;
+  }
+  static bool thread_create(thread_t* thread, void* (*func)(void*), void* data) {
+    thread_start_t* start = malloc(sizeof(thread_start_t));
+    start->func = func;
+    start->data = data;
+    *thread = CreateThread(NULL, 0, thread_trampoline, start, 0, NULL);
+    if (!*thread)
+      free(start);
+    return *thread != NULL;
+  }
+  static void thread_join(thread_t thread) { WaitForSingleObject(thread, INFINITE); CloseHandle(thread); }
+  static void mutex_init(mutex_t* mutex) { InitializeCriticalSection(mutex); }
+  static void mutex_destroy(mutex_t* mutex) { DeleteCriticalSection(mutex); }
+  static void mutex_lock(mutex_t* mutex) { EnterCriticalSection(mutex); }
+  static bool mutex_trylock(mutex_t* mutex) { return TryEnterCriticalSection(mutex); }
+  static void mutex_unlock(mutex_t* mutex) { LeaveCriticalSection(mutex); }
+  static void cond_init(cond_t* cond) { InitializeConditionVariable(cond); }
+  static void cond_destroy(cond_t* cond) { }
+  static void cond_wait(cond_t* cond, mutex_t* mutex) { SleepConditionVariableCS(cond, mutex, INFINITE); }
+  static void cond_signal(cond_t* cond) { WakeConditionVariable(cond); }
+  static void cond_broadcast(cond_t* cond) { WakeAllConditionVariable(cond); }
+  static int thread_cpu_count() { SYSTEM_INFO info; GetSystemInfo(&info); return info.dwNumberOfProcessors; }
+  static double clock_seconds() {
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double)counter.QuadPart / frequency.QuadPart;
+  }
+#else
+  typedef pthread_t thread_t;
+  typedef pthread_mutex_t mutex_t;
+  typedef pthread_cond_t cond_t;
+  static bool thread_create(thread_t* thread, void* (*func)(void*), void* data) { return pthread_create(thread, NULL, func, data) == 0; }
+  static void thread_join(thread_t thread) { pthread_join(thread, NULL); }
+  static void mutex_init(mutex_t* mutex) { pthread_mutex_init(mutex, NULL); }
+  static void mutex_destroy(mutex_t* mutex) { pthread_mutex_destroy(mutex); }
+  static void mutex_lock(mutex_t* mutex) { pthread_mutex_lock(mutex); }
+  static bool mutex_trylock(mutex_t* mutex) { return pthread_mutex_trylock(mutex) == 0; }
+  static void mutex_unlock(mutex_t* mutex) { pthread_mutex_unlock(mutex); }
+  static void cond_init(cond_t* cond) { pthread_cond_init(cond, NULL); }
+  static void cond_destroy(cond_t* cond) { pthread_cond_destroy(cond); }
+  static void cond_wait(cond_t* cond, mutex_t* mutex) { pthread_cond_wait(cond, mutex); }
+  static void cond_signal(cond_t* cond) { pthread_cond_signal(cond); }
+  static void cond_broadcast(cond_t* cond) { pthread_cond_broadcast(cond); }
+  static int thread_cpu_count() { long count = sysconf(_SC_NPROCESSORS_ONLN); return count > 0 ? count : 1; }
+  static double clock_seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+  }
+#endif
+
+
+#ifdef _WIN32
+/* Windows wants wide paths while lite-xl hands us utf8 ones */
+static wchar_t* encoding_wide_path(const char* path) {
+  int len = MultiByteToWideChar(CP_UTF8, 0, path, -1, NULL, 0);
+  wchar_t* wide = len > 0 ? malloc(len * sizeof(wchar_t)) : NULL;
+  if (wide)
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, wide, len);
+  return wide;
+}
+#endif
+
+/* Opens a file from an utf8 path. */
+static FILE* encoding_fopen(const char* filename, const char* mode) {
+#ifdef _WIN32
+  wchar_t wide_mode[8] = {0};
+  for (size_t i = 0; mode[i] && i < 7; ++i)
+    wide_mode[i] = mode[i];
+  wchar_t* path = encoding_wide_path(filename);
+  FILE* file = path ? _wfopen(path, wide_mode) : NULL;
+  free(path);
+  return file;
+#else
+  return fopen(filename, mode);
+#endif
+}
+
+/* Deletes a file from an utf8 path. */
+static bool encoding_remove(const char* filename) {
+#ifdef _WIN32
+  wchar_t* path = encoding_wide_path(filename);
+  bool removed = path && DeleteFileW(path);
+  free(path);
+  return removed;
+#else
+  return unlink(filename) == 0;
+#endif
+}
+
+/* Moves a file over another one, replacing it in a single step. */
+static bool encoding_rename(const char* from, const char* to) {
+#ifdef _WIN32
+  wchar_t* wide_from = encoding_wide_path(from);
+  wchar_t* wide_to = encoding_wide_path(to);
+  bool renamed = wide_from && wide_to
+    && MoveFileExW(wide_from, wide_to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+  free(wide_from);
+  free(wide_to);
+  return renamed;
+#else
+  return rename(from, to) == 0;
+#endif
+}
+
+#ifndef _WIN32
+/* Modification time in nanoseconds, edits within the same second differ. */
+static long long encoding_stat_mtime(const struct stat* st) {
+#ifdef __APPLE__
+  return (long long)st->st_mtimespec.tv_sec * 1000000000LL + st->st_mtimespec.tv_nsec;
+#else
+  return (long long)st->st_mtim.tv_sec * 1000000000LL + st->st_mtim.tv_nsec;
+#endif
+}
+#endif
+
+/* Sets the modification time of a file to now. */
+static bool encoding_touch(const char* filename) {
+#ifdef _WIN32
+  wchar_t* path = encoding_wide_path(filename);
+  HANDLE file = path ? CreateFileW(
+    path, FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL
+  ) : INVALID_HANDLE_VALUE;
+  free(path);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+  FILETIME now;
+  GetSystemTimeAsFileTime(&now);
+  bool touched = SetFileTime(file, NULL, NULL, &now);
+  CloseHandle(file);
+  return touched;
+#else
+  return utimes(filename, NULL) == 0;
+#endif
+}
+
+/* Size and modification time of a file, in the units of encoding_map_file(). */
+static bool encoding_file_stamp(const char* filename, unsigned long long* size, long long* mtime) {
+#ifdef _WIN32
+  wchar_t* path = encoding_wide_path(filename);
+  WIN32_FILE_ATTRIBUTE_DATA data;
+  bool found = path && GetFileAttributesExW(path, GetFileExInfoStandard, &data);
+  free(path);
+  if (!found)
+    return false;
+  *size = ((unsigned long long)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+  *mtime = ((long long)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+  return true;
+#else
+  struct stat st;
+  if (stat(filename, &st) != 0)
+    return false;
+  *size = st.st_size;
+  *mtime = encoding_stat_mtime(&st);
+  return true;
+#endif
+}
+
+#ifdef _WIN32
+/* The errno closest to a windows error code. */
+static int encoding_win32_errno(DWORD code) {
+  switch (code) {
+    case ERROR_FILE_NOT_FOUND:
+    case ERROR_PATH_NOT_FOUND: return ENOENT;
+    case ERROR_ACCESS_DENIED: return EACCES;
+    case ERROR_SHARING_VIOLATION:
+    case ERROR_LOCK_VIOLATION: return EBUSY;
+    case ERROR_NOT_ENOUGH_MEMORY:
+    case ERROR_OUTOFMEMORY: return ENOMEM;
+    case ERROR_DISK_FULL:
+    case ERROR_HANDLE_DISK_FULL: return ENOSPC;
+    default: return EIO;
+  }
+}
+#else
+/* Writes all of data to fd and flushes it to disk, false with errno set. */
+static bool encoding_write_fd(int fd, const char* data, size_t len) {
+  for (size_t done = 0; done < len;) {
+    ssize_t count = write(fd, data + done, len - done);
+    if (count < 0 && errno == EINTR)
+      continue;
+    if (count <= 0) {
+      if (count == 0)
+        errno = EIO;
+      return false;
+    }
+    done += count;
+  }
+  return fsync(fd) == 0;
+}
+
+/* Rewrites a file where it is, for the files that can't be replaced. */
+static bool encoding_write_in_place(const char* path, const char* data, size_t len, int* error) {
+  int fd = open(path, O_WRONLY | O_TRUNC);
+  if (fd < 0) {
+    *error = errno;
+    return false;
+  }
+  bool written = encoding_write_fd(fd, data, len);
+  if (!written)
+    *error = errno;
+  if (close(fd) != 0 && written) {
+    written = false;
+    *error = errno;
+  }
+  return written;
+}
+#endif
+
+/*
+ * Writes a whole file through a temporary one next to it, flushed to disk and
+ * renamed over it, so the file is never left half written. Symbolic links are
+ * followed and the permissions, owner and attributes of the file replaced are
+ * kept. Files with other hard links, in directories that can't be written or
+ * which owner can't be given to the temporary are written in place instead.
+ * The error number is set on failure.
+*/
+static bool encoding_write_atomic(
+  const char* filename, const char* data, size_t len, int* error
+) {
+#ifdef _WIN32
+  wchar_t* target = encoding_wide_path(filename);
+  DWORD attributes = target ? GetFileAttributesW(target) : INVALID_FILE_ATTRIBUTES;
+  free(target);
+  /* read only files stay so, as when written in place */
+  if (attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_READONLY)) {
+    *error = EACCES;
+    return false;
+  }
+  size_t name_len = strlen(filename);
+  char* temp = malloc(name_len + 32);
+  wchar_t* path = NULL;
+  if (temp) {
+    snprintf(temp, name_len + 32, "%s.%lu.tmp", filename, (unsigned long)GetCurrentThreadId());
+    path = encoding_wide_path(temp);
+  }
+  *error = ENOMEM;
+  HANDLE file = path ? CreateFileW(
+    path, GENERIC_WRITE, 0, NULL, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, NULL
+  ) : INVALID_HANDLE_VALUE;
+  if (path && file == INVALID_HANDLE_VALUE)
+    *error = encoding_win32_errno(GetLastError());
+  bool written = file != INVALID_HANDLE_VALUE;
+  for (size_t done = 0; written && done < len;) {
+    DWORD count = 0;
+    DWORD chunk = len - done > 0x40000000 ? 0x40000000 : (DWORD)(len - done);
+    written = WriteFile(file, data + done, chunk, &count, NULL) && count > 0;
+    if (!written)
+      *error = encoding_win32_errno(GetLastError());
+    done += count;
+  }
+  if (written && !FlushFileBuffers(file)) {
+    *error = encoding_win32_errno(GetLastError());
+    written = false;
+  }
+  if (file != INVALID_HANDLE_VALUE)
+    CloseHandle(file);
+  /* hidden, system and the like carry over to the new file */
+  if (written && attributes != INVALID_FILE_ATTRIBUTES && attributes != FILE_ATTRIBUTE_NORMAL)
+    SetFileAttributesW(path, attributes);
+  bool renamed = written && encoding_rename(temp, filename);
+  if (written && !renamed)
+    *error = encoding_win32_errno(GetLastError());
+  if (!renamed && file != INVALID_HANDLE_VALUE)
+    encoding_remove(temp);
+  free(path);
+  free(temp);
+  return renamed;
+#else
+  char* target = realpath(filename, NULL);
+  const char* path = target ? target : filename;
+  struct stat info;
+  bool exists = stat(path, &info) == 0;
+  /* read only files stay so, as when written in place */
+  if (exists && access(path, W_OK) != 0) {
+    *error = errno;
+    free(target);
+    return false;
+  }
+  size_t path_len = strlen(path);
+  char* temp = malloc(path_len + 48);
+  char* dir = malloc(path_len + 2);
+  if (!temp || !dir) {
+    free(temp);
+    free(dir);
+    free(target);
+    *error = ENOMEM;
+    return false;
+  }
+  const char* slash = strrchr(path, '/');
+  if (slash) {
+    size_t dir_len = slash > path ? (size_t)(slash - path) : 1;
+    memcpy(dir, path, dir_len);
+    dir[dir_len] = '\0';
+  } else {
+    strcpy(dir, ".");
+  }
+  /* other hard links would keep the old contents, and the owner could be lost */
+  bool in_place = exists && (info.st_nlink > 1 || access(dir, W_OK | X_OK) != 0);
+  int fd = -1;
+  if (!in_place) {
+    snprintf(temp, path_len + 48, "%s.%ld-%lx.tmp", path, (long)getpid(), (unsigned long)pthread_self());
+    fd = open(temp, O_WRONLY | O_CREAT | O_EXCL, exists ? info.st_mode & 07777 : 0666);
+    *error = errno;
+    if (fd >= 0 && exists && (info.st_uid != geteuid() || info.st_gid != getegid())
+      && fchown(fd, info.st_uid, info.st_gid) != 0) {
+      close(fd);
+      encoding_remove(temp);
+      fd = -1;
+      in_place = true;
+    }
+  }
+  if (in_place) {
+    bool written = encoding_write_in_place(path, data, len, error);
+    free(temp);
+    free(dir);
+    free(target);
+    return written;
+  }
+  bool written = fd >= 0 && (!exists || fchmod(fd, info.st_mode & 07777) == 0);
+  written = written && encoding_write_fd(fd, data, len);
+  if (fd >= 0 && !written)
+    *error = errno ? errno : EIO;
+  if (fd >= 0 && close(fd) != 0 && written) {
+    written = false;
+    *error = errno;
+  }
+  bool renamed = written && encoding_rename(temp, path);
+  if (written && !renamed)
+    *error = errno;
+  if (!renamed && fd >= 0)
+    encoding_remove(temp);
+  /* the rename itself is only durable once the directory is flushed too */
+  int dir_fd = renamed ? open(dir, O_RDONLY) : -1;
+  if (dir_fd >= 0) {
+    fsync(dir_fd);
+    close(dir_fd);
+  }
+  free(temp);
+  free(dir);
+  free(target);
+  return renamed;
+#endif
+}
+
+
+/*
+ * Bump allocator for native temporaries. Blocks are requested through the lua
+ * allocator and kept between calls, consolidated into one big enough for the
+ * last round, so repeated operations reach a steady state without allocating.
+*/
+typedef struct arena_block_s {
+  struct arena_block_s* next;
+  size_t size;
+  size_t used;
+  size_t padding;
+} arena_block_t;
+
+typedef struct {
+  lua_Alloc alloc;
+  void* alloc_ud;
+  arena_block_t* blocks;    /* the first block is the one being filled */
+  size_t used;
+  size_t reserved;
+  size_t peak;
+  size_t block_allocations;
+} arena_t;
+
+#define ARENA_ALIGN 16
+#define ARENA_MIN_BLOCK (64*1024)
+#define ARENA_MAX_RETAINED (8*1024*1024)
+
+/* Temporaries of the functions called from lua, only used from its thread. */
+static arena_t encoding_arena;
+
+static void* arena_block_data(arena_block_t* block) {
+  return (char*)block + sizeof(arena_block_t);
+}
+
+static arena_block_t* arena_new_block(arena_t* arena, size_t size) {
+  size_t total = sizeof(arena_block_t) + size;
+  arena_block_t* block = arena->alloc ?
+    arena->alloc(arena->alloc_ud, NULL, 0, total) : malloc(total);
+  if (!block)
+    return NULL;
+  block->size = size;
+  block->used = 0;
+  block->next = arena->blocks;
+  arena->blocks = block;
+  arena->reserved += size;
+  arena->block_allocations++;
+  return block;
+}
+
+static void arena_free_blocks(arena_t* arena) {
+  while (arena->blocks) {
+    arena_block_t* next = arena->blocks->next;
+    size_t total = sizeof(arena_block_t) + arena->blocks->size;
+    if (arena->alloc)
+      arena->alloc(arena->alloc_ud, arena->blocks, total, 0);
+    else
+      free(arena->blocks);
+    arena->blocks = next;
+  }
+  arena->reserved = 0;
+}
+
+static void* arena_alloc(arena_t* arena, size_t size) {
+  size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+  arena_block_t* block = arena->blocks;
+  if (!block || block->size - block->used < size) {
+    block = arena_new_block(arena, size > ARENA_MIN_BLOCK ? size : ARENA_MIN_BLOCK);
+    if (!block)
+      return NULL;
+  }
+  void* ptr = (char*)arena_block_data(block) + block->used;
+  block->used += size;
+  arena->used += size;
+  if (arena->used > arena->peak)
+    arena->peak = arena->used;
+  return ptr;
+}
+
+/* Grows an allocation, in place when it's the last one made on the arena. */
+static void* arena_realloc(arena_t* arena, void* ptr, size_t old_size, size_t size) {
+  arena_block_t* block = arena->blocks;
+  old_size = (old_size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+  if (ptr && block && (char*)ptr + old_size == (char*)arena_block_data(block) + block->used) {
+    size_t grown = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (grown <= old_size)
+      return ptr;
+    if (block->size - block->used >= grown - old_size) {
+      block->used += grown - old_size;
+      arena->used += grown - old_size;
+      if (arena->used > arena->peak)
+        arena->peak = arena->used;
+      return ptr;
+    }
+  }
+  void* grown = arena_alloc(arena, size);
+  if (grown && ptr)
+    memcpy(grown, ptr, old_size < size ? old_size : size);
+  return grown;
+}
+
+/* Releases every allocation, keeping a single block sized for the last round. */
+static void arena_reset(arena_t* arena) {
+  size_t round = arena->used;
+  if (arena->blocks && (arena->blocks->next || arena->blocks->size > ARENA_MAX_RETAINED)) {
+    arena_free_blocks(arena);
+    if (round <= ARENA_MAX_RETAINED)
+      arena_new_block(arena, round > ARENA_MIN_BLOCK ? round : ARENA_MIN_BLOCK);
+  }
+  if (arena->blocks)
+    arena->blocks->used = 0;
+  arena->used = 0;
+}
+
+
+/*
+ * A growable byte string living on an arena, or on the heap if none given.
+ * When a limit is set the capacity never goes over it, reservations past the
+ * limit are clamped and fail with EFBIG once no room is left.
+*/
+typedef struct {
+  char* data;
+  size_t size;
+  size_t capacity;
+  arena_t* arena;
+  size_t limit;
+} bytes_t;
+
+static bool bytes_reserve(bytes_t* bytes, size_t extra) {
+  if (bytes->limit && bytes->size + extra > bytes->limit) {
+    extra = bytes->limit > bytes->size ? bytes->limit - bytes->size : 0;
+    if (extra == 0) {
+      errno = EFBIG;
+      return false;
+    }
+  }
+  if (bytes->capacity - bytes->size >= extra)
+    return true;
+  size_t capacity = bytes->capacity * 2;
+  if (capacity < bytes->size + extra)
+    capacity = bytes->size + extra;
+  if (bytes->limit && capacity > bytes->limit)
+    capacity = bytes->limit;
+  char* data = bytes->arena ?
+    arena_realloc(bytes->arena, bytes->data, bytes->capacity, capacity) :
+    realloc(bytes->data, capacity);
+  if (!data)
+    return false;
+  bytes->data = data;
+  bytes->capacity = capacity;
+  return true;
+}
+
+static void bytes_free(bytes_t* bytes) {
+  if (!bytes->arena)
+    free(bytes->data);
+  bytes->data = NULL;
+  bytes->size = bytes->capacity = 0;
+}
+
+
+/*
+ * XXH64 of raw and converted bytes, hashing eight bytes per step on four
+ * independent lanes so long inputs hash at memory speed. The streaming state
+ * lets conversions hash their input and output slice by slice while each
+ * slice is still in the cpu cache, instead of in another pass.
+*/
+#define XXH_PRIME1 0x9E3779B185EBCA87ull
+#define XXH_PRIME2 0xC2B2AE3D27D4EB4Full
+#define XXH_PRIME3 0x165667B19E3779F9ull
+#define XXH_PRIME4 0x85EBCA77C2B2AE63ull
+#define XXH_PRIME5 0x27D4EB2F165667C5ull
+
+typedef struct {
+  unsigned long long lanes[4];
+  unsigned long long total;
+  unsigned long long seed;
+  unsigned char buffer[32];
+  size_t buffered;
+} hash_state_t;
+
+static inline unsigned long long xxh_rotl(unsigned long long value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+static inline unsigned long long xxh_read64(const unsigned char* p) {
+  unsigned long long value;
+  memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  value = __builtin_bswap64(value);
+#endif
+  return value;
+}
+
+static inline unsigned long long xxh_round(unsigned long long acc, unsigned long long input) {
+  return xxh_rotl(acc + input * XXH_PRIME2, 31) * XXH_PRIME1;
+}
+
+static inline unsigned long long xxh_merge(unsigned long long acc, unsigned long long lane) {
+  return (acc ^ xxh_round(0, lane)) * XXH_PRIME1 + XXH_PRIME4;
+}
+
+/* Runs the lanes over as many whole 32 byte stripes as available. */
+static const unsigned char* xxh_stripes(
+  unsigned long long* lanes, const unsigned char* p, const unsigned char* end
+) {
+  while (end - p >= 32) {
+    lanes[0] = xxh_round(lanes[0], xxh_read64(p));
+    lanes[1] = xxh_round(lanes[1], xxh_read64(p + 8));
+    lanes[2] = xxh_round(lanes[2], xxh_read64(p + 16));
+    lanes[3] = xxh_round(lanes[3], xxh_read64(p + 24));
+    p += 32;
+  }
+  return p;
+}
+
+/* Folds the lanes, the remaining bytes and the total length into the hash. */
+static unsigned long long xxh_finish(
+  const unsigned long long* lanes, unsigned long long seed, unsigned long long total,
+  const unsigned char* p, const unsigned char* end
+) {
+  unsigned long long hash;
+  if (total >= 32) {
+    hash = xxh_rotl(lanes[0], 1) + xxh_rotl(lanes[1], 7)
+      + xxh_rotl(lanes[2], 12) + xxh_rotl(lanes[3], 18);
+    for (int i = 0; i < 4; ++i)
+      hash = xxh_merge(hash, lanes[i]);
+  } else {
+    hash = seed + XXH_PRIME5;
+  }
+  hash += total;
+  for (; end - p >= 8; p += 8)
+    hash = xxh_rotl(hash ^ xxh_round(0, xxh_read64(p)), 27) * XXH_PRIME1 + XXH_PRIME4;
+  if (end - p >= 4) {
+    unsigned long long word = (unsigned long long)p[0] | (unsigned long long)p[1] << 8
+      | (unsigned long long)p[2] << 16 | (unsigned long long)p[3] << 24;
+    hash = xxh_rotl(hash ^ word * XXH_PRIME1, 23) * XXH_PRIME2 + XXH_PRIME3;
+    p += 4;
+  }
+  for (; p < end; ++p)
+    hash = xxh_rotl(hash ^ *p * XXH_PRIME5, 11) * XXH_PRIME1;
+  hash ^= hash >> 33;
+  hash *= XXH_PRIME2;
+  hash ^= hash >> 29;
+  hash *= XXH_PRIME3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+static void hash_init(hash_state_t* state, unsigned long long seed) {
+  state->lanes[0] = seed + XXH_PRIME1 + XXH_PRIME2;
+  state->lanes[1] = seed + XXH_PRIME2;
+  state->lanes[2] = seed;
+  state->lanes[3] = seed - XXH_PRIME1;
+  state->total = 0;
+  state->seed = seed;
+  state->buffered = 0;
+}
+
+static void hash_update(hash_state_t* state, const char* data, size_t len) {
+  const unsigned char* p = (const unsigned char*)data;
+  const unsigned char* end = p + len;
+  state->total += len;
+  if (state->buffered > 0) {
+    size_t fill = 32 - state->buffered < len ? 32 - state->buffered : len;
+    memcpy(state->buffer + state->buffered, p, fill);
+    state->buffered += fill;
+    p += fill;
+    if (state->buffered < 32)
+      return;
+    xxh_stripes(state->lanes, state->buffer, state->buffer + 32);
+    state->buffered = 0;
+  }
+  p = xxh_stripes(state->lanes, p, end);
+  memcpy(state->buffer, p, end - p);
+  state->buffered = end - p;
+}
+
+static unsigned long long hash_digest(const hash_state_t* state) {
+  return xxh_finish(
+    state->lanes, state->seed, state->total, state->buffer, state->buffer + state->buffered
+  );
+}
+
+static unsigned long long encoding_hash64(const char* data, size_t len, unsigned long long seed) {
+  unsigned long long lanes[4] = {
+    seed + XXH_PRIME1 + XXH_PRIME2, seed + XXH_PRIME2, seed, seed - XXH_PRIME1
+  };
+  const unsigned char* p = (const unsigned char*)data;
+  const unsigned char* end = p + len;
+  return xxh_finish(lanes, seed, len, xxh_stripes(lanes, p, end), end);
+}
+
+
+/*
+ * Vectorized kernels. Each one has a portable version plus variants for the
+ * instruction sets of its architecture, and the best the cpu supports is
+ * chosen once when the library is opened, so a single build runs on old and
+ * new machines alike. ENCODING_ISA can force an instruction set by name for
+ * testing and benchmarking, kernels without a variant for it use the next
+ * best one. Variants are compiled in whenever the compiler can target their
+ * instruction set, regardless of the flags of the rest of the file.
+*/
+typedef enum {
+  ISA_SCALAR,
+  ISA_SSE2,
+  ISA_AVX2,
+  ISA_NEON,
+  ISA_COUNT
+} encoding_isa_t;
+
+static const char* const encoding_isa_names[] = { "scalar", "sse2", "avx2", "neon", NULL };
+
+typedef struct {
+  /* length of the ascii run at the start of p */
+  size_t (*ascii_span)(const unsigned char* p, size_t len);
+  /* copies the ascii run at the start of p into o, o has room for len bytes */
+  size_t (*ascii_copy)(unsigned char* o, const unsigned char* p, size_t len);
+  /* narrows the leading ascii code units of utf16 into o, returns how many */
+  size_t (*utf16_ascii)(unsigned char* o, const unsigned char* p, size_t units, bool big_endian);
+  /* first position up to last where needle starts, needle is never empty */
+  const char* (*find)(const char* p, const char* last, const char* needle, size_t needle_len);
+  /* maps p through table into o up to the first byte other than 0 mapped to 0 */
+  size_t (*translate)(unsigned char* o, const unsigned char* p, size_t len, const unsigned char* table);
+} encoding_kernels_t;
+
+static const char* const encoding_kernel_names[] = { "ascii_span", "ascii_copy", "utf16_ascii", "find", "translate", NULL };
+
+#define ASCII_WORD_MASK 0x8080808080808080ull
+
+static size_t scalar_ascii_span(const unsigned char* p, size_t len) {
+  size_t i = 0;
+  for (unsigned long long word; i + 8 <= len; i += 8) {
+    memcpy(&word, p + i, 8);
+    if (word & ASCII_WORD_MASK)
+      break;
+  }
+  while (i < len && p[i] < 0x80)
+    ++i;
+  return i;
+}
+
+static size_t scalar_ascii_copy(unsigned char* o, const unsigned char* p, size_t len) {
+  size_t i = 0;
+  for (unsigned long long word; i + 8 <= len; i += 8) {
+    memcpy(&word, p + i, 8);
+    if (word & ASCII_WORD_MASK)
+      break;
+    memcpy(o + i, &word, 8);
+  }
+  for (; i < len && p[i] < 0x80; ++i)
+    o[i] = p[i];
+  return i;
+}
+
+static size_t scalar_utf16_ascii(unsigned char* o, const unsigned char* p, size_t units, bool big_endian) {
+  int high = big_endian ? 0 : 1, low = big_endian ? 1 : 0;
+  size_t i = 0;
+  for (; i < units && p[i * 2 + high] == 0 && p[i * 2 + low] < 0x80; ++i)
+    o[i] = p[i * 2 + low];
+  return i;
+}
+
+static const char* scalar_find(const char* p, const char* last, const char* needle, size_t needle_len) {
+  while (p <= last) {
+    p = memchr(p, needle[0], last - p + 1);
+    if (!p)
+      return NULL;
+    if (memcmp(p + 1, needle + 1, needle_len - 1) == 0)
+      return p;
+    ++p;
+  }
+  return NULL;
+}
+
+static size_t scalar_translate(unsigned char* o, const unsigned char* p, size_t len, const unsigned char* table) {
+  size_t i = 0;
+  for (; i < len; ++i) {
+    unsigned char c = table[p[i]];
+    if (!c && p[i])
+      break;
+    o[i] = c;
+  }
+  return i;
+}
+
+#if defined(__SSE2__)
+static size_t sse2_ascii_span(const unsigned char* p, size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(p + i)));
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+  return i + scalar_ascii_span(p + i, len - i);
+}
+
+static size_t sse2_ascii_copy(unsigned char* o, const unsigned char* p, size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i chunk = _mm_loadu_si128((const __m128i*)(p + i));
+    int mask = _mm_movemask_epi8(chunk);
+    _mm_storeu_si128((__m128i*)(o + i), chunk);
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+  return i + scalar_ascii_copy(o + i, p + i, len - i);
+}
+
+static size_t sse2_utf16_ascii(unsigned char* o, const unsigned char* p, size_t units, bool big_endian) {
+  /* the bits that must be clear in each unit as loaded in little endian */
+  const __m128i bits = _mm_set1_epi16(big_endian ? 0x80FF : 0xFF80);
+  size_t i = 0;
+  for (; i + 16 <= units; i += 16) {
+    __m128i a = _mm_loadu_si128((const __m128i*)(p + i * 2));
+    __m128i b = _mm_loadu_si128((const __m128i*)(p + i * 2 + 16));
+    __m128i any = _mm_and_si128(_mm_or_si128(a, b), bits);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(any, _mm_setzero_si128())) != 0xFFFF)
+      break;
+    if (big_endian) {
+      a = _mm_srli_epi16(a, 8);
+      b = _mm_srli_epi16(b, 8);
+    }
+    _mm_storeu_si128((__m128i*)(o + i), _mm_packus_epi16(a, b));
+  }
+  return i + scalar_utf16_ascii(o + i, p + i * 2, units - i, big_endian);
+}
+
+/*
+ * Candidates are filtered by comparing the first and last needle bytes
+ * sixteen positions at a time before doing the full comparison, which keeps
+ * the common no match case memory bound.
+*/
+static const char* sse2_find(const char* p, const char* last, const char* needle, size_t needle_len) {
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i final = _mm_set1_epi8(needle[needle_len - 1]);
+  for (; p + 16 <= last + 1; p += 16) {
+    __m128i block_first = _mm_loadu_si128((const __m128i*)p);
+    __m128i block_last = _mm_loadu_si128((const __m128i*)(p + needle_len - 1));
+    unsigned int mask = _mm_movemask_epi8(_mm_and_si128(
+      _mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(final, block_last)
+    ));
+    while (mask) {
+      int bit = __builtin_ctz(mask);
+      if (memcmp(p + bit + 1, needle + 1, needle_len - 1) == 0)
+        return p + bit;
+      mask &= mask - 1;
+    }
+  }
+  return scalar_find(p, last, needle, needle_len);
+}
+#endif
+
+#ifdef ENCODING_AVX2
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 static size_t avx2_ascii_span(const unsigned char* p, size_t len) {
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    unsigned int mask = _mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*)(p + i)));
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+  return i + scalar_ascii_span(p + i, len - i);
+}
+
+AVX2 static size_t avx2_ascii_copy(unsigned char* o, const unsigned char* p, size_t len) {
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i chunk = _mm256_loadu_si256((const __m256i*)(p + i));
+    unsigned int mask = _mm256_movemask_epi8(chunk);
+    _mm256_storeu_si256((__m256i*)(o + i), chunk);
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+  return i + scalar_ascii_copy(o + i, p + i, len - i);
+}
+
+AVX2 static size_t avx2_utf16_ascii(unsigned char* o, const unsigned char* p, size_t units, bool big_endian) {
+  const __m256i bits = _mm256_set1_epi16(big_endian ? 0x80FF : 0xFF80);
+  size_t i = 0;
+  for (; i + 32 <= units; i += 32) {
+    __m256i a = _mm256_loadu_si256((const __m256i*)(p + i * 2));
+    __m256i b = _mm256_loadu_si256((const __m256i*)(p + i * 2 + 32));
+    if (!_mm256_testz_si256(_mm256_or_si256(a, b), bits))
+      break;
+    if (big_endian) {
+      a = _mm256_srli_epi16(a, 8);
+      b = _mm256_srli_epi16(b, 8);
+    }
+    /* packing works within each 128 bit lane, the quadwords need reordering */
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+    _mm256_storeu_si256((__m256i*)(o + i), packed);
+  }
+  return i + scalar_utf16_ascii(o + i, p + i * 2, units - i, big_endian);
+}
+
+AVX2 static const char* avx2_find(const char* p, const char* last, const char* needle, size_t needle_len) {
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i final = _mm256_set1_epi8(needle[needle_len - 1]);
+  for (; p + 32 <= last + 1; p += 32) {
+    __m256i block_first = _mm256_loadu_si256((const __m256i*)p);
+    __m256i block_last = _mm256_loadu_si256((const __m256i*)(p + needle_len - 1));
+    unsigned int mask = _mm256_movemask_epi8(_mm256_and_si256(
+      _mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(final, block_last)
+    ));
+    while (mask) {
+      int bit = __builtin_ctz(mask);
+      if (memcmp(p + bit + 1, needle + 1, needle_len - 1) == 0)
+        return p + bit;
+      mask &= mask - 1;
+    }
+  }
+  return scalar_find(p, last, needle, needle_len);
+}
+
+/*
+ * A shuffle looks up sixteen entries of the table, each of the sixteen rows
+ * is looked up with the low nibble and kept for the bytes of its high nibble.
+*/
+AVX2 static size_t avx2_translate(unsigned char* o, const unsigned char* p, size_t len, const unsigned char* table) {
+  size_t i = 0;
+  if (len >= 32) {
+    __m256i rows[16];
+    for (int row = 0; row < 16; ++row)
+      rows[row] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(table + row * 16)));
+    const __m256i nibble = _mm256_set1_epi8(0x0F), zero = _mm256_setzero_si256();
+    for (; i + 32 <= len; i += 32) {
+      __m256i chunk = _mm256_loadu_si256((const __m256i*)(p + i));
+      __m256i low = _mm256_and_si256(chunk, nibble);
+      __m256i high = _mm256_and_si256(_mm256_srli_epi16(chunk, 4), nibble);
+      __m256i mapped = zero;
+      for (int row = 0; row < 16; ++row) {
+        __m256i selected = _mm256_cmpeq_epi8(high, _mm256_set1_epi8(row));
+        mapped = _mm256_or_si256(mapped, _mm256_and_si256(selected, _mm256_shuffle_epi8(rows[row], low)));
+      }
+      unsigned int mask = _mm256_movemask_epi8(_mm256_andnot_si256(
+        _mm256_cmpeq_epi8(chunk, zero), _mm256_cmpeq_epi8(mapped, zero)
+      ));
+      _mm256_storeu_si256((__m256i*)(o + i), mapped);
+      if (mask)
+        return i + __builtin_ctz(mask);
+    }
+  }
+  return i + scalar_translate(o + i, p + i, len - i, table);
+}
+#endif
+
+#ifdef ENCODING_NEON
+static size_t neon_ascii_span(const unsigned char* p, size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    if (vmaxvq_u8(vld1q_u8(p + i)) >= 0x80)
+      break;
+  }
+  return i + scalar_ascii_span(p + i, len - i);
+}
+
+static size_t neon_ascii_copy(unsigned char* o, const unsigned char* p, size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    uint8x16_t chunk = vld1q_u8(p + i);
+    if (vmaxvq_u8(chunk) >= 0x80)
+      break;
+    vst1q_u8(o + i, chunk);
+  }
+  return i + scalar_ascii_copy(o + i, p + i, len - i);
+}
+
+static size_t neon_utf16_ascii(unsigned char* o, const unsigned char* p, size_t units, bool big_endian) {
+  size_t i = 0;
+  for (; i + 16 <= units; i += 16) {
+    /* splits the even and odd bytes of sixteen units */
+    uint8x16x2_t planes = vld2q_u8(p + i * 2);
+    uint8x16_t high = planes.val[big_endian ? 0 : 1], low = planes.val[big_endian ? 1 : 0];
+    if (vmaxvq_u8(vorrq_u8(high, vandq_u8(low, vdupq_n_u8(0x80)))) != 0)
+      break;
+    vst1q_u8(o + i, low);
+  }
+  return i + scalar_utf16_ascii(o + i, p + i * 2, units - i, big_endian);
+}
+
+static const char* neon_find(const char* p, const char* last, const char* needle, size_t needle_len) {
+  const uint8x16_t first = vdupq_n_u8(needle[0]);
+  const uint8x16_t final = vdupq_n_u8(needle[needle_len - 1]);
+  for (; p + 16 <= last + 1; p += 16) {
+    uint8x16_t block_first = vld1q_u8((const uint8_t*)p);
+    uint8x16_t block_last = vld1q_u8((const uint8_t*)(p + needle_len - 1));
+    uint8x16_t matches = vandq_u8(vceqq_u8(first, block_first), vceqq_u8(final, block_last));
+    if (vmaxvq_u8(matches) == 0)
+      continue;
+    for (int bit = 0; bit < 16; ++bit) {
+      if (p[bit] == needle[0] && memcmp(p + bit + 1, needle + 1, needle_len - 1) == 0)
+        return p + bit;
+    }
+  }
+  return scalar_find(p, last, needle, needle_len);
+}
+
+/* Four lookups of a quarter of the table each, out of range indexes give 0. */
+static size_t neon_translate(unsigned char* o, const unsigned char* p, size_t len, const unsigned char* table) {
+  size_t i = 0;
+  if (len >= 16) {
+    uint8x16x4_t quarters[4];
+    for (int quarter = 0; quarter < 4; ++quarter) {
+      for (int part = 0; part < 4; ++part)
+        quarters[quarter].val[part] = vld1q_u8(table + quarter * 64 + part * 16);
+    }
+    const uint8x16_t step = vdupq_n_u8(64);
+    for (; i + 16 <= len; i += 16) {
+      uint8x16_t chunk = vld1q_u8(p + i), index = chunk;
+      uint8x16_t mapped = vqtbl4q_u8(quarters[0], index);
+      for (int quarter = 1; quarter < 4; ++quarter) {
+        index = vsubq_u8(index, step);
+        mapped = vorrq_u8(mapped, vqtbl4q_u8(quarters[quarter], index));
+      }
+      if (vmaxvq_u8(vandq_u8(vceqzq_u8(mapped), vtstq_u8(chunk, chunk))) != 0)
+        break;
+      vst1q_u8(o + i, mapped);
+    }
+  }
+  return i + scalar_translate(o + i, p + i, len - i, table);
+}
+#endif
+
+/*
+ * The variants of each instruction set, missing ones fall back to another set.
+ * Table lookups need the byte shuffles of ssse3, so sse2 has no translate.
+*/
+static const encoding_kernels_t encoding_kernel_sets[ISA_COUNT] = {
+  [ISA_SCALAR] = { scalar_ascii_span, scalar_ascii_copy, scalar_utf16_ascii, scalar_find, scalar_translate },
+#if defined(__SSE2__)
+  [ISA_SSE2] = { sse2_ascii_span, sse2_ascii_copy, sse2_utf16_ascii, sse2_find, NULL },
+#endif
+#ifdef ENCODING_AVX2
+  [ISA_AVX2] = { avx2_ascii_span, avx2_ascii_copy, avx2_utf16_ascii, avx2_find, avx2_translate },
+#endif
+#ifdef ENCODING_NEON
+  [ISA_NEON] = { neon_ascii_span, neon_ascii_copy, neon_utf16_ascii, neon_find, neon_translate },
+#endif
+};
+
+/* The instruction set each set falls back to, scalar falls back to itself. */
+static const encoding_isa_t encoding_isa_fallbacks[ISA_COUNT] = {
+  [ISA_SCALAR] = ISA_SCALAR, [ISA_SSE2] = ISA_SCALAR, [ISA_AVX2] = ISA_SSE2, [ISA_NEON] = ISA_SCALAR
+};
+
+#define KERNEL_COUNT 5
+
+static encoding_kernels_t kernels = {
+  scalar_ascii_span, scalar_ascii_copy, scalar_utf16_ascii, scalar_find, scalar_translate
+};
+static encoding_isa_t kernel_isas[KERNEL_COUNT];
+static encoding_isa_t encoding_isa = ISA_SCALAR;
+
+static bool encoding_isa_supported(encoding_isa_t isa) {
+  switch (isa) {
+    case ISA_SCALAR: return true;
+#if defined(__SSE2__)
+    case ISA_SSE2: return true;
+#endif
+#ifdef ENCODING_AVX2
+    case ISA_AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+#endif
+#ifdef ENCODING_NEON
+    case ISA_NEON: return true;
+#endif
+    default: return false;
+  }
+}
+
+#define KERNEL_RESOLVE(index, field) do { \
+    encoding_isa_t isa = encoding_isa; \
+    while (!encoding_kernel_sets[isa].field) \
+      isa = encoding_isa_fallbacks[isa]; \
+    kernels.field = encoding_kernel_sets[isa].field; \
+    kernel_isas[index] = isa; \
+  } while (0)
+
+/* Picks the variant of every kernel for the best or the forced instruction set. */
+static void encoding_kernels_init() {
+  static const encoding_isa_t preferred[] = { ISA_AVX2, ISA_NEON, ISA_SSE2, ISA_SCALAR };
+  for (size_t i = 0; i < sizeof(preferred) / sizeof(preferred[0]); ++i) {
+    if (encoding_isa_supported(preferred[i])) {
+      encoding_isa = preferred[i];
+      break;
+    }
+  }
+  const char* forced = getenv("ENCODING_ISA");
+  for (int isa = 0; forced && isa < ISA_COUNT; ++isa) {
+    if (strcmp(encoding_isa_names[isa], forced) == 0 && encoding_isa_supported(isa))
+      encoding_isa = isa;
+  }
+  KERNEL_RESOLVE(0, ascii_span);
+  KERNEL_RESOLVE(1, ascii_copy);
+  KERNEL_RESOLVE(2, utf16_ascii);
+  KERNEL_RESOLVE(3, find);
+  KERNEL_RESOLVE(4, translate);
+}
+
+
+/*
+ * Conversion backends. The linked iconv is usually the bundled libiconv, on
+ * glibc the C library one is available next to it under the plain names, and
+ * a few charsets have native kernels. Which one runs each charset pair is
+ * decided by a quick benchmark the first time the pair is used, between the
+ * linked iconv and the native kernels, the C library one only runs if asked.
+*/
+typedef enum {
+  BACKEND_ICONV,    /* the iconv linked in, usually the bundled libiconv */
+  BACKEND_SYSTEM,   /* the C library iconv when libiconv is linked too */
+  BACKEND_NATIVE,   /* our own kernels, for a few charsets only */
+  BACKEND_AUTO
+} encoding_backend_t;
+
+static const char* const encoding_backend_names[] = { "iconv", "system", "native", "auto", NULL };
+
+#if defined(_LIBICONV_VERSION) && defined(__GLIBC__)
+  #define ENCODING_SYSTEM_ICONV
+  extern iconv_t system_iconv_open(const char* to, const char* from) __asm__("iconv_open");
+  extern size_t system_iconv(iconv_t, char**, size_t*, char**, size_t*) __asm__("iconv");
+  extern int system_iconv_close(iconv_t) __asm__("iconv_close");
+#endif
+
+static iconv_t backend_iconv_open(encoding_backend_t backend, const char* to, const char* from) {
+#ifdef ENCODING_SYSTEM_ICONV
+  if (backend == BACKEND_SYSTEM)
+    return system_iconv_open(to, from);
+#endif
+  if (backend != BACKEND_ICONV) {
+    errno = EINVAL;
+    return (iconv_t)-1;
+  }
+  return iconv_open(to, from);
+}
+
+static size_t backend_iconv(
+  encoding_backend_t backend, iconv_t conv,
+  char** inbuf, size_t* inbytesleft, char** outbuf, size_t* outbytesleft
+) {
+  (void)backend;
+#ifdef ENCODING_SYSTEM_ICONV
+  if (backend == BACKEND_SYSTEM)
+    return system_iconv(conv, inbuf, inbytesleft, outbuf, outbytesleft);
+#endif
+  return iconv(conv, inbuf, inbytesleft, outbuf, outbytesleft);
+}
+
+static void backend_iconv_close(encoding_backend_t backend, iconv_t conv) {
+  (void)backend;
+#ifdef ENCODING_SYSTEM_ICONV
+  if (backend == BACKEND_SYSTEM) {
+    system_iconv_close(conv);
+    return;
+  }
+#endif
+  iconv_close(conv);
+}
+
+
+/*
+ * Small cache of iconv descriptors used from the lua thread, iconv_open is
+ * expensive and allocates so conversions reuse descriptors after resetting
+ * their shift state.
+*/
+#define ICONV_CACHE_SIZE 8
+typedef struct {
+  char to[48];
+  char from[48];
+  encoding_backend_t backend;
+  iconv_t conv;
+  unsigned long long last_use;
+} iconv_cache_entry_t;
+
+static iconv_cache_entry_t iconv_cache[ICONV_CACHE_SIZE];
+static unsigned long long iconv_cache_clock = 0;
+static size_t iconv_opens = 0;
+static size_t iconv_cache_hits = 0;
+
+static iconv_t iconv_cache_open(
+  encoding_backend_t backend, const char* to, const char* from, bool* cached
+) {
+  *cached = strlen(to) < sizeof(iconv_cache[0].to) && strlen(from) < sizeof(iconv_cache[0].from);
+  iconv_cache_entry_t* slot = NULL;
+  for (size_t i = 0; *cached && i < ICONV_CACHE_SIZE; ++i) {
+    iconv_cache_entry_t* entry = &iconv_cache[i];
+    if (entry->conv && entry->backend == backend
+      && strcmp(entry->to, to) == 0 && strcmp(entry->from, from) == 0) {
+      entry->last_use = ++iconv_cache_clock;
+      backend_iconv(backend, entry->conv, NULL, NULL, NULL, NULL);
+      iconv_cache_hits++;
+      return entry->conv;
+    }
+    if (!slot || !entry->conv || (slot->conv && entry->last_use < slot->last_use))
+      slot = entry;
+  }
+  iconv_t conv = backend_iconv_open(backend, to, from);
+  iconv_opens++;
+  if (conv == (iconv_t)-1 || !*cached) {
+    *cached = false;
+    return conv;
+  }
+  if (slot->conv)
+    backend_iconv_close(slot->backend, slot->conv);
+  strcpy(slot->to, to);
+  strcpy(slot->from, from);
+  slot->backend = backend;
+  slot->conv = conv;
+  slot->last_use = ++iconv_cache_clock;
+  return conv;
+}
+
+static void iconv_cache_close(encoding_backend_t backend, iconv_t conv, bool cached) {
+  if (!cached && conv != (iconv_t)-1)
+    backend_iconv_close(backend, conv);
+}
+
+
+typedef struct {
+  const char* charset;
+  unsigned char bom[4];
+  int len;
+} bom_t;
+
+/*
+ * List of encodings that can have byte order marks.
+ * Note: UTF-32 should be tested before UTF-16, the order matters.
+*/
+static bom_t bom_list[] = {
+  { "UTF-8",    {0xef, 0xbb, 0xbf},       3 },
+  { "UTF-32LE", {0xff, 0xfe, 0x00, 0x00}, 4 },
+  { "UTF-32BE", {0x00, 0x00, 0xfe, 0xff}, 4 },
+  { "UTF-16LE", {0xff, 0xfe},             2 },
+  { "UTF-16BE", {0xfe, 0xff},             2 },
+  { "GB18030",  {0x84, 0x31, 0x95, 0x33}, 4 },
+  { "UTF-7",    {0x2b, 0x2f, 0x76, 0x38}, 4 },
+  { "UTF-7",    {0x2b, 0x2f, 0x76, 0x39}, 4 },
+  { "UTF-7",    {0x2b, 0x2f, 0x76, 0x2b}, 4 },
+  { "UTF-7",    {0x2b, 0x2f, 0x76, 0x2f}, 4 },
+  { NULL }
+};
+
+typedef enum {
+  CHARSET_SINGLE,   /* one byte per character, ASCII compatible */
+  CHARSET_UTF8,
+  CHARSET_UTF16,
+  CHARSET_UTF32,
+  CHARSET_MULTI,    /* lead/trail byte sequences, ASCII compatible leads */
+  CHARSET_EBCDIC,   /* one byte per character, newlines are 0x15 */
+  CHARSET_STATEFUL  /* escape or shift sequences, and anything unknown */
+} charset_kind_t;
+
+typedef enum {
+  MULTI_NONE,
+  MULTI_DBCS,       /* lead 0x81-0xFE followed by one trail byte */
+  MULTI_SJIS,
+  MULTI_EUC,
+  MULTI_EUCJP,
+  MULTI_EUCTW,
+  MULTI_GB18030,
+  MULTI_JOHAB
+} charset_multi_t;
+
+typedef struct {
+  const char* charset;
+  charset_kind_t kind;
+  charset_multi_t multi;
+  unsigned char unit;    /* size in bytes of a code unit */
+  unsigned char sync;    /* bytes below this value never appear as trail bytes */
+  bool big_endian;
+} charset_t;
+
+/*
+ * Layout of the charsets we know how to walk byte by byte, used to search
+ * and split raw text without decoding it first. Charsets not listed here,
+ * other than the ebcdic codepages, are handled as stateful, which always
+ * goes through iconv.
+*/
+static const charset_t charset_list[] = {
+  { "UTF-8",        CHARSET_UTF8,   MULTI_NONE,    1, 0x80, false },
+  { "UTF-16LE",     CHARSET_UTF16,  MULTI_NONE,    2, 0x00, false },
+  { "UTF-16BE",     CHARSET_UTF16,  MULTI_NONE,    2, 0x00, true  },
+  { "UCS-2LE",      CHARSET_UTF16,  MULTI_NONE,    2, 0x00, false },
+  { "UCS-2BE",      CHARSET_UTF16,  MULTI_NONE,    2, 0x00, true  },
+  { "UTF-32LE",     CHARSET_UTF32,  MULTI_NONE,    4, 0x00, false },
+  { "UTF-32BE",     CHARSET_UTF32,  MULTI_NONE,    4, 0x00, true  },
+  { "UCS-4LE",      CHARSET_UTF32,  MULTI_NONE,    4, 0x00, false },
+  { "UCS-4BE",      CHARSET_UTF32,  MULTI_NONE,    4, 0x00, true  },
+  { "SHIFT_JIS",    CHARSET_MULTI,  MULTI_SJIS,    1, 0x40, false },
+  { "SJIS",         CHARSET_MULTI,  MULTI_SJIS,    1, 0x40, false },
+  { "CP932",        CHARSET_MULTI,  MULTI_SJIS,    1, 0x40, false },
+  { "WINDOWS-31J",  CHARSET_MULTI,  MULTI_SJIS,    1, 0x40, false },
+  { "EUC-JP",       CHARSET_MULTI,  MULTI_EUCJP,   1, 0x80, false },
+  { "EUC-KR",       CHARSET_MULTI,  MULTI_EUC,     1, 0x80, false },
+  { "EUC-CN",       CHARSET_MULTI,  MULTI_EUC,     1, 0x80, false },
+  { "GB2312",       CHARSET_MULTI,  MULTI_EUC,     1, 0x80, false },
+  { "EUC-TW",       CHARSET_MULTI,  MULTI_EUCTW,   1, 0x80, false },
+  { "GBK",          CHARSET_MULTI,  MULTI_DBCS,    1, 0x40, false },
+  { "CP936",        CHARSET_MULTI,  MULTI_DBCS,    1, 0x40, false },
+  { "GB18030",      CHARSET_MULTI,  MULTI_GB18030, 1, 0x30, false },
+  { "BIG5",         CHARSET_MULTI,  MULTI_DBCS,    1, 0x40, false },
+  { "BIG5-HKSCS",   CHARSET_MULTI,  MULTI_DBCS,    1, 0x40, false },
+  { "CP950",        CHARSET_MULTI,  MULTI_DBCS,    1, 0x40, false },
+  { "UHC",          CHARSET_MULTI,  MULTI_DBCS,    1, 0x41, false },
+  { "CP949",        CHARSET_MULTI,  MULTI_DBCS,    1, 0x41, false },
+  { "JOHAB",        CHARSET_MULTI,  MULTI_JOHAB,   1, 0x31, false },
+  { "ASCII",        CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "US-ASCII",     CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ARMSCII-8",    CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "CP866",        CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "GEORGIAN-ACADEMY", CHARSET_SINGLE, MULTI_NONE, 1, 0x00, false },
+  { "IBM850",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "IBM852",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "IBM855",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "IBM857",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "IBM862",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "IBM864",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-1",   CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-2",   CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-3",   CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-4",   CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-5",   CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-6",   CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-7",   CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-8",   CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-8-I", CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-9",   CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-10",  CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-13",  CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-14",  CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-15",  CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-8859-16",  CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "ISO-IR-111",   CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "KOI8-R",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "KOI8-U",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "MACINTOSH",    CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "MAC-CYRILLIC", CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "TCVN",         CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "TIS-620",      CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "VISCII",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "WINDOWS-1250", CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "WINDOWS-1251", CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "WINDOWS-1252", CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "WINDOWS-1253", CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "WINDOWS-1254", CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "WINDOWS-1255", CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "WINDOWS-1256", CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "WINDOWS-1257", CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "WINDOWS-1258", CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "CP1250",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "CP1251",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "CP1252",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "CP1253",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "CP1254",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "CP1255",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "CP1256",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "CP1257",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { "CP1258",       CHARSET_SINGLE, MULTI_NONE,    1, 0x00, false },
+  { NULL,           CHARSET_STATEFUL, MULTI_NONE,  1, 0x00, false }
+};
+
+/* The ebcdic codepages, which take several names each. */
+static const charset_t charset_ebcdic = {
+  "EBCDIC", CHARSET_EBCDIC, MULTI_NONE, 1, 0x00, false
+};
+
+static bool encoding_is_ebcdic(const char* charset);
+
+/* Case insensitive lookup of a charset layout, unknown charsets are stateful */
+static const charset_t* charset_from_name(const char* charset) {
+  size_t i = 0;
+  for (; charset_list[i].charset != NULL; i++) {
+    const char* a = charset_list[i].charset;
+    const char* b = charset;
+    while (*a && (*a == *b || (*b >= 'a' && *b <= 'z' && *b - 32 == *a))) {
+      a++; b++;
+    }
+    if (*a == 0 && *b == 0)
+      return &charset_list[i];
+  }
+  if (encoding_is_ebcdic(charset))
+    return &charset_ebcdic;
+  return &charset_list[i];
+}
+
+/* The byte ending lines in the raw text, in the last byte of a code unit. */
+static unsigned char charset_newline(const charset_t* cs) {
+  return cs->kind == CHARSET_EBCDIC ? 0x15 : '\n';
+}
+
+/* Case insensitive comparison of charset names. */
+static bool encoding_charset_equal(const char* a, const char* b) {
+  for (; *a && *b; ++a, ++b) {
+    char ca = *a >= 'a' && *a <= 'z' ? *a - 32 : *a;
+    char cb = *b >= 'a' && *b <= 'z' ? *b - 32 : *b;
+    if (ca != cb)
+      return false;
+  }
+  return *a == *b;
+}
+
+/* Length of the character starting at the given bytes, always at least 1 */
+static size_t charset_char_len(
+  const charset_t* cs, const unsigned char* p, size_t left
+) {
+  size_t len = 1;
+  if (cs->kind == CHARSET_UTF16) {
+    if (left < 2) return left;
+    unsigned int u = cs->big_endian ? (p[0] << 8 | p[1]) : (p[1] << 8 | p[0]);
+    len = (u >= 0xD800 && u <= 0xDBFF && strncmp(cs->charset, "UTF", 3) == 0) ? 4 : 2;
+  } else if (cs->kind == CHARSET_UTF32) {
+    len = 4;
+  } else if (cs->kind == CHARSET_UTF8) {
+    if (p[0] >= 0xF0) len = 4;
+    else if (p[0] >= 0xE0) len = 3;
+    else if (p[0] >= 0xC0) len = 2;
+  } else if (cs->kind == CHARSET_MULTI && p[0] >= 0x80) {
+    switch (cs->multi) {
+      case MULTI_SJIS:
+        len = (p[0] >= 0xA1 && p[0] <= 0xDF) ? 1 : 2;
+      break;
+      case MULTI_EUCJP:
+        len = p[0] == 0x8F ? 3 : 2;
+      break;
+      case MULTI_EUCTW:
+        len = p[0] == 0x8E ? 4 : 2;
+      break;
+      case MULTI_GB18030:
+        len = (left > 1 && p[1] >= 0x30 && p[1] <= 0x39) ? 4 : 2;
+      break;
+      case MULTI_JOHAB:
+        len = (p[0] >= 0x84 && p[0] != 0xFF) ? 2 : 1;
+      break;
+      default:
+        len = p[0] >= 0x81 && p[0] != 0xFF ? 2 : 1;
+      break;
+    }
+  }
+  return len > left ? left : len;
+}
+
+/*
+ * Bounds of the bytes a single character takes on the given charset, used to
+ * estimate conversion sizes. Stateful charsets include room for escapes.
+*/
+static void charset_char_bounds(const charset_t* cs, size_t* min, size_t* max) {
+  *min = cs->unit;
+  switch (cs->kind) {
+    case CHARSET_SINGLE: *max = 2; break; /* some decompose into base + accent */
+    case CHARSET_EBCDIC: *max = 1; break;
+    case CHARSET_UTF8:
+    case CHARSET_UTF16:
+    case CHARSET_UTF32: *max = 4; break;
+    case CHARSET_MULTI:
+      *max = cs->multi == MULTI_EUCJP ? 3 :
+        (cs->multi == MULTI_EUCTW || cs->multi == MULTI_GB18030) ? 4 : 2;
+    break;
+    default: *max = 8; break;
+  }
+}
+
+/*
+ * NOTE:
+ * Newer uchardet currently has some issues properly detecting some instances of
+ * UTF-8 as seen on https://gitlab.freedesktop.org/uchardet/uchardet/-/issues.
+ * REF: https://github.com/notepad-plus-plus/notepad-plus-plus/issues/5310
+ *
+ * For this reason, we included a third party MIT function to check if a string
+ * is valid utf8 and prefer this result over the one from uchardet.
+*/
+int utf8_validate(const char *str, size_t len) {
+  int bytes_left = 0;
+  for (size_t i = 0; i < len; i++) {
+    if (!bytes_left && (unsigned char)str[i] < 0x80) {
+      i += kernels.ascii_span((const unsigned char*)str + i, len - i);
+      if (i == len)
+        break;
+    }
+    int state = str[i];
+    if (bytes_left) {
+      if ((state & 0xC0) != 0x80)
+        return 0;
+      bytes_left--;
+    } else {
+      /* continuation bytes without a lead, or leads of overlong and too big ones */
+      if ((unsigned char)state < 0xC2 || (unsigned char)state > 0xF4)
+        return 0;
+      switch (state & 0xf0) {
+        case 0xf0 :  bytes_left = 3;  break;
+        case 0xe0 :  bytes_left = 2;  break;
+        case 0xd0 :
+        case 0xc0 :  bytes_left = 1;  break;
+        default   :  break;
+      }
+    }
+  }
+  return 1;
+}
+
+/*
+ * Full utf8 validation for strict decoding, unlike utf8_validate() a sequence
+ * cut by the end of the text is invalid, and so are surrogates and the
+ * overlong three and four byte forms.
+*/
+static bool encoding_utf8_valid(const char* str, size_t len) {
+  const unsigned char* p = (const unsigned char*)str;
+  const unsigned char* end = p + len;
+  while (p < end) {
+    if (*p < 0x80) {
+      p += kernels.ascii_span(p, end - p);
+      continue;
+    }
+    size_t size;
+    unsigned char min = 0x80, max = 0xBF;
+    if (*p >= 0xC2 && *p <= 0xDF)
+      size = 2;
+    else if (*p >= 0xE0 && *p <= 0xEF)
+      size = 3;
+    else if (*p >= 0xF0 && *p <= 0xF4)
+      size = 4;
+    else
+      return false;
+    if (*p == 0xE0)
+      min = 0xA0;
+    else if (*p == 0xED)
+      max = 0x9F;
+    else if (*p == 0xF0)
+      min = 0x90;
+    else if (*p == 0xF4)
+      max = 0x8F;
+    if ((size_t)(end - p) < size || p[1] < min || p[1] > max)
+      return false;
+    for (size_t i = 2; i < size; ++i) {
+      if ((p[i] & 0xC0) != 0x80)
+        return false;
+    }
+    p += size;
+  }
+  return true;
+}
+
+/* Get the applicable byte order marks for the given charset */
+static const char* encoding_bom_from_charset(const char* charset, size_t* len) {
+  for (size_t i=0; bom_list[i].charset != NULL; i++){
+    if (strcmp(bom_list[i].charset, charset) == 0) {
+      if (len) *len = bom_list[i].len;
+      return bom_list[i].bom;
+    }
+  }
+  if (len) *len = 0;
+  return "";
+}
+
+
+/* Detect the encoding of the given string if a valid bom sequence is found */
+static const char* encoding_charset_from_bom(
+  const char* string, size_t len, size_t* bom_len
+) {
+  const unsigned char* bytes = (unsigned char*) string;
+
+  for (size_t i=0; bom_list[i].charset != NULL; i++) {
+    if (len >= bom_list[i].len) {
+      bool all_match = true;
+      for (size_t b = 0; b<bom_list[i].len; b++) {
+        if (bytes[b] != bom_list[i].bom[b]) {
+          all_match = false;
+          break;
+        }
+      }
+      if (all_match) {
+        if (bom_len) *bom_len = bom_list[i].len;
+        return bom_list[i].charset;
+      }
+    }
+  }
+  if (bom_len) *bom_len = 0;
+  return NULL;
+}
+
+
+#define CHARSET_NAME_MAX 64
+
+static uchardet_t detector = NULL;
+static mutex_t detector_mutex;
+static size_t detector_allocations = 0;
+
+/* A possible charset of some text as reported by the detection. */
+typedef struct {
+  char charset[CHARSET_NAME_MAX];
+  char language[16];
+  float confidence;
+  const char* source;   /* "bom", "utf8", "ebcdic" or "uchardet" */
+} encoding_candidate_t;
+
+static void encoding_set_candidate(
+  encoding_candidate_t* candidate, const char* charset, const char* language,
+  float confidence, const char* source
+) {
+  strncpy(candidate->charset, charset, CHARSET_NAME_MAX - 1);
+  candidate->charset[CHARSET_NAME_MAX - 1] = 0;
+  strncpy(candidate->language, language ? language : "", sizeof(candidate->language) - 1);
+  candidate->language[sizeof(candidate->language) - 1] = 0;
+  candidate->confidence = confidence;
+  candidate->source = source;
+}
+
+/*
+ * EBCDIC text, unknown to uchardet: mostly 0x40 spaces, letters and digits,
+ * and almost no ascii spaces. Where the brackets are tells IBM1047 from the
+ * IBM037 of older systems.
+*/
+static const char* encoding_detect_ebcdic(const char* string, size_t len, float* confidence) {
+  static const unsigned char alphanumeric[][2] = {
+    { 0x81, 0x89 }, { 0x91, 0x99 }, { 0xA2, 0xA9 }, { 0xC1, 0xC9 },
+    { 0xD1, 0xD9 }, { 0xE2, 0xE9 }, { 0xF0, 0xF9 }
+  };
+  if (len < 16)
+    return NULL;
+  size_t counts[256] = { 0 };
+  for (size_t i = 0; i < len; ++i)
+    counts[(unsigned char)string[i]]++;
+  size_t text = counts[0x40];
+  for (size_t i = 0; i < sizeof(alphanumeric) / sizeof(alphanumeric[0]); ++i) {
+    for (int byte = alphanumeric[i][0]; byte <= alphanumeric[i][1]; ++byte)
+      text += counts[byte];
+  }
+  if (counts[0x40] * 20 < len || text * 10 < len * 6 || counts[0x20] * 100 >= len)
+    return NULL;
+  *confidence = (float)text / len;
+  if (counts[0xAD] + counts[0xBD] > counts[0xBA] + counts[0xBB])
+    return "IBM1047";
+  return "IBM037";
+}
+
+/*
+ * The ways of detecting a charset. By default they run in the order below,
+ * any order or subset can be asked for to measure them one by one.
+*/
+typedef enum {
+  DETECT_BOM,
+  DETECT_UTF8,
+  DETECT_EBCDIC,
+  DETECT_UCHARDET,
+  DETECT_COUNT
+} encoding_engine_t;
+
+static const char* const encoding_engine_names[] = { "bom", "utf8", "ebcdic", "uchardet", NULL };
+
+static const encoding_engine_t encoding_default_engines[DETECT_COUNT] = {
+  DETECT_BOM, DETECT_UTF8, DETECT_EBCDIC, DETECT_UCHARDET
+};
+
+/* Most engines a single detection can be asked to run. */
+#define DETECT_ENGINES_MAX 8
+
+/* Bytes from the start of a file the detection looks at. */
+#define DETECT_SAMPLE_SIZE (100*1024)
+
+/* Appends the uchardet candidates not found yet, returns the new count. */
+static size_t encoding_detect_uchardet(
+  const char* string, size_t len, encoding_candidate_t* candidates, size_t count,
+  size_t max
+) {
+  /* reuse the shared detector unless another thread is using it */
+  bool shared = mutex_trylock(&detector_mutex);
+  uchardet_t ud = NULL;
+  if (shared) {
+    if (!detector) {
+      detector = uchardet_new();
+      detector_allocations++;
+    } else {
+      uchardet_reset(detector);
+    }
+    ud = detector;
+  } else {
+    ud = uchardet_new();
+  }
+  if (uchardet_handle_data(ud, string, len) == 0) {
+    uchardet_data_end(ud);
+    size_t found = uchardet_get_n_candidates(ud);
+    for (size_t i = 0; i < found && count < max; ++i) {
+      const char* charset = uchardet_get_encoding(ud, i);
+      bool duplicated = !charset || !*charset;
+      for (size_t j = 0; j < count && !duplicated; ++j)
+        duplicated = strcmp(candidates[j].charset, charset) == 0;
+      if (!duplicated)
+        encoding_set_candidate(
+          &candidates[count++], charset, uchardet_get_language(ud, i),
+          uchardet_get_confidence(ud, i), "uchardet"
+        );
+    }
+  }
+  if (shared)
+    mutex_unlock(&detector_mutex);
+  else
+    uchardet_delete(ud);
+  return count;
+}
+
+/*
+ * Detect up to max charsets for the given string ranked by confidence,
+ * running the engines in the given order until there are enough. A bom is
+ * always the only candidate, ebcdic is never tried on valid utf8, and when
+ * more than one is wanted uchardet also runs over valid utf8 to fill the
+ * remaining ones.
+*/
+static size_t encoding_detect_engines(
+  const char* string, size_t len, encoding_candidate_t* candidates, size_t max,
+  bool* bom, const encoding_engine_t* engines, size_t engine_count
+) {
+  size_t count = 0;
+  bool utf8 = false;
+  *bom = false;
+  if (max == 0)
+    return 0;
+  if (len == 0) {
+    encoding_set_candidate(&candidates[count++], "UTF-8", NULL, 1.0f, "utf8");
+    return count;
+  }
+  for (size_t i = 0; i < engine_count && count < max; ++i) {
+    const char* charset = NULL;
+    float confidence = 0;
+    switch (engines[i]) {
+      case DETECT_BOM:
+        if ((charset = encoding_charset_from_bom(string, len, NULL))) {
+          *bom = true;
+          encoding_set_candidate(&candidates[0], charset, NULL, 1.0f, "bom");
+          return 1;
+        }
+        break;
+      case DETECT_UTF8:
+        if ((utf8 = utf8_validate(string, len)))
+          encoding_set_candidate(&candidates[count++], "UTF-8", NULL, 1.0f, "utf8");
+        break;
+      case DETECT_EBCDIC:
+        if (!utf8 && (charset = encoding_detect_ebcdic(string, len, &confidence)))
+          encoding_set_candidate(&candidates[count++], charset, NULL, confidence, "ebcdic");
+        break;
+      case DETECT_UCHARDET:
+        count = encoding_detect_uchardet(string, len, candidates, count, max);
+        break;
+      case DETECT_COUNT:
+        break;
+    }
+  }
+  return count;
+}
+
+/* Like encoding_detect_engines() with every engine in the default order. */
+static size_t encoding_detect_candidates(
+  const char* string, size_t len, encoding_candidate_t* candidates, size_t max,
+  bool* bom
+) {
+  return encoding_detect_engines(string, len, candidates, max, bom, encoding_default_engines, DETECT_COUNT);
+}
+
+/*
+ * Detect the charset of the given string. The name is copied into charset
+ * which should hold at least CHARSET_NAME_MAX bytes.
+*/
+static bool encoding_detect(
+  const char* string, size_t len, char* charset, bool* bom
+) {
+  encoding_candidate_t candidate;
+  if (encoding_detect_candidates(string, len, &candidate, 1, bom) == 0)
+    return false;
+  strcpy(charset, candidate.charset);
+  return true;
+}
+
+/* Pushes a list of detection candidates as tables. */
+static void encoding_push_candidates(
+  lua_State* L, const encoding_candidate_t* candidates, size_t count
+) {
+  lua_createtable(L, count, 0);
+  for (size_t i = 0; i < count; ++i) {
+    lua_createtable(L, 0, 4);
+    lua_pushstring(L, candidates[i].charset);
+    lua_setfield(L, -2, "charset");
+    lua_pushnumber(L, candidates[i].confidence);
+    lua_setfield(L, -2, "confidence");
+    lua_pushstring(L, candidates[i].source);
+    lua_setfield(L, -2, "source");
+    if (candidates[i].language[0]) {
+      lua_pushstring(L, candidates[i].language);
+      lua_setfield(L, -2, "language");
+    }
+    lua_rawseti(L, -2, i + 1);
+  }
+}
+
+/*
+ * Detects the charset of the given bytes pushing the usual charset and bom
+ * results, or when the options table at idx asks for candidates the ranked
+ * list of them and the bom flag.
+*/
+static int encoding_push_detection(lua_State* L, const char* string, size_t len, int idx) {
+  lua_Integer max = 0;
+  encoding_engine_t engines[DETECT_ENGINES_MAX];
+  size_t engine_count = DETECT_COUNT;
+  memcpy(engines, encoding_default_engines, sizeof(encoding_default_engines));
+  if (lua_istable(L, idx)) {
+    lua_getfield(L, idx, "candidates");
+    max = luaL_optinteger(L, -1, 0);
+    lua_pop(L, 1);
+    lua_getfield(L, idx, "engines");
+    if (!lua_isnil(L, -1)) {
+      luaL_checktype(L, -1, LUA_TTABLE);
+      engine_count = lua_rawlen(L, -1);
+      if (engine_count > DETECT_ENGINES_MAX)
+        return luaL_error(L, "too many detection engines");
+      for (size_t i = 0; i < engine_count; ++i) {
+        lua_rawgeti(L, -1, i + 1);
+        const char* name = lua_tostring(L, -1);
+        int engine = 0;
+        while (encoding_engine_names[engine] && (!name || strcmp(encoding_engine_names[engine], name)))
+          engine++;
+        if (!encoding_engine_names[engine])
+          return luaL_error(L, "invalid detection engine '%s'", name ? name : luaL_typename(L, -1));
+        engines[i] = engine;
+        lua_pop(L, 1);
+      }
+    }
+    lua_pop(L, 1);
+  }
+  bool bom = false;
+  if (max > 0) {
+    encoding_candidate_t stack_candidates[8];
+    encoding_candidate_t* candidates = max <= 8 ? stack_candidates :
+      malloc(max * sizeof(encoding_candidate_t));
+    if (!candidates)
+      return luaL_error(L, "out of memory");
+    size_t count = encoding_detect_engines(string, len, candidates, max, &bom, engines, engine_count);
+    encoding_push_candidates(L, candidates, count);
+    if (candidates != stack_candidates)
+      free(candidates);
+    if (count == 0) {
+      lua_pop(L, 1);
+      lua_pushnil(L);
+      lua_pushstring(L, "could not detect the file encoding");
+      return 2;
+    }
+    lua_pushboolean(L, bom);
+    return 2;
+  }
+  encoding_candidate_t candidate;
+  if (encoding_detect_engines(string, len, &candidate, 1, &bom, engines, engine_count) > 0) {
+    lua_pushstring(L, candidate.charset);
+    lua_pushboolean(L, bom);
+  } else {
+    lua_pushnil(L);
+    lua_pushstring(L, "could not detect the file encoding");
+  }
+  return 2;
+}
+
+
+/*
+ * Converts text with the given descriptor appending it to out, flushing the
+ * shift state when text is NULL. Invalid input bytes are skipped unless
+ * strict, in which case false is returned. The position up to which the input
+ * was converted is stored in consumed if given. When streaming, an incomplete
+ * sequence at the end of text is left unconverted for the next call.
+*/
+static bool encoding_iconv_feed(
+  encoding_backend_t backend, iconv_t conv, const char* text, size_t len,
+  bool strict, bool stream, bytes_t* out, const char** consumed
+) {
+  char* inbuf = (char*)text;
+  size_t inbytesleft = len;
+  size_t room = 64;
+  do {
+    if (!bytes_reserve(out, inbytesleft > room ? inbytesleft : room)) {
+      if (errno != EFBIG)
+        errno = ENOMEM;
+      return false;
+    }
+    char* outbuf = out->data + out->size;
+    size_t outbytesleft = out->capacity - out->size;
+    size_t err = backend_iconv(backend, conv, text ? &inbuf : NULL, &inbytesleft, &outbuf, &outbytesleft);
+    out->size = outbuf - out->data;
+    if (consumed)
+      *consumed = inbuf;
+    room = 64;
+    if (err != (size_t)-1) {
+      if (!text)
+        break;
+    } else if (errno == E2BIG) {
+      if (out->limit && out->capacity >= out->limit) {
+        errno = EFBIG;
+        return false;
+      }
+      room = out->capacity - out->size + 64;
+    } else if (stream && errno == EINVAL) {
+      break;
+    } else if (strict || !text) {
+      return false;
+    } else {
+      ++inbuf;
+      --inbytesleft;
+    }
+  } while (inbytesleft > 0 || !text);
+  return true;
+}
+
+
+/* What to write instead of characters the output charset can't encode. */
+typedef enum {
+  FALLBACK_NONE,
+  FALLBACK_TRANSLIT,  /* closest ascii lookalike, ? if none */
+  FALLBACK_ENTITY,    /* html and xml numeric character reference */
+  FALLBACK_REPLACE    /* a question mark */
+} encoding_fallback_t;
+
+static const char* const encoding_fallback_names[] = {
+  "none", "translit", "entity", "replace", NULL
+};
+
+typedef struct {
+  unsigned int codepoint;
+  const char* text;
+} fallback_entry_t;
+
+/* Typographic punctuation and symbols, sorted by codepoint. */
+static const fallback_entry_t fallback_punctuation[] = {
+  { 0x00A0, " "   }, { 0x00A9, "(C)" }, { 0x00AB, "<<"  }, { 0x00AD, ""    },
+  { 0x00AE, "(R)" }, { 0x00B7, "."   }, { 0x00BB, ">>"  }, { 0x00D7, "x"   },
+  { 0x00F7, "/"   }, { 0x02C6, "^"   }, { 0x02DC, "~"   }, { 0x2002, " "   },
+  { 0x2003, " "   }, { 0x2004, " "   }, { 0x2005, " "   }, { 0x2006, " "   },
+  { 0x2007, " "   }, { 0x2008, " "   }, { 0x2009, " "   }, { 0x200A, " "   },
+  { 0x200B, ""    }, { 0x2010, "-"   }, { 0x2011, "-"   }, { 0x2012, "-"   },
+  { 0x2013, "-"   }, { 0x2014, "-"   }, { 0x2015, "-"   }, { 0x2018, "'"   },
+  { 0x2019, "'"   }, { 0x201A, ","   }, { 0x201B, "'"   }, { 0x201C, "\""  },
+  { 0x201D, "\""  }, { 0x201E, "\""  }, { 0x201F, "\""  }, { 0x2022, "*"   },
+  { 0x2026, "..." }, { 0x202F, " "   }, { 0x2032, "'"   }, { 0x2033, "\""  },
+  { 0x2039, "<"   }, { 0x203A, ">"   }, { 0x2044, "/"   }, { 0x20AC, "EUR" },
+  { 0x2122, "(TM)"}, { 0x2190, "<-"  }, { 0x2192, "->"  }, { 0x2212, "-"   },
+  { 0x2264, "<="  }, { 0x2265, ">="  }, { 0xFEFF, ""    }
+};
+
+/* Base letters of U+00C0 to U+017F, a space marks the ones below. */
+static const char fallback_latin[] =
+  "AAAAAA CEEEEIIIIDNOOOOO OUUUUY  aaaaaa ceeeeiiiidnooooo ouuuuy y"
+  "AaAaAaCcCcCcCcDdDdEeEeEeEeEeGgGgGgGgHhHhIiIiIiIiIi  JjKkqLlLlLlL"
+  "lLlNnNnNn NnOoOoOo  RrRrRrSsSsSsSsTtTtTtUuUuUuUuUuUuWwYyYZzZzZzs";
+
+static const fallback_entry_t fallback_latin_multi[] = {
+  { 0x00C6, "AE" }, { 0x00DE, "TH" }, { 0x00DF, "ss" }, { 0x00E6, "ae" },
+  { 0x00FE, "th" }, { 0x0132, "IJ" }, { 0x0133, "ij" }, { 0x0149, "'n" },
+  { 0x0152, "OE" }, { 0x0153, "oe" }
+};
+
+static const char* fallback_find(
+  const fallback_entry_t* entries, size_t count, unsigned int codepoint
+) {
+  size_t low = 0, high = count;
+  while (low < high) {
+    size_t mid = (low + high) / 2;
+    if (entries[mid].codepoint == codepoint)
+      return entries[mid].text;
+    if (entries[mid].codepoint < codepoint)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return NULL;
+}
+
+/* Writes the replacement of codepoint into text, returns its length. */
+static size_t encoding_fallback_text(
+  encoding_fallback_t mode, unsigned int codepoint, char* text
+) {
+  const char* found = NULL;
+  if (mode == FALLBACK_ENTITY)
+    return sprintf(text, "&#%u;", codepoint);
+  if (mode == FALLBACK_TRANSLIT) {
+    found = fallback_find(
+      fallback_punctuation,
+      sizeof(fallback_punctuation) / sizeof(fallback_entry_t), codepoint
+    );
+    if (!found && codepoint >= 0xC0 && codepoint <= 0x17F) {
+      found = fallback_find(
+        fallback_latin_multi,
+        sizeof(fallback_latin_multi) / sizeof(fallback_entry_t), codepoint
+      );
+      if (!found && fallback_latin[codepoint - 0xC0] != ' ') {
+        text[0] = fallback_latin[codepoint - 0xC0];
+        return 1;
+      }
+    }
+  }
+  if (!found)
+    found = "?";
+  strcpy(text, found);
+  return strlen(found);
+}
+
+/* Decodes the utf8 character at p, returns its length or 0 if invalid. */
+static size_t encoding_utf8_decode(const unsigned char* p, size_t len, unsigned int* codepoint) {
+  size_t size = p[0] < 0x80 ? 1 : (p[0] >= 0xC2 && p[0] <= 0xDF) ? 2 :
+    (p[0] >= 0xE0 && p[0] <= 0xEF) ? 3 : (p[0] >= 0xF0 && p[0] <= 0xF4) ? 4 : 0;
+  if (size == 0 || size > len)
+    return 0;
+  /* overlong forms, surrogates and codepoints past 0x10FFFF */
+  if (size > 2 && ((p[0] == 0xE0 && p[1] < 0xA0) || (p[0] == 0xED && p[1] > 0x9F)
+    || (p[0] == 0xF0 && p[1] < 0x90) || (p[0] == 0xF4 && p[1] > 0x8F)))
+    return 0;
+  unsigned int value = size == 1 ? p[0] : p[0] & (0x7F >> size);
+  for (size_t i = 1; i < size; ++i) {
+    if ((p[i] & 0xC0) != 0x80)
+      return 0;
+    value = (value << 6) | (p[i] & 0x3F);
+  }
+  *codepoint = value;
+  return size;
+}
+
+/* Writes codepoint as utf8 at p, which must have room for 4 bytes. */
+static size_t encoding_utf8_encode(unsigned int c, unsigned char* p) {
+  if (c < 0x80) {
+    p[0] = c;
+    return 1;
+  } else if (c < 0x800) {
+    p[0] = 0xC0 | (c >> 6);
+    p[1] = 0x80 | (c & 0x3F);
+    return 2;
+  } else if (c < 0x10000) {
+    p[0] = 0xE0 | (c >> 12);
+    p[1] = 0x80 | ((c >> 6) & 0x3F);
+    p[2] = 0x80 | (c & 0x3F);
+    return 3;
+  }
+  p[0] = 0xF0 | (c >> 18);
+  p[1] = 0x80 | ((c >> 12) & 0x3F);
+  p[2] = 0x80 | ((c >> 6) & 0x3F);
+  p[3] = 0x80 | (c & 0x3F);
+  return 4;
+}
+
+/*
+ * Native codecs of the escape sequence charsets ISO-2022-JP, ISO-2022-KR and
+ * HZ. Their text is ascii except for runs of double byte characters, which
+ * are those of the matching EUC charset with the high bits cleared, so the
+ * state machine copies ascii runs as they are and hands the double byte runs
+ * to a stateless EUC descriptor. The shift state lives in the converter, so
+ * it survives from one chunk or line to the next, and encoding only writes
+ * an escape sequence when the state actually changes.
+*/
+typedef enum {
+  ESCAPE_NONE,
+  ESCAPE_ISO2022JP,
+  ESCAPE_ISO2022KR,
+  ESCAPE_HZ
+} encoding_escape_t;
+
+typedef enum {
+  SHIFT_ASCII,
+  SHIFT_ROMAN,      /* JIS X 0201 Roman, ascii with yen sign and overline */
+  SHIFT_DOUBLE      /* the double byte set of the charset */
+} encoding_shift_t;
+
+static const struct {
+  const char* charset;
+  encoding_escape_t escape;
+} escape_charsets[] = {
+  { "ISO-2022-JP", ESCAPE_ISO2022JP },
+  { "CSISO2022JP", ESCAPE_ISO2022JP },
+  { "ISO-2022-KR", ESCAPE_ISO2022KR },
+  { "CSISO2022KR", ESCAPE_ISO2022KR },
+  { "HZ",          ESCAPE_HZ },
+  { "HZ-GB-2312",  ESCAPE_HZ },
+  { NULL,          ESCAPE_NONE }
+};
+
+/* EUC charset holding the double byte set of each codec */
+static const char* const escape_inner_charsets[] = { NULL, "EUC-JP", "EUC-KR", "EUC-CN" };
+
+/* Sequence switching each codec into each shift state */
+static const char* const escape_sequences[][3] = {
+  { "",        "",        ""        },
+  { "\x1B(B",  "\x1B(J",  "\x1B$B"  },
+  { "\x0F",    "\x0F",    "\x0E"    },
+  { "~}",      "~}",      "~{"      }
+};
+
+/* Designation of KS C 5601 that starts ISO-2022-KR text */
+#define ESCAPE_KR_HEADER "\x1B$)C"
+
+/* Length and utf8 bytes a byte of a single byte charset decodes to. */
+typedef unsigned char single_entry_t[4];
+
+/*
+ * EBCDIC codepages of the mainframes, converted natively from and into utf8.
+ * Every one is IBM037 with some bytes moved, so only those are listed. Like
+ * z/OS, 0x15 decodes to a line feed and 0x25 to the next line control, the
+ * other way around to iconv, for the text to split in lines and save back.
+*/
+static const unsigned char ebcdic_base[256] = {
+  0x00, 0x01, 0x02, 0x03, 0x9C, 0x09, 0x86, 0x7F, 0x97, 0x8D, 0x8E, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+  0x10, 0x11, 0x12, 0x13, 0x9D, 0x0A, 0x08, 0x87, 0x18, 0x19, 0x92, 0x8F, 0x1C, 0x1D, 0x1E, 0x1F,
+  0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x17, 0x1B, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x05, 0x06, 0x07,
+  0x90, 0x91, 0x16, 0x93, 0x94, 0x95, 0x96, 0x04, 0x98, 0x99, 0x9A, 0x9B, 0x14, 0x15, 0x9E, 0x1A,
+  0x20, 0xA0, 0xE2, 0xE4, 0xE0, 0xE1, 0xE3, 0xE5, 0xE7, 0xF1, 0xA2, 0x2E, 0x3C, 0x28, 0x2B, 0x7C,
+  0x26, 0xE9, 0xEA, 0xEB, 0xE8, 0xED, 0xEE, 0xEF, 0xEC, 0xDF, 0x21, 0x24, 0x2A, 0x29, 0x3B, 0xAC,
+  0x2D, 0x2F, 0xC2, 0xC4, 0xC0, 0xC1, 0xC3, 0xC5, 0xC7, 0xD1, 0xA6, 0x2C, 0x25, 0x5F, 0x3E, 0x3F,
+  0xF8, 0xC9, 0xCA, 0xCB, 0xC8, 0xCD, 0xCE, 0xCF, 0xCC, 0x60, 0x3A, 0x23, 0x40, 0x27, 0x3D, 0x22,
+  0xD8, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0xAB, 0xBB, 0xF0, 0xFD, 0xFE, 0xB1,
+  0xB0, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F, 0x70, 0x71, 0x72, 0xAA, 0xBA, 0xE6, 0xB8, 0xC6, 0xA4,
+  0xB5, 0x7E, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0xA1, 0xBF, 0xD0, 0xDD, 0xDE, 0xAE,
+  0x5E, 0xA3, 0xA5, 0xB7, 0xA9, 0xA7, 0xB6, 0xBC, 0xBD, 0xBE, 0x5B, 0x5D, 0xAF, 0xA8, 0xB4, 0xD7,
+  0x7B, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0xAD, 0xF4, 0xF6, 0xF2, 0xF3, 0xF5,
+  0x7D, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, 0x50, 0x51, 0x52, 0xB9, 0xFB, 0xFC, 0xF9, 0xFA, 0xFF,
+  0x5C, 0xF7, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0xB2, 0xD4, 0xD6, 0xD2, 0xD3, 0xD5,
+  0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0xB3, 0xDB, 0xDC, 0xD9, 0xDA, 0x9F
+};
+
+static const unsigned short ebcdic_273[][2] = {
+  { 0x43, 0x007B }, { 0x4A, 0x00C4 }, { 0x4F, 0x0021 }, { 0x59, 0x007E },
+  { 0x5A, 0x00DC }, { 0x5F, 0x005E }, { 0x63, 0x005B }, { 0x6A, 0x00F6 },
+  { 0x7C, 0x00A7 }, { 0xA1, 0x00DF }, { 0xB0, 0x00A2 }, { 0xB5, 0x0040 },
+  { 0xBA, 0x00AC }, { 0xBB, 0x007C }, { 0xC0, 0x00E4 }, { 0xCC, 0x00A6 },
+  { 0xD0, 0x00FC }, { 0xDC, 0x007D }, { 0xE0, 0x00D6 }, { 0xEC, 0x005C },
+  { 0xFC, 0x005D }, { 0 }
+};
+static const unsigned short ebcdic_277[][2] = {
+  { 0x47, 0x007D }, { 0x4A, 0x0023 }, { 0x4F, 0x0021 }, { 0x5A, 0x00A4 },
+  { 0x5B, 0x00C5 }, { 0x5F, 0x005E }, { 0x67, 0x0024 }, { 0x6A, 0x00F8 },
+  { 0x70, 0x00A6 }, { 0x7B, 0x00C6 }, { 0x7C, 0x00D8 }, { 0x80, 0x0040 },
+  { 0x9C, 0x007B }, { 0x9E, 0x005B }, { 0x9F, 0x005D }, { 0xA1, 0x00FC },
+  { 0xB0, 0x00A2 }, { 0xBA, 0x00AC }, { 0xBB, 0x007C }, { 0xC0, 0x00E6 },
+  { 0xD0, 0x00E5 }, { 0xDC, 0x007E }, { 0 }
+};
+static const unsigned short ebcdic_278[][2] = {
+  { 0x43, 0x007B }, { 0x47, 0x007D }, { 0x4A, 0x00A7 }, { 0x4F, 0x0021 },
+  { 0x51, 0x0060 }, { 0x5A, 0x00A4 }, { 0x5B, 0x00C5 }, { 0x5F, 0x005E },
+  { 0x63, 0x0023 }, { 0x67, 0x0024 }, { 0x6A, 0x00F6 }, { 0x79, 0x00E9 },
+  { 0x7B, 0x00C4 }, { 0x7C, 0x00D6 }, { 0x9F, 0x005D }, { 0xA1, 0x00FC },
+  { 0xB0, 0x00A2 }, { 0xB5, 0x005B }, { 0xBA, 0x00AC }, { 0xBB, 0x007C },
+  { 0xC0, 0x00E4 }, { 0xCC, 0x00A6 }, { 0xD0, 0x00E5 }, { 0xDC, 0x007E },
+  { 0xEC, 0x0040 }, { 0 }
+};
+static const unsigned short ebcdic_280[][2] = {
+  { 0x44, 0x007B }, { 0x48, 0x005C }, { 0x4A, 0x00B0 }, { 0x4F, 0x0021 },
+  { 0x51, 0x005D }, { 0x54, 0x007D }, { 0x58, 0x007E }, { 0x5A, 0x00E9 },
+  { 0x5F, 0x005E }, { 0x6A, 0x00F2 }, { 0x79, 0x00F9 }, { 0x7B, 0x00A3 },
+  { 0x7C, 0x00A7 }, { 0x90, 0x005B }, { 0xA1, 0x00EC }, { 0xB0, 0x00A2 },
+  { 0xB1, 0x0023 }, { 0xB5, 0x0040 }, { 0xBA, 0x00AC }, { 0xBB, 0x007C },
+  { 0xC0, 0x00E0 }, { 0xCD, 0x00A6 }, { 0xD0, 0x00E8 }, { 0xDD, 0x0060 },
+  { 0xE0, 0x00E7 }, { 0 }
+};
+static const unsigned short ebcdic_284[][2] = {
+  { 0x49, 0x00A6 }, { 0x4A, 0x005B }, { 0x5A, 0x005D }, { 0x69, 0x0023 },
+  { 0x6A, 0x00F1 }, { 0x7B, 0x00D1 }, { 0xA1, 0x00A8 }, { 0xB0, 0x00A2 },
+  { 0xBA, 0x005E }, { 0xBB, 0x0021 }, { 0xBD, 0x007E }, { 0 }
+};
+static const unsigned short ebcdic_285[][2] = {
+  { 0x4A, 0x0024 }, { 0x5B, 0x00A3 }, { 0xA1, 0x203E }, { 0xB0, 0x00A2 },
+  { 0xB1, 0x005B }, { 0xBA, 0x005E }, { 0xBC, 0x007E }, { 0 }
+};
+static const unsigned short ebcdic_297[][2] = {
+  { 0x44, 0x0040 }, { 0x48, 0x005C }, { 0x4A, 0x00B0 }, { 0x4F, 0x0021 },
+  { 0x51, 0x007B }, { 0x54, 0x007D }, { 0x5A, 0x00A7 }, { 0x5F, 0x005E },
+  { 0x6A, 0x00F9 }, { 0x79, 0x00B5 }, { 0x7B, 0x00A3 }, { 0x7C, 0x00E0 },
+  { 0x90, 0x005B }, { 0xA0, 0x0060 }, { 0xA1, 0x00A8 }, { 0xB0, 0x00A2 },
+  { 0xB1, 0x0023 }, { 0xB5, 0x005D }, { 0xBA, 0x00AC }, { 0xBB, 0x007C },
+  { 0xBD, 0x007E }, { 0xC0, 0x00E9 }, { 0xD0, 0x00E8 }, { 0xDD, 0x00A6 },
+  { 0xE0, 0x00E7 }, { 0 }
+};
+static const unsigned short ebcdic_500[][2] = {
+  { 0x4A, 0x005B }, { 0x4F, 0x0021 }, { 0x5A, 0x005D }, { 0x5F, 0x005E },
+  { 0xB0, 0x00A2 }, { 0xBA, 0x00AC }, { 0xBB, 0x007C }, { 0 }
+};
+static const unsigned short ebcdic_871[][2] = {
+  { 0x4A, 0x00FE }, { 0x4F, 0x0021 }, { 0x5A, 0x00C6 }, { 0x5F, 0x00D6 },
+  { 0x79, 0x00F0 }, { 0x7C, 0x00D0 }, { 0x8C, 0x0060 }, { 0x8E, 0x007B },
+  { 0x9C, 0x007D }, { 0x9E, 0x005D }, { 0xA1, 0x00F6 }, { 0xAC, 0x0040 },
+  { 0xAE, 0x005B }, { 0xB0, 0x00A2 }, { 0xBA, 0x00AC }, { 0xBB, 0x007C },
+  { 0xBE, 0x005C }, { 0xC0, 0x00DE }, { 0xCC, 0x007E }, { 0xD0, 0x00E6 },
+  { 0xE0, 0x00B4 }, { 0xEC, 0x005E }, { 0 }
+};
+static const unsigned short ebcdic_1047[][2] = {
+  { 0x5F, 0x005E }, { 0xAD, 0x005B }, { 0xB0, 0x00AC }, { 0xBA, 0x00DD },
+  { 0xBB, 0x00A8 }, { 0xBD, 0x005D }, { 0 }
+};
+static const unsigned short ebcdic_1140[][2] = {
+  { 0x9F, 0x20AC }, { 0 }
+};
+static const unsigned short ebcdic_1141[][2] = {
+  { 0x43, 0x007B }, { 0x4A, 0x00C4 }, { 0x4F, 0x0021 }, { 0x59, 0x007E },
+  { 0x5A, 0x00DC }, { 0x5F, 0x005E }, { 0x63, 0x005B }, { 0x6A, 0x00F6 },
+  { 0x7C, 0x00A7 }, { 0x9F, 0x20AC }, { 0xA1, 0x00DF }, { 0xB0, 0x00A2 },
+  { 0xB5, 0x0040 }, { 0xBA, 0x00AC }, { 0xBB, 0x007C }, { 0xC0, 0x00E4 },
+  { 0xCC, 0x00A6 }, { 0xD0, 0x00FC }, { 0xDC, 0x007D }, { 0xE0, 0x00D6 },
+  { 0xEC, 0x005C }, { 0xFC, 0x005D }, { 0 }
+};
+static const unsigned short ebcdic_1142[][2] = {
+  { 0x47, 0x007D }, { 0x4A, 0x0023 }, { 0x4F, 0x0021 }, { 0x5A, 0x20AC },
+  { 0x5B, 0x00C5 }, { 0x5F, 0x005E }, { 0x67, 0x0024 }, { 0x6A, 0x00F8 },
+  { 0x70, 0x00A6 }, { 0x7B, 0x00C6 }, { 0x7C, 0x00D8 }, { 0x80, 0x0040 },
+  { 0x9C, 0x007B }, { 0x9E, 0x005B }, { 0x9F, 0x005D }, { 0xA1, 0x00FC },
+  { 0xB0, 0x00A2 }, { 0xBA, 0x00AC }, { 0xBB, 0x007C }, { 0xC0, 0x00E6 },
+  { 0xD0, 0x00E5 }, { 0xDC, 0x007E }, { 0 }
+};
+static const unsigned short ebcdic_1143[][2] = {
+  { 0x43, 0x007B }, { 0x47, 0x007D }, { 0x4A, 0x00A7 }, { 0x4F, 0x0021 },
+  { 0x51, 0x0060 }, { 0x5A, 0x20AC }, { 0x5B, 0x00C5 }, { 0x5F, 0x005E },
+  { 0x63, 0x0023 }, { 0x67, 0x0024 }, { 0x6A, 0x00F6 }, { 0x71, 0x005C },
+  { 0x79, 0x00E9 }, { 0x7B, 0x00C4 }, { 0x7C, 0x00D6 }, { 0x9F, 0x005D },
+  { 0xA1, 0x00FC }, { 0xB0, 0x00A2 }, { 0xB5, 0x005B }, { 0xBA, 0x00AC },
+  { 0xBB, 0x007C }, { 0xC0, 0x00E4 }, { 0xCC, 0x00A6 }, { 0xD0, 0x00E5 },
+  { 0xDC, 0x007E }, { 0xE0, 0x00C9 }, { 0xEC, 0x0040 }, { 0 }
+};
+static const unsigned short ebcdic_1144[][2] = {
+  { 0x44, 0x007B }, { 0x48, 0x005C }, { 0x4A, 0x00B0 }, { 0x4F, 0x0021 },
+  { 0x51, 0x005D }, { 0x54, 0x007D }, { 0x58, 0x007E }, { 0x5A, 0x00E9 },
+  { 0x5F, 0x005E }, { 0x6A, 0x00F2 }, { 0x79, 0x00F9 }, { 0x7B, 0x00A3 },
+  { 0x7C, 0x00A7 }, { 0x90, 0x005B }, { 0x9F, 0x20AC }, { 0xA1, 0x00EC },
+  { 0xB0, 0x00A2 }, { 0xB1, 0x0023 }, { 0xB5, 0x0040 }, { 0xBA, 0x00AC },
+  { 0xBB, 0x007C }, { 0xC0, 0x00E0 }, { 0xCD, 0x00A6 }, { 0xD0, 0x00E8 },
+  { 0xDD, 0x0060 }, { 0xE0, 0x00E7 }, { 0 }
+};
+static const unsigned short ebcdic_1145[][2] = {
+  { 0x49, 0x00A6 }, { 0x4A, 0x005B }, { 0x5A, 0x005D }, { 0x69, 0x0023 },
+  { 0x6A, 0x00F1 }, { 0x7B, 0x00D1 }, { 0x9F, 0x20AC }, { 0xA1, 0x00A8 },
+  { 0xB0, 0x00A2 }, { 0xBA, 0x005E }, { 0xBB, 0x0021 }, { 0xBD, 0x007E }, { 0 }
+};
+static const unsigned short ebcdic_1146[][2] = {
+  { 0x4A, 0x0024 }, { 0x5B, 0x00A3 }, { 0x9F, 0x20AC }, { 0xA1, 0x00AF },
+  { 0xB0, 0x00A2 }, { 0xB1, 0x005B }, { 0xBA, 0x005E }, { 0xBC, 0x007E }, { 0 }
+};
+static const unsigned short ebcdic_1147[][2] = {
+  { 0x44, 0x0040 }, { 0x48, 0x005C }, { 0x4A, 0x00B0 }, { 0x4F, 0x0021 },
+  { 0x51, 0x007B }, { 0x54, 0x007D }, { 0x5A, 0x00A7 }, { 0x5F, 0x005E },
+  { 0x6A, 0x00F9 }, { 0x79, 0x00B5 }, { 0x7B, 0x00A3 }, { 0x7C, 0x00E0 },
+  { 0x90, 0x005B }, { 0x9F, 0x20AC }, { 0xA0, 0x0060 }, { 0xA1, 0x00A8 },
+  { 0xB0, 0x00A2 }, { 0xB1, 0x0023 }, { 0xB5, 0x005D }, { 0xBA, 0x00AC },
+  { 0xBB, 0x007C }, { 0xBD, 0x007E }, { 0xC0, 0x00E9 }, { 0xD0, 0x00E8 },
+  { 0xDD, 0x00A6 }, { 0xE0, 0x00E7 }, { 0 }
+};
+static const unsigned short ebcdic_1148[][2] = {
+  { 0x4A, 0x005B }, { 0x4F, 0x0021 }, { 0x5A, 0x005D }, { 0x5F, 0x005E },
+  { 0x9F, 0x20AC }, { 0xB0, 0x00A2 }, { 0xBA, 0x00AC }, { 0xBB, 0x007C }, { 0 }
+};
+static const unsigned short ebcdic_1149[][2] = {
+  { 0x4A, 0x00DE }, { 0x4F, 0x0021 }, { 0x5A, 0x00C6 }, { 0x5F, 0x00D6 },
+  { 0x79, 0x00F0 }, { 0x7C, 0x00D0 }, { 0x8C, 0x0060 }, { 0x8E, 0x007B },
+  { 0x9C, 0x007D }, { 0x9E, 0x005D }, { 0x9F, 0x20AC }, { 0xA1, 0x00F6 },
+  { 0xAC, 0x0040 }, { 0xAE, 0x005B }, { 0xB0, 0x00A2 }, { 0xBA, 0x00AC },
+  { 0xBB, 0x007C }, { 0xBE, 0x005C }, { 0xC0, 0x00FE }, { 0xCC, 0x007E },
+  { 0xD0, 0x00E6 }, { 0xE0, 0x00B4 }, { 0xEC, 0x005E }, { 0 }
+};
+
+typedef struct {
+  unsigned short number;
+  const unsigned short (*changes)[2];
+  bool built;
+  single_entry_t decode[256];
+  unsigned char decode_ascii[256];  /* ascii of the bytes decoding to ascii, else 0 */
+  unsigned char encode[256];        /* byte of each codepoint up to 0xFF, 0 if none */
+  unsigned char encode_ascii[256];  /* the ascii half of encode, zeroes after it */
+} ebcdic_codepage_t;
+
+static ebcdic_codepage_t ebcdic_codepages[] = {
+  { .number = 37, .changes = NULL },
+  { .number = 273, .changes = ebcdic_273 },
+  { .number = 277, .changes = ebcdic_277 },
+  { .number = 278, .changes = ebcdic_278 },
+  { .number = 280, .changes = ebcdic_280 },
+  { .number = 284, .changes = ebcdic_284 },
+  { .number = 285, .changes = ebcdic_285 },
+  { .number = 297, .changes = ebcdic_297 },
+  { .number = 500, .changes = ebcdic_500 },
+  { .number = 871, .changes = ebcdic_871 },
+  { .number = 1047, .changes = ebcdic_1047 },
+  { .number = 1140, .changes = ebcdic_1140 },
+  { .number = 1141, .changes = ebcdic_1141 },
+  { .number = 1142, .changes = ebcdic_1142 },
+  { .number = 1143, .changes = ebcdic_1143 },
+  { .number = 1144, .changes = ebcdic_1144 },
+  { .number = 1145, .changes = ebcdic_1145 },
+  { .number = 1146, .changes = ebcdic_1146 },
+  { .number = 1147, .changes = ebcdic_1147 },
+  { .number = 1148, .changes = ebcdic_1148 },
+  { .number = 1149, .changes = ebcdic_1149 },
+  { .number = 0 }
+};
+
+/* The codepage named like IBM037, IBM-037, CP037 or IBM01140, NULL if none. */
+static ebcdic_codepage_t* encoding_ebcdic_find(const char* charset) {
+  static const char* const prefixes[] = { "IBM-", "IBM", "CP", NULL };
+  if (!charset)
+    return NULL;
+  const char* digits = NULL;
+  for (size_t i = 0; !digits && prefixes[i]; ++i) {
+    size_t n = 0;
+    while (prefixes[i][n] && (charset[n] | 0x20) == (prefixes[i][n] | 0x20))
+      ++n;
+    if (!prefixes[i][n])
+      digits = charset + n;
+  }
+  if (!digits || !*digits || strlen(digits) > 5 || strspn(digits, "0123456789") != strlen(digits))
+    return NULL;
+  unsigned short number = atoi(digits);
+  for (size_t i = 0; ebcdic_codepages[i].number; ++i) {
+    if (ebcdic_codepages[i].number == number)
+      return &ebcdic_codepages[i];
+  }
+  return NULL;
+}
+
+static bool encoding_is_ebcdic(const char* charset) {
+  return encoding_ebcdic_find(charset) != NULL;
+}
+
+/* The native kernels, any other pair goes through an iconv backend. */
+typedef enum {
+  KERNEL_NONE,
+  KERNEL_ESCAPE,    /* the escape charsets from and into utf8 */
+  KERNEL_SINGLE,    /* single byte charsets into utf8, with a lookup table */
+  KERNEL_UTF16,     /* UTF-16LE and UTF-16BE into utf8 */
+  KERNEL_UTF8,      /* utf8 into utf8, validating */
+  KERNEL_EBCDIC     /* utf8 into the ebcdic codepages */
+} encoding_kernel_t;
+
+/* A conversion descriptor on any backend. */
+typedef struct {
+  iconv_t iconv;              /* also the EUC descriptor of escape codecs */
+  bool cached;
+  encoding_backend_t backend;
+  encoding_kernel_t kernel;
+  encoding_escape_t escape;
+  bool encode;                /* from utf8 into the escape charset */
+  encoding_shift_t shift;
+  bool header;                /* ISO-2022-KR header already written */
+  bool big_endian;
+  const single_entry_t* table;
+  bool own_table;
+  const unsigned char* ascii;   /* bytes a table decodes to ascii, if not ascii */
+  const ebcdic_codepage_t* ebcdic;
+} encoding_conv_t;
+
+static encoding_escape_t encoding_escape_from_name(const char* charset) {
+  size_t i = 0;
+  while (escape_charsets[i].charset && !encoding_charset_equal(escape_charsets[i].charset, charset))
+    ++i;
+  return escape_charsets[i].escape;
+}
+
+static bool encoding_escape_put(bytes_t* out, const char* bytes, size_t len) {
+  if (!bytes_reserve(out, len)) {
+    if (errno != EFBIG)
+      errno = ENOMEM;
+    return false;
+  }
+  memcpy(out->data + out->size, bytes, len);
+  out->size += len;
+  return true;
+}
+
+static bool encoding_escape_shift(encoding_conv_t* conv, encoding_shift_t shift, bytes_t* out) {
+  if (conv->shift == shift)
+    return true;
+  const char* sequence = escape_sequences[conv->escape][shift];
+  if (!encoding_escape_put(out, sequence, strlen(sequence)))
+    return false;
+  conv->shift = shift;
+  return true;
+}
+
+/* Bytes that are copied as they are in the current shift state. */
+static bool encoding_escape_plain(const encoding_conv_t* conv, unsigned char c) {
+  if (c >= 0x80)
+    return false;
+  switch (conv->escape) {
+    case ESCAPE_ISO2022JP: if (c == 0x1B) return false; break;
+    case ESCAPE_ISO2022KR: if (c == 0x1B || c == 0x0E || c == 0x0F) return false; break;
+    case ESCAPE_HZ: if (c == '~') return false; break;
+    default: break;
+  }
+  if (conv->shift == SHIFT_ROMAN)
+    return c != 0x5C && c != 0x7E;
+  return conv->shift == SHIFT_ASCII || c < 0x21;
+}
+
+/* Length of the escape sequence at p, 0 if invalid or -1 if incomplete. */
+static int encoding_escape_sequence(
+  const encoding_conv_t* conv, const unsigned char* p, size_t len, encoding_shift_t* shift
+) {
+  *shift = conv->shift;
+  switch (conv->escape) {
+    case ESCAPE_ISO2022JP:
+      if (len >= 2 && p[1] != '(' && p[1] != '$')
+        return 0;
+      if (len < 3)
+        return -1;
+      if (p[1] == '(' && (p[2] == 'B' || p[2] == 'J'))
+        *shift = p[2] == 'B' ? SHIFT_ASCII : SHIFT_ROMAN;
+      else if (p[1] == '$' && (p[2] == '@' || p[2] == 'B'))
+        *shift = SHIFT_DOUBLE;
+      else
+        return 0;
+      return 3;
+    case ESCAPE_ISO2022KR:
+      if (p[0] != 0x1B) {
+        *shift = p[0] == 0x0E ? SHIFT_DOUBLE : SHIFT_ASCII;
+        return 1;
+      }
+      if (memcmp(p, ESCAPE_KR_HEADER, len < 4 ? len : 4) != 0)
+        return 0;
+      return len < 4 ? -1 : 4;
+    case ESCAPE_HZ:
+      if (len < 2)
+        return -1;
+      if (p[1] == '{' || p[1] == '}')
+        *shift = p[1] == '{' ? SHIFT_DOUBLE : SHIFT_ASCII;
+      else if (p[1] != '~' && p[1] != '\n')
+        return 0;
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+/* Converts the double byte characters of an escape charset into utf8. */
+static bool encoding_escape_decode(
+  encoding_conv_t* conv, const char* text, size_t len, bool strict, bool stream,
+  bytes_t* out, const char** consumed
+) {
+  if (!text) {
+    conv->shift = SHIFT_ASCII;
+    return true;
+  }
+  const unsigned char* p = (const unsigned char*)text;
+  const unsigned char* end = p + len;
+  while (p < end) {
+    if (consumed)
+      *consumed = (const char*)p;
+    const unsigned char* run = p;
+    if (conv->shift == SHIFT_ASCII) {
+      /* the common case, ascii up to the next escape */
+      unsigned char special = conv->escape == ESCAPE_HZ ? '~' : 0x1B;
+      bool shifts = conv->escape == ESCAPE_ISO2022KR;
+      while (p < end && *p < 0x80 && *p != special && !(shifts && (*p & 0xFE) == 0x0E))
+        ++p;
+    } else {
+      while (p < end && encoding_escape_plain(conv, *p))
+        ++p;
+    }
+    if (p > run && !encoding_escape_put(out, (const char*)run, p - run))
+      return false;
+    if (p == end)
+      break;
+    if (consumed)
+      *consumed = (const char*)p;
+    unsigned char c = *p;
+    if (conv->shift == SHIFT_ROMAN && (c == 0x5C || c == 0x7E)) {
+      if (!encoding_escape_put(out, c == 0x5C ? "\xC2\xA5" : "\xE2\x80\xBE", c == 0x5C ? 2 : 3))
+        return false;
+      ++p;
+      continue;
+    }
+    if (c == 0x1B || (conv->escape == ESCAPE_ISO2022KR && (c == 0x0E || c == 0x0F))
+      || (conv->escape == ESCAPE_HZ && c == '~')) {
+      encoding_shift_t shift;
+      int sequence_len = encoding_escape_sequence(conv, p, end - p, &shift);
+      if (sequence_len < 0 && stream)
+        return true;
+      if (sequence_len > 0) {
+        if (conv->escape == ESCAPE_HZ && p[1] == '~' && !encoding_escape_put(out, "~", 1))
+          return false;
+        conv->shift = shift;
+        p += sequence_len;
+        continue;
+      }
+    } else if (conv->shift == SHIFT_DOUBLE && c < 0x7F) {
+      /* a run of complete pairs goes through the EUC descriptor */
+      char euc[256];
+      size_t n = 0;
+      run = p;
+      while (p + 1 < end && n < sizeof(euc) && p[0] >= 0x21 && p[0] < 0x7F
+        && p[1] >= 0x21 && p[1] < 0x7F && !(conv->escape == ESCAPE_HZ && p[0] == '~')) {
+        euc[n++] = p[0] | 0x80;
+        euc[n++] = p[1] | 0x80;
+        p += 2;
+      }
+      if (n == 0 && p + 1 == end && stream)
+        return true;
+      const char* stop = euc;
+      if (n > 0 && !encoding_iconv_feed(BACKEND_ICONV, conv->iconv, euc, n, true, false, out, &stop)) {
+        if (errno != EILSEQ && errno != EINVAL)
+          return false;
+        p = run + (stop - euc);
+        if (consumed)
+          *consumed = (const char*)p;
+        if (strict) {
+          errno = EILSEQ;
+          return false;
+        }
+        p += 2;
+      }
+      if (n > 0)
+        continue;
+    }
+    /* anything else is not valid in this charset */
+    if (strict) {
+      errno = EILSEQ;
+      return false;
+    }
+    ++p;
+  }
+  if (consumed)
+    *consumed = (const char*)p;
+  return true;
+}
+
+/* Writes the EUC characters converted from utf8 in the escape charset. */
+static bool encoding_escape_put_euc(
+  encoding_conv_t* conv, const unsigned char* euc, size_t euc_len,
+  const unsigned char** in, bool strict, bytes_t* out, const char** consumed
+) {
+  for (size_t i = 0; i < euc_len;) {
+    unsigned int codepoint = 0;
+    size_t char_len = encoding_utf8_decode(*in, 4, &codepoint);
+    size_t euc_char_len = euc[i] < 0x80 ? 1 : euc[i] == 0x8F ? 3 : 2;
+    bool success;
+    if (euc_char_len == 2 && euc[i] >= 0xA1 && euc[i] < 0xFF) {
+      char pair[2] = { euc[i] & 0x7F, euc[i + 1] & 0x7F };
+      success = encoding_escape_shift(conv, SHIFT_DOUBLE, out)
+        && encoding_escape_put(out, pair, 2);
+    } else if (euc_char_len == 1) {
+      bool roman = conv->escape == ESCAPE_ISO2022JP && (codepoint == 0xA5 || codepoint == 0x203E);
+      success = encoding_escape_shift(conv, roman ? SHIFT_ROMAN : SHIFT_ASCII, out)
+        && encoding_escape_put(out, (const char*)euc + i, 1);
+    } else {
+      /* half width katakana and JIS X 0212 have no place in ISO-2022-JP */
+      if (consumed)
+        *consumed = (const char*)*in;
+      errno = EILSEQ;
+      if (strict)
+        return false;
+      success = true;
+    }
+    if (!success)
+      return false;
+    *in += char_len ? char_len : 1;
+    i += euc_char_len;
+    if (consumed)
+      *consumed = (const char*)*in;
+  }
+  return true;
+}
+
+/* Converts utf8 into an escape charset, with ascii runs copied as they are. */
+static bool encoding_escape_encode(
+  encoding_conv_t* conv, const char* text, size_t len, bool strict, bool stream,
+  bytes_t* out, const char** consumed
+) {
+  if (!text)
+    return encoding_escape_shift(conv, SHIFT_ASCII, out);
+  if (conv->escape == ESCAPE_ISO2022KR && !conv->header) {
+    if (!encoding_escape_put(out, ESCAPE_KR_HEADER, 4))
+      return false;
+    conv->header = true;
+  }
+  const unsigned char* p = (const unsigned char*)text;
+  const unsigned char* end = p + len;
+  while (p < end) {
+    if (consumed)
+      *consumed = (const char*)p;
+    if (*p < 0x80) {
+      const unsigned char* run = p;
+      while (p < end && *p < 0x80 && !(conv->escape == ESCAPE_HZ && *p == '~'))
+        ++p;
+      if (!encoding_escape_shift(conv, SHIFT_ASCII, out)
+        || (p > run && !encoding_escape_put(out, (const char*)run, p - run)))
+        return false;
+      if (p < end && *p == '~') {
+        if (!encoding_escape_put(out, "~~", 2))
+          return false;
+        ++p;
+      }
+      continue;
+    }
+    const unsigned char* run_end = p;
+    while (run_end < end && *run_end >= 0x80)
+      ++run_end;
+    char* inbuf = (char*)p;
+    size_t inbytesleft = run_end - p;
+    while (inbytesleft > 0) {
+      char euc[256];
+      char* outbuf = euc;
+      size_t outbytesleft = sizeof(euc);
+      size_t err = iconv(conv->iconv, &inbuf, &inbytesleft, &outbuf, &outbytesleft);
+      int error = errno;
+      if (!encoding_escape_put_euc(conv, (const unsigned char*)euc, outbuf - euc, &p, strict, out, consumed))
+        return false;
+      if (err != (size_t)-1 || error == E2BIG)
+        continue;
+      /* invalid or unencodable input, or an incomplete character at the end */
+      if (consumed)
+        *consumed = inbuf;
+      if (error == EINVAL && stream && run_end == end)
+        return true;
+      if (strict) {
+        errno = error == EINVAL ? EILSEQ : error;
+        return false;
+      }
+      ++inbuf;
+      --inbytesleft;
+      p = (const unsigned char*)inbuf;
+    }
+    p = run_end;
+  }
+  if (consumed)
+    *consumed = (const char*)p;
+  return true;
+}
+
+/*
+ * Utf8 of every byte of a single byte charset, built once through iconv and
+ * shared by every descriptor. Charsets that compose characters on decoding
+ * or don't keep ascii as it is can't use a table.
+*/
+#define SINGLE_TABLES_MAX 32
+static struct {
+  char charset[48];
+  single_entry_t* table;
+} single_tables[SINGLE_TABLES_MAX];
+static size_t single_table_count = 0;
+static mutex_t single_tables_mutex;
+
+static const char* const single_composing_charsets[] = { "TCVN", "WINDOWS-1258", "CP1258", NULL };
+
+static single_entry_t* encoding_single_table_build(const char* charset) {
+  for (size_t i = 0; single_composing_charsets[i]; ++i) {
+    if (encoding_charset_equal(single_composing_charsets[i], charset))
+      return NULL;
+  }
+  iconv_t conv = iconv_open("UTF-8", charset);
+  if (conv == (iconv_t)-1)
+    return NULL;
+  single_entry_t* table = calloc(256, sizeof(single_entry_t));
+  for (int i = 0; table && i < 256; ++i) {
+    char byte = i, utf8[8];
+    char* inbuf = &byte;
+    char* outbuf = utf8;
+    size_t inbytesleft = 1, outbytesleft = sizeof(utf8);
+    iconv(conv, NULL, NULL, NULL, NULL);
+    if (iconv(conv, &inbuf, &inbytesleft, &outbuf, &outbytesleft) == (size_t)-1)
+      continue;
+    size_t len = outbuf - utf8;
+    if (len > 3 || (i < 0x80 && (len != 1 || utf8[0] != byte))) {
+      free(table);
+      table = NULL;
+      break;
+    }
+    table[i][0] = len;
+    memcpy(table[i] + 1, utf8, len);
+  }
+  iconv_close(conv);
+  return table;
+}
+
+/* The shared table of charset, or a private one once there are too many. */
+static const single_entry_t* encoding_single_table(const char* charset, bool* own) {
+  *own = false;
+  mutex_lock(&single_tables_mutex);
+  for (size_t i = 0; i < single_table_count; ++i) {
+    if (encoding_charset_equal(single_tables[i].charset, charset)) {
+      mutex_unlock(&single_tables_mutex);
+      return single_tables[i].table;
+    }
+  }
+  single_entry_t* table = encoding_single_table_build(charset);
+  if (strlen(charset) >= sizeof(single_tables[0].charset) || single_table_count == SINGLE_TABLES_MAX) {
+    *own = table != NULL;
+  } else {
+    strcpy(single_tables[single_table_count].charset, charset);
+    single_tables[single_table_count++].table = table;
+  }
+  mutex_unlock(&single_tables_mutex);
+  return table;
+}
+
+/* The codepage of charset with its tables built, NULL if not an ebcdic one. */
+static const ebcdic_codepage_t* encoding_ebcdic_codepage(const char* charset) {
+  ebcdic_codepage_t* codepage = encoding_ebcdic_find(charset);
+  if (!codepage)
+    return NULL;
+  mutex_lock(&single_tables_mutex);
+  if (!codepage->built) {
+    unsigned short codepoints[256];
+    for (int i = 0; i < 256; ++i)
+      codepoints[i] = ebcdic_base[i];
+    for (size_t i = 0; codepage->changes && codepage->changes[i][0]; ++i)
+      codepoints[codepage->changes[i][0]] = codepage->changes[i][1];
+    memset(codepage->encode, 0, sizeof(codepage->encode));
+    for (int i = 0; i < 256; ++i) {
+      codepage->decode[i][0] = encoding_utf8_encode(codepoints[i], codepage->decode[i] + 1);
+      codepage->decode_ascii[i] = codepoints[i] < 0x80 ? codepoints[i] : 0;
+      if (codepoints[i] < 0x100)
+        codepage->encode[codepoints[i]] = i;
+    }
+    memcpy(codepage->encode_ascii, codepage->encode, 0x80);
+    memset(codepage->encode_ascii + 0x80, 0, 0x80);
+    codepage->built = true;
+  }
+  mutex_unlock(&single_tables_mutex);
+  return codepage;
+}
+
+/* Makes sure there is room for at least 4 more bytes in out. */
+static bool encoding_kernel_reserve(bytes_t* out, size_t left) {
+  if (out->capacity - out->size >= 4)
+    return true;
+  if (!bytes_reserve(out, left + 16) || out->capacity - out->size < 4) {
+    if (errno != EFBIG)
+      errno = ENOMEM;
+    return false;
+  }
+  return true;
+}
+
+static bool encoding_single_decode(
+  encoding_conv_t* conv, const char* text, size_t len, bool strict,
+  bytes_t* out, const char** consumed
+) {
+  const unsigned char* p = (const unsigned char*)text;
+  const unsigned char* end = p + len;
+  bool success = true;
+  while (success && p < end) {
+    if (!encoding_kernel_reserve(out, end - p))
+      break;
+    unsigned char* o = (unsigned char*)out->data + out->size;
+    unsigned char* limit = (unsigned char*)out->data + out->capacity - 3;
+    while (p < end && o < limit) {
+      if (conv->ascii ? conv->ascii[*p] || !*p : *p < 0x80) {
+        /* copies the ascii up to the next byte that needs the table */
+        size_t room = limit - o, left = end - p, n = left < room ? left : room;
+        size_t ascii = conv->ascii ? kernels.translate(o, p, n, conv->ascii) : kernels.ascii_copy(o, p, n);
+        p += ascii;
+        o += ascii;
+        continue;
+      }
+      const unsigned char* entry = conv->table[*p];
+      if (entry[0] == 0 && strict) {
+        errno = EILSEQ;
+        success = false;
+        break;
+      }
+      memcpy(o, entry + 1, 3);
+      o += entry[0];
+      ++p;
+    }
+    out->size = o - (unsigned char*)out->data;
+  }
+  if (consumed)
+    *consumed = (const char*)p;
+  return success && p == end;
+}
+
+static bool encoding_utf16_decode(
+  encoding_conv_t* conv, const char* text, size_t len, bool strict, bool stream,
+  bytes_t* out, const char** consumed
+) {
+  const unsigned char* p = (const unsigned char*)text;
+  const unsigned char* end = p + len;
+  int high = conv->big_endian ? 0 : 1, low = conv->big_endian ? 1 : 0;
+  bool success = true, incomplete = false;
+  while (success && !incomplete && p < end) {
+    if (!encoding_kernel_reserve(out, end - p))
+      break;
+    unsigned char* o = (unsigned char*)out->data + out->size;
+    unsigned char* limit = (unsigned char*)out->data + out->capacity - 3;
+    while (p < end && o < limit) {
+      if (end - p < 2) {
+        incomplete = true;
+        break;
+      }
+      unsigned int unit = (p[high] << 8) | p[low];
+      size_t unit_len = 2;
+      if (unit < 0x80) {
+        size_t room = limit - o, units = (end - p) / 2;
+        size_t ascii = kernels.utf16_ascii(o, p, units < room ? units : room, conv->big_endian);
+        p += ascii * 2;
+        o += ascii;
+        continue;
+      }
+      if (unit >= 0xD800 && unit < 0xDC00) {
+        if (end - p < 4) {
+          incomplete = true;
+          break;
+        }
+        unsigned int second = (p[2 + high] << 8) | p[2 + low];
+        if (second >= 0xDC00 && second < 0xE000) {
+          unit = 0x10000 + ((unit - 0xD800) << 10) + (second - 0xDC00);
+          unit_len = 4;
+        }
+      }
+      if (unit >= 0xD800 && unit < 0xE000) {
+        if (strict) {
+          errno = EILSEQ;
+          success = false;
+          break;
+        }
+        p += 2;
+        continue;
+      }
+      o += encoding_utf8_encode(unit, o);
+      p += unit_len;
+    }
+    out->size = o - (unsigned char*)out->data;
+  }
+  if (consumed)
+    *consumed = (const char*)p;
+  if (incomplete && !stream) {
+    if (strict) {
+      errno = EILSEQ;
+      return false;
+    }
+    if (consumed)
+      *consumed = (const char*)end;
+    return true;
+  }
+  return success && (incomplete || p == end);
+}
+
+/* Whether the len bytes at p are the start of a longer utf8 sequence. */
+static bool encoding_utf8_cut(const unsigned char* p, size_t len) {
+  size_t expected = *p >= 0xF0 ? 4 : *p >= 0xE0 ? 3 : 2;
+  if (*p < 0xC2 || *p > 0xF4 || len >= expected)
+    return false;
+  /* the second byte already tells overlongs, surrogates and past 0x10FFFF */
+  if (len > 1 && ((p[0] == 0xE0 && p[1] < 0xA0) || (p[0] == 0xED && p[1] > 0x9F)
+    || (p[0] == 0xF0 && p[1] < 0x90) || (p[0] == 0xF4 && p[1] > 0x8F)))
+    return false;
+  for (size_t i = 1; i < len; ++i) {
+    if ((p[i] & 0xC0) != 0x80)
+      return false;
+  }
+  return true;
+}
+
+static bool encoding_utf8_copy(
+  const char* text, size_t len, bool strict, bool stream,
+  bytes_t* out, const char** consumed
+) {
+  const unsigned char* p = (const unsigned char*)text;
+  const unsigned char* end = p + len;
+  bool success = true;
+  while (p < end) {
+    const unsigned char* run = p;
+    unsigned int codepoint;
+    size_t char_len = 0;
+    while (p < end) {
+      if (*p < 0x80)
+        p += kernels.ascii_span(p, end - p);
+      else if ((char_len = encoding_utf8_decode(p, end - p, &codepoint)) > 0)
+        p += char_len;
+      else
+        break;
+    }
+    if (p > run) {
+      if (!bytes_reserve(out, p - run)) {
+        if (errno != EFBIG)
+          errno = ENOMEM;
+        p = run;
+        success = false;
+        break;
+      }
+      /* up to the last whole character when the limit cuts the run */
+      if (out->capacity - out->size < (size_t)(p - run)) {
+        p = run + (out->capacity - out->size);
+        while (p > run && (*p & 0xC0) == 0x80)
+          --p;
+        errno = EFBIG;
+        success = false;
+      }
+      memcpy(out->data + out->size, run, p - run);
+      out->size += p - run;
+      if (!success)
+        break;
+    }
+    if (p == end)
+      break;
+    /* a sequence cut by the end of the text is left for the next call */
+    if (stream && encoding_utf8_cut(p, end - p))
+      break;
+    if (strict) {
+      errno = EILSEQ;
+      success = false;
+      break;
+    }
+    ++p;
+  }
+  if (consumed)
+    *consumed = (const char*)p;
+  return success;
+}
+
+/* Utf8 into an ebcdic codepage, the ascii runs through the translate kernel. */
+static bool encoding_ebcdic_encode(
+  encoding_conv_t* conv, const char* text, size_t len, bool strict, bool stream,
+  bytes_t* out, const char** consumed
+) {
+  const ebcdic_codepage_t* codepage = conv->ebcdic;
+  const unsigned char* p = (const unsigned char*)text;
+  const unsigned char* end = p + len;
+  bool success = true, cut = false;
+  while (success && !cut && p < end) {
+    if (!encoding_kernel_reserve(out, end - p))
+      break;
+    unsigned char* o = (unsigned char*)out->data + out->size;
+    unsigned char* limit = (unsigned char*)out->data + out->capacity;
+    while (p < end && o < limit) {
+      if (*p < 0x80) {
+        size_t room = limit - o, left = end - p;
+        size_t ascii = kernels.translate(o, p, left < room ? left : room, codepage->encode_ascii);
+        p += ascii;
+        o += ascii;
+        if (ascii > 0)
+          continue;
+      }
+      unsigned int codepoint;
+      size_t char_len = encoding_utf8_decode(p, end - p, &codepoint);
+      if (char_len == 0) {
+        if (stream && encoding_utf8_cut(p, end - p)) {
+          cut = true;
+          break;
+        }
+        char_len = 1;
+      }
+      /* the ascii left has no byte, past it only the changes go above 0xFF */
+      int byte = -1;
+      if (char_len > 1 && codepoint < 0x100 && codepage->encode[codepoint]) {
+        byte = codepage->encode[codepoint];
+      } else if (char_len > 1) {
+        for (size_t i = 0; codepage->changes && codepage->changes[i][0]; ++i) {
+          if (codepage->changes[i][1] == codepoint)
+            byte = codepage->changes[i][0];
+        }
+      }
+      if (byte < 0 && strict) {
+        errno = EILSEQ;
+        success = false;
+        break;
+      }
+      if (byte >= 0)
+        *o++ = byte;
+      p += char_len;
+    }
+    out->size = o - (unsigned char*)out->data;
+  }
+  if (consumed)
+    *consumed = (const char*)p;
+  return success && (cut || p == end);
+}
+
+/* Which native kernel converts between the given charsets, if any. */
+static encoding_kernel_t encoding_native_kernel(const char* to, const char* from) {
+  const charset_t* to_cs = charset_from_name(to);
+  const charset_t* from_cs = charset_from_name(from);
+  if (to_cs->kind == CHARSET_UTF8 && from_cs->kind == CHARSET_UTF8)
+    return KERNEL_UTF8;
+  if (to_cs->kind == CHARSET_UTF8 && encoding_ebcdic_find(from))
+    return KERNEL_SINGLE;
+  if (from_cs->kind == CHARSET_UTF8 && encoding_ebcdic_find(to))
+    return KERNEL_EBCDIC;
+  if (encoding_escape_from_name(to_cs->kind == CHARSET_UTF8 ? from : to) != ESCAPE_NONE
+    && (to_cs->kind == CHARSET_UTF8 || from_cs->kind == CHARSET_UTF8))
+    return KERNEL_ESCAPE;
+  if (to_cs->kind != CHARSET_UTF8)
+    return KERNEL_NONE;
+  if (from_cs->kind == CHARSET_SINGLE)
+    return KERNEL_SINGLE;
+  if (from_cs->kind == CHARSET_UTF16 && strncmp(from_cs->charset, "UTF-16", 6) == 0)
+    return KERNEL_UTF16;
+  return KERNEL_NONE;
+}
+
+/* Opens a descriptor on the given backend, false if it can't convert the pair. */
+static bool encoding_conv_open_backend(
+  encoding_conv_t* conv, const char* to, const char* from,
+  encoding_backend_t backend, bool cache
+) {
+  memset(conv, 0, sizeof(*conv));
+  conv->iconv = (iconv_t)-1;
+  conv->backend = backend;
+  if (backend == BACKEND_NATIVE) {
+    conv->kernel = encoding_native_kernel(to, from);
+    switch (conv->kernel) {
+      case KERNEL_NONE:
+        errno = EINVAL;
+        return false;
+      case KERNEL_ESCAPE:
+        /* the double byte runs go through the linked iconv */
+        conv->encode = charset_from_name(from)->kind == CHARSET_UTF8;
+        conv->escape = encoding_escape_from_name(conv->encode ? to : from);
+        if (conv->encode)
+          to = escape_inner_charsets[conv->escape];
+        else
+          from = escape_inner_charsets[conv->escape];
+        backend = BACKEND_ICONV;
+        break;
+      case KERNEL_SINGLE:
+        if ((conv->ebcdic = encoding_ebcdic_codepage(from))) {
+          conv->table = (const single_entry_t*)conv->ebcdic->decode;
+          conv->ascii = conv->ebcdic->decode_ascii;
+          return true;
+        }
+        conv->table = encoding_single_table(from, &conv->own_table);
+        if (!conv->table)
+          errno = EINVAL;
+        return conv->table != NULL;
+      case KERNEL_UTF16:
+        conv->big_endian = charset_from_name(from)->big_endian;
+        return true;
+      case KERNEL_UTF8:
+        return true;
+      case KERNEL_EBCDIC:
+        conv->ebcdic = encoding_ebcdic_codepage(to);
+        return true;
+    }
+  }
+  if (cache)
+    conv->iconv = iconv_cache_open(backend, to, from, &conv->cached);
+  else
+    conv->iconv = backend_iconv_open(backend, to, from);
+  return conv->iconv != (iconv_t)-1;
+}
+
+/* Back to the initial shift state, as if just opened. */
+static void encoding_conv_reset(encoding_conv_t* conv) {
+  if (conv->iconv != (iconv_t)-1)
+    backend_iconv(conv->kernel == KERNEL_ESCAPE ? BACKEND_ICONV : conv->backend, conv->iconv, NULL, NULL, NULL, NULL);
+  conv->shift = SHIFT_ASCII;
+  conv->header = false;
+}
+
+static void encoding_conv_close(encoding_conv_t* conv) {
+  iconv_cache_close(conv->kernel == KERNEL_ESCAPE ? BACKEND_ICONV : conv->backend, conv->iconv, conv->cached);
+  if (conv->own_table)
+    free((void*)conv->table);
+  conv->iconv = (iconv_t)-1;
+  conv->table = NULL;
+  conv->own_table = false;
+  conv->ascii = NULL;
+  conv->ebcdic = NULL;
+  conv->kernel = KERNEL_NONE;
+}
+
+/* Like encoding_iconv_feed() with any kind of descriptor. */
+static bool encoding_conv_feed(
+  encoding_conv_t* conv, const char* text, size_t len, bool strict, bool stream,
+  bytes_t* out, const char** consumed
+) {
+  switch (conv->kernel) {
+    case KERNEL_NONE:
+      return encoding_iconv_feed(conv->backend, conv->iconv, text, len, strict, stream, out, consumed);
+    case KERNEL_ESCAPE:
+      if (conv->encode)
+        return encoding_escape_encode(conv, text, len, strict, stream, out, consumed);
+      return encoding_escape_decode(conv, text, len, strict, stream, out, consumed);
+    case KERNEL_SINGLE:
+      return !text || encoding_single_decode(conv, text, len, strict, out, consumed);
+    case KERNEL_UTF16:
+      return !text || encoding_utf16_decode(conv, text, len, strict, stream, out, consumed);
+    case KERNEL_UTF8:
+      return !text || encoding_utf8_copy(text, len, strict, stream, out, consumed);
+    case KERNEL_EBCDIC:
+      return !text || encoding_ebcdic_encode(conv, text, len, strict, stream, out, consumed);
+  }
+  return false;
+}
+
+static bool encoding_conv_append(
+  encoding_conv_t* conv, const char* text, size_t len, bool strict, bytes_t* out,
+  const char** consumed
+) {
+  return encoding_conv_feed(conv, text, len, strict, false, out, consumed);
+}
+
+/*
+ * Backend choice of each charset pair. The first time a pair is opened every
+ * backend able to convert it runs a sample of multilingual text, plus every
+ * character of single byte charsets, those with an output different from the
+ * linked iconv are discarded and the fastest of the rest is kept, and appended
+ * to the backend cache file if configured.
+*/
+#define TUNE_SAMPLE_SIZE (16*1024)
+#define TUNE_ROUNDS 5
+
+typedef struct {
+  char to[48];
+  char from[48];
+  encoding_backend_t backend;
+} backend_choice_t;
+
+static backend_choice_t* backend_choices = NULL;
+static size_t backend_choice_count = 0;
+static size_t backend_choice_capacity = 0;
+static size_t backend_tunings = 0;
+static mutex_t backend_mutex;
+static encoding_backend_t encoding_backend_mode = BACKEND_AUTO;
+static char* backend_cache_path = NULL;
+
+/* Text the samples of every charset are taken from. */
+static const char tune_probe[] =
+  "static int main(void) { return printf(\"%d\\n\", 42) > 0 ? 0 : 1; }\n"
+  "Ünïcödé façade, déjà vu, Smørrebrød, Zażółć gęślą jaźń, Příliš žluťoučký kůň\n"
+  "Съешь же ещё этих мягких французских булок, Ελληνικά γράμματα, עברית, العربية\n"
+  "Çok güzel ağaç, Ģirts ēd ābolu, ภาษาไทย, 日本語のテキスト、カタカナ, "
+  "中文简体, 繁體中文, 한국어 텍스트\n"
+  "“quotes” ‘single’ – dash — € £ ¥ © ® ™ … • ½ ° 😀\n";
+
+static backend_choice_t* encoding_backend_find(const char* to, const char* from) {
+  for (size_t i = 0; i < backend_choice_count; ++i) {
+    if (strcmp(backend_choices[i].to, to) == 0 && strcmp(backend_choices[i].from, from) == 0)
+      return &backend_choices[i];
+  }
+  return NULL;
+}
+
+static void encoding_backend_record(const char* to, const char* from, encoding_backend_t backend) {
+  if (strlen(to) >= sizeof(backend_choices[0].to) || strlen(from) >= sizeof(backend_choices[0].from))
+    return;
+  if (backend_choice_count == backend_choice_capacity) {
+    size_t capacity = backend_choice_capacity ? backend_choice_capacity * 2 : 16;
+    backend_choice_t* choices = realloc(backend_choices, capacity * sizeof(backend_choice_t));
+    if (!choices)
+      return;
+    backend_choices = choices;
+    backend_choice_capacity = capacity;
+  }
+  backend_choice_t* choice = &backend_choices[backend_choice_count++];
+  strcpy(choice->to, to);
+  strcpy(choice->from, from);
+  choice->backend = backend;
+}
+
+/* Converts the whole text from the initial state into out, false on errors. */
+static bool encoding_conv_run(encoding_conv_t* conv, const char* text, size_t len, bool strict, bytes_t* out) {
+  encoding_conv_reset(conv);
+  out->size = 0;
+  return encoding_conv_append(conv, text, len, strict, out, NULL)
+    && encoding_conv_append(conv, NULL, 0, strict, out, NULL);
+}
+
+/* Keeps only the characters of the utf8 sample that charset can encode. */
+static void encoding_tune_filter(const char* charset, bytes_t* sample) {
+  encoding_conv_t conv;
+  if (!encoding_conv_open_backend(&conv, charset, "UTF-8", BACKEND_ICONV, false))
+    return;
+  bytes_t out = { NULL, 0, 0, NULL, 0 };
+  bytes_t kept = { NULL, 0, 0, NULL, 0 };
+  for (size_t i = 0; i < sample->size;) {
+    unsigned int codepoint;
+    size_t char_len = encoding_utf8_decode((const unsigned char*)sample->data + i, sample->size - i, &codepoint);
+    if (char_len == 0)
+      char_len = 1;
+    if (encoding_conv_run(&conv, sample->data + i, char_len, true, &out) && bytes_reserve(&kept, char_len)) {
+      memcpy(kept.data + kept.size, sample->data + i, char_len);
+      kept.size += char_len;
+    }
+    i += char_len;
+  }
+  encoding_conv_close(&conv);
+  bytes_free(&out);
+  bytes_free(sample);
+  *sample = kept;
+}
+
+/*
+ * Appends to the utf8 sample every character of a single byte charset, so all
+ * of its 256 bytes are compared between the backends and not just the probe.
+*/
+static void encoding_tune_bytes(const char* charset, bytes_t* sample) {
+  charset_kind_t kind = charset_from_name(charset)->kind;
+  encoding_conv_t conv;
+  if ((kind != CHARSET_SINGLE && kind != CHARSET_EBCDIC)
+    || !encoding_conv_open_backend(&conv, "UTF-8", charset, BACKEND_ICONV, false))
+    return;
+  bytes_t out = { NULL, 0, 0, NULL, 0 };
+  for (int byte = 0; byte < 256; ++byte) {
+    char c = (char)byte;
+    if (encoding_conv_run(&conv, &c, 1, true, &out) && bytes_reserve(sample, out.size)) {
+      memcpy(sample->data + sample->size, out.data, out.size);
+      sample->size += out.size;
+    }
+  }
+  encoding_conv_close(&conv);
+  bytes_free(&out);
+}
+
+static encoding_backend_t encoding_backend_tune(const char* to, const char* from) {
+  encoding_conv_t convs[BACKEND_AUTO];
+  encoding_backend_t available[BACKEND_AUTO];
+  size_t count = 0;
+  /* the C library iconv only runs when asked for, it is never tuned */
+  encoding_backend_t order[] = { BACKEND_ICONV, BACKEND_NATIVE };
+  for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); ++i) {
+    if (encoding_conv_open_backend(&convs[count], to, from, order[i], false))
+      available[count++] = order[i];
+  }
+  if (count == 0)
+    return BACKEND_ICONV;
+  encoding_backend_t best = available[0];
+  if (count > 1) {
+    /* the probe restricted to what both charsets can hold, as from text */
+    bytes_t sample = { NULL, 0, 0, NULL, 0 };
+    bytes_t input = { NULL, 0, 0, NULL, 0 };
+    bytes_t expected = { NULL, 0, 0, NULL, 0 };
+    bytes_t out = { NULL, 0, 0, NULL, 0 };
+    while (sample.size < TUNE_SAMPLE_SIZE && bytes_reserve(&sample, sizeof(tune_probe))) {
+      memcpy(sample.data + sample.size, tune_probe, sizeof(tune_probe) - 1);
+      sample.size += sizeof(tune_probe) - 1;
+    }
+    encoding_tune_bytes(from, &sample);
+    encoding_tune_bytes(to, &sample);
+    if (charset_from_name(from)->kind != CHARSET_UTF8)
+      encoding_tune_filter(from, &sample);
+    if (charset_from_name(to)->kind != CHARSET_UTF8)
+      encoding_tune_filter(to, &sample);
+    encoding_conv_t encoder;
+    bool ready = true;
+    if (charset_from_name(from)->kind != CHARSET_UTF8) {
+      ready = encoding_conv_open_backend(&encoder, from, "UTF-8", BACKEND_ICONV, false);
+      if (ready) {
+        ready = encoding_conv_run(&encoder, sample.data, sample.size, false, &input);
+        encoding_conv_close(&encoder);
+      }
+    } else {
+      input = sample;
+      sample.data = NULL;
+    }
+    /* the linked iconv, or the first one available, gives the expected output */
+    ready = ready && encoding_conv_run(&convs[0], input.data, input.size, false, &expected);
+    double best_time = 0;
+    for (size_t i = 0; ready && i < count; ++i) {
+      if (!encoding_conv_run(&convs[i], input.data, input.size, false, &out)
+        || out.size != expected.size || memcmp(out.data, expected.data, out.size) != 0)
+        continue;
+      double fastest = 0;
+      for (int round = 0; round < TUNE_ROUNDS; ++round) {
+        double start = clock_seconds();
+        encoding_conv_run(&convs[i], input.data, input.size, false, &out);
+        double elapsed = clock_seconds() - start;
+        if (round == 0 || elapsed < fastest)
+          fastest = elapsed;
+      }
+      if (best_time == 0 || fastest < best_time) {
+        best_time = fastest;
+        best = available[i];
+      }
+    }
+    bytes_free(&sample);
+    bytes_free(&input);
+    bytes_free(&expected);
+    bytes_free(&out);
+  }
+  for (size_t i = 0; i < count; ++i)
+    encoding_conv_close(&convs[i]);
+  backend_tunings++;
+  return best;
+}
+
+/* The backend that runs a pair, tuning it the first time. */
+static encoding_backend_t encoding_backend_choose(const char* to, const char* from) {
+  mutex_lock(&backend_mutex);
+  backend_choice_t* choice = encoding_backend_find(to, from);
+  encoding_backend_t backend;
+  if (choice) {
+    backend = choice->backend;
+  } else {
+    backend = encoding_backend_tune(to, from);
+    encoding_backend_record(to, from, backend);
+    FILE* file = backend_cache_path ? encoding_fopen(backend_cache_path, "ab") : NULL;
+    if (file) {
+      fprintf(file, "%s\t%s\t%s\n", from, to, encoding_backend_names[backend]);
+      fclose(file);
+    }
+  }
+  mutex_unlock(&backend_mutex);
+  return backend;
+}
+
+/* Loads the choices saved on the backend cache file, the file ones win. */
+static void encoding_backend_load(const char* path) {
+  FILE* file = encoding_fopen(path, "rb");
+  if (!file)
+    return;
+  char line[160];
+  mutex_lock(&backend_mutex);
+  while (fgets(line, sizeof(line), file)) {
+    char* to = strchr(line, '\t');
+    char* name = to ? strchr(to + 1, '\t') : NULL;
+    if (!name)
+      continue;
+    *to++ = '\0';
+    *name++ = '\0';
+    name[strcspn(name, "\r\n")] = '\0';
+    encoding_backend_t backend = BACKEND_ICONV;
+    while (backend < BACKEND_AUTO && strcmp(encoding_backend_names[backend], name) != 0)
+      backend++;
+    if (backend == BACKEND_AUTO || backend == BACKEND_SYSTEM)
+      continue;
+    backend_choice_t* choice = encoding_backend_find(to, line);
+    if (choice)
+      choice->backend = backend;
+    else
+      encoding_backend_record(to, line, backend);
+  }
+  mutex_unlock(&backend_mutex);
+  fclose(file);
+}
+
+/*
+ * Opens a descriptor converting from one charset into another on the backend
+ * chosen for the pair, or the first one able to if that fails. Descriptors
+ * used off the lua thread or kept between calls must not be cached.
+*/
+static bool encoding_conv_open(
+  encoding_conv_t* conv, const char* to, const char* from, bool cache
+) {
+  encoding_backend_t backend = encoding_backend_mode;
+  /* iconv disagrees on the line ends of ebcdic, so no tuning against it */
+  if (encoding_ebcdic_find(to) || encoding_ebcdic_find(from))
+    backend = BACKEND_NATIVE;
+  else if (backend == BACKEND_AUTO)
+    backend = encoding_backend_choose(to, from);
+  if (encoding_conv_open_backend(conv, to, from, backend, cache))
+    return true;
+  encoding_backend_t order[] = { BACKEND_NATIVE, BACKEND_ICONV, BACKEND_SYSTEM };
+  for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); ++i) {
+    if (order[i] != backend && encoding_conv_open_backend(conv, to, from, order[i], cache))
+      return true;
+  }
+  return false;
+}
+
+/* Whether any backend can convert between the charsets, without tuning. */
+static bool encoding_conv_available(const char* to, const char* from) {
+  encoding_conv_t conv;
+  for (encoding_backend_t backend = BACKEND_ICONV; backend < BACKEND_AUTO; ++backend) {
+    if (encoding_conv_open_backend(&conv, to, from, backend, false)) {
+      encoding_conv_close(&conv);
+      return true;
+    }
+  }
+  return false;
+}
+
+/*
+ * Converts utf8 text like encoding_conv_feed() but characters which can't
+ * be encoded are replaced as the fallback mode says, in the same pass. Only
+ * the input that is not valid utf8 is handled as strict asks.
+*/
+static bool encoding_iconv_fallback(
+  encoding_conv_t* conv, const char* text, size_t len, bool strict, bool stream,
+  encoding_fallback_t mode, bytes_t* out, const char** consumed,
+  size_t* substitutions
+) {
+  const char* end = text + len;
+  while (text < end) {
+    const char* stop = text;
+    bool success = encoding_conv_feed(conv, text, end - text, true, stream, out, &stop);
+    if (consumed)
+      *consumed = stop;
+    if (success)
+      return true;
+    if (errno != EILSEQ && errno != EINVAL)
+      return false;
+    unsigned int codepoint = 0;
+    size_t char_len = encoding_utf8_decode(
+      (const unsigned char*)stop, end - stop, &codepoint
+    );
+    if (char_len == 0) {
+      if (strict)
+        return false;
+      text = stop + 1;
+      continue;
+    }
+    char replacement[16];
+    size_t replacement_len = encoding_fallback_text(mode, codepoint, replacement);
+    if (replacement_len > 0 && !encoding_conv_feed(
+      conv, replacement, replacement_len, false, false, out, NULL
+    ) && (errno == EFBIG || errno == ENOMEM))
+      return false;
+    ++*substitutions;
+    text = stop + char_len;
+    if (consumed)
+      *consumed = text;
+  }
+  return true;
+}
+
+#define HASH_SLICE_SIZE (64*1024)
+
+/*
+ * Converts the whole text and flushes the shift state. When hashes are asked
+ * the text goes through in slices, each one hashed right before and its
+ * output right after being converted, while both are still in the cache.
+*/
+static bool encoding_conv_hashed(
+  encoding_conv_t* conv, const char* text, size_t len, bool strict,
+  encoding_fallback_t fallback, bytes_t* out, const char** consumed,
+  size_t* substitutions, hash_state_t* input_hash, hash_state_t* output_hash
+) {
+  const char* end = text + len;
+  const char* hashed = text;
+  size_t output_hashed = out->size;
+  bool success;
+  do {
+    const char* stop = (input_hash || output_hash) && (size_t)(end - text) > HASH_SLICE_SIZE ?
+      text + HASH_SLICE_SIZE : end;
+    bool stream = stop < end;
+    if (input_hash && stop > hashed) {
+      hash_update(input_hash, hashed, stop - hashed);
+      hashed = stop;
+    }
+    const char* done = text;
+    success = fallback != FALLBACK_NONE ?
+      encoding_iconv_fallback(conv, text, stop - text, strict, stream, fallback, out, &done, substitutions) :
+      encoding_conv_feed(conv, text, stop - text, strict, stream, out, &done);
+    if (success && !stream)
+      success = encoding_conv_append(conv, NULL, 0, strict, out, NULL);
+    if (output_hash && out->size > output_hashed) {
+      hash_update(output_hash, out->data + output_hashed, out->size - output_hashed);
+      output_hashed = out->size;
+    }
+    if (consumed)
+      *consumed = done;
+    /* lenient conversions may leave the last invalid bytes behind */
+    text = stream ? done : end;
+  } while (success && text < end);
+  return success;
+}
+
+
+/*
+ * Unicode normalization to NFC or NFD. A quick check walks the text first,
+ * skipping ascii sixteen bytes at a time, and most text is found normalized
+ * already so it can be returned as it is. Otherwise only the spans around the
+ * characters that fail it go through canonical decomposition, reordering and
+ * composition for NFC, the rest is copied as it is.
+*/
+typedef enum {
+  NORMALIZE_NONE,
+  NORMALIZE_NFC,
+  NORMALIZE_NFD
+} encoding_normalize_t;
+
+static const char* const encoding_normalize_names[] = { "none", "NFC", "NFD", NULL };
+
+#define HANGUL_S_BASE 0xAC00
+#define HANGUL_L_BASE 0x1100
+#define HANGUL_V_BASE 0x1161
+#define HANGUL_T_BASE 0x11A7
+#define HANGUL_L_COUNT 19
+#define HANGUL_V_COUNT 21
+#define HANGUL_T_COUNT 28
+#define HANGUL_N_COUNT (HANGUL_V_COUNT * HANGUL_T_COUNT)
+#define HANGUL_S_COUNT (HANGUL_L_COUNT * HANGUL_N_COUNT)
+
+/* Bytes that are not valid utf8 are kept as they are with this flag. */
+#define NORMALIZE_RAW_BYTE 0x80000000u
+
+static unsigned char unicode_range_find(
+  const unicode_range_t* ranges, size_t count, unsigned int codepoint
+) {
+  size_t low = 0, high = count;
+  while (low < high) {
+    size_t mid = (low + high) / 2;
+    if (codepoint < ranges[mid].first)
+      high = mid;
+    else if (codepoint > ranges[mid].last)
+      low = mid + 1;
+    else
+      return ranges[mid].value;
+  }
+  return 0;
+}
+
+static unsigned char unicode_combining_class(unsigned int codepoint) {
+  if (codepoint < 0x300 || codepoint & NORMALIZE_RAW_BYTE)
+    return 0;
+  return unicode_range_find(
+    unicode_combining, sizeof(unicode_combining) / sizeof(unicode_range_t), codepoint
+  );
+}
+
+static const unicode_decomposition_t* unicode_find_decomposition(unsigned int codepoint) {
+  size_t low = 0, high = sizeof(unicode_decompositions) / sizeof(unicode_decomposition_t);
+  if (codepoint < 0xC0 || codepoint & NORMALIZE_RAW_BYTE)
+    return NULL;
+  while (low < high) {
+    size_t mid = (low + high) / 2;
+    if (unicode_decompositions[mid].codepoint == codepoint)
+      return &unicode_decompositions[mid];
+    if (unicode_decompositions[mid].codepoint < codepoint)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return NULL;
+}
+
+static unsigned int unicode_compose(unsigned int first, unsigned int second) {
+  if (first >= HANGUL_L_BASE && first < HANGUL_L_BASE + HANGUL_L_COUNT
+    && second >= HANGUL_V_BASE && second < HANGUL_V_BASE + HANGUL_V_COUNT)
+    return HANGUL_S_BASE + ((first - HANGUL_L_BASE) * HANGUL_V_COUNT
+      + (second - HANGUL_V_BASE)) * HANGUL_T_COUNT;
+  if (first >= HANGUL_S_BASE && first < HANGUL_S_BASE + HANGUL_S_COUNT
+    && (first - HANGUL_S_BASE) % HANGUL_T_COUNT == 0
+    && second > HANGUL_T_BASE && second < HANGUL_T_BASE + HANGUL_T_COUNT)
+    return first + (second - HANGUL_T_BASE);
+  size_t low = 0, high = sizeof(unicode_compositions) / sizeof(unicode_composition_t);
+  while (low < high) {
+    size_t mid = (low + high) / 2;
+    const unicode_composition_t* c = &unicode_compositions[mid];
+    if (c->first == first && c->second == second)
+      return c->composite;
+    if (c->first < first || (c->first == first && c->second < second))
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return 0;
+}
+
+/* Quick check result of a codepoint: 0 yes, 1 maybe, 2 no. */
+static int unicode_quick_check(encoding_normalize_t form, unsigned int codepoint) {
+  if (form == NORMALIZE_NFD) {
+    if (codepoint >= HANGUL_S_BASE && codepoint < HANGUL_S_BASE + HANGUL_S_COUNT)
+      return 2;
+    return unicode_find_decomposition(codepoint) ? 2 : 0;
+  }
+  if (codepoint < 0x300)
+    return 0;
+  return unicode_range_find(
+    unicode_nfc_quick_check,
+    sizeof(unicode_nfc_quick_check) / sizeof(unicode_range_t), codepoint
+  );
+}
+
+/* Next codepoint of the text, invalid bytes are returned flagged as raw. */
+static unsigned int encoding_next_codepoint(const char* text, size_t len, size_t* i) {
+  unsigned int codepoint = 0;
+  size_t size = encoding_utf8_decode((const unsigned char*)text + *i, len - *i, &codepoint);
+  if (size == 0 || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+    codepoint = NORMALIZE_RAW_BYTE | (unsigned char)text[*i];
+    size = 1;
+  }
+  *i += size;
+  return codepoint;
+}
+
+/*
+ * Tells if the utf8 text is already in the given normalization form, only
+ * texts with characters that may compose with the previous one are checked
+ * by normalizing them.
+*/
+static int encoding_is_normalized(encoding_normalize_t form, const char* text, size_t len) {
+  size_t i = 0;
+  unsigned char last_class = 0;
+  int result = 0;
+  while (i < len) {
+    if ((unsigned char)text[i] < 0x80) {
+      i += kernels.ascii_span((const unsigned char*)text + i, len - i);
+      last_class = 0;
+      continue;
+    }
+    unsigned int codepoint = encoding_next_codepoint(text, len, &i);
+    unsigned char class = unicode_combining_class(codepoint);
+    if (class != 0 && last_class > class)
+      return 2;
+    int check = unicode_quick_check(form, codepoint);
+    if (check == 2)
+      return 2;
+    if (check == 1)
+      result = 1;
+    last_class = class;
+  }
+  return result;
+}
+
+static bool normalize_push(unsigned int** buffer, size_t* count, size_t* capacity, unsigned int codepoint) {
+  if (*count == *capacity) {
+    size_t grown = *capacity ? *capacity * 2 : 256;
+    unsigned int* data = arena_realloc(
+      &encoding_arena, *buffer, *capacity * sizeof(unsigned int), grown * sizeof(unsigned int)
+    );
+    if (!data)
+      return false;
+    *buffer = data;
+    *capacity = grown;
+  }
+  (*buffer)[(*count)++] = codepoint;
+  return true;
+}
+
+static bool normalize_decompose(
+  unsigned int** buffer, size_t* count, size_t* capacity, unsigned int codepoint
+) {
+  if (codepoint >= HANGUL_S_BASE && codepoint < HANGUL_S_BASE + HANGUL_S_COUNT) {
+    unsigned int index = codepoint - HANGUL_S_BASE;
+    unsigned int trail = index % HANGUL_T_COUNT;
+    return normalize_push(buffer, count, capacity, HANGUL_L_BASE + index / HANGUL_N_COUNT)
+      && normalize_push(buffer, count, capacity, HANGUL_V_BASE + (index % HANGUL_N_COUNT) / HANGUL_T_COUNT)
+      && (trail == 0 || normalize_push(buffer, count, capacity, HANGUL_T_BASE + trail));
+  }
+  const unicode_decomposition_t* decomposition = unicode_find_decomposition(codepoint);
+  if (!decomposition)
+    return normalize_push(buffer, count, capacity, codepoint);
+  for (size_t i = 0; i < decomposition->length; ++i) {
+    if (!normalize_decompose(
+      buffer, count, capacity, unicode_decomposition_pool[decomposition->index + i]
+    ))
+      return false;
+  }
+  return true;
+}
+
+/*
+ * Normalizes a span of utf8 text appending it to out, the codepoints go
+ * through buffer which is kept between spans.
+*/
+static bool normalize_span(
+  encoding_normalize_t form, const char* text, size_t len, bytes_t* out,
+  unsigned int** codepoints, size_t* capacity
+) {
+  unsigned int* buffer = *codepoints;
+  size_t count = 0;
+  bool decomposed = true;
+  for (size_t i = 0; i < len && decomposed;)
+    decomposed = normalize_decompose(&buffer, &count, capacity, encoding_next_codepoint(text, len, &i));
+  *codepoints = buffer;
+  if (!decomposed)
+    return false;
+  /* canonical ordering of combining marks, runs are short */
+  for (size_t i = 1; i < count; ++i) {
+    unsigned char class = unicode_combining_class(buffer[i]);
+    if (class == 0)
+      continue;
+    for (size_t j = i; j > 0; --j) {
+      unsigned char previous = unicode_combining_class(buffer[j - 1]);
+      if (previous <= class)
+        break;
+      unsigned int swap = buffer[j];
+      buffer[j] = buffer[j - 1];
+      buffer[j - 1] = swap;
+    }
+  }
+  if (form == NORMALIZE_NFC && count > 0) {
+    size_t starter = 0, written = 1;
+    unsigned int last_class = unicode_combining_class(buffer[0]) ? 256 : 0;
+    for (size_t i = 1; i < count; ++i) {
+      unsigned int codepoint = buffer[i];
+      unsigned int class = unicode_combining_class(codepoint);
+      unsigned int composite = codepoint & NORMALIZE_RAW_BYTE ? 0 :
+        unicode_compose(buffer[starter], codepoint);
+      if (composite && (last_class < class || last_class == 0)) {
+        buffer[starter] = composite;
+        continue;
+      }
+      if (class == 0)
+        starter = written;
+      last_class = class;
+      buffer[written++] = codepoint;
+    }
+    count = written;
+  }
+  if (!bytes_reserve(out, count * 4))
+    return false;
+  for (size_t i = 0; i < count; ++i) {
+    unsigned int c = buffer[i];
+    unsigned char* p = (unsigned char*)out->data + out->size;
+    if (c & NORMALIZE_RAW_BYTE) {
+      p[0] = c & 0xFF;
+      out->size += 1;
+    } else {
+      out->size += encoding_utf8_encode(c, p);
+    }
+  }
+  return true;
+}
+
+/* Appends text unchanged to out. */
+static bool normalize_copy(const char* text, size_t len, bytes_t* out) {
+  if (len == 0)
+    return true;
+  if (!bytes_reserve(out, len))
+    return false;
+  memcpy(out->data + out->size, text, len);
+  out->size += len;
+  return true;
+}
+
+/* Starters that never combine with what is before them split the text. */
+static bool normalize_is_boundary(encoding_normalize_t form, unsigned int codepoint) {
+  return unicode_combining_class(codepoint) == 0 && unicode_quick_check(form, codepoint) == 0;
+}
+
+/*
+ * Normalizes utf8 text into out, allocating the temporaries on the arena. Only
+ * the spans around the characters the quick check doesn't pass, from the
+ * boundary before them to the one after, are normalized, the rest is copied.
+*/
+static bool encoding_normalize(
+  encoding_normalize_t form, const char* text, size_t len, bytes_t* out
+) {
+  unsigned int* buffer = NULL;
+  size_t capacity = 0, copied = 0, boundary = 0, i = 0;
+  unsigned char last_class = 0;
+  while (i < len) {
+    if ((unsigned char)text[i] < 0x80) {
+      i += kernels.ascii_span((const unsigned char*)text + i, len - i);
+      boundary = i - 1;
+      last_class = 0;
+      continue;
+    }
+    size_t start = i;
+    unsigned int codepoint = encoding_next_codepoint(text, len, &i);
+    unsigned char class = unicode_combining_class(codepoint);
+    int check = unicode_quick_check(form, codepoint);
+    if (check == 0 && (class == 0 || last_class <= class)) {
+      if (class == 0)
+        boundary = start;
+      last_class = class;
+      continue;
+    }
+    size_t end = i;
+    while (end < len && (unsigned char)text[end] >= 0x80) {
+      size_t next = end;
+      if (normalize_is_boundary(form, encoding_next_codepoint(text, len, &next)))
+        break;
+      end = next;
+    }
+    if (!normalize_copy(text + copied, boundary - copied, out)
+      || !normalize_span(form, text + boundary, end - boundary, out, &buffer, &capacity))
+      return false;
+    copied = boundary = i = end;
+    last_class = 0;
+  }
+  return normalize_copy(text + copied, len - copied, out);
+}
+
+/*
+ * Normalizes text unless it already is, result points to text itself or to
+ * the normalized copy in the arena.
+*/
+static bool encoding_normalize_text(
+  encoding_normalize_t form, const char* text, size_t len,
+  const char** result, size_t* result_len
+) {
+  *result = text;
+  *result_len = len;
+  int check = encoding_is_normalized(form, text, len);
+  if (check == 0)
+    return true;
+  bytes_t out = { NULL, 0, 0, &encoding_arena, 0 };
+  if (!encoding_normalize(form, text, len, &out))
+    return false;
+  if (check == 1 && out.size == len && memcmp(out.data, text, len) == 0)
+    return true;
+  *result = out.data ? out.data : "";
+  *result_len = out.size;
+  return true;
+}
+
+static encoding_normalize_t encoding_check_normalize(lua_State* L, int idx) {
+  const char* name = luaL_optstring(L, idx, "none");
+  for (int i = 0; encoding_normalize_names[i]; ++i) {
+    if (encoding_charset_equal(encoding_normalize_names[i], name))
+      return i;
+  }
+  luaL_error(L, "invalid normalization form '%s'", name);
+  return NORMALIZE_NONE;
+}
+
+/*
+ * Reads the hash option at idx, a table which input and output fields ask
+ * for the hash of the raw input and of the converted output.
+*/
+static void encoding_check_hashes(
+  lua_State* L, int idx, hash_state_t* input, hash_state_t* output,
+  hash_state_t** input_hash, hash_state_t** output_hash
+) {
+  *input_hash = *output_hash = NULL;
+  if (lua_isnil(L, idx))
+    return;
+  idx = lua_absindex(L, idx);
+  luaL_checktype(L, idx, LUA_TTABLE);
+  lua_getfield(L, idx, "input");
+  if (lua_toboolean(L, -1)) {
+    hash_init(input, 0);
+    *input_hash = input;
+  }
+  lua_getfield(L, idx, "output");
+  if (lua_toboolean(L, -1)) {
+    hash_init(output, 0);
+    *output_hash = output;
+  }
+  lua_pop(L, 2);
+}
+
+/* Pushes a table with the input and output digests of the hashes asked for. */
+static void encoding_push_hashes(
+  lua_State* L, const hash_state_t* input_hash, const hash_state_t* output_hash
+) {
+  lua_createtable(L, 0, 2);
+  if (input_hash) {
+    lua_pushinteger(L, (lua_Integer)hash_digest(input_hash));
+    lua_setfield(L, -2, "input");
+  }
+  if (output_hash) {
+    lua_pushinteger(L, (lua_Integer)hash_digest(output_hash));
+    lua_setfield(L, -2, "output");
+  }
+}
+
+
+/* Name of the userdata metatable of encoding.buffer */
+#define BUFFER_METATABLE "encoding.buffer"
+
+/*
+ * Growable byte array, views share the bytes of their parent buffer and keep
+ * it alive through their user value.
+*/
+typedef struct encoding_buffer_s {
+  char* data;
+  size_t size;
+  size_t capacity;
+  struct encoding_buffer_s* parent;
+  size_t offset;
+  size_t length;
+} encoding_buffer_t;
+
+static const char* encoding_buffer_bytes(const encoding_buffer_t* buffer, size_t* len) {
+  if (!buffer->parent) {
+    *len = buffer->size;
+    return buffer->data ? buffer->data : "";
+  }
+  const encoding_buffer_t* parent = buffer->parent;
+  size_t offset = buffer->offset < parent->size ? buffer->offset : parent->size;
+  *len = parent->size - offset < buffer->length ? parent->size - offset : buffer->length;
+  return parent->data ? parent->data + offset : "";
+}
+
+static bool encoding_buffer_reserve(encoding_buffer_t* buffer, size_t capacity) {
+  if (capacity <= buffer->capacity)
+    return true;
+  if (capacity < buffer->capacity * 2)
+    capacity = buffer->capacity * 2;
+  char* data = realloc(buffer->data, capacity);
+  if (!data)
+    return false;
+  buffer->data = data;
+  buffer->capacity = capacity;
+  return true;
+}
+
+/* Returns the bytes of either a string or an encoding.buffer argument. */
+static const char* encoding_checkbytes(lua_State* L, int idx, size_t* len) {
+  encoding_buffer_t* buffer = luaL_testudata(L, idx, BUFFER_METATABLE);
+  if (buffer)
+    return encoding_buffer_bytes(buffer, len);
+  if (lua_type(L, idx) != LUA_TSTRING && lua_type(L, idx) != LUA_TNUMBER)
+    luaL_typeerror(L, idx, "string or encoding.buffer");
+  return lua_tolstring(L, idx, len);
+}
+
+
+/*
+ * encoding.detect(string)
+ *
+ * Detects a string's encoding.
+ *
+ * Arguments:
+ *  string, the string or encoding.buffer to check
+ *  options, a table with the following fields:
+ *    candidates, return up to this amount of ranked candidates instead
+ *    engines, list of "bom", "utf8", "ebcdic" and "uchardet" to run in order
+ *      instead of all of them
+ *
+ * Returns:
+ *  The charset string, the list of candidates or nil
+ *  Whether a BOM was present, or the error message
+ */
+int f_detect(lua_State *L) {
+  size_t string_len = 0;
+  const char* string = encoding_checkbytes(L, 1, &string_len);
+  return encoding_push_detection(L, string, string_len, 2);
+}
+
+
+/* Soft cap in bytes of the output of each conversion call, 0 means unlimited. */
+static size_t encoding_max_output = 0;
+
+/*
+ * encoding.convert(tocharset, fromcharset, text, options)
+ *
+ * Convert the given text from one charset into another if possible.
+ *
+ * Arguments:
+ *  tocharset, a string representing a valid iconv charset
+ *  fromcharset, a string representing a valid iconv charset
+ *  text, the string or encoding.buffer to convert
+ *  options, a table of conversion options
+ *    strict, fail on invalid input instead of skipping it
+ *    output, an encoding.buffer which contents are replaced by the result
+ *    max_output, maximum size in bytes of the result, overrides the global cap
+ *    partial, return the output converted until max_output was reached
+ *    handle_from_bom, skip the bom of fromcharset if the text starts with it
+ *    handle_to_bom, start the output with the bom of tocharset if any
+ *    on_unencodable, "translit", "entity" or "replace" characters that can't
+ *      be encoded instead of failing, only when converting from utf8
+ *    normalize, "NFC" or "NFD" to normalize the result when converting to utf8
+ *    hash, a table with input and output fields set to true to compute the
+ *      XXH64 of the raw input and of the result along the conversion
+ *
+ * Returns:
+ *  The converted ouput string (or the output buffer) or nil
+ *  The error message, or the amount of substitutions when on_unencodable set
+ *  When partial, the amount of input bytes consumed if the limit was reached,
+ *  otherwise when hash was given a table with the input and output digests
+ */
+int f_convert(lua_State *L) {
+  const char* to = luaL_checkstring(L, 1);
+  const char* from = luaL_checkstring(L, 2);
+  size_t text_len = 0;
+  const char* text = encoding_checkbytes(L, 3, &text_len);
+  const char* input = text;
+  /* conversion options */
+  bool strict = false;
+  bool partial = false;
+  bool handle_to_bom = false;
+  bool handle_from_bom = false;
+  encoding_fallback_t fallback = FALLBACK_NONE;
+  size_t substitutions = 0;
+  encoding_normalize_t normalize = NORMALIZE_NONE;
+  size_t max_output = encoding_max_output;
+  encoding_buffer_t* output = NULL;
+  hash_state_t input_state, output_state;
+  hash_state_t* input_hash = NULL;
+  hash_state_t* output_hash = NULL;
+
+  if (lua_gettop(L) > 3 && lua_istable(L, 4)) {
+    lua_getfield(L, 4, "strict");
+    if (lua_isboolean(L, -1))
+      strict = lua_toboolean(L, -1);
+    lua_getfield(L, 4, "partial");
+    partial = lua_toboolean(L, -1);
+    lua_getfield(L, 4, "handle_to_bom");
+    handle_to_bom = lua_toboolean(L, -1);
+    lua_getfield(L, 4, "handle_from_bom");
+    handle_from_bom = lua_toboolean(L, -1);
+    lua_getfield(L, 4, "on_unencodable");
+    const char* fallback_name = luaL_optstring(L, -1, "none");
+    while (encoding_fallback_names[fallback] && strcmp(encoding_fallback_names[fallback], fallback_name))
+      fallback++;
+    if (!encoding_fallback_names[fallback])
+      return luaL_error(L, "invalid on_unencodable option '%s'", fallback_name);
+    lua_getfield(L, 4, "normalize");
+    normalize = encoding_check_normalize(L, -1);
+    lua_getfield(L, 4, "max_output");
+    max_output = luaL_optinteger(L, -1, max_output);
+    lua_getfield(L, 4, "hash");
+    encoding_check_hashes(L, -1, &input_state, &output_state, &input_hash, &output_hash);
+    lua_getfield(L, 4, "output");
+    if (!lua_isnil(L, -1)) {
+      output = luaL_checkudata(L, -1, BUFFER_METATABLE);
+      if (output->parent)
+        return luaL_error(L, "can't write into a buffer view");
+      if (output->data && text >= output->data && text < output->data + output->capacity)
+        return luaL_error(L, "the output buffer can't be the input");
+    }
+  }
+  /* boms are skipped and written in the same pass as the conversion */
+  size_t from_bom_len = 0, to_bom_len = 0;
+  if (handle_from_bom) {
+    const char* bom = encoding_bom_from_charset(from, &from_bom_len);
+    if (from_bom_len > text_len || memcmp(text, bom, from_bom_len) != 0)
+      from_bom_len = 0;
+    text += from_bom_len;
+    text_len -= from_bom_len;
+  }
+  if (input_hash)
+    hash_update(input_hash, input, from_bom_len);
+  const char* to_bom = handle_to_bom ? encoding_bom_from_charset(to, &to_bom_len) : NULL;
+  /* fail before allocating anything if even the smallest output is too big */
+  size_t from_min, from_max, to_min, to_max;
+  charset_char_bounds(charset_from_name(from), &from_min, &from_max);
+  charset_char_bounds(charset_from_name(to), &to_min, &to_max);
+  size_t least = (text_len / from_max) * to_min + to_bom_len;
+  size_t most = (text_len / from_min + 1) * to_max + to_bom_len + 16;
+  if (max_output && least > max_output && !partial) {
+    lua_pushnil(L);
+    lua_pushfstring(L, "output would take at least %I bytes, over the limit of %I bytes",
+      (lua_Integer)least, (lua_Integer)max_output);
+    return 2;
+  }
+  encoding_conv_t conv;
+  if (!encoding_conv_open(&conv, to, from, true)) {
+    lua_pushnil(L);
+    lua_pushstring(L, strerror(errno));
+    return 2;
+  }
+  arena_reset(&encoding_arena);
+  bytes_t out = { NULL, 0, 0, &encoding_arena, max_output };
+  if (output) {
+    /* the room already in the buffer counts against the limit too */
+    out.data = output->data;
+    out.capacity = max_output && output->capacity > max_output ? max_output : output->capacity;
+    out.arena = NULL;
+  }
+  /* reserve the worst case at once when small enough so the output never
+     has to be moved, otherwise start from the input size and grow */
+  size_t estimate = (max_output && most > max_output) ? max_output : most;
+  if (estimate > text_len * 2 + 16)
+    estimate = text_len + 16;
+  const char* consumed = text;
+  bool success = bytes_reserve(&out, estimate);
+  if (success && to_bom_len > 0) {
+    if (max_output && to_bom_len > max_output) {
+      success = false;
+      errno = EFBIG;
+    } else {
+      memcpy(out.data, to_bom, to_bom_len);
+      out.size = to_bom_len;
+      if (output_hash)
+        hash_update(output_hash, to_bom, to_bom_len);
+    }
+  }
+  /* replacing unencodable characters needs to know what they are */
+  if (fallback != FALLBACK_NONE && charset_from_name(from)->kind != CHARSET_UTF8)
+    fallback = FALLBACK_NONE;
+  success = success && encoding_conv_hashed(
+    &conv, text, text_len, strict, fallback, &out, &consumed, &substitutions,
+    input_hash, output_hash
+  );
+  int error = errno;
+  encoding_conv_close(&conv);
+  bool truncated = !success && error == EFBIG && partial;
+  /* normalizing decoded text, the arena keeps both copies until pushed */
+  const char* result = out.data ? out.data : "";
+  size_t result_len = out.size;
+  if (success && normalize != NORMALIZE_NONE && charset_from_name(to)->kind == CHARSET_UTF8) {
+    success = encoding_normalize_text(normalize, result, result_len, &result, &result_len)
+      && (!max_output || result_len <= max_output);
+    if (success && output_hash && result != out.data) {
+      hash_init(output_hash, 0);
+      hash_update(output_hash, result, result_len);
+    }
+    if (success && output && result != out.data) {
+      out.size = 0;
+      success = bytes_reserve(&out, result_len);
+      if (success) {
+        memcpy(out.data, result, result_len);
+        out.size = result_len;
+      }
+    }
+    if (!success)
+      error = max_output && result_len > max_output ? EFBIG : ENOMEM;
+  }
+  if (output) {
+    if (out.data != output->data || out.capacity > output->capacity)
+      output->capacity = out.capacity;
+    output->data = out.data;
+    output->size = success || truncated ? out.size : 0;
+  }
+  if (!success && !truncated) {
+    arena_reset(&encoding_arena);
+    lua_pushnil(L);
+    if (error == EFBIG)
+      lua_pushfstring(L, "output limit of %I bytes reached", (lua_Integer)max_output);
+    else
+      lua_pushstring(L, error == ENOMEM ? "out of memory" : "illegal multibyte sequence");
+    return 2;
+  }
+  if (output)
+    lua_getfield(L, 4, "output");
+  else
+    lua_pushlstring(L, result, result_len);
+  arena_reset(&encoding_arena);
+  if (truncated) {
+    lua_pushfstring(L, "output limit of %I bytes reached", (lua_Integer)max_output);
+    lua_pushinteger(L, consumed - input);
+    return 3;
+  }
+  if (input_hash || output_hash) {
+    if (fallback != FALLBACK_NONE)
+      lua_pushinteger(L, substitutions);
+    else
+      lua_pushnil(L);
+    encoding_push_hashes(L, input_hash, output_hash);
+    return 3;
+  }
+  if (fallback != FALLBACK_NONE) {
+    lua_pushinteger(L, substitutions);
+    return 2;
+  }
+  return 1;
+}
+
+
+/*
+ * Snapshots of decoded documents so that reopening a large file which didn't
+ * change skips the conversion. A snapshot holds a header describing the file
+ * it was decoded from, the offset of every line and the utf8 text of the lines
+ * as lite-xl stores them. It is written in native byte order and read back
+ * through a memory map. Snapshots live in a directory bounded in size, where
+ * the least recently used ones are evicted first.
+*/
+#define SNAPSHOT_MAGIC "LXESNAP\0"
+#define SNAPSHOT_VERSION 3
+#define SNAPSHOT_EXTENSION ".snap"
+
+typedef struct {
+  char magic[8];
+  unsigned long long version;
+  unsigned long long source_size;
+  long long source_mtime;
+  unsigned long long source_hash;
+  unsigned long long line_count;
+  unsigned long long text_size;
+  char charset[CHARSET_NAME_MAX];
+  unsigned char bom;
+  unsigned char crlf;
+  unsigned char normalize;
+  unsigned char reserved[5];
+} snapshot_header_t;
+
+static char* snapshot_dir = NULL;
+static size_t snapshot_max_size = 512*1024*1024;
+static size_t snapshot_hits = 0;
+static size_t snapshot_writes = 0;
+
+/*
+ * Fingerprint of a file's content, the XXH64 of all of it. Writing a snapshot
+ * takes it from the decoding pass, checking one hashes at memory speed after
+ * the size and modification time matched.
+*/
+static unsigned long long encoding_snapshot_hash(const char* data, size_t size) {
+  return encoding_hash64(data, size, 0);
+}
+
+/* Path of the snapshot of filename, to be freed by the caller. */
+static char* encoding_snapshot_path(const char* filename) {
+  if (!snapshot_dir)
+    return NULL;
+  size_t len = strlen(snapshot_dir);
+  char* path = malloc(len + 32);
+  if (!path)
+    return NULL;
+  unsigned long long key = encoding_hash64(filename, strlen(filename), 0);
+  snprintf(
+    path, len + 32, "%s%c%016llx" SNAPSHOT_EXTENSION, snapshot_dir,
+#ifdef _WIN32
+    '\\',
+#else
+    '/',
+#endif
+    key
+  );
+  return path;
+}
+
+typedef struct {
+  char* path;
+  unsigned long long size;
+  long long mtime;
+} snapshot_entry_t;
+
+static int snapshot_entry_compare(const void* a, const void* b) {
+  long long ma = ((const snapshot_entry_t*)a)->mtime;
+  long long mb = ((const snapshot_entry_t*)b)->mtime;
+  return ma < mb ? -1 : ma > mb;
+}
+
+static bool snapshot_entry_add(
+  snapshot_entry_t** entries, size_t* count, size_t* capacity,
+  const char* name, unsigned long long size, long long mtime
+) {
+  size_t name_len = strlen(name);
+  size_t ext_len = sizeof(SNAPSHOT_EXTENSION) - 1;
+  if (name_len <= ext_len || strcmp(name + name_len - ext_len, SNAPSHOT_EXTENSION) != 0)
+    return true;
+  if (*count == *capacity) {
+    size_t grown_capacity = *capacity ? *capacity * 2 : 64;
+    snapshot_entry_t* grown = realloc(*entries, grown_capacity * sizeof(snapshot_entry_t));
+    if (!grown)
+      return false;
+    *entries = grown;
+    *capacity = grown_capacity;
+  }
+  size_t dir_len = strlen(snapshot_dir);
+  char* path = malloc(dir_len + name_len + 2);
+  if (!path)
+    return false;
+  memcpy(path, snapshot_dir, dir_len);
+#ifdef _WIN32
+  path[dir_len] = '\\';
+#else
+  path[dir_len] = '/';
+#endif
+  memcpy(path + dir_len + 1, name, name_len + 1);
+  (*entries)[*count].path = path;
+  (*entries)[*count].size = size;
+  (*entries)[*count].mtime = mtime;
+  (*count)++;
+  return true;
+}
+
+/* Deletes the least recently used snapshots until they fit the size limit. */
+static void encoding_snapshot_evict() {
+  if (!snapshot_dir)
+    return;
+  snapshot_entry_t* entries = NULL;
+  size_t count = 0, capacity = 0;
+  unsigned long long total = 0;
+#ifdef _WIN32
+  size_t dir_len = strlen(snapshot_dir);
+  char* pattern = malloc(dir_len + 3);
+  if (!pattern)
+    return;
+  memcpy(pattern, snapshot_dir, dir_len);
+  strcpy(pattern + dir_len, "\\*");
+  wchar_t* wide = encoding_wide_path(pattern);
+  free(pattern);
+  WIN32_FIND_DATAW data;
+  HANDLE find = wide ? FindFirstFileW(wide, &data) : INVALID_HANDLE_VALUE;
+  free(wide);
+  if (find == INVALID_HANDLE_VALUE)
+    return;
+  do {
+    char name[MAX_PATH * 4];
+    if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+      continue;
+    if (!WideCharToMultiByte(CP_UTF8, 0, data.cFileName, -1, name, sizeof(name), NULL, NULL))
+      continue;
+    unsigned long long size = ((unsigned long long)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+    long long mtime = ((long long)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+    if (!snapshot_entry_add(&entries, &count, &capacity, name, size, mtime))
+      break;
+  } while (FindNextFileW(find, &data));
+  FindClose(find);
+#else
+  DIR* dir = opendir(snapshot_dir);
+  if (!dir)
+    return;
+  struct dirent* entry;
+  while ((entry = readdir(dir))) {
+    size_t before = count;
+    if (!snapshot_entry_add(&entries, &count, &capacity, entry->d_name, 0, 0))
+      break;
+    struct stat st;
+    if (count > before) {
+      if (stat(entries[before].path, &st) == 0 && S_ISREG(st.st_mode)) {
+        entries[before].size = st.st_size;
+        entries[before].mtime = st.st_mtime;
+      } else {
+        free(entries[--count].path);
+      }
+    }
+  }
+  closedir(dir);
+#endif
+  for (size_t i = 0; i < count; ++i)
+    total += entries[i].size;
+  qsort(entries, count, sizeof(snapshot_entry_t), snapshot_entry_compare);
+  for (size_t i = 0; i < count; ++i) {
+    if (total > snapshot_max_size && encoding_remove(entries[i].path))
+      total -= entries[i].size;
+    free(entries[i].path);
+  }
+  free(entries);
+}
+
+/*
+ * Prefetching. Files likely to be opened next are detected and decoded ahead
+ * of time by worker threads, so loading one of them only has to split its
+ * text into lines. Requests are served by priority and the decoded texts are
+ * kept under a memory budget, evicting the least recently requested first.
+*/
+#define PREFETCH_MAX_ENTRIES 256
+#define PREFETCH_THREADS 2
+
+typedef enum {
+  PREFETCH_PENDING,
+  PREFETCH_RUNNING,
+  PREFETCH_DONE
+} prefetch_state_t;
+
+typedef struct prefetch_entry_s {
+  struct prefetch_entry_s* next;    /* most recently requested first */
+  prefetch_state_t state;
+  int priority;
+  bool dropped;                     /* removed while running, the worker frees it */
+  char charset[CHARSET_NAME_MAX];   /* empty until detected unless given */
+  bool bom;
+  const char* error;                /* why the file couldn't be decoded */
+  unsigned long long size;          /* of the file when decoded */
+  long long mtime;
+  unsigned long long hash;
+  char* text;
+  size_t text_len;
+  char path[];
+} prefetch_entry_t;
+
+static mutex_t prefetch_mutex;
+static cond_t prefetch_cond;        /* new requests and finished decodings */
+static thread_t prefetch_workers[PREFETCH_THREADS];
+static int prefetch_worker_count = 0;
+static prefetch_entry_t* prefetch_entries = NULL;
+static size_t prefetch_count = 0;
+static size_t prefetch_memory = 0;
+static size_t prefetch_max_memory = 64*1024*1024;
+static size_t prefetch_max_size = 4*1024*1024;
+static size_t prefetch_hits = 0;
+static size_t prefetch_misses = 0;
+
+static void prefetch_entry_free(prefetch_entry_t* entry) {
+  free(entry->text);
+  free(entry);
+}
+
+/* Finds the link pointing to the entry of path, with the mutex held. */
+static prefetch_entry_t** prefetch_find(const char* path) {
+  prefetch_entry_t** link = &prefetch_entries;
+  while (*link && strcmp((*link)->path, path) != 0)
+    link = &(*link)->next;
+  return link;
+}
+
+/* Takes an entry out of the list, with the mutex held. */
+static prefetch_entry_t* prefetch_unlink(prefetch_entry_t** link) {
+  prefetch_entry_t* entry = *link;
+  *link = entry->next;
+  entry->next = NULL;
+  prefetch_count--;
+  prefetch_memory -= entry->text_len;
+  return entry;
+}
+
+/* Drops the least recently requested entries past the budget, mutex held. */
+static void prefetch_evict() {
+  while (prefetch_count > 0
+    && (prefetch_memory > prefetch_max_memory || prefetch_count > PREFETCH_MAX_ENTRIES)) {
+    prefetch_entry_t** link = &prefetch_entries;
+    while ((*link)->next)
+      link = &(*link)->next;
+    prefetch_entry_t* entry = prefetch_unlink(link);
+    if (entry->state == PREFETCH_RUNNING)
+      entry->dropped = true;
+    else
+      prefetch_entry_free(entry);
+  }
+}
+
+static void catalogue_configure(lua_State* L, int idx);
+
+/*
+ * encoding.configure(options)
+ *
+ * Change the global settings of the library.
+ *
+ * Arguments:
+ *  options, a table with any of the following fields:
+ *    max_output, soft cap in bytes of the output of each conversion, 0 to disable
+ *    backend, "auto" to benchmark each charset pair on first use and keep the
+ *      fastest of iconv and native, or "iconv", "system" or "native" to prefer
+ *      that one, the C library iconv only runs when "system" is asked for
+ *    backend_cache, file where the backend chosen for each pair is kept
+ *    snapshot_dir, existing directory where decoded snapshots are kept
+ *    snapshot_max_size, total size in bytes the snapshots can take, the least
+ *      recently used are deleted past it, 0 to stop taking snapshots
+ *    prefetch_memory, bytes the prefetched documents can take, the least
+ *      recently requested are dropped past it
+ *    prefetch_max_size, files bigger than this are not prefetched
+ *    known_groups, list of region names of the charsets known by name
+ *    known_charsets, list for each of those regions of its charsets, tables
+ *      with charset and name, listed first by encoding.charsets()
+ *
+ * Returns:
+ *  A table with the current settings
+ */
+int f_configure(lua_State *L) {
+  if (lua_istable(L, 1)) {
+    lua_getfield(L, 1, "max_output");
+    if (!lua_isnil(L, -1)) {
+      lua_Integer max_output = luaL_checkinteger(L, -1);
+      luaL_argcheck(L, max_output >= 0, 1, "max_output can't be negative");
+      encoding_max_output = max_output;
+    }
+    lua_getfield(L, 1, "backend");
+    if (!lua_isnil(L, -1)) {
+      const char* name = luaL_checkstring(L, -1);
+      encoding_backend_t backend = BACKEND_ICONV;
+      while (encoding_backend_names[backend] && strcmp(encoding_backend_names[backend], name))
+        backend++;
+      if (!encoding_backend_names[backend])
+        return luaL_error(L, "invalid backend '%s'", name);
+      encoding_backend_mode = backend;
+    }
+    lua_getfield(L, 1, "backend_cache");
+    if (!lua_isnil(L, -1)) {
+      const char* path = luaL_checkstring(L, -1);
+      char* copy = malloc(strlen(path) + 1);
+      if (copy) {
+        strcpy(copy, path);
+        encoding_backend_load(copy);
+      }
+      free(backend_cache_path);
+      backend_cache_path = copy;
+    }
+    lua_getfield(L, 1, "snapshot_max_size");
+    if (!lua_isnil(L, -1)) {
+      lua_Integer max_size = luaL_checkinteger(L, -1);
+      luaL_argcheck(L, max_size >= 0, 1, "snapshot_max_size can't be negative");
+      snapshot_max_size = max_size;
+    }
+    lua_getfield(L, 1, "snapshot_dir");
+    if (!lua_isnil(L, -1)) {
+      const char* dir = luaL_checkstring(L, -1);
+      char* copy = malloc(strlen(dir) + 1);
+      if (copy)
+        strcpy(copy, dir);
+      free(snapshot_dir);
+      snapshot_dir = copy;
+    }
+    lua_getfield(L, 1, "prefetch_memory");
+    if (!lua_isnil(L, -1)) {
+      lua_Integer memory = luaL_checkinteger(L, -1);
+      luaL_argcheck(L, memory >= 0, 1, "prefetch_memory can't be negative");
+      mutex_lock(&prefetch_mutex);
+      prefetch_max_memory = memory;
+      prefetch_evict();
+      mutex_unlock(&prefetch_mutex);
+    }
+    lua_getfield(L, 1, "prefetch_max_size");
+    if (!lua_isnil(L, -1)) {
+      lua_Integer max_size = luaL_checkinteger(L, -1);
+      luaL_argcheck(L, max_size >= 0, 1, "prefetch_max_size can't be negative");
+      prefetch_max_size = max_size;
+    }
+    lua_pop(L, 7);
+    catalogue_configure(L, 1);
+    encoding_snapshot_evict();
+  }
+  lua_createtable(L, 0, 7);
+  lua_pushinteger(L, encoding_max_output);
+  lua_setfield(L, -2, "max_output");
+  lua_pushstring(L, encoding_backend_names[encoding_backend_mode]);
+  lua_setfield(L, -2, "backend");
+  if (backend_cache_path) {
+    lua_pushstring(L, backend_cache_path);
+    lua_setfield(L, -2, "backend_cache");
+  }
+  if (snapshot_dir) {
+    lua_pushstring(L, snapshot_dir);
+    lua_setfield(L, -2, "snapshot_dir");
+  }
+  lua_pushinteger(L, snapshot_max_size);
+  lua_setfield(L, -2, "snapshot_max_size");
+  lua_pushinteger(L, prefetch_max_memory);
+  lua_setfield(L, -2, "prefetch_memory");
+  lua_pushinteger(L, prefetch_max_size);
+  lua_setfield(L, -2, "prefetch_max_size");
+  return 1;
+}
+
+
+/*
+ * encoding.bom(charset)
+ *
+ * Retrieve the byte order marks sequence for the given charset if applicable.
+ *
+ * Arguments:
+ *  charset, a string representing a valid iconv charset
+ *
+ * Returns:
+ *  The bom sequence string or empty string if not applicable.
+ */
+int f_bom(lua_State *L) {
+  size_t bom_len = 0;
+  const char* bom = encoding_bom_from_charset(luaL_checkstring(L, 1), &bom_len);
+  lua_pushlstring(L, bom, bom_len);
+  return 1;
+}
+
+
+/*
+ * encoding.strip_bom(text, charset)
+ *
+ * Finds the byte order marks at the start of the text without copying it.
+ *
+ * Arguments:
+ *  text, the string or encoding.buffer to check
+ *  charset, only look for the bom of this charset, all if not given
+ *
+ * Returns:
+ *  The length of the bom found, where the content starts, or 0 if none
+ *  The charset of the bom found, or nil
+ */
+int f_strip_bom(lua_State *L) {
+  size_t len = 0, bom_len = 0;
+  const char* text = encoding_checkbytes(L, 1, &len);
+  const char* charset = luaL_optstring(L, 2, NULL);
+  if (charset) {
+    const char* bom = encoding_bom_from_charset(charset, &bom_len);
+    if (bom_len == 0 || bom_len > len || memcmp(text, bom, bom_len) != 0)
+      charset = NULL;
+  } else {
+    charset = encoding_charset_from_bom(text, len, &bom_len);
+  }
+  lua_pushinteger(L, charset ? bom_len : 0);
+  if (charset)
+    lua_pushstring(L, charset);
+  else
+    lua_pushnil(L);
+  return 2;
+}
+
+
+/*
+ * encoding.normalize(text, form)
+ *
+ * Normalizes utf8 text to the given unicode normalization form, text which
+ * already is normalized is returned as it is without copying it.
+ *
+ * Arguments:
+ *  text, the utf8 string or encoding.buffer to normalize
+ *  form, "NFC" or "NFD"
+ *
+ * Returns:
+ *  The normalized text, the given one when nothing changed
+ *  True if the text was changed
+ */
+int f_normalize(lua_State *L) {
+  size_t len = 0, result_len = 0;
+  const char* text = encoding_checkbytes(L, 1, &len);
+  encoding_normalize_t form = encoding_check_normalize(L, 2);
+  luaL_argcheck(L, form != NORMALIZE_NONE, 2, "expected NFC or NFD");
+  const char* result = text;
+  arena_reset(&encoding_arena);
+  if (!encoding_normalize_text(form, text, len, &result, &result_len))
+    return luaL_error(L, "out of memory");
+  if (result == text)
+    lua_pushvalue(L, 1);
+  else
+    lua_pushlstring(L, result, result_len);
+  arena_reset(&encoding_arena);
+  lua_pushboolean(L, result != text);
+  return 2;
+}
+
+
+/* Name of the userdata metatable of encoding.converter */
+#define CONVERTER_METATABLE "encoding.converter"
+
+/* A conversion that keeps its shift state from one chunk to the next. */
+typedef struct {
+  encoding_conv_t conv;
+  bool open;
+  bool strict;
+  encoding_fallback_t fallback;
+  const char* bom;           /* still to be written before the first output */
+  size_t bom_len;
+  char pending[16];          /* incomplete character at the end of a chunk */
+  size_t pending_len;
+  bool hashed;
+  hash_state_t input_hash;
+  hash_state_t output_hash;
+} encoding_converter_t;
+
+/*
+ * encoding.converter(tocharset, fromcharset, options)
+ *
+ * Create a converter for text given in chunks, like the lines of a file.
+ * Shift states and characters split between chunks are carried over.
+ *
+ * Arguments:
+ *  tocharset, a string representing a valid iconv charset
+ *  fromcharset, a string representing a valid iconv charset
+ *  options, a table of conversion options
+ *    strict, fail on invalid input instead of skipping it
+ *    handle_to_bom, start the output with the bom of tocharset if any
+ *    on_unencodable, "translit", "entity" or "replace" characters that can't
+ *      be encoded instead of failing, only when converting from utf8
+ *    hash, hash the input and the output along the conversion, see
+ *      converter:hashes()
+ *
+ * Returns:
+ *  The encoding.converter or nil
+ *  The error message
+ */
+int f_converter(lua_State *L) {
+  const char* to = luaL_checkstring(L, 1);
+  const char* from = luaL_checkstring(L, 2);
+  bool strict = false, handle_to_bom = false, hashed = false;
+  encoding_fallback_t fallback = FALLBACK_NONE;
+  if (lua_istable(L, 3)) {
+    lua_getfield(L, 3, "strict");
+    strict = lua_toboolean(L, -1);
+    lua_getfield(L, 3, "handle_to_bom");
+    handle_to_bom = lua_toboolean(L, -1);
+    lua_getfield(L, 3, "hash");
+    hashed = lua_toboolean(L, -1);
+    lua_getfield(L, 3, "on_unencodable");
+    const char* fallback_name = luaL_optstring(L, -1, "none");
+    while (encoding_fallback_names[fallback] && strcmp(encoding_fallback_names[fallback], fallback_name))
+      fallback++;
+    if (!encoding_fallback_names[fallback])
+      return luaL_error(L, "invalid on_unencodable option '%s'", fallback_name);
+    lua_pop(L, 4);
+  }
+  if (charset_from_name(from)->kind != CHARSET_UTF8)
+    fallback = FALLBACK_NONE;
+  encoding_converter_t* converter = lua_newuserdata(L, sizeof(encoding_converter_t));
+  memset(converter, 0, sizeof(encoding_converter_t));
+  if (!encoding_conv_open(&converter->conv, to, from, false)) {
+    lua_pushnil(L);
+    lua_pushstring(L, strerror(errno));
+    return 2;
+  }
+  luaL_setmetatable(L, CONVERTER_METATABLE);
+  converter->open = true;
+  converter->strict = strict;
+  converter->fallback = fallback;
+  converter->hashed = hashed;
+  hash_init(&converter->input_hash, 0);
+  hash_init(&converter->output_hash, 0);
+  if (handle_to_bom)
+    converter->bom = encoding_bom_from_charset(to, &converter->bom_len);
+  return 1;
+}
+
+/*
+ * converter:convert(text, final)
+ *
+ * Convert the next chunk of text.
+ *
+ * Arguments:
+ *  text, the string or encoding.buffer to convert
+ *  final, true on the last chunk to flush the shift state
+ *
+ * Returns:
+ *  The converted output string or nil
+ *  The error message, or the amount of substitutions when on_unencodable set
+ */
+static int f_converter_convert(lua_State *L) {
+  encoding_converter_t* converter = luaL_checkudata(L, 1, CONVERTER_METATABLE);
+  size_t text_len = 0;
+  const char* text = encoding_checkbytes(L, 2, &text_len);
+  bool final = lua_toboolean(L, 3);
+  if (!converter->open)
+    return luaL_error(L, "the converter is closed");
+  arena_reset(&encoding_arena);
+  bytes_t out = { NULL, 0, 0, &encoding_arena, encoding_max_output };
+  if (converter->hashed)
+    hash_update(&converter->input_hash, text, text_len);
+  /* the carried over bytes go first, along with the new chunk */
+  if (converter->pending_len > 0) {
+    char* joined = arena_alloc(&encoding_arena, converter->pending_len + text_len);
+    if (!joined)
+      return luaL_error(L, "out of memory");
+    memcpy(joined, converter->pending, converter->pending_len);
+    memcpy(joined + converter->pending_len, text, text_len);
+    text = joined;
+    text_len += converter->pending_len;
+    converter->pending_len = 0;
+  }
+  const char* consumed = text;
+  size_t substitutions = 0;
+  bool success = bytes_reserve(&out, text_len + converter->bom_len + 16);
+  if (success && converter->bom_len > 0) {
+    memcpy(out.data, converter->bom, converter->bom_len);
+    out.size = converter->bom_len;
+    converter->bom_len = 0;
+  }
+  success = success
+    && (converter->fallback != FALLBACK_NONE ?
+      encoding_iconv_fallback(
+        &converter->conv, text, text_len, converter->strict, !final,
+        converter->fallback, &out, &consumed, &substitutions
+      ) :
+      encoding_conv_feed(&converter->conv, text, text_len, converter->strict, !final, &out, &consumed))
+    && (!final || encoding_conv_append(&converter->conv, NULL, 0, converter->strict, &out, NULL));
+  int error = errno;
+  size_t left = success ? text_len - (consumed - text) : 0;
+  if (left > sizeof(converter->pending)) {
+    success = false;
+    error = EILSEQ;
+  }
+  if (!success) {
+    arena_reset(&encoding_arena);
+    lua_pushnil(L);
+    if (error == EFBIG)
+      lua_pushfstring(L, "output limit of %I bytes reached", (lua_Integer)encoding_max_output);
+    else
+      lua_pushstring(L, error == ENOMEM ? "out of memory" : "illegal multibyte sequence");
+    return 2;
+  }
+  memcpy(converter->pending, consumed, left);
+  converter->pending_len = left;
+  if (converter->hashed && out.size > 0)
+    hash_update(&converter->output_hash, out.data, out.size);
+  lua_pushlstring(L, out.data ? out.data : "", out.size);
+  arena_reset(&encoding_arena);
+  if (converter->fallback != FALLBACK_NONE) {
+    lua_pushinteger(L, substitutions);
+    return 2;
+  }
+  return 1;
+}
+
+/*
+ * converter:reset()
+ *
+ * Go back to the initial shift state, dropping any carried over bytes.
+ */
+static int f_converter_reset(lua_State *L) {
+  encoding_converter_t* converter = luaL_checkudata(L, 1, CONVERTER_METATABLE);
+  if (converter->open)
+    encoding_conv_reset(&converter->conv);
+  converter->pending_len = 0;
+  hash_init(&converter->input_hash, 0);
+  hash_init(&converter->output_hash, 0);
+  return 0;
+}
+
+/*
+ * converter:hashes()
+ *
+ * Hashes of everything converted since the converter was created or reset,
+ * when created with the hash option.
+ *
+ * Returns:
+ *  The XXH64 of the input chunks, or nil
+ *  The XXH64 of the output chunks
+ */
+static int f_converter_hashes(lua_State *L) {
+  encoding_converter_t* converter = luaL_checkudata(L, 1, CONVERTER_METATABLE);
+  if (!converter->hashed) {
+    lua_pushnil(L);
+    return 1;
+  }
+  lua_pushinteger(L, (lua_Integer)hash_digest(&converter->input_hash));
+  lua_pushinteger(L, (lua_Integer)hash_digest(&converter->output_hash));
+  return 2;
+}
+
+static int f_converter_gc(lua_State *L) {
+  encoding_converter_t* converter = luaL_checkudata(L, 1, CONVERTER_METATABLE);
+  if (converter->open)
+    encoding_conv_close(&converter->conv);
+  converter->open = false;
+  return 0;
+}
+
+
+static const luaL_Reg converter_lib[] = {
+  { "convert", f_converter_convert },
+  { "reset",   f_converter_reset   },
+  { "hashes",  f_converter_hashes  },
+  { "__gc",    f_converter_gc      },
+  { NULL, NULL }
+};
+
+
+/* A read-only view of a whole file, memory mapped when possible. */
+typedef struct {
+  const char* data;
+  size_t size;
+  long long mtime;    /* in nanoseconds, or 100ns intervals on windows */
+#ifdef _WIN32
+  HANDLE file;
+  HANDLE mapping;
+#endif
+} encoding_map_t;
+
+static bool encoding_map_file(
+  const char* filename, encoding_map_t* map, const char** errmsg
+) {
+  memset(map, 0, sizeof(encoding_map_t));
+  map->data = "";
+#ifdef _WIN32
+  wchar_t* path = encoding_wide_path(filename);
+  map->file = path ? CreateFileW(
+    path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL
+  ) : INVALID_HANDLE_VALUE;
+  free(path);
+  LARGE_INTEGER size;
+  if (map->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(map->file, &size)) {
+    if (map->file != INVALID_HANDLE_VALUE)
+      CloseHandle(map->file);
+    map->file = NULL;
+    *errmsg = "unable to open file";
+    return false;
+  }
+  map->size = (size_t)size.QuadPart;
+  FILETIME written;
+  if (GetFileTime(map->file, NULL, NULL, &written))
+    map->mtime = ((long long)written.dwHighDateTime << 32) | written.dwLowDateTime;
+  if (map->size > 0) {
+    map->mapping = CreateFileMapping(map->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    map->data = map->mapping ?
+      MapViewOfFile(map->mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!map->data) {
+      if (map->mapping)
+        CloseHandle(map->mapping);
+      CloseHandle(map->file);
+      map->file = map->mapping = NULL;
+      *errmsg = "unable to map file";
+      return false;
+    }
+  }
+#else
+  int fd = open(filename, O_RDONLY);
+  struct stat st;
+  if (fd == -1 || fstat(fd, &st) != 0) {
+    *errmsg = strerror(errno);
+    if (fd != -1)
+      close(fd);
+    return false;
+  }
+  map->size = st.st_size;
+  map->mtime = encoding_stat_mtime(&st);
+  if (map->size > 0) {
+    void* data = mmap(NULL, map->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      *errmsg = strerror(errno);
+      close(fd);
+      return false;
+    }
+    map->data = data;
+  }
+  close(fd);
+#endif
+  return true;
+}
+
+static void encoding_unmap_file(encoding_map_t* map) {
+#ifdef _WIN32
+  if (map->mapping) {
+    UnmapViewOfFile(map->data);
+    CloseHandle(map->mapping);
+  }
+  if (map->file)
+    CloseHandle(map->file);
+#else
+  if (map->size > 0)
+    munmap((void*)map->data, map->size);
+#endif
+  map->data = "";
+  map->size = 0;
+}
+
+
+/* Find the first occurrence of needle in haystack. */
+static const char* encoding_memmem(
+  const char* haystack, size_t len, const char* needle, size_t needle_len
+) {
+  if (needle_len == 0)
+    return haystack;
+  if (needle_len > len)
+    return NULL;
+  return kernels.find(haystack, haystack + len - needle_len, needle, needle_len);
+}
+
+
+/*
+ * Checks if the newline byte of the charset found at offset is a whole
+ * newline code unit, storing the offset following the unit in next.
+*/
+static bool encoding_is_newline(
+  const charset_t* cs, const char* data, size_t size,
+  size_t base, size_t offset, size_t* next
+) {
+  if (cs->unit == 1) {
+    *next = offset + 1;
+    return true;
+  }
+  size_t unit_offset = (offset - base) % cs->unit;
+  size_t unit_start = offset - unit_offset;
+  if (unit_start + cs->unit > size || unit_offset != (cs->big_endian ? cs->unit - 1u : 0u))
+    return false;
+  for (size_t i = 0; i < cs->unit; ++i) {
+    if (unit_start + i != offset && data[unit_start + i] != 0)
+      return false;
+  }
+  *next = unit_start + cs->unit;
+  return true;
+}
+
+
+/*
+ * Counts the newline characters in the given raw bytes, honoring the code unit
+ * size of the charset. The offset following the last newline is stored in
+ * line_start when at least one is found.
+*/
+static size_t encoding_count_lines(
+  const charset_t* cs, const char* data, size_t from, size_t to,
+  size_t base, size_t* line_start
+) {
+  size_t lines = 0;
+  const char* p = data + from;
+  const char* end = data + to;
+  unsigned char newline = charset_newline(cs);
+  while (p < end && (p = memchr(p, newline, end - p))) {
+    if (encoding_is_newline(cs, data, to, base, p - data, line_start))
+      lines++;
+    ++p;
+  }
+  return lines;
+}
+
+
+/* Raw offset just past the newline that ends the line containing offset. */
+static size_t encoding_line_end(
+  const charset_t* cs, const char* data, size_t size, size_t base, size_t offset
+) {
+  const char* p = data + offset;
+  const char* end = data + size;
+  size_t next = size;
+  unsigned char newline = charset_newline(cs);
+  while (p < end && (p = memchr(p, newline, end - p))) {
+    if (encoding_is_newline(cs, data, size, base, p - data, &next))
+      return next;
+    ++p;
+  }
+  return size;
+}
+
+
+/*
+ * Checks that the raw offset starts a character, walking forward from the
+ * closest byte that can not be part of a multibyte sequence. The cursor is a
+ * known character boundary at or before offset which gets moved forward.
+*/
+static bool encoding_is_boundary(
+  const charset_t* cs, const unsigned char* data, size_t size,
+  size_t base, size_t offset, size_t* cursor
+) {
+  switch (cs->kind) {
+    case CHARSET_UTF16:
+    case CHARSET_UTF32: {
+      if ((offset - base) % cs->unit != 0)
+        return false;
+      if (cs->kind == CHARSET_UTF16 && offset >= base + 2) {
+        const unsigned char* p = data + offset - 2;
+        unsigned int u = cs->big_endian ? (p[0] << 8 | p[1]) : (p[1] << 8 | p[0]);
+        return !(u >= 0xD800 && u <= 0xDBFF);
+      }
+      return true;
+    }
+    case CHARSET_MULTI: {
+      size_t p = offset;
+      while (p > *cursor && data[p - 1] >= cs->sync)
+        --p;
+      while (p < offset) {
+        *cursor = p;
+        p += charset_char_len(cs, data + p, size - p);
+      }
+      if (p == offset)
+        *cursor = p;
+      return p == offset;
+    }
+    default:
+      return true;
+  }
+}
+
+
+/*
+ * Length in bytes that the given raw text has once converted to utf8, the
+ * scratch buffer holds the conversion.
+*/
+static size_t encoding_decoded_len(
+  const charset_t* cs, encoding_conv_t* conv, const char* text, size_t len,
+  bytes_t* scratch
+) {
+  if (cs->kind == CHARSET_UTF8)
+    return len;
+  if (cs->kind == CHARSET_SINGLE || cs->kind == CHARSET_MULTI) {
+    size_t i = 0;
+    while (i < len && (unsigned char)text[i] < 0x80)
+      ++i;
+    if (i == len)
+      return len;
+  }
+  if (conv->iconv == (iconv_t)-1 && conv->kernel == KERNEL_NONE)
+    return len;
+  encoding_conv_reset(conv);
+  scratch->size = 0;
+  encoding_conv_append(conv, text, len, false, scratch, NULL);
+  return scratch->size;
+}
+
+
+typedef struct {
+  size_t offset;     /* raw byte offset, the line start for stateful charsets */
+  size_t line;
+  size_t col;        /* byte column in the utf8 decoded line */
+  const char* text;  /* the decoded line without its newline, if requested */
+  size_t text_len;
+} encoding_match_t;
+
+/* Return false to stop searching */
+typedef bool (*encoding_match_cb)(void* udata, const encoding_match_t* match);
+
+typedef struct {
+  const char* charset;
+  const char* data;
+  size_t size;
+  size_t bom_len;
+  const char* needle;  /* in utf8 */
+  size_t needle_len;
+  bool with_text;
+  encoding_match_cb callback;
+  void* udata;
+} encoding_search_t;
+
+static size_t encoding_trim_newline(const char* text, size_t len) {
+  if (len > 0 && text[len - 1] == '\n') --len;
+  if (len > 0 && text[len - 1] == '\r') --len;
+  return len;
+}
+
+/*
+ * The explicit byte order variant of the wide charsets named without one,
+ * taken from their bom like iconv does, big endian without it. The length of
+ * the bom found is stored in bom_len. NULL for any other charset.
+*/
+static const char* encoding_wide_byte_order(
+  const char* charset, const char* data, size_t size, size_t* bom_len
+) {
+  static const char* const wide[][3] = {
+    { "UTF-16", "UTF-16LE", "UTF-16BE" }, { "UCS-2", "UCS-2LE", "UCS-2BE" },
+    { "UTF-32", "UTF-32LE", "UTF-32BE" }, { "UCS-4", "UCS-4LE", "UCS-4BE" }
+  };
+  for (size_t i = 0; i < sizeof(wide) / sizeof(wide[0]); ++i) {
+    if (!encoding_charset_equal(charset, wide[i][0]))
+      continue;
+    size_t unit = i < 2 ? 2 : 4;
+    const unsigned char* p = (const unsigned char*)data;
+    *bom_len = 0;
+    if (size >= unit) {
+      bool le = unit == 2 ? (p[0] == 0xFF && p[1] == 0xFE)
+        : (p[0] == 0xFF && p[1] == 0xFE && p[2] == 0 && p[3] == 0);
+      bool be = unit == 2 ? (p[0] == 0xFE && p[1] == 0xFF)
+        : (p[0] == 0 && p[1] == 0 && p[2] == 0xFE && p[3] == 0xFF);
+      if (le || be)
+        *bom_len = unit;
+      if (le)
+        return wide[i][1];
+    }
+    return wide[i][2];
+  }
+  return NULL;
+}
+
+/*
+ * Searches raw text in the given charset for the given utf8 needle. The needle
+ * is encoded into the charset once and matched against the raw bytes, except
+ * for stateful charsets where the same bytes can mean different characters,
+ * those get decoded line by line and matched in utf8. UTF-16, UCS-2, UTF-32 and
+ * UCS-4 named without a byte order take it from their bom, big endian without.
+*/
+static bool encoding_search(const encoding_search_t* search, const char** errmsg) {
+  const char* charset = search->charset;
+  const char* data = search->data;
+  size_t size = search->size, bom_len = search->bom_len;
+  /* wide text is never split on the raw newline bytes of a stateful charset */
+  size_t wide_bom_len = 0;
+  const char* wide = encoding_wide_byte_order(charset, data, size, &wide_bom_len);
+  if (wide) {
+    charset = wide;
+    if (wide_bom_len > bom_len)
+      bom_len = wide_bom_len;
+  }
+  const charset_t* cs = charset_from_name(charset);
+  char* encoded = NULL;
+  size_t encoded_len = search->needle_len;
+  bool stateful = cs->kind == CHARSET_STATEFUL;
+  if (search->needle_len == 0)
+    return true;
+  if (!stateful && cs->kind != CHARSET_UTF8) {
+    encoding_conv_t encoder;
+    if (!encoding_conv_open(&encoder, charset, "UTF-8", false)) {
+      *errmsg = strerror(errno);
+      return false;
+    }
+    bytes_t out = { NULL, 0, 0, NULL, 0 };
+    bool encoded_all = encoding_conv_append(&encoder, search->needle, search->needle_len, true, &out, NULL)
+      && encoding_conv_append(&encoder, NULL, 0, true, &out, NULL);
+    encoding_conv_close(&encoder);
+    if (!encoded_all || out.size == 0) {
+      /* not representable in this charset, so it can't be found either */
+      bytes_free(&out);
+      return true;
+    }
+    encoded = out.data;
+    encoded_len = out.size;
+  }
+  const char* pattern = encoded ? encoded : search->needle;
+  encoding_conv_t conv = { .iconv = (iconv_t)-1 };
+  encoding_match_t match = { 0, 1, 1, NULL, 0 };
+  size_t line_start = bom_len;
+  bytes_t line = { NULL, 0, 0, NULL, 0 };
+  if (!stateful) {
+    size_t cursor = bom_len, counted = bom_len, from = bom_len;
+    /* the decoded column is carried from one match to the next on a line */
+    size_t col_line = (size_t)-1, col_offset = 0, col = 0;
+    bool decoding = cs->kind == CHARSET_UTF8 || encoding_conv_open(&conv, "UTF-8", charset, false);
+    const char* found;
+    while ((found = encoding_memmem(data + from, size - from, pattern, encoded_len))) {
+      size_t offset = found - data;
+      if (!encoding_is_boundary(cs, (const unsigned char*)data, size, bom_len, offset, &cursor)) {
+        from = offset + 1;
+        continue;
+      }
+      match.line += encoding_count_lines(cs, data, counted, offset, bom_len, &line_start);
+      counted = offset;
+      match.offset = offset;
+      if (col_line != line_start) {
+        col_line = line_start;
+        col_offset = line_start;
+        col = 0;
+      }
+      col += encoding_decoded_len(cs, &conv, data + col_offset, offset - col_offset, &line);
+      col_offset = offset;
+      match.col = col + 1;
+      if (search->with_text) {
+        size_t line_end = encoding_line_end(cs, data, size, bom_len, offset + encoded_len - 1);
+        if (cs->kind == CHARSET_UTF8) {
+          match.text = data + line_start;
+          match.text_len = line_end - line_start;
+        } else if (decoding) {
+          encoding_conv_reset(&conv);
+          line.size = 0;
+          encoding_conv_append(&conv, data + line_start, line_end - line_start, false, &line, NULL);
+          match.text = line.data;
+          match.text_len = line.size;
+        }
+        match.text_len = encoding_trim_newline(match.text, match.text_len);
+      }
+      if (!search->callback(search->udata, &match))
+        break;
+      from = offset + encoded_len;
+    }
+  } else if (encoding_conv_open(&conv, "UTF-8", charset, false)) {
+    /* stateful charsets keep newlines as plain ascii, and the decoder keeps
+       the shift state from one line to the next */
+    bool done = false;
+    while (!done && line_start < size) {
+      const char* newline = memchr(data + line_start, '\n', size - line_start);
+      size_t line_end = newline ? (size_t)(newline - data) + 1 : size;
+      line.size = 0;
+      encoding_conv_append(&conv, data + line_start, line_end - line_start, false, &line, NULL);
+      size_t from = 0;
+      const char* found;
+      while ((found = encoding_memmem(line.data + from, line.size - from, search->needle, search->needle_len))) {
+        match.offset = line_start;
+        match.col = (found - line.data) + 1;
+        if (search->with_text) {
+          match.text = line.data;
+          match.text_len = encoding_trim_newline(line.data, line.size);
+        }
+        if (!search->callback(search->udata, &match)) {
+          done = true;
+          break;
+        }
+        from = (found - line.data) + search->needle_len;
+      }
+      match.line++;
+      line_start = line_end;
+    }
+  }
+  encoding_conv_close(&conv);
+  bytes_free(&line);
+  free(encoded);
+  return true;
+}
+
+
+typedef struct {
+  lua_State* L;
+  int table;
+  size_t count;
+  size_t limit;
+} encoding_search_results_t;
+
+static bool encoding_search_push(void* udata, const encoding_match_t* match) {
+  encoding_search_results_t* results = udata;
+  lua_State* L = results->L;
+  lua_createtable(L, 0, 3);
+  lua_pushinteger(L, match->line);
+  lua_setfield(L, -2, "line");
+  lua_pushinteger(L, match->col);
+  lua_setfield(L, -2, "col");
+  lua_pushinteger(L, match->offset + 1);
+  lua_setfield(L, -2, "offset");
+  lua_rawseti(L, results->table, ++results->count);
+  return results->limit == 0 || results->count < results->limit;
+}
+
+
+/*
+ * encoding.search(filename, text, options)
+ *
+ * Search a file for the given utf8 text without decoding it first, the text
+ * is encoded into the file charset and matched against its raw bytes.
+ *
+ * Arguments:
+ *  filename, the path of the file to search
+ *  text, the utf8 string to find
+ *  options, a table with the following optional fields:
+ *    charset, the file charset, detected if not given
+ *    limit, the maximum amount of matches to return
+ *
+ * Returns:
+ *  A list of matches with line, col (in the decoded utf8 line) and offset
+ *  (raw byte offset in the file) fields, or nil
+ *  The file charset, or the error message
+ */
+int f_search(lua_State *L) {
+  const char* filename = luaL_checkstring(L, 1);
+  size_t needle_len = 0;
+  const char* needle = luaL_checklstring(L, 2, &needle_len);
+  const char* charset = NULL;
+  encoding_search_results_t results = { L, 0, 0, 0 };
+
+  if (lua_istable(L, 3)) {
+    lua_getfield(L, 3, "charset");
+    charset = lua_tostring(L, -1);
+    lua_getfield(L, 3, "limit");
+    results.limit = luaL_optinteger(L, -1, 0);
+  }
+  encoding_map_t map;
+  const char* errmsg = NULL;
+  if (!encoding_map_file(filename, &map, &errmsg)) {
+    lua_pushnil(L);
+    lua_pushstring(L, errmsg);
+    return 2;
+  }
+  char detected[CHARSET_NAME_MAX];
+  bool bom = false;
+  size_t bom_len = 0;
+  if (!charset) {
+    size_t sample = map.size < DETECT_SAMPLE_SIZE ? map.size : DETECT_SAMPLE_SIZE;
+    if (!encoding_detect(map.data, sample, detected, &bom))
+      strcpy(detected, "ISO-8859-1");
+    charset = detected;
+  }
+  const char* charset_bom = encoding_bom_from_charset(charset, &bom_len);
+  if (bom_len > map.size || memcmp(map.data, charset_bom, bom_len) != 0)
+    bom_len = 0;
+  lua_newtable(L);
+  results.table = lua_gettop(L);
+  encoding_search_t search = {
+    charset, map.data, map.size, bom_len, needle, needle_len, false,
+    encoding_search_push, &results
+  };
+  bool success = encoding_search(&search, &errmsg);
+  encoding_unmap_file(&map);
+  if (!success) {
+    lua_pushnil(L);
+    lua_pushstring(L, errmsg);
+    return 2;
+  }
+  lua_pushstring(L, charset);
+  return 2;
+}
+
+
+/*
+ * Appends the lines of the given utf8 text to the table at idx which already
+ * has count of them, split the same way lite-xl does it: every line ends with
+ * a newline and carriage returns found before them are removed, which is
+ * reported on crlf. Unless final the text after the last newline is left out,
+ * returns the amount of bytes consumed.
+*/
+static size_t encoding_append_lines(
+  lua_State* L, int idx, size_t* count, const char* text, size_t len,
+  bool final, bool* crlf
+) {
+  size_t capacity = 0;
+  char* scratch = NULL;
+  const char* start = text;
+  const char* end = text + len;
+  idx = lua_absindex(L, idx);
+  while (text < end) {
+    const char* newline = memchr(text, '\n', end - text);
+    if (!newline && !final)
+      break;
+    size_t line_len = newline ? (size_t)(newline - text) : (size_t)(end - text);
+    bool cr = line_len > 0 && text[line_len - 1] == '\r';
+    if (cr) {
+      *crlf = true;
+      line_len--;
+    }
+    if (newline && !cr) {
+      lua_pushlstring(L, text, line_len + 1);
+    } else {
+      if (capacity < line_len + 1) {
+        capacity = line_len + 1 > capacity * 2 ? line_len + 1 : capacity * 2;
+        scratch = realloc(scratch, capacity);
+      }
+      memcpy(scratch, text, line_len);
+      scratch[line_len] = '\n';
+      lua_pushlstring(L, scratch, line_len + 1);
+    }
+    lua_rawseti(L, idx, ++*count);
+    text = newline ? newline + 1 : end;
+  }
+  free(scratch);
+  return text - start;
+}
+
+/* Pushes a table with the lines of the given utf8 text. */
+static void encoding_push_lines(lua_State* L, const char* text, size_t len, bool* crlf) {
+  size_t count = 0;
+  lua_newtable(L);
+  encoding_append_lines(L, -1, &count, text, len, true, crlf);
+  if (count == 0) {
+    lua_pushliteral(L, "\n");
+    lua_rawseti(L, -2, 1);
+  }
+}
+
+
+static encoding_buffer_t* encoding_buffer_new(lua_State* L) {
+  encoding_buffer_t* buffer = lua_newuserdata(L, sizeof(encoding_buffer_t));
+  memset(buffer, 0, sizeof(encoding_buffer_t));
+  luaL_setmetatable(L, BUFFER_METATABLE);
+  return buffer;
+}
+
+static encoding_buffer_t* encoding_buffer_writable(lua_State* L, int idx) {
+  encoding_buffer_t* buffer = luaL_checkudata(L, idx, BUFFER_METATABLE);
+  if (buffer->parent)
+    luaL_error(L, "can't write into a buffer view");
+  return buffer;
+}
+
+/* Pushes a view of len bytes at offset of the buffer at idx */
+static void encoding_buffer_push_view(lua_State* L, int idx, size_t offset, size_t len) {
+  encoding_buffer_t* buffer = luaL_checkudata(L, idx, BUFFER_METATABLE);
+  encoding_buffer_t* view = encoding_buffer_new(L);
+  if (buffer->parent) {
+    view->parent = buffer->parent;
+    view->offset = buffer->offset + offset;
+    lua_getuservalue(L, idx);
+  } else {
+    view->parent = buffer;
+    view->offset = offset;
+    lua_pushvalue(L, idx);
+  }
+  view->length = len;
+  lua_setuservalue(L, -2);
+}
+
+/* Translates lua style i, j string indexes into an offset and length. */
+static size_t encoding_range(lua_State* L, int idx, size_t len, size_t* offset) {
+  lua_Integer i = luaL_optinteger(L, idx, 1);
+  lua_Integer j = luaL_optinteger(L, idx + 1, -1);
+  if (i < 0) i = (lua_Integer)len + i + 1 > 0 ? (lua_Integer)len + i + 1 : 1;
+  else if (i == 0) i = 1;
+  if (j < 0) j = (lua_Integer)len + j + 1;
+  else if (j > (lua_Integer)len) j = len;
+  *offset = i - 1;
+  return i > j ? 0 : (size_t)(j - i + 1);
+}
+
+
+/*
+ * encoding.buffer(initial)
+ *
+ * Creates a growable byte array that can be used as input and output of the
+ * conversion functions to avoid creating intermediate strings.
+ *
+ * Arguments:
+ *  initial, a string or buffer to copy, or the initial capacity in bytes
+ *
+ * Returns:
+ *  The new buffer
+ */
+int f_buffer(lua_State *L) {
+  size_t len = 0;
+  const char* initial = NULL;
+  size_t capacity = 0;
+  if (lua_type(L, 1) == LUA_TNUMBER)
+    capacity = luaL_checkinteger(L, 1);
+  else if (!lua_isnoneornil(L, 1))
+    initial = encoding_checkbytes(L, 1, &len);
+  encoding_buffer_t* buffer = encoding_buffer_new(L);
+  if (!encoding_buffer_reserve(buffer, len > capacity ? len : capacity))
+    return luaL_error(L, "out of memory");
+  if (len > 0)
+    memcpy(buffer->data, initial, len);
+  buffer->size = len;
+  return 1;
+}
+
+
+/*
+ * buffer:append(data)
+ *
+ * Appends a string or the contents of another buffer.
+ *
+ * Returns:
+ *  The buffer
+ */
+static int f_buffer_append(lua_State *L) {
+  encoding_buffer_t* buffer = encoding_buffer_writable(L, 1);
+  size_t len = 0;
+  const char* data = encoding_checkbytes(L, 2, &len);
+  if (!encoding_buffer_reserve(buffer, buffer->size + len))
+    return luaL_error(L, "out of memory");
+  /* fetched again, appending the buffer to itself moved it with the realloc */
+  data = encoding_checkbytes(L, 2, &len);
+  memmove(buffer->data + buffer->size, data, len);
+  buffer->size += len;
+  lua_settop(L, 1);
+  return 1;
+}
+
+
+/*
+ * buffer:clear()
+ *
+ * Empties the buffer keeping its allocated memory.
+ */
+static int f_buffer_clear(lua_State *L) {
+  encoding_buffer_writable(L, 1)->size = 0;
+  lua_settop(L, 1);
+  return 1;
+}
+
+
+/*
+ * buffer:reserve(capacity)
+ *
+ * Makes sure the buffer can hold at least the given amount of bytes.
+ */
+static int f_buffer_reserve(lua_State *L) {
+  encoding_buffer_t* buffer = encoding_buffer_writable(L, 1);
+  if (!encoding_buffer_reserve(buffer, luaL_checkinteger(L, 2)))
+    return luaL_error(L, "out of memory");
+  lua_settop(L, 1);
+  return 1;
+}
+
+
+/*
+ * buffer:sub(i, j)
+ *
+ * Creates a view over a range of the buffer without copying it, indexes work
+ * like on string.sub(). Views are read only and follow changes made to the
+ * buffer they come from.
+ *
+ * Returns:
+ *  The buffer view
+ */
+static int f_buffer_sub(lua_State *L) {
+  size_t len = 0, offset = 0;
+  encoding_buffer_bytes(luaL_checkudata(L, 1, BUFFER_METATABLE), &len);
+  size_t length = encoding_range(L, 2, len, &offset);
+  encoding_buffer_push_view(L, 1, offset, length);
+  return 1;
+}
+
+
+/*
+ * buffer:tostring(i, j)
+ *
+ * Returns:
+ *  The contents of the buffer, or the given range of it, as a string
+ */
+static int f_buffer_tostring(lua_State *L) {
+  size_t len = 0, offset = 0;
+  const char* data = encoding_buffer_bytes(luaL_checkudata(L, 1, BUFFER_METATABLE), &len);
+  size_t length = encoding_range(L, 2, len, &offset);
+  lua_pushlstring(L, data + offset, length);
+  return 1;
+}
+
+
+/*
+ * buffer:strip_bom(charset)
+ *
+ * Skips the byte order marks at the start of the buffer if any.
+ *
+ * Arguments:
+ *  charset, only look for the bom of this charset, all if not given
+ *
+ * Returns:
+ *  A view of the buffer without the bom, or the buffer itself if none found
+ *  The charset of the bom found, or nil
+ */
+static int f_buffer_strip_bom(lua_State *L) {
+  size_t len = 0, bom_len = 0;
+  const char* data = encoding_buffer_bytes(luaL_checkudata(L, 1, BUFFER_METATABLE), &len);
+  const char* charset = luaL_optstring(L, 2, NULL);
+  if (charset) {
+    const char* bom = encoding_bom_from_charset(charset, &bom_len);
+    if (bom_len > len || memcmp(data, bom, bom_len) != 0)
+      charset = NULL;
+  } else {
+    charset = encoding_charset_from_bom(data, len, &bom_len);
+  }
+  if (charset && bom_len > 0) {
+    encoding_buffer_push_view(L, 1, bom_len, len - bom_len);
+    lua_pushstring(L, charset);
+  } else {
+    lua_settop(L, 1);
+    lua_pushnil(L);
+  }
+  return 2;
+}
+
+
+/*
+ * buffer:lines()
+ *
+ * Splits the utf8 contents of the buffer into lines like lite-xl does when
+ * loading a document.
+ *
+ * Returns:
+ *  The list of lines, each one ending with a newline
+ *  True if carriage returns were removed from the line endings
+ */
+static int f_buffer_lines(lua_State *L) {
+  size_t len = 0;
+  const char* data = encoding_buffer_bytes(luaL_checkudata(L, 1, BUFFER_METATABLE), &len);
+  bool crlf = false;
+  encoding_push_lines(L, data, len, &crlf);
+  lua_pushboolean(L, crlf);
+  return 2;
+}
+
+
+/*
+ * buffer:read(filename)
+ *
+ * Replaces the contents of the buffer with the ones of a file.
+ *
+ * Returns:
+ *  The buffer or nil
+ *  The error message
+ */
+static int f_buffer_read(lua_State *L) {
+  encoding_buffer_t* buffer = encoding_buffer_writable(L, 1);
+  const char* filename = luaL_checkstring(L, 2);
+  FILE* file = encoding_fopen(filename, "rb");
+  if (!file) {
+    lua_pushnil(L);
+    lua_pushstring(L, strerror(errno));
+    return 2;
+  }
+  buffer->size = 0;
+  size_t read = 0;
+  do {
+    if (!encoding_buffer_reserve(buffer, buffer->size + 64*1024)) {
+      fclose(file);
+      return luaL_error(L, "out of memory");
+    }
+    read = fread(buffer->data + buffer->size, 1, buffer->capacity - buffer->size, file);
+    buffer->size += read;
+  } while (read > 0);
+  bool failed = ferror(file);
+  fclose(file);
+  if (failed) {
+    lua_pushnil(L);
+    lua_pushstring(L, "error reading file");
+    return 2;
+  }
+  lua_settop(L, 1);
+  return 1;
+}
+
+
+/*
+ * buffer:write(filename)
+ *
+ * Writes the contents of the buffer into a file, replacing it.
+ *
+ * Returns:
+ *  True or nil
+ *  The error message
+ */
+static int f_buffer_write(lua_State *L) {
+  size_t len = 0;
+  const char* data = encoding_buffer_bytes(luaL_checkudata(L, 1, BUFFER_METATABLE), &len);
+  const char* filename = luaL_checkstring(L, 2);
+  FILE* file = encoding_fopen(filename, "wb");
+  bool written = file && fwrite(data, 1, len, file) == len;
+  if (file && fclose(file) != 0)
+    written = false;
+  if (!written) {
+    lua_pushnil(L);
+    lua_pushstring(L, strerror(errno));
+    return 2;
+  }
+  lua_pushboolean(L, 1);
+  return 1;
+}
+
+
+static int f_buffer_len(lua_State *L) {
+  size_t len = 0;
+  encoding_buffer_bytes(luaL_checkudata(L, 1, BUFFER_METATABLE), &len);
+  lua_pushinteger(L, len);
+  return 1;
+}
+
+
+static int f_buffer_gc(lua_State *L) {
+  encoding_buffer_t* buffer = luaL_checkudata(L, 1, BUFFER_METATABLE);
+  if (!buffer->parent)
+    free(buffer->data);
+  buffer->data = NULL;
+  buffer->size = buffer->capacity = 0;
+  return 0;
+}
+
+
+static const luaL_Reg buffer_lib[] = {
+  { "append",    f_buffer_append    },
+  { "clear",     f_buffer_clear     },
+  { "reserve",   f_buffer_reserve   },
+  { "sub",       f_buffer_sub       },
+  { "tostring",  f_buffer_tostring  },
+  { "strip_bom", f_buffer_strip_bom },
+  { "lines",     f_buffer_lines     },
+  { "read",      f_buffer_read      },
+  { "write",     f_buffer_write     },
+  { "__len",     f_buffer_len       },
+  { "__gc",      f_buffer_gc        },
+  { NULL, NULL }
+};
+
+
+/*
+ * Mixed charset segmentation, the input is split into blocks at line
+ * boundaries which are classified in parallel line by line: plain ascii lines
+ * are neutral, valid utf8 ones are utf8 and the remaining ones are detected
+ * together by uchardet. Adjacent lines and blocks sharing a charset are then
+ * merged into segments. Only ascii compatible charsets can be told apart.
+*/
+#define SEGMENT_BLOCK_SIZE (16*1024)
+#define SEGMENT_MAX_CHARSETS 16
+
+typedef struct {
+  size_t offset;
+  size_t size;
+  float confidence;
+  char charset[CHARSET_NAME_MAX];   /* empty while only ascii was seen */
+} encoding_segment_t;
+
+typedef struct {
+  encoding_segment_t* items;
+  size_t count;
+  size_t capacity;
+} encoding_segments_t;
+
+typedef struct {
+  size_t block_size;
+  int threads;
+  size_t charset_count;
+  char charsets[SEGMENT_MAX_CHARSETS][CHARSET_NAME_MAX];
+  char fallback[CHARSET_NAME_MAX];
+} encoding_segment_options_t;
+
+typedef struct {
+  size_t from;
+  size_t to;
+  encoding_segments_t segments;
+  bool failed;
+} encoding_segment_block_t;
+
+typedef struct {
+  const char* data;
+  const encoding_segment_options_t* options;
+  encoding_segment_block_t* blocks;
+  size_t block_count;
+  size_t next;
+  mutex_t mutex;
+} encoding_segment_job_t;
+
+/*
+ * Appends a range to the list merging it with the last segment when they
+ * share the charset, neutral ranges join whatever precedes them and take the
+ * charset of what follows when they come first.
+*/
+static bool encoding_segments_push(
+  encoding_segments_t* list, size_t offset, size_t size,
+  const char* charset, float confidence
+) {
+  if (list->count > 0) {
+    encoding_segment_t* last = &list->items[list->count - 1];
+    if (!*charset || !*last->charset || strcmp(last->charset, charset) == 0) {
+      if (!*last->charset && *charset) {
+        strcpy(last->charset, charset);
+        last->confidence = confidence;
+      }
+      last->size = offset + size - last->offset;
+      return true;
+    }
+  }
+  if (list->count == list->capacity) {
+    size_t capacity = list->capacity ? list->capacity * 2 : 16;
+    encoding_segment_t* items = realloc(list->items, capacity * sizeof(encoding_segment_t));
+    if (!items)
+      return false;
+    list->items = items;
+    list->capacity = capacity;
+  }
+  encoding_segment_t* segment = &list->items[list->count++];
+  segment->offset = offset;
+  segment->size = size;
+  segment->confidence = confidence;
+  strcpy(segment->charset, charset);
+  return true;
+}
+
+/* Classifies a line as plain ascii (0), valid utf8 (1) or something else (2). */
+static int encoding_line_class(const unsigned char* p, size_t len) {
+  size_t i = 0;
+  int result = 0;
+  while (i < len) {
+    unsigned char c = p[i];
+    if (c < 0x80) {
+      i += kernels.ascii_span(p + i, len - i);
+      continue;
+    }
+    unsigned char lo = 0x80, hi = 0xBF;
+    size_t follow = 0;
+    if (c >= 0xC2 && c <= 0xDF) follow = 1;
+    else if (c == 0xE0) { follow = 2; lo = 0xA0; }
+    else if (c == 0xED) { follow = 2; hi = 0x9F; }
+    else if (c >= 0xE1 && c <= 0xEF) follow = 2;
+    else if (c == 0xF0) { follow = 3; lo = 0x90; }
+    else if (c >= 0xF1 && c <= 0xF3) follow = 3;
+    else if (c == 0xF4) { follow = 3; hi = 0x8F; }
+    else return 2;
+    if (i + follow >= len || p[i + 1] < lo || p[i + 1] > hi)
+      return 2;
+    for (size_t j = 2; j <= follow; ++j) {
+      if ((p[i + j] & 0xC0) != 0x80)
+        return 2;
+    }
+    i += follow + 1;
+    result = 1;
+  }
+  return result;
+}
+
+/* Picks the charset of the non utf8 lines of a block from uchardet results. */
+static void encoding_segment_pick(
+  uchardet_t ud, const encoding_segment_options_t* options,
+  char* charset, float* confidence
+) {
+  size_t found = uchardet_get_n_candidates(ud);
+  for (size_t i = 0; i < found; ++i) {
+    const char* candidate = uchardet_get_encoding(ud, i);
+    if (!candidate || !*candidate || encoding_charset_equal(candidate, "UTF-8"))
+      continue;
+    bool allowed = options->charset_count == 0;
+    for (size_t j = 0; j < options->charset_count && !allowed; ++j)
+      allowed = encoding_charset_equal(candidate, options->charsets[j]);
+    if (allowed) {
+      strncpy(charset, candidate, CHARSET_NAME_MAX - 1);
+      charset[CHARSET_NAME_MAX - 1] = 0;
+      *confidence = uchardet_get_confidence(ud, i);
+      return;
+    }
+  }
+  strcpy(charset, options->fallback);
+  *confidence = 0;
+}
+
+static void encoding_segment_block(
+  encoding_segment_job_t* job, encoding_segment_block_t* block, uchardet_t ud
+) {
+  const unsigned char* data = (const unsigned char*)job->data;
+  char legacy[CHARSET_NAME_MAX] = "";
+  float legacy_confidence = 0;
+  for (int pass = 0; pass < 2; ++pass) {
+    size_t offset = block->from;
+    bool others = false;
+    if (pass == 0)
+      uchardet_reset(ud);
+    while (offset < block->to) {
+      const unsigned char* newline = memchr(data + offset, '\n', block->to - offset);
+      size_t end = newline ? (size_t)(newline - data) + 1 : block->to;
+      int class = encoding_line_class(data + offset, end - offset);
+      if (pass == 0) {
+        if (class == 2) {
+          others = true;
+          uchardet_handle_data(ud, (const char*)data + offset, end - offset);
+        }
+      } else if (!encoding_segments_push(
+        &block->segments, offset, end - offset,
+        class == 0 ? "" : (class == 1 ? "UTF-8" : legacy),
+        class == 2 ? legacy_confidence : 1.0f
+      )) {
+        block->failed = true;
+        return;
+      }
+      offset = end;
+    }
+    if (pass == 0 && others) {
+      uchardet_data_end(ud);
+      encoding_segment_pick(ud, job->options, legacy, &legacy_confidence);
+    }
+  }
+}
+
+static void* encoding_segment_thread(void* data) {
+  encoding_segment_job_t* job = data;
+  uchardet_t ud = uchardet_new();
+  while (true) {
+    mutex_lock(&job->mutex);
+    size_t index = job->next++;
+    mutex_unlock(&job->mutex);
+    if (index >= job->block_count)
+      break;
+    encoding_segment_block(job, &job->blocks[index], ud);
+  }
+  uchardet_delete(ud);
+  return NULL;
+}
+
+/* Splits data into segments of the same charset, false if out of memory. */
+static bool encoding_segment(
+  const char* data, size_t size, const encoding_segment_options_t* options,
+  encoding_segments_t* segments
+) {
+  encoding_segment_job_t job = { .data = data, .options = options };
+  size_t capacity = size / options->block_size + 1;
+  job.blocks = calloc(capacity, sizeof(encoding_segment_block_t));
+  if (!job.blocks)
+    return false;
+  for (size_t from = 0; from < size && job.block_count < capacity;) {
+    size_t to = size - from > options->block_size ? from + options->block_size : size;
+    const char* newline = to < size ? memchr(data + to, '\n', size - to) : NULL;
+    to = newline ? (size_t)(newline - data) + 1 : size;
+    job.blocks[job.block_count].from = from;
+    job.blocks[job.block_count++].to = to;
+    from = to;
+  }
+  int threads = options->threads;
+  if ((size_t)threads > job.block_count / 4)
+    threads = job.block_count / 4;
+  mutex_init(&job.mutex);
+  thread_t workers[64];
+  int started = 0;
+  for (; started < threads && started < 64; ++started) {
+    if (!thread_create(&workers[started], encoding_segment_thread, &job))
+      break;
+  }
+  /* the calling thread always takes part, which covers small inputs */
+  encoding_segment_thread(&job);
+  for (int i = 0; i < started; ++i)
+    thread_join(workers[i]);
+  mutex_destroy(&job.mutex);
+  bool success = true;
+  for (size_t i = 0; i < job.block_count; ++i) {
+    encoding_segment_block_t* block = &job.blocks[i];
+    success = success && !block->failed;
+    for (size_t j = 0; success && j < block->segments.count; ++j) {
+      encoding_segment_t* segment = &block->segments.items[j];
+      success = encoding_segments_push(
+        segments, segment->offset, segment->size, segment->charset, segment->confidence
+      );
+    }
+    free(block->segments.items);
+  }
+  free(job.blocks);
+  /* plain ascii is valid utf8 */
+  if (success && segments->count == 1 && !*segments->items[0].charset) {
+    strcpy(segments->items[0].charset, "UTF-8");
+    segments->items[0].confidence = 1.0f;
+  }
+  return success;
+}
+
+/* Decodes every segment with its charset into out as utf8. */
+static bool encoding_decode_segments(
+  const char* data, const encoding_segments_t* segments, bytes_t* out
+) {
+  for (size_t i = 0; i < segments->count; ++i) {
+    const encoding_segment_t* segment = &segments->items[i];
+    if (encoding_charset_equal(segment->charset, "UTF-8")) {
+      if (!bytes_reserve(out, segment->size)) {
+        if (errno != EFBIG)
+          errno = ENOMEM;
+        return false;
+      }
+      memcpy(out->data + out->size, data + segment->offset, segment->size);
+      out->size += segment->size;
+      continue;
+    }
+    encoding_conv_t conv;
+    if (!encoding_conv_open(&conv, "UTF-8", segment->charset, true))
+      return false;
+    bool success = encoding_conv_append(&conv, data + segment->offset, segment->size, false, out, NULL)
+      && encoding_conv_append(&conv, NULL, 0, false, out, NULL);
+    encoding_conv_close(&conv);
+    if (!success)
+      return false;
+  }
+  return true;
+}
+
+static void encoding_check_segment_options(
+  lua_State* L, int idx, encoding_segment_options_t* options
+) {
+  memset(options, 0, sizeof(encoding_segment_options_t));
+  options->block_size = SEGMENT_BLOCK_SIZE;
+  options->threads = thread_cpu_count();
+  strcpy(options->fallback, "ISO-8859-1");
+  if (!lua_istable(L, idx))
+    return;
+  lua_getfield(L, idx, "block_size");
+  lua_Integer block_size = luaL_optinteger(L, -1, options->block_size);
+  options->block_size = block_size > 256 ? block_size : 256;
+  lua_getfield(L, idx, "threads");
+  lua_Integer threads = luaL_optinteger(L, -1, options->threads);
+  options->threads = threads > 0 ? (threads < 64 ? threads : 64) : 1;
+  lua_getfield(L, idx, "fallback");
+  if (!lua_isnil(L, -1)) {
+    strncpy(options->fallback, luaL_checkstring(L, -1), CHARSET_NAME_MAX - 1);
+    options->fallback[CHARSET_NAME_MAX - 1] = 0;
+  }
+  lua_getfield(L, idx, "charsets");
+  if (lua_istable(L, -1)) {
+    for (size_t i = 1; i <= SEGMENT_MAX_CHARSETS; ++i) {
+      if (lua_rawgeti(L, -1, i) != LUA_TSTRING) {
+        lua_pop(L, 1);
+        break;
+      }
+      strncpy(options->charsets[options->charset_count], lua_tostring(L, -1), CHARSET_NAME_MAX - 1);
+      options->charsets[options->charset_count++][CHARSET_NAME_MAX - 1] = 0;
+      lua_pop(L, 1);
+    }
+  }
+  lua_pop(L, 4);
+}
+
+static void encoding_push_segments(lua_State* L, const encoding_segments_t* segments) {
+  lua_createtable(L, segments->count, 0);
+  for (size_t i = 0; i < segments->count; ++i) {
+    const encoding_segment_t* segment = &segments->items[i];
+    lua_createtable(L, 0, 4);
+    lua_pushstring(L, segment->charset);
+    lua_setfield(L, -2, "charset");
+    lua_pushinteger(L, segment->offset + 1);
+    lua_setfield(L, -2, "offset");
+    lua_pushinteger(L, segment->size);
+    lua_setfield(L, -2, "length");
+    lua_pushnumber(L, segment->confidence);
+    lua_setfield(L, -2, "confidence");
+    lua_rawseti(L, -2, i + 1);
+  }
+}
+
+/*
+ * Segments and decodes data into the arena, on success out holds the utf8
+ * text and the segments list is pushed, otherwise nil and the error message.
+*/
+static bool encoding_decode_mixed(
+  lua_State* L, const char* data, size_t size, int options_idx, bytes_t* out
+) {
+  encoding_segment_options_t options;
+  encoding_check_segment_options(L, options_idx, &options);
+  encoding_segments_t segments = { NULL, 0, 0 };
+  arena_reset(&encoding_arena);
+  bool success = encoding_segment(data, size, &options, &segments)
+    && bytes_reserve(out, size + 16)
+    && encoding_decode_segments(data, &segments, out);
+  int error = errno;
+  if (success) {
+    encoding_push_segments(L, &segments);
+  } else {
+    arena_reset(&encoding_arena);
+    lua_pushnil(L);
+    if (error == EFBIG)
+      lua_pushfstring(L, "output limit of %I bytes reached", (lua_Integer)encoding_max_output);
+    else
+      lua_pushstring(L, error == ENOMEM ? "out of memory" : strerror(error));
+  }
+  free(segments.items);
+  return success;
+}
+
+
+/*
+ * encoding.segments(text, options)
+ *
+ * Splits text mixing several ascii compatible charsets into segments at line
+ * boundaries, detecting the charset of each one.
+ *
+ * Arguments:
+ *  text, the string or encoding.buffer to split
+ *  options, a table with the following fields:
+ *    block_size, bytes classified by each job, 16KB by default
+ *    threads, amount of threads used, all cpus by default
+ *    charsets, list of the legacy charsets that can be reported
+ *    fallback, charset of lines that couldn't be detected, ISO-8859-1 default
+ *
+ * Returns:
+ *  The list of segments with charset, offset, length and confidence or nil
+ *  The error message
+ */
+int f_segments(lua_State *L) {
+  size_t len = 0;
+  const char* text = encoding_checkbytes(L, 1, &len);
+  encoding_segment_options_t options;
+  encoding_check_segment_options(L, 2, &options);
+  encoding_segments_t segments = { NULL, 0, 0 };
+  if (!encoding_segment(text, len, &options, &segments)) {
+    free(segments.items);
+    lua_pushnil(L);
+    lua_pushstring(L, "out of memory");
+    return 2;
+  }
+  encoding_push_segments(L, &segments);
+  free(segments.items);
+  return 1;
+}
+
+
+/*
+ * encoding.decode_mixed(text, options)
+ *
+ * Converts text mixing several charsets into utf8, every segment found as
+ * with encoding.segments() is decoded with its own charset in a single pass.
+ *
+ * Arguments:
+ *  text, the string or encoding.buffer to convert
+ *  options, same as encoding.segments()
+ *
+ * Returns:
+ *  The utf8 string or nil
+ *  The list of segments or the error message
+ */
+int f_decode_mixed(lua_State *L) {
+  size_t len = 0;
+  const char* text = encoding_checkbytes(L, 1, &len);
+  bytes_t out = { NULL, 0, 0, &encoding_arena, encoding_max_output };
+  if (!encoding_decode_mixed(L, text, len, 2, &out))
+    return 2;
+  lua_pushlstring(L, out.data ? out.data : "", out.size);
+  lua_insert(L, -2);
+  arena_reset(&encoding_arena);
+  return 2;
+}
+
+
+/* Name of the userdata metatable of encoding.source */
+#define SOURCE_METATABLE "encoding.source"
+
+/*
+ * Writes the snapshot of the lines table at idx, decoded from the given file
+ * content. Failures are not reported since the snapshot is only a cache.
+*/
+static void encoding_snapshot_write(
+  lua_State* L, int idx, const char* filename, size_t size, long long mtime,
+  unsigned long long hash, const char* charset, bool bom, bool crlf,
+  encoding_normalize_t normalize
+) {
+  char* path = encoding_snapshot_path(filename);
+  if (!path || snapshot_max_size == 0) {
+    free(path);
+    return;
+  }
+  idx = lua_absindex(L, idx);
+  snapshot_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.source_size = size;
+  header.source_mtime = mtime;
+  header.source_hash = hash;
+  header.line_count = lua_rawlen(L, idx);
+  strncpy(header.charset, charset, CHARSET_NAME_MAX - 1);
+  header.bom = bom;
+  header.crlf = crlf;
+  header.normalize = normalize;
+  unsigned long long* offsets = malloc((header.line_count + 1) * sizeof(unsigned long long));
+  if (!offsets) {
+    free(path);
+    return;
+  }
+  offsets[0] = 0;
+  for (size_t i = 1; i <= header.line_count; ++i) {
+    lua_rawgeti(L, idx, i);
+    size_t len = 0;
+    lua_tolstring(L, -1, &len);
+    offsets[i] = offsets[i - 1] + len;
+    lua_pop(L, 1);
+  }
+  header.text_size = offsets[header.line_count];
+  unsigned long long total = sizeof(header)
+    + (header.line_count + 1) * sizeof(unsigned long long) + header.text_size;
+  size_t path_len = strlen(path);
+  char* temp = malloc(path_len + 5);
+  FILE* file = NULL;
+  if (total <= snapshot_max_size && temp) {
+    memcpy(temp, path, path_len);
+    strcpy(temp + path_len, ".tmp");
+    file = encoding_fopen(temp, "wb");
+  }
+  if (file) {
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+      && fwrite(offsets, sizeof(unsigned long long), header.line_count + 1, file) == header.line_count + 1;
+    for (size_t i = 1; written && i <= header.line_count; ++i) {
+      lua_rawgeti(L, idx, i);
+      size_t len = 0;
+      const char* line = lua_tolstring(L, -1, &len);
+      written = fwrite(line, 1, len, file) == len;
+      lua_pop(L, 1);
+    }
+    written = fclose(file) == 0 && written;
+    if (written && encoding_rename(temp, path)) {
+      snapshot_writes++;
+      encoding_snapshot_evict();
+    } else {
+      encoding_remove(temp);
+    }
+  }
+  free(temp);
+  free(offsets);
+  free(path);
+}
+
+
+/*
+ * encoding.load_snapshot(filename, options)
+ *
+ * Loads the lines of a file from the snapshot taken when it was last decoded,
+ * as long as the file didn't change since then.
+ *
+ * Arguments:
+ *  filename, path of the file as given to encoding.open()
+ *  options, a table with the following fields:
+ *    normalize, the normalization form the lines are expected in
+ *
+ * Returns:
+ *  The list of lines, each one ending with a newline, or nil
+ *  A table with the charset, bom and crlf fields, or the error message
+ */
+int f_load_snapshot(lua_State *L) {
+  const char* filename = luaL_checkstring(L, 1);
+  encoding_normalize_t normalize = NORMALIZE_NONE;
+  if (lua_istable(L, 2)) {
+    lua_getfield(L, 2, "normalize");
+    normalize = encoding_check_normalize(L, -1);
+    lua_pop(L, 1);
+  }
+  char* path = encoding_snapshot_path(filename);
+  if (!path) {
+    lua_pushnil(L);
+    lua_pushstring(L, snapshot_dir ? "out of memory" : "snapshots are disabled");
+    return 2;
+  }
+  encoding_map_t source, snapshot;
+  const char* errmsg = NULL;
+  if (!encoding_map_file(path, &snapshot, &errmsg)) {
+    free(path);
+    lua_pushnil(L);
+    lua_pushstring(L, "no snapshot");
+    return 2;
+  }
+  if (!encoding_map_file(filename, &source, &errmsg)) {
+    encoding_unmap_file(&snapshot);
+    free(path);
+    lua_pushnil(L);
+    lua_pushstring(L, errmsg);
+    return 2;
+  }
+  const snapshot_header_t* header = (const snapshot_header_t*)snapshot.data;
+  const unsigned long long* offsets = (const unsigned long long*)(header + 1);
+  bool valid = snapshot.size >= sizeof(snapshot_header_t)
+    && memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) == 0
+    && header->version == SNAPSHOT_VERSION
+    && header->line_count < snapshot.size / sizeof(unsigned long long)
+    && header->text_size < snapshot.size
+    && snapshot.size == sizeof(snapshot_header_t)
+      + (header->line_count + 1) * sizeof(unsigned long long) + header->text_size
+    && offsets[header->line_count] == header->text_size
+    && header->charset[CHARSET_NAME_MAX - 1] == 0;
+  bool fresh = valid
+    && header->source_size == source.size && header->source_mtime == source.mtime
+    && header->source_hash == encoding_snapshot_hash(source.data, source.size);
+  encoding_unmap_file(&source);
+  if (!fresh || header->normalize != normalize) {
+    encoding_unmap_file(&snapshot);
+    if (!fresh)
+      encoding_remove(path);
+    free(path);
+    lua_pushnil(L);
+    lua_pushstring(L, fresh ? "snapshot has another normalization" : "stale snapshot");
+    return 2;
+  }
+  const char* text = (const char*)(offsets + header->line_count + 1);
+  lua_createtable(L, header->line_count, 0);
+  for (size_t i = 0; i < header->line_count; ++i) {
+    if (offsets[i] > offsets[i + 1]) {
+      encoding_unmap_file(&snapshot);
+      encoding_remove(path);
+      free(path);
+      lua_pushnil(L);
+      lua_pushstring(L, "corrupted snapshot");
+      return 2;
+    }
+    lua_pushlstring(L, text + offsets[i], offsets[i + 1] - offsets[i]);
+    lua_rawseti(L, -2, i + 1);
+  }
+  lua_createtable(L, 0, 3);
+  lua_pushstring(L, header->charset);
+  lua_setfield(L, -2, "charset");
+  lua_pushboolean(L, header->bom);
+  lua_setfield(L, -2, "bom");
+  lua_pushboolean(L, header->crlf);
+  lua_setfield(L, -2, "crlf");
+  encoding_unmap_file(&snapshot);
+  encoding_touch(path);
+  free(path);
+  snapshot_hits++;
+  return 2;
+}
+
+
+/* Detects and decodes the file of an entry, without the lua state or arena. */
+static void prefetch_decode(prefetch_entry_t* entry, size_t max_size) {
+  encoding_map_t map;
+  const char* errmsg = NULL;
+  if (!encoding_map_file(entry->path, &map, &errmsg)) {
+    entry->error = "unable to open file";
+    return;
+  }
+  entry->size = map.size;
+  entry->mtime = map.mtime;
+  bool bom = false;
+  if (map.size > max_size) {
+    entry->error = "file too big to prefetch";
+  } else if (!entry->charset[0]
+    && !encoding_detect(map.data, map.size < DETECT_SAMPLE_SIZE ? map.size : DETECT_SAMPLE_SIZE, entry->charset, &bom)) {
+    entry->error = "no charset detected";
+  }
+  if (entry->error) {
+    encoding_unmap_file(&map);
+    return;
+  }
+  size_t bom_len = 0;
+  const char* bom_bytes = encoding_bom_from_charset(entry->charset, &bom_len);
+  if (bom_len > map.size || memcmp(map.data, bom_bytes, bom_len) != 0)
+    bom_len = 0;
+  entry->bom = bom_len > 0;
+  const char* data = map.data + bom_len;
+  size_t len = map.size - bom_len;
+  hash_state_t input_hash;
+  hash_init(&input_hash, 0);
+  hash_update(&input_hash, map.data, bom_len);
+  bytes_t out = { NULL, 0, 0, NULL, encoding_max_output };
+  bool success;
+  if (charset_from_name(entry->charset)->kind == CHARSET_UTF8) {
+    hash_update(&input_hash, data, len);
+    success = bytes_reserve(&out, len);
+    if (success && len > 0) {
+      memcpy(out.data, data, len);
+      out.size = len;
+    }
+  } else {
+    encoding_conv_t conv;
+    success = encoding_conv_open(&conv, "UTF-8", entry->charset, false);
+    if (success) {
+      success = bytes_reserve(&out, len + 16) && encoding_conv_hashed(
+        &conv, data, len, false, FALLBACK_NONE, &out, NULL, NULL, &input_hash, NULL
+      );
+      encoding_conv_close(&conv);
+    }
+  }
+  encoding_unmap_file(&map);
+  if (!success) {
+    bytes_free(&out);
+    entry->error = "unable to decode";
+    return;
+  }
+  entry->hash = hash_digest(&input_hash);
+  entry->text = out.data;
+  entry->text_len = out.size;
+}
+
+/* Decodes the pending entries, highest priority and most recent first. */
+static void* prefetch_thread(void* data) {
+  (void)data;
+  mutex_lock(&prefetch_mutex);
+  while (true) {
+    prefetch_entry_t* entry = NULL;
+    for (prefetch_entry_t* pending = prefetch_entries; pending; pending = pending->next) {
+      if (pending->state == PREFETCH_PENDING && (!entry || pending->priority > entry->priority))
+        entry = pending;
+    }
+    if (!entry) {
+      cond_wait(&prefetch_cond, &prefetch_mutex);
+      continue;
+    }
+    entry->state = PREFETCH_RUNNING;
+    size_t max_size = prefetch_max_size;
+    mutex_unlock(&prefetch_mutex);
+    prefetch_decode(entry, max_size);
+    mutex_lock(&prefetch_mutex);
+    entry->state = PREFETCH_DONE;
+    if (entry->dropped) {
+      prefetch_entry_free(entry);
+    } else {
+      if (entry->text_len > prefetch_max_memory) {
+        free(entry->text);
+        entry->text = NULL;
+        entry->text_len = 0;
+        entry->error = "file too big to prefetch";
+      }
+      prefetch_memory += entry->text_len;
+      prefetch_evict();
+    }
+    cond_broadcast(&prefetch_cond);
+  }
+  mutex_unlock(&prefetch_mutex);
+  return NULL;
+}
+
+
+/*
+ * encoding.prefetch(paths, options)
+ *
+ * Queues files likely to be opened soon to be detected and decoded on
+ * background threads, files already queued are requested again. Only files
+ * up to the configured prefetch_max_size are decoded. Files decoded, or that
+ * failed to, are decoded again when they changed since.
+ *
+ * Arguments:
+ *  paths, a filename or a list of them
+ *  options, a table with the following optional fields:
+ *    priority, files with a higher one are decoded first, defaults to 0
+ *    charset, decode the files with this charset instead of detecting it
+ */
+int f_prefetch(lua_State *L) {
+  lua_Integer priority = 0;
+  char charset[CHARSET_NAME_MAX] = "";
+  if (lua_istable(L, 2)) {
+    lua_getfield(L, 2, "priority");
+    priority = luaL_optinteger(L, -1, 0);
+    lua_getfield(L, 2, "charset");
+    const char* name = luaL_optstring(L, -1, "");
+    luaL_argcheck(L, strlen(name) < CHARSET_NAME_MAX, 2, "charset name too long");
+    strcpy(charset, name);
+    lua_pop(L, 2);
+  }
+  bool list = lua_istable(L, 1);
+  if (!list)
+    luaL_checkstring(L, 1);
+  size_t count = list ? lua_rawlen(L, 1) : 1;
+  for (size_t i = 1; i <= count; ++i) {
+    if (list)
+      lua_rawgeti(L, 1, i);
+    else
+      lua_pushvalue(L, 1);
+    const char* path = luaL_checkstring(L, -1);
+    unsigned long long size = 0;
+    long long mtime = 0;
+    bool stamped = encoding_file_stamp(path, &size, &mtime);
+    mutex_lock(&prefetch_mutex);
+    prefetch_entry_t** link = prefetch_find(path);
+    prefetch_entry_t* entry = *link ? prefetch_unlink(link) : NULL;
+    /* done with a file that changed since, or couldn't be read then */
+    if (entry && entry->state == PREFETCH_DONE
+      && (!stamped || entry->size != size || entry->mtime != mtime)) {
+      prefetch_entry_free(entry);
+      entry = NULL;
+    }
+    /* asked with another charset than the one decoded or being decoded */
+    if (entry && charset[0] && entry->state != PREFETCH_PENDING
+      && (entry->state == PREFETCH_RUNNING || strcmp(entry->charset, charset) != 0)) {
+      if (entry->state == PREFETCH_RUNNING)
+        entry->dropped = true;
+      else
+        prefetch_entry_free(entry);
+      entry = NULL;
+    }
+    if (!entry) {
+      size_t len = strlen(path);
+      entry = calloc(1, sizeof(prefetch_entry_t) + len + 1);
+      if (entry)
+        memcpy(entry->path, path, len + 1);
+    }
+    if (entry) {
+      if (entry->state == PREFETCH_PENDING)
+        strcpy(entry->charset, charset);
+      entry->priority = priority;
+      entry->next = prefetch_entries;
+      prefetch_entries = entry;
+      prefetch_count++;
+      prefetch_memory += entry->text_len;
+      prefetch_evict();
+    }
+    mutex_unlock(&prefetch_mutex);
+    lua_pop(L, 1);
+  }
+  mutex_lock(&prefetch_mutex);
+  int threads = thread_cpu_count() > 1 ? PREFETCH_THREADS : 1;
+  while (prefetch_worker_count < threads
+    && thread_create(&prefetch_workers[prefetch_worker_count], prefetch_thread, NULL))
+    prefetch_worker_count++;
+  cond_broadcast(&prefetch_cond);
+  mutex_unlock(&prefetch_mutex);
+  return 0;
+}
+
+
+/*
+ * Pushes the lines and info of a decoded entry, or nil and the error when it
+ * failed, was decoded with another charset or the file changed since. The
+ * entry is freed, so it must be out of any queue already.
+*/
+static bool prefetch_push(
+  lua_State* L, const char* filename, prefetch_entry_t* entry, const char* error,
+  const char* charset, encoding_normalize_t normalize
+) {
+  if (!error && entry)
+    error = entry->error;
+  if (!error && charset && !encoding_charset_equal(entry->charset, charset))
+    error = "prefetched with another charset";
+  encoding_map_t map;
+  const char* errmsg = NULL;
+  if (!error) {
+    if (!encoding_map_file(filename, &map, &errmsg)) {
+      error = errmsg;
+    } else {
+      if (map.size != entry->size || map.mtime != entry->mtime
+        || encoding_hash64(map.data, map.size, 0) != entry->hash)
+        error = "file changed since prefetched";
+      encoding_unmap_file(&map);
+    }
+  }
+  if (error) {
+    lua_pushnil(L);
+    lua_pushstring(L, error);
+    if (entry)
+      prefetch_entry_free(entry);
+    return false;
+  }
+  const char* text = entry->text ? entry->text : "";
+  size_t text_len = entry->text_len;
+  arena_reset(&encoding_arena);
+  if (normalize != NORMALIZE_NONE
+    && !encoding_normalize_text(normalize, text, text_len, &text, &text_len)) {
+    prefetch_entry_free(entry);
+    luaL_error(L, "out of memory");
+    return false;
+  }
+  bool crlf = false;
+  encoding_push_lines(L, text, text_len, &crlf);
+  arena_reset(&encoding_arena);
+  lua_createtable(L, 0, 4);
+  lua_pushstring(L, entry->charset);
+  lua_setfield(L, -2, "charset");
+  lua_pushboolean(L, entry->bom);
+  lua_setfield(L, -2, "bom");
+  lua_pushboolean(L, crlf);
+  lua_setfield(L, -2, "crlf");
+  lua_pushinteger(L, entry->size);
+  lua_setfield(L, -2, "size");
+  prefetch_entry_free(entry);
+  return true;
+}
+
+
+/*
+ * encoding.prefetched(filename, options)
+ *
+ * Takes the lines of a prefetched file out of the queue. It never waits, a
+ * file still being decoded is left to its worker and reported as such, the
+ * caller decodes it itself or asks again later. Files changed since are not
+ * used.
+ *
+ * Arguments:
+ *  filename, the path given to encoding.prefetch()
+ *  options, a table with the following fields:
+ *    charset, the charset the file must have been decoded with, any if nil
+ *    normalize, "NFC" or "NFD" to normalize the lines
+ *
+ * Returns:
+ *  The list of lines, each one ending with a newline, or nil
+ *  A table with the charset, bom, crlf and size fields, or the error message
+ */
+int f_prefetched(lua_State *L) {
+  const char* filename = luaL_checkstring(L, 1);
+  const char* charset = NULL;
+  encoding_normalize_t normalize = NORMALIZE_NONE;
+  if (lua_istable(L, 2)) {
+    lua_getfield(L, 2, "charset");
+    charset = luaL_optstring(L, -1, NULL);
+    lua_getfield(L, 2, "normalize");
+    normalize = encoding_check_normalize(L, -1);
+    lua_pop(L, 2);
+  }
+  mutex_lock(&prefetch_mutex);
+  prefetch_entry_t** link = prefetch_find(filename);
+  prefetch_entry_t* entry = *link && (*link)->state != PREFETCH_RUNNING ? prefetch_unlink(link) : NULL;
+  const char* error = !*link && !entry ? "not prefetched" :
+    !entry ? "still being prefetched" :
+    entry->state == PREFETCH_PENDING ? "not prefetched yet" : NULL;
+  mutex_unlock(&prefetch_mutex);
+  if (prefetch_push(L, filename, entry, error, charset, normalize))
+    prefetch_hits++;
+  else
+    prefetch_misses++;
+  return 2;
+}
+
+
+/*
+ * Batch of files opened together, like the documents of a restored session.
+ * A pool of worker threads decodes them in the order given, which is the
+ * order their documents are wanted, so the first ones are ready soonest.
+*/
+#define BATCH_METATABLE "encoding.batch"
+
+typedef struct {
+  prefetch_entry_t** entries;   /* set to NULL once retrieved */
+  size_t count;
+  size_t next;                  /* first entry a worker may still pick */
+  size_t remaining;             /* entries not retrieved yet */
+  size_t max_size;
+  size_t max_memory;            /* text the workers decode in total, 0 for any */
+  size_t memory;
+  encoding_normalize_t normalize;
+  mutex_t mutex;
+  cond_t cond;
+  bool cancelled;
+  thread_t* workers;
+  int worker_count;
+} batch_job_t;
+
+static void* batch_thread(void* data) {
+  batch_job_t* job = data;
+  mutex_lock(&job->mutex);
+  while (true) {
+    /* entries are skipped when retrieved or decoded by job:take() already */
+    while (job->next < job->count && (!job->entries[job->next]
+      || job->entries[job->next]->state != PREFETCH_PENDING))
+      job->next++;
+    /* past the budget the rest is left to job:take() */
+    if (job->cancelled || job->next == job->count
+      || (job->max_memory && job->memory >= job->max_memory))
+      break;
+    prefetch_entry_t* entry = job->entries[job->next++];
+    entry->state = PREFETCH_RUNNING;
+    mutex_unlock(&job->mutex);
+    prefetch_decode(entry, job->max_size);
+    mutex_lock(&job->mutex);
+    entry->state = PREFETCH_DONE;
+    job->memory += entry->text_len;
+    cond_broadcast(&job->cond);
+  }
+  mutex_unlock(&job->mutex);
+  return NULL;
+}
+
+/* Joins the workers and drops the entries they didn't get to decode. */
+static void batch_job_stop(batch_job_t* job) {
+  if (!job->workers)
+    return;
+  mutex_lock(&job->mutex);
+  job->cancelled = true;
+  mutex_unlock(&job->mutex);
+  for (int i = 0; i < job->worker_count; ++i)
+    thread_join(job->workers[i]);
+  free(job->workers);
+  job->workers = NULL;
+  for (size_t i = 0; i < job->count; ++i) {
+    if (job->entries[i] && job->entries[i]->state == PREFETCH_PENDING) {
+      prefetch_entry_free(job->entries[i]);
+      job->entries[i] = NULL;
+      job->remaining--;
+    }
+  }
+}
+
+
+/*
+ * encoding.open_batch(paths, options)
+ *
+ * Starts detecting and decoding a list of files concurrently on a pool of
+ * worker threads, in the order given, so the first files should be the ones
+ * needed first, like the active document of a restored session.
+ *
+ * Arguments:
+ *  paths, the list of filenames
+ *  options, a table with the following optional fields:
+ *    threads, the amount of worker threads, defaults to the cpu count
+ *    max_size, files bigger than this amount of bytes are not decoded
+ *    max_memory, the workers stop once they decoded this amount of bytes of
+ *      text, the rest is decoded by job:take() when asked for
+ *    normalize, "NFC" or "NFD" to normalize the lines returned by job:poll()
+ *
+ * Returns:
+ *  A batch job which documents can be retrieved with job:poll() or job:take()
+ */
+int f_open_batch(lua_State *L) {
+  luaL_checktype(L, 1, LUA_TTABLE);
+  size_t count = lua_rawlen(L, 1);
+  int threads = thread_cpu_count();
+  size_t max_size = 0, max_memory = 0;
+  encoding_normalize_t normalize = NORMALIZE_NONE;
+  if (lua_istable(L, 2)) {
+    lua_getfield(L, 2, "threads");
+    threads = luaL_optinteger(L, -1, threads);
+    lua_getfield(L, 2, "max_size");
+    lua_Integer size = luaL_optinteger(L, -1, 0);
+    luaL_argcheck(L, size >= 0, 2, "max_size can't be negative");
+    max_size = size;
+    lua_getfield(L, 2, "max_memory");
+    lua_Integer memory = luaL_optinteger(L, -1, 0);
+    luaL_argcheck(L, memory >= 0, 2, "max_memory can't be negative");
+    max_memory = memory;
+    lua_getfield(L, 2, "normalize");
+    normalize = encoding_check_normalize(L, -1);
+    lua_pop(L, 4);
+  }
+  for (size_t i = 1; i <= count; ++i) {
+    lua_rawgeti(L, 1, i);
+    luaL_argcheck(L, lua_type(L, -1) == LUA_TSTRING, 1, "list of filenames expected");
+    lua_pop(L, 1);
+  }
+  if (threads > (int)count)
+    threads = count;
+  if (threads < 1)
+    threads = 1;
+  batch_job_t* job = lua_newuserdata(L, sizeof(batch_job_t));
+  memset(job, 0, sizeof(batch_job_t));
+  job->entries = calloc(count + 1, sizeof(prefetch_entry_t*));
+  if (!job->entries)
+    return luaL_error(L, "out of memory");
+  luaL_setmetatable(L, BATCH_METATABLE);
+  mutex_init(&job->mutex);
+  cond_init(&job->cond);
+  job->max_size = max_size ? max_size : (size_t)-1;
+  job->max_memory = max_memory;
+  job->normalize = normalize;
+  for (size_t i = 0; i < count; ++i) {
+    lua_rawgeti(L, 1, i + 1);
+    size_t len = 0;
+    const char* path = lua_tolstring(L, -1, &len);
+    prefetch_entry_t* entry = calloc(1, sizeof(prefetch_entry_t) + len + 1);
+    lua_pop(L, 1);
+    if (!entry)
+      return luaL_error(L, "out of memory");
+    memcpy(entry->path, path, len + 1);
+    job->entries[job->count++] = entry;
+    job->remaining++;
+  }
+  job->workers = calloc(threads, sizeof(thread_t));
+  for (int i = 0; job->workers && i < threads; ++i) {
+    if (!thread_create(&job->workers[job->worker_count], batch_thread, job))
+      break;
+    job->worker_count++;
+  }
+  if (job->worker_count == 0)
+    batch_thread(job);
+  return 1;
+}
+
+
+/*
+ * job:poll(max)
+ *
+ * Retrieve the documents decoded since the last call, in the order they were
+ * given to encoding.open_batch().
+ *
+ * Arguments:
+ *  max, the maximum amount of documents to retrieve, all if not given
+ *
+ * Returns:
+ *  A list of tables with the filename, lines, charset, bom, crlf and size
+ *  fields, or the filename and error fields if the file couldn't be decoded
+ *  True if all the documents were retrieved
+ */
+static int f_batch_poll(lua_State *L) {
+  batch_job_t* job = luaL_checkudata(L, 1, BATCH_METATABLE);
+  size_t max = luaL_optinteger(L, 2, 0);
+  size_t count = 0;
+  lua_newtable(L);
+  /*
+   * entries leave the job one at a time, right before being pushed, so the
+   * ones not reached when lua runs out of memory are still freed with it
+  */
+  for (size_t i = 0; i < job->count && (!max || count < max); ++i) {
+    mutex_lock(&job->mutex);
+    prefetch_entry_t* entry = job->entries[i] && job->entries[i]->state == PREFETCH_DONE ?
+      job->entries[i] : NULL;
+    mutex_unlock(&job->mutex);
+    if (!entry)
+      continue;
+    lua_pushstring(L, entry->path);
+    const char* filename = lua_tostring(L, -1);
+    mutex_lock(&job->mutex);
+    job->entries[i] = NULL;
+    job->remaining--;
+    mutex_unlock(&job->mutex);
+    if (prefetch_push(L, filename, entry, NULL, NULL, job->normalize)) {
+      /* filename, lines, info: the info table becomes the result */
+      lua_insert(L, -3);
+      lua_setfield(L, -3, "lines");
+      lua_setfield(L, -2, "filename");
+    } else {
+      /* filename, nil, error: a new table becomes the result */
+      lua_createtable(L, 0, 2);
+      lua_insert(L, -4);
+      lua_setfield(L, -4, "error");
+      lua_pop(L, 1);
+      lua_setfield(L, -2, "filename");
+    }
+    lua_rawseti(L, -2, ++count);
+  }
+  mutex_lock(&job->mutex);
+  bool done = job->remaining == 0;
+  mutex_unlock(&job->mutex);
+  lua_pushboolean(L, done);
+  return 2;
+}
+
+
+/*
+ * job:take(filename, options)
+ *
+ * Retrieves a document of the batch right away, decoding it on the calling
+ * thread if no worker started with it yet or waiting for the one that did.
+ *
+ * Arguments:
+ *  filename, one of the paths given to encoding.open_batch()
+ *  options, a table with the following fields:
+ *    charset, the charset the file must have been decoded with, any if nil
+ *    normalize, "NFC" or "NFD" to normalize the lines, defaults to the batch one
+ *
+ * Returns:
+ *  The list of lines, each one ending with a newline, or nil
+ *  A table with the charset, bom, crlf and size fields, or the error message
+ */
+static int f_batch_take(lua_State *L) {
+  batch_job_t* job = luaL_checkudata(L, 1, BATCH_METATABLE);
+  const char* filename = luaL_checkstring(L, 2);
+  const char* charset = NULL;
+  encoding_normalize_t normalize = job->normalize;
+  if (lua_istable(L, 3)) {
+    lua_getfield(L, 3, "charset");
+    charset = luaL_optstring(L, -1, NULL);
+    lua_getfield(L, 3, "normalize");
+    if (!lua_isnil(L, -1))
+      normalize = encoding_check_normalize(L, -1);
+    lua_pop(L, 2);
+  }
+  mutex_lock(&job->mutex);
+  size_t index = 0;
+  while (index < job->count
+    && (!job->entries[index] || strcmp(job->entries[index]->path, filename) != 0))
+    index++;
+  prefetch_entry_t* entry = index < job->count ? job->entries[index] : NULL;
+  if (entry && entry->state == PREFETCH_PENDING) {
+    entry->state = PREFETCH_RUNNING;
+    mutex_unlock(&job->mutex);
+    prefetch_decode(entry, job->max_size);
+    mutex_lock(&job->mutex);
+    entry->state = PREFETCH_DONE;
+  }
+  while (entry && entry->state == PREFETCH_RUNNING)
+    cond_wait(&job->cond, &job->mutex);
+  if (entry) {
+    job->entries[index] = NULL;
+    job->remaining--;
+  }
+  mutex_unlock(&job->mutex);
+  prefetch_push(L, filename, entry, entry ? NULL : "not in the batch", charset, normalize);
+  return 2;
+}
+
+
+/*
+ * job:cancel()
+ *
+ * Stops decoding, the documents decoded already can still be retrieved.
+ */
+static int f_batch_cancel(lua_State *L) {
+  batch_job_t* job = luaL_checkudata(L, 1, BATCH_METATABLE);
+  batch_job_stop(job);
+  return 0;
+}
+
+
+static int f_batch_len(lua_State *L) {
+  batch_job_t* job = luaL_checkudata(L, 1, BATCH_METATABLE);
+  mutex_lock(&job->mutex);
+  lua_pushinteger(L, job->remaining);
+  mutex_unlock(&job->mutex);
+  return 1;
+}
+
+
+static int f_batch_gc(lua_State *L) {
+  batch_job_t* job = luaL_checkudata(L, 1, BATCH_METATABLE);
+  if (!job->entries)
+    return 0;
+  batch_job_stop(job);
+  for (size_t i = 0; i < job->count; ++i) {
+    if (job->entries[i])
+      prefetch_entry_free(job->entries[i]);
+  }
+  free(job->entries);
+  job->entries = NULL;
+  mutex_destroy(&job->mutex);
+  cond_destroy(&job->cond);
+  return 0;
+}
+
+
+static const luaL_Reg batch_lib[] = {
+  { "poll",    f_batch_poll   },
+  { "take",    f_batch_take   },
+  { "cancel",  f_batch_cancel },
+  { "__len",   f_batch_len    },
+  { "__gc",    f_batch_gc     },
+  { NULL, NULL }
+};
+
+
+/*
+ * Documents saved together, like on save all. The lines of each one are copied
+ * when the job starts, then encoded and written on a pool of worker threads.
+*/
+#define SAVE_METATABLE "encoding.save"
+
+typedef struct {
+  char* text;                   /* utf8 copy of the lines */
+  size_t text_len;
+  char charset[CHARSET_NAME_MAX];
+  bool bom;
+  bool crlf;
+  prefetch_state_t state;
+  bool retrieved;
+  const char* error;
+  int error_number;             /* of a failed write */
+  size_t line;                  /* the first one that couldn't be encoded */
+  size_t substitutions;
+  size_t size;                  /* bytes written */
+  char path[];
+} save_entry_t;
+
+typedef struct {
+  save_entry_t** entries;
+  size_t count;
+  size_t next;                  /* first entry not picked by a worker */
+  size_t remaining;             /* entries not retrieved yet */
+  encoding_fallback_t fallback;
+  mutex_t mutex;
+  cond_t cond;
+  bool cancelled;
+  thread_t* workers;
+  int worker_count;
+} save_job_t;
+
+/* Encodes the text of an entry to its charset and writes it to the file. */
+static void save_write(save_entry_t* entry, encoding_fallback_t fallback) {
+  const char* text = entry->text ? entry->text : "";
+  size_t len = entry->text_len;
+  char* expanded = NULL;
+  if (entry->crlf) {
+    size_t newlines = 0;
+    for (const char* p = text; (p = memchr(p, '\n', text + len - p)); ++p)
+      newlines++;
+    expanded = newlines > 0 ? malloc(len + newlines) : NULL;
+    if (newlines > 0 && !expanded) {
+      entry->error = "out of memory";
+      return;
+    }
+    if (expanded) {
+      size_t size = 0;
+      for (size_t i = 0; i < len; ++i) {
+        if (text[i] == '\n')
+          expanded[size++] = '\r';
+        expanded[size++] = text[i];
+      }
+      text = expanded;
+      len = size;
+    }
+  }
+  size_t bom_len = 0;
+  const char* bom = entry->bom ? encoding_bom_from_charset(entry->charset, &bom_len) : NULL;
+  bytes_t out = { NULL, 0, 0, NULL, encoding_max_output };
+  const char* data = text;
+  size_t size = len;
+  bool success = true;
+  if (charset_from_name(entry->charset)->kind != CHARSET_UTF8 || bom_len > 0) {
+    encoding_conv_t conv;
+    const char* consumed = text;
+    success = bytes_reserve(&out, len + bom_len + 16);
+    if (success && bom_len > 0) {
+      memcpy(out.data, bom, bom_len);
+      out.size = bom_len;
+    }
+    if (success && charset_from_name(entry->charset)->kind == CHARSET_UTF8) {
+      memcpy(out.data + out.size, text, len);
+      out.size += len;
+    } else if (success) {
+      success = encoding_conv_open(&conv, entry->charset, "UTF-8", false);
+      if (!success)
+        entry->error = "unsupported charset";
+      if (success) {
+        success = encoding_conv_hashed(
+          &conv, text, len, true, fallback, &out, &consumed, &entry->substitutions, NULL, NULL
+        );
+        encoding_conv_close(&conv);
+        if (!success && errno == EILSEQ) {
+          entry->line = 1;
+          for (const char* p = text; (p = memchr(p, '\n', consumed - p)); ++p)
+            entry->line++;
+        }
+      }
+    }
+    if (!success && !entry->error) {
+      entry->error = errno == EFBIG ? "output limit reached" :
+        errno == ENOMEM ? "out of memory" : "illegal multibyte sequence";
+    }
+    data = out.data;
+    size = out.size;
+  }
+  if (success && !encoding_write_atomic(entry->path, data ? data : "", size, &entry->error_number))
+    entry->error = "unable to write the file";
+  else if (success)
+    entry->size = size;
+  bytes_free(&out);
+  free(expanded);
+  /* the copy of the lines is not needed anymore */
+  free(entry->text);
+  entry->text = NULL;
+}
+
+static void* save_thread(void* data) {
+  save_job_t* job = data;
+  mutex_lock(&job->mutex);
+  while (!job->cancelled && job->next < job->count) {
+    save_entry_t* entry = job->entries[job->next++];
+    entry->state = PREFETCH_RUNNING;
+    mutex_unlock(&job->mutex);
+    save_write(entry, job->fallback);
+    mutex_lock(&job->mutex);
+    entry->state = PREFETCH_DONE;
+    cond_broadcast(&job->cond);
+  }
+  mutex_unlock(&job->mutex);
+  return NULL;
+}
+
+static void save_job_stop(save_job_t* job) {
+  if (!job->workers)
+    return;
+  mutex_lock(&job->mutex);
+  job->cancelled = true;
+  mutex_unlock(&job->mutex);
+  for (int i = 0; i < job->worker_count; ++i)
+    thread_join(job->workers[i]);
+  free(job->workers);
+  job->workers = NULL;
+  for (size_t i = 0; i < job->count; ++i) {
+    if (job->entries[i]->state == PREFETCH_PENDING) {
+      job->entries[i]->state = PREFETCH_DONE;
+      job->entries[i]->error = "save cancelled";
+    }
+  }
+}
+
+
+/*
+ * encoding.save_batch(documents, options)
+ *
+ * Starts saving a list of documents on a pool of worker threads. The lines of
+ * each document are copied right away so it can be edited meanwhile, then
+ * encoded to its charset and written to a temporary file renamed over the
+ * original one, which is never left half written.
+ *
+ * Arguments:
+ *  documents, a list of tables with the following fields:
+ *    filename, the path of the file to write
+ *    lines, the list of utf8 lines, each one ending with a newline
+ *    charset, the charset to write the document in, defaults to UTF-8
+ *    bom, true to write the byte order mark of the charset first
+ *    crlf, true to write the newlines as \r\n
+ *  options, a table with the following optional fields:
+ *    threads, the amount of worker threads, defaults to the cpu count
+ *    on_unencodable, "translit", "entity" or "replace" to substitute the
+ *      characters the charset can't represent instead of failing
+ *
+ * Returns:
+ *  A save job which results can be retrieved with job:poll()
+ */
+int f_save_batch(lua_State *L) {
+  luaL_checktype(L, 1, LUA_TTABLE);
+  size_t count = lua_rawlen(L, 1);
+  int threads = thread_cpu_count();
+  encoding_fallback_t fallback = FALLBACK_NONE;
+  if (lua_istable(L, 2)) {
+    lua_getfield(L, 2, "threads");
+    threads = luaL_optinteger(L, -1, threads);
+    lua_getfield(L, 2, "on_unencodable");
+    const char* fallback_name = luaL_optstring(L, -1, "none");
+    while (encoding_fallback_names[fallback] && strcmp(encoding_fallback_names[fallback], fallback_name))
+      fallback++;
+    if (!encoding_fallback_names[fallback])
+      return luaL_error(L, "invalid on_unencodable option '%s'", fallback_name);
+    lua_pop(L, 2);
+  }
+  if (threads > (int)count)
+    threads = count;
+  if (threads < 1)
+    threads = 1;
+  save_job_t* job = lua_newuserdata(L, sizeof(save_job_t));
+  memset(job, 0, sizeof(save_job_t));
+  job->entries = calloc(count + 1, sizeof(save_entry_t*));
+  if (!job->entries)
+    return luaL_error(L, "out of memory");
+  luaL_setmetatable(L, SAVE_METATABLE);
+  mutex_init(&job->mutex);
+  cond_init(&job->cond);
+  job->fallback = fallback;
+  for (size_t i = 1; i <= count; ++i) {
+    lua_rawgeti(L, 1, i);
+    luaL_argcheck(L, lua_istable(L, -1), 1, "list of documents expected");
+    lua_getfield(L, -1, "filename");
+    size_t path_len = 0;
+    const char* path = luaL_checklstring(L, -1, &path_len);
+    lua_getfield(L, -2, "charset");
+    const char* charset = luaL_optstring(L, -1, "UTF-8");
+    luaL_argcheck(L, strlen(charset) < CHARSET_NAME_MAX, 1, "charset name too long");
+    lua_getfield(L, -3, "lines");
+    luaL_checktype(L, -1, LUA_TTABLE);
+    size_t line_count = lua_rawlen(L, -1);
+    size_t text_len = 0;
+    for (size_t j = 1; j <= line_count; ++j) {
+      size_t len = 0;
+      lua_rawgeti(L, -1, j);
+      if (!lua_tolstring(L, -1, &len))
+        return luaL_error(L, "line %d of %s is not a string", (int)j, path);
+      text_len += len;
+      lua_pop(L, 1);
+    }
+    save_entry_t* entry = calloc(1, sizeof(save_entry_t) + path_len + 1);
+    if (!entry)
+      return luaL_error(L, "out of memory");
+    job->entries[job->count++] = entry;
+    job->remaining++;
+    memcpy(entry->path, path, path_len + 1);
+    strcpy(entry->charset, charset);
+    entry->text = text_len > 0 ? malloc(text_len) : NULL;
+    if (text_len > 0 && !entry->text)
+      return luaL_error(L, "out of memory");
+    for (size_t j = 1; j <= line_count; ++j) {
+      size_t len = 0;
+      lua_rawgeti(L, -1, j);
+      const char* line = lua_tolstring(L, -1, &len);
+      memcpy(entry->text + entry->text_len, line, len);
+      entry->text_len += len;
+      lua_pop(L, 1);
+    }
+    lua_getfield(L, -4, "bom");
+    entry->bom = lua_toboolean(L, -1);
+    lua_getfield(L, -5, "crlf");
+    entry->crlf = lua_toboolean(L, -1);
+    lua_pop(L, 6);
+  }
+  job->workers = calloc(threads, sizeof(thread_t));
+  for (int i = 0; job->workers && i < threads; ++i) {
+    if (!thread_create(&job->workers[job->worker_count], save_thread, job))
+      break;
+    job->worker_count++;
+  }
+  if (job->worker_count == 0)
+    save_thread(job);
+  return 1;
+}
+
+
+/*
+ * job:poll(max)
+ *
+ * Retrieve the results of the documents saved since the last call, in the
+ * order they were given to encoding.save_batch().
+ *
+ * Arguments:
+ *  max, the maximum amount of results to retrieve, all if not given
+ *
+ * Returns:
+ *  A list of tables with the index of the document, its filename and the
+ *  size written and substitutions made, or the error and the line that
+ *  couldn't be encoded if any
+ *  True if all the documents were saved and their results retrieved
+ */
+static int f_save_poll(lua_State *L) {
+  save_job_t* job = luaL_checkudata(L, 1, SAVE_METATABLE);
+  size_t max = luaL_optinteger(L, 2, 0);
+  size_t* ready = lua_newuserdata(L, (job->count + 1) * sizeof(size_t));
+  size_t count = 0;
+  mutex_lock(&job->mutex);
+  for (size_t i = 0; i < job->count && (!max || count < max); ++i) {
+    if (!job->entries[i]->retrieved && job->entries[i]->state == PREFETCH_DONE) {
+      job->entries[i]->retrieved = true;
+      job->remaining--;
+      ready[count++] = i;
+    }
+  }
+  bool done = job->remaining == 0;
+  mutex_unlock(&job->mutex);
+  /* finished entries are not touched by the workers anymore */
+  lua_createtable(L, count, 0);
+  for (size_t i = 0; i < count; ++i) {
+    save_entry_t* entry = job->entries[ready[i]];
+    lua_createtable(L, 0, 4);
+    lua_pushinteger(L, ready[i] + 1);
+    lua_setfield(L, -2, "index");
+    lua_pushstring(L, entry->path);
+    lua_setfield(L, -2, "filename");
+    if (entry->error) {
+      if (entry->error_number)
+        lua_pushfstring(L, "%s: %s", entry->error, strerror(entry->error_number));
+      else
+        lua_pushstring(L, entry->error);
+      lua_setfield(L, -2, "error");
+      if (entry->line) {
+        lua_pushinteger(L, entry->line);
+        lua_setfield(L, -2, "line");
+      }
+    } else {
+      lua_pushinteger(L, entry->size);
+      lua_setfield(L, -2, "size");
+      lua_pushinteger(L, entry->substitutions);
+      lua_setfield(L, -2, "substitutions");
+    }
+    lua_rawseti(L, -2, i + 1);
+  }
+  lua_pushboolean(L, done);
+  return 2;
+}
+
+
+/*
+ * job:cancel()
+ *
+ * Stops saving, the documents not started yet are reported as not saved.
+ */
+static int f_save_cancel(lua_State *L) {
+  save_job_stop(luaL_checkudata(L, 1, SAVE_METATABLE));
+  return 0;
+}
+
+
+static int f_save_gc(lua_State *L) {
+  save_job_t* job = luaL_checkudata(L, 1, SAVE_METATABLE);
+  if (!job->entries)
+    return 0;
+  /* documents are still saved when the job is dropped */
+  for (int i = 0; job->workers && i < job->worker_count; ++i)
+    thread_join(job->workers[i]);
+  free(job->workers);
+  job->workers = NULL;
+  for (size_t i = 0; i < job->count; ++i) {
+    free(job->entries[i]->text);
+    free(job->entries[i]);
+  }
+  free(job->entries);
+  job->entries = NULL;
+  mutex_destroy(&job->mutex);
+  cond_destroy(&job->cond);
+  return 0;
+}
+
+
+static const luaL_Reg save_lib[] = {
+  { "poll",   f_save_poll   },
+  { "cancel", f_save_cancel },
+  { "__gc",   f_save_gc     },
+  { NULL, NULL }
+};
+
+
+/*
+ * Private copy of the raw bytes of a file so it can be decoded again with
+ * another charset without touching the disk. The raw line offsets are kept
+ * for the code unit layout and newline of the charset last previewed.
+*/
+typedef struct {
+  char* data;
+  size_t size;
+  char* path;
+  long long mtime;
+  size_t* lines;
+  size_t line_count;
+  size_t index_unit;
+  bool index_big_endian;
+  unsigned char index_newline;
+  size_t index_base;
+} encoding_source_t;
+
+/* Length of the bom of charset found at the start of the source, if any. */
+static size_t encoding_source_bom(const encoding_source_t* source, const char* charset) {
+  size_t bom_len = 0;
+  const char* bom = encoding_bom_from_charset(charset, &bom_len);
+  if (bom_len == 0 || bom_len > source->size || memcmp(source->data, bom, bom_len) != 0)
+    return 0;
+  return bom_len;
+}
+
+/* Builds the raw line offsets for the layout of cs if not already done. */
+static bool encoding_source_index(
+  encoding_source_t* source, const charset_t* cs, size_t base
+) {
+  if (
+    source->lines && source->index_unit == cs->unit
+    && source->index_big_endian == cs->big_endian
+    && source->index_newline == charset_newline(cs) && source->index_base == base
+  )
+    return true;
+  free(source->lines);
+  source->lines = NULL;
+  source->line_count = 0;
+  size_t capacity = 1024;
+  size_t* lines = malloc(capacity * sizeof(size_t));
+  if (!lines)
+    return false;
+  size_t count = 0;
+  size_t offset = base;
+  do {
+    if (count == capacity) {
+      size_t* grown = realloc(lines, capacity * 2 * sizeof(size_t));
+      if (!grown) {
+        free(lines);
+        return false;
+      }
+      lines = grown;
+      capacity *= 2;
+    }
+    lines[count++] = offset;
+    offset = encoding_line_end(cs, source->data, source->size, base, offset);
+  } while (offset < source->size);
+  source->lines = lines;
+  source->line_count = count;
+  source->index_unit = cs->unit;
+  source->index_big_endian = cs->big_endian;
+  source->index_newline = charset_newline(cs);
+  source->index_base = base;
+  return true;
+}
+
+/*
+ * Decodes len raw bytes of the source into the arena and pushes the resulting
+ * lines, or nil and an error message. The arena is reset afterwards. The raw
+ * bytes and the decoded text are added to the hashes given.
+*/
+static int encoding_source_push_lines(
+  lua_State* L, const char* charset, const char* data, size_t len, bool strict,
+  encoding_normalize_t normalize, hash_state_t* input_hash, hash_state_t* output_hash
+) {
+  bool crlf = false;
+  const char* text = data;
+  size_t text_len = len;
+  arena_reset(&encoding_arena);
+  if (charset_from_name(charset)->kind == CHARSET_UTF8) {
+    if (strict && !encoding_utf8_valid(data, len)) {
+      lua_pushnil(L);
+      lua_pushstring(L, "illegal multibyte sequence");
+      return 2;
+    }
+    if (input_hash)
+      hash_update(input_hash, data, len);
+    if (output_hash)
+      hash_update(output_hash, data, len);
+  } else {
+    encoding_conv_t conv;
+    if (!encoding_conv_open(&conv, "UTF-8", charset, true)) {
+      lua_pushnil(L);
+      lua_pushstring(L, strerror(errno));
+      return 2;
+    }
+    bytes_t out = { NULL, 0, 0, &encoding_arena, encoding_max_output };
+    bool success = bytes_reserve(&out, len + 16) && encoding_conv_hashed(
+      &conv, data, len, strict, FALLBACK_NONE, &out, NULL, NULL, input_hash, output_hash
+    );
+    int error = errno;
+    encoding_conv_close(&conv);
+    if (!success) {
+      arena_reset(&encoding_arena);
+      lua_pushnil(L);
+      if (error == EFBIG)
+        lua_pushfstring(L, "output limit of %I bytes reached", (lua_Integer)encoding_max_output);
+      else
+        lua_pushstring(L, error == ENOMEM ? "out of memory" : "illegal multibyte sequence");
+      return 2;
+    }
+    text = out.data ? out.data : "";
+    text_len = out.size;
+  }
+  const char* decoded = text;
+  if (normalize != NORMALIZE_NONE
+    && !encoding_normalize_text(normalize, text, text_len, &text, &text_len)) {
+    arena_reset(&encoding_arena);
+    return luaL_error(L, "out of memory");
+  }
+  if (output_hash && text != decoded) {
+    hash_init(output_hash, 0);
+    hash_update(output_hash, text, text_len);
+  }
+  encoding_push_lines(L, text, text_len, &crlf);
+  arena_reset(&encoding_arena);
+  lua_pushboolean(L, crlf);
+  return 2;
+}
+
+
+/*
+ * encoding.open(filename)
+ *
+ * Loads a private copy of the raw bytes of a file which can then be decoded
+ * with different charsets without reading the file again.
+ *
+ * Arguments:
+ *  filename, path of the file to load
+ *
+ * Returns:
+ *  The encoding.source or nil
+ *  The error message
+ */
+int f_open(lua_State *L) {
+  const char* filename = luaL_checkstring(L, 1);
+  encoding_map_t map;
+  const char* errmsg = NULL;
+  if (!encoding_map_file(filename, &map, &errmsg)) {
+    lua_pushnil(L);
+    lua_pushstring(L, errmsg);
+    return 2;
+  }
+  encoding_source_t* source = lua_newuserdata(L, sizeof(encoding_source_t));
+  memset(source, 0, sizeof(encoding_source_t));
+  luaL_setmetatable(L, SOURCE_METATABLE);
+  source->data = malloc(map.size > 0 ? map.size : 1);
+  if (!source->data) {
+    encoding_unmap_file(&map);
+    return luaL_error(L, "out of memory");
+  }
+  memcpy(source->data, map.data, map.size);
+  source->size = map.size;
+  source->mtime = map.mtime;
+  encoding_unmap_file(&map);
+  source->path = malloc(strlen(filename) + 1);
+  if (source->path)
+    strcpy(source->path, filename);
+  return 1;
+}
+
+
+/*
+ * source:detect(options)
+ *
+ * Detects the charset of the source using its first 100KB, options are the
+ * same of encoding.detect().
+ *
+ * Returns:
+ *  The charset string, the list of candidates or nil
+ *  Whether a BOM was present, or the error message
+ */
+static int f_source_detect(lua_State *L) {
+  encoding_source_t* source = luaL_checkudata(L, 1, SOURCE_METATABLE);
+  size_t sample = source->size < DETECT_SAMPLE_SIZE ? source->size : DETECT_SAMPLE_SIZE;
+  return encoding_push_detection(L, source->data, sample, 2);
+}
+
+
+/*
+ * source:decode(charset, options)
+ *
+ * Decodes the whole source into utf8 lines in a single pass, the bom of the
+ * charset is skipped when present.
+ *
+ * Arguments:
+ *  charset, the charset of the raw bytes
+ *  options, a table with the following fields:
+ *    strict, fail on invalid input instead of skipping it
+ *    normalize, "NFC" or "NFD" to normalize the decoded text
+ *    snapshot, keep a snapshot of the lines for encoding.load_snapshot()
+ *    hash, a table with input and output fields set to true to compute the
+ *      XXH64 of the raw bytes and of the decoded text
+ *
+ * Returns:
+ *  The list of lines, each one ending with a newline, or nil
+ *  True if carriage returns were removed from the line endings, or the error
+ *  True if a bom was skipped
+ *  When hash was given, a table with the input and output digests
+ */
+static int f_source_decode(lua_State *L) {
+  encoding_source_t* source = luaL_checkudata(L, 1, SOURCE_METATABLE);
+  const char* charset = luaL_checkstring(L, 2);
+  bool strict = false, snapshot = false;
+  encoding_normalize_t normalize = NORMALIZE_NONE;
+  hash_state_t input_state, output_state;
+  hash_state_t* input_hash = NULL;
+  hash_state_t* output_hash = NULL;
+  if (lua_istable(L, 3)) {
+    lua_getfield(L, 3, "strict");
+    strict = lua_toboolean(L, -1);
+    lua_getfield(L, 3, "normalize");
+    normalize = encoding_check_normalize(L, -1);
+    lua_getfield(L, 3, "snapshot");
+    snapshot = lua_toboolean(L, -1);
+    lua_getfield(L, 3, "hash");
+    encoding_check_hashes(L, -1, &input_state, &output_state, &input_hash, &output_hash);
+    lua_pop(L, 4);
+  }
+  /* the snapshot fingerprint is hashed while decoding */
+  hash_state_t* source_hash = input_hash;
+  snapshot = snapshot && source->path;
+  if (snapshot && !source_hash) {
+    hash_init(&input_state, 0);
+    source_hash = &input_state;
+  }
+  size_t bom_len = encoding_source_bom(source, charset);
+  if (source_hash)
+    hash_update(source_hash, source->data, bom_len);
+  if (encoding_source_push_lines(
+    L, charset, source->data + bom_len, source->size - bom_len, strict, normalize,
+    source_hash, output_hash
+  ) != 2 || lua_isnil(L, -2))
+    return 2;
+  if (snapshot)
+    encoding_snapshot_write(
+      L, -2, source->path, source->size, source->mtime, hash_digest(source_hash),
+      charset, bom_len > 0, lua_toboolean(L, -1), normalize
+    );
+  lua_pushboolean(L, bom_len > 0);
+  if (input_hash || output_hash) {
+    encoding_push_hashes(L, input_hash, output_hash);
+    return 4;
+  }
+  return 3;
+}
+
+
+/*
+ * source:preview(charset, first, last)
+ *
+ * Decodes only the given range of lines, meant to quickly show how the
+ * visible part of a document looks with another charset.
+ *
+ * Arguments:
+ *  charset, the charset of the raw bytes
+ *  first, the first line to decode
+ *  last, the last line to decode
+ *
+ * Returns:
+ *  The list of decoded lines starting at first, or nil
+ *  The total amount of lines in the source, or the error message
+ */
+static int f_source_preview(lua_State *L) {
+  encoding_source_t* source = luaL_checkudata(L, 1, SOURCE_METATABLE);
+  const char* charset = luaL_checkstring(L, 2);
+  lua_Integer first = luaL_checkinteger(L, 3);
+  lua_Integer last = luaL_checkinteger(L, 4);
+  size_t bom_len = encoding_source_bom(source, charset);
+  if (!encoding_source_index(source, charset_from_name(charset), bom_len))
+    return luaL_error(L, "out of memory");
+  if (first < 1)
+    first = 1;
+  if (last > (lua_Integer)source->line_count)
+    last = source->line_count;
+  if (first > last) {
+    lua_newtable(L);
+    lua_pushinteger(L, source->line_count);
+    return 2;
+  }
+  size_t from = source->lines[first - 1];
+  size_t to = (size_t)last < source->line_count ? source->lines[last] : source->size;
+  if (encoding_source_push_lines(
+    L, charset, source->data + from, to - from, false, NORMALIZE_NONE, NULL, NULL
+  ) != 2
+    || lua_isnil(L, -2))
+    return 2;
+  lua_pop(L, 1);
+  lua_pushinteger(L, source->line_count);
+  return 2;
+}
+
+
+/*
+ * source:decode_mixed(options)
+ *
+ * Decodes a source mixing several charsets into lines, options are the same
+ * of encoding.segments().
+ *
+ * Returns:
+ *  The list of lines, each one ending with a newline, or nil
+ *  True if carriage returns were removed from the line endings, or the error
+ *  The list of segments
+ */
+static int f_source_decode_mixed(lua_State *L) {
+  encoding_source_t* source = luaL_checkudata(L, 1, SOURCE_METATABLE);
+  bytes_t out = { NULL, 0, 0, &encoding_arena, encoding_max_output };
+  if (!encoding_decode_mixed(L, source->data, source->size, 2, &out))
+    return 2;
+  bool crlf = false;
+  encoding_push_lines(L, out.data ? out.data : "", out.size, &crlf);
+  arena_reset(&encoding_arena);
+  lua_pushboolean(L, crlf);
+  lua_rotate(L, -3, -1);
+  return 3;
+}
+
+
+static int f_source_len(lua_State *L) {
+  lua_pushinteger(L, ((encoding_source_t*)luaL_checkudata(L, 1, SOURCE_METATABLE))->size);
+  return 1;
+}
+
+
+static int f_source_gc(lua_State *L) {
+  encoding_source_t* source = luaL_checkudata(L, 1, SOURCE_METATABLE);
+  free(source->data);
+  free(source->lines);
+  free(source->path);
+  source->data = NULL;
+  source->lines = NULL;
+  source->path = NULL;
+  source->size = source->line_count = 0;
+  return 0;
+}
+
+
+static const luaL_Reg source_lib[] = {
+  { "detect",       f_source_detect       },
+  { "decode",       f_source_decode       },
+  { "decode_mixed", f_source_decode_mixed },
+  { "preview",      f_source_preview      },
+  { "__len",        f_source_len          },
+  { "__gc",         f_source_gc           },
+  { NULL, NULL }
+};
+
+
+/*
+ * Map of a file as blocks of whole lines with the hash of each, kept with a
+ * document to tell which parts of the file changed when it gets modified by
+ * another program. Block boundaries depend on the content of the lines
+ * before them, so an edit only changes the blocks around it and the ones
+ * after it resynchronize. Stateful charsets are not supported since their
+ * lines can't be decoded on their own.
+*/
+#define BLOCKS_METATABLE "encoding.blocks"
+#define BLOCK_MIN_SIZE (8*1024)
+#define BLOCK_MAX_SIZE (256*1024)
+#define BLOCK_MASK 0xFF
+
+typedef struct {
+  size_t offset;
+  size_t size;
+  size_t lines;
+  unsigned long long hash;
+} block_t;
+
+typedef struct {
+  char* path;
+  char charset[CHARSET_NAME_MAX];
+  encoding_normalize_t normalize;
+  size_t base;               /* length of the bom skipped */
+  block_t* blocks;
+  size_t count;
+} encoding_blocks_t;
+
+/* Splits the raw bytes from base on into blocks, false if out of memory. */
+static bool encoding_blocks_build(
+  const charset_t* cs, const char* data, size_t size, size_t base,
+  block_t** result, size_t* result_count
+) {
+  size_t capacity = 64, count = 0;
+  block_t* blocks = malloc(capacity * sizeof(block_t));
+  if (!blocks)
+    return false;
+  size_t offset = base;
+  while (offset < size) {
+    if (count == capacity) {
+      block_t* grown = realloc(blocks, capacity * 2 * sizeof(block_t));
+      if (!grown) {
+        free(blocks);
+        return false;
+      }
+      blocks = grown;
+      capacity *= 2;
+    }
+    block_t* block = &blocks[count++];
+    block->offset = offset;
+    block->lines = 0;
+    block->hash = 0;
+    size_t end = offset;
+    do {
+      size_t next = encoding_line_end(cs, data, size, base, end);
+      unsigned long long line_hash = encoding_hash64(data + end, next - end, 0);
+      block->hash = xxh_round(block->hash, line_hash);
+      block->lines++;
+      end = next;
+      if (end - offset >= BLOCK_MIN_SIZE && (line_hash & BLOCK_MASK) == 0)
+        break;
+    } while (end < size && end - offset < BLOCK_MAX_SIZE);
+    block->size = end - offset;
+    offset = end;
+  }
+  *result = blocks;
+  *result_count = count;
+  return true;
+}
+
+static bool block_equal(const block_t* a, const block_t* b) {
+  return a->hash == b->hash && a->size == b->size && a->lines == b->lines;
+}
+
+/*
+ * encoding.blocks(filename, charset, options)
+ *
+ * Creates the block map of a file, to later reload only the lines that
+ * changed with blocks:update().
+ *
+ * Arguments:
+ *  filename, path of the file
+ *  charset, the charset the document was decoded from
+ *  options, a table with the following fields:
+ *    normalize, the normalization form of the document lines
+ *
+ * Returns:
+ *  The encoding.blocks or nil
+ *  The error message
+ */
+int f_blocks(lua_State *L) {
+  const char* filename = luaL_checkstring(L, 1);
+  const char* charset = luaL_checkstring(L, 2);
+  encoding_normalize_t normalize = NORMALIZE_NONE;
+  if (lua_istable(L, 3)) {
+    lua_getfield(L, 3, "normalize");
+    normalize = encoding_check_normalize(L, -1);
+    lua_pop(L, 1);
+  }
+  const charset_t* cs = charset_from_name(charset);
+  if (cs->kind == CHARSET_STATEFUL || strlen(charset) >= CHARSET_NAME_MAX) {
+    lua_pushnil(L);
+    lua_pushfstring(L, "lines of %s can't be decoded on their own", charset);
+    return 2;
+  }
+  encoding_map_t map;
+  const char* errmsg = NULL;
+  if (!encoding_map_file(filename, &map, &errmsg)) {
+    lua_pushnil(L);
+    lua_pushstring(L, errmsg);
+    return 2;
+  }
+  encoding_blocks_t* blocks = lua_newuserdata(L, sizeof(encoding_blocks_t));
+  memset(blocks, 0, sizeof(encoding_blocks_t));
+  luaL_setmetatable(L, BLOCKS_METATABLE);
+  strcpy(blocks->charset, charset);
+  blocks->normalize = normalize;
+  const char* bom = encoding_bom_from_charset(charset, &blocks->base);
+  if (blocks->base > map.size || memcmp(map.data, bom, blocks->base) != 0)
+    blocks->base = 0;
+  blocks->path = malloc(strlen(filename) + 1);
+  bool success = blocks->path && encoding_blocks_build(
+    cs, map.data, map.size, blocks->base, &blocks->blocks, &blocks->count
+  );
+  encoding_unmap_file(&map);
+  if (!success)
+    return luaL_error(L, "out of memory");
+  strcpy(blocks->path, filename);
+  return 1;
+}
+
+/*
+ * blocks:update()
+ *
+ * Compares the file with its block map and decodes only the blocks that
+ * changed, the map is then updated to the current file.
+ *
+ * Returns:
+ *  The first document line that changed, or nil
+ *  The amount of lines to delete from there, or the error message
+ *  The list of lines to insert in their place
+ */
+static int f_blocks_update(lua_State *L) {
+  encoding_blocks_t* blocks = luaL_checkudata(L, 1, BLOCKS_METATABLE);
+  if (!blocks->path)
+    return luaL_error(L, "the block map is closed");
+  encoding_map_t map;
+  const char* errmsg = NULL;
+  if (!encoding_map_file(blocks->path, &map, &errmsg)) {
+    lua_pushnil(L);
+    lua_pushstring(L, errmsg);
+    return 2;
+  }
+  size_t base = 0;
+  const char* bom = encoding_bom_from_charset(blocks->charset, &base);
+  if (base > map.size || memcmp(map.data, bom, base) != 0)
+    base = 0;
+  if (base != blocks->base) {
+    encoding_unmap_file(&map);
+    lua_pushnil(L);
+    lua_pushstring(L, "the byte order mark changed");
+    return 2;
+  }
+  block_t* current = NULL;
+  size_t count = 0;
+  if (!encoding_blocks_build(
+    charset_from_name(blocks->charset), map.data, map.size, base, &current, &count
+  )) {
+    encoding_unmap_file(&map);
+    return luaL_error(L, "out of memory");
+  }
+  /* the blocks shared at the start and at the end are left untouched */
+  size_t prefix = 0, suffix = 0, first_line = 1;
+  if (blocks->count > 0 && count > 0) {
+    while (prefix < blocks->count && prefix < count && block_equal(&blocks->blocks[prefix], &current[prefix]))
+      first_line += blocks->blocks[prefix++].lines;
+    while (suffix < blocks->count - prefix && suffix < count - prefix
+      && block_equal(&blocks->blocks[blocks->count - suffix - 1], &current[count - suffix - 1]))
+      suffix++;
+  }
+  size_t deleted = 0;
+  for (size_t i = prefix; i < blocks->count - suffix; ++i)
+    deleted += blocks->blocks[i].lines;
+  /* an empty file is still a document with one empty line */
+  if (blocks->count == 0)
+    deleted = 1;
+  size_t from = prefix < count ? current[prefix].offset : map.size;
+  size_t to = suffix > 0 ? current[count - suffix].offset : map.size;
+  int results = 0;
+  if (from < to || count == 0) {
+    results = encoding_source_push_lines(
+      L, blocks->charset, map.data + from, to - from, false, blocks->normalize, NULL, NULL
+    );
+    if (results == 2 && !lua_isnil(L, -2)) {
+      lua_pop(L, 1);
+      results = 1;
+    }
+  } else {
+    lua_newtable(L);
+    results = 1;
+  }
+  encoding_unmap_file(&map);
+  if (results != 1) {
+    free(current);
+    return results;
+  }
+  free(blocks->blocks);
+  blocks->blocks = current;
+  blocks->count = count;
+  lua_pushinteger(L, first_line);
+  lua_pushinteger(L, deleted);
+  lua_rotate(L, -3, -1);
+  return 3;
+}
+
+static int f_blocks_len(lua_State *L) {
+  lua_pushinteger(L, ((encoding_blocks_t*)luaL_checkudata(L, 1, BLOCKS_METATABLE))->count);
+  return 1;
+}
+
+static int f_blocks_gc(lua_State *L) {
+  encoding_blocks_t* blocks = luaL_checkudata(L, 1, BLOCKS_METATABLE);
+  free(blocks->path);
+  free(blocks->blocks);
+  blocks->path = NULL;
+  blocks->blocks = NULL;
+  blocks->count = 0;
+  return 0;
+}
+
+
+static const luaL_Reg blocks_lib[] = {
+  { "update", f_blocks_update },
+  { "__len",  f_blocks_len    },
+  { "__gc",   f_blocks_gc     },
+  { NULL, NULL }
+};
+
+
+/*
+ * Streaming reader that transparently decompresses gzip and zstd files when
+ * the support was compiled in, plain files are read as they are.
+*/
+#define STREAM_CHUNK_SIZE (64*1024)
+
+typedef enum {
+  STREAM_PLAIN,
+  STREAM_GZIP,
+  STREAM_ZSTD
+} encoding_stream_format_t;
+
+static const char* encoding_stream_formats[] = { "none", "gzip", "zstd" };
+
+typedef struct {
+  FILE* file;
+  encoding_stream_format_t format;
+  unsigned char in[STREAM_CHUNK_SIZE];
+  size_t in_pos;
+  size_t in_size;
+  bool eof;
+  bool done;
+#ifdef ENCODING_ZLIB
+  z_stream zlib;
+#endif
+#ifdef ENCODING_ZSTD
+  ZSTD_DStream* zstd;
+#endif
+} encoding_stream_t;
+
+/* Refills the input chunk once all of it was consumed. */
+static bool encoding_stream_fill(encoding_stream_t* stream) {
+  if (stream->in_pos < stream->in_size || stream->eof)
+    return stream->in_pos < stream->in_size;
+  stream->in_pos = 0;
+  stream->in_size = fread(stream->in, 1, STREAM_CHUNK_SIZE, stream->file);
+  if (stream->in_size < STREAM_CHUNK_SIZE)
+    stream->eof = true;
+  return stream->in_size > 0;
+}
+
+static bool encoding_stream_open(
+  encoding_stream_t* stream, const char* filename, const char** errmsg
+) {
+  memset(stream, 0, sizeof(encoding_stream_t));
+  stream->file = encoding_fopen(filename, "rb");
+  if (!stream->file) {
+    *errmsg = strerror(errno);
+    return false;
+  }
+  encoding_stream_fill(stream);
+  const unsigned char* magic = stream->in;
+  if (stream->in_size >= 2 && magic[0] == 0x1F && magic[1] == 0x8B)
+    stream->format = STREAM_GZIP;
+  else if (
+    stream->in_size >= 4 && magic[0] == 0x28 && magic[1] == 0xB5
+    && magic[2] == 0x2F && magic[3] == 0xFD
+  )
+    stream->format = STREAM_ZSTD;
+  *errmsg = NULL;
+  switch (stream->format) {
+    case STREAM_GZIP:
+#ifdef ENCODING_ZLIB
+      /* 32 enables automatic gzip header detection */
+      if (inflateInit2(&stream->zlib, 15 + 32) != Z_OK)
+        *errmsg = "unable to initialize zlib";
+#else
+      *errmsg = "gzip support was not compiled in";
+#endif
+      break;
+    case STREAM_ZSTD:
+#ifdef ENCODING_ZSTD
+      stream->zstd = ZSTD_createDStream();
+      if (!stream->zstd || ZSTD_isError(ZSTD_initDStream(stream->zstd)))
+        *errmsg = "unable to initialize zstd";
+#else
+      *errmsg = "zstd support was not compiled in";
+#endif
+      break;
+    default:
+      break;
+  }
+  if (*errmsg) {
+#ifdef ENCODING_ZSTD
+    if (stream->zstd)
+      ZSTD_freeDStream(stream->zstd);
+#endif
+    fclose(stream->file);
+    return false;
+  }
+  return true;
+}
+
+static void encoding_stream_close(encoding_stream_t* stream) {
+#ifdef ENCODING_ZLIB
+  if (stream->format == STREAM_GZIP)
+    inflateEnd(&stream->zlib);
+#endif
+#ifdef ENCODING_ZSTD
+  if (stream->zstd)
+    ZSTD_freeDStream(stream->zstd);
+#endif
+  fclose(stream->file);
+}
+
+/*
+ * Reads up to size decompressed bytes into out, less are only returned at the
+ * end of the stream. Returns false with errmsg set on errors.
+*/
+static bool encoding_stream_read(
+  encoding_stream_t* stream, char* out, size_t size, size_t* read, const char** errmsg
+) {
+  *read = 0;
+  while (*read < size && !stream->done) {
+    if (!encoding_stream_fill(stream)) {
+      if (ferror(stream->file)) {
+        *errmsg = "error reading file";
+        return false;
+      }
+      stream->done = true;
+      break;
+    }
+    switch (stream->format) {
+      case STREAM_PLAIN: {
+        size_t count = stream->in_size - stream->in_pos;
+        if (count > size - *read)
+          count = size - *read;
+        memcpy(out + *read, stream->in + stream->in_pos, count);
+        stream->in_pos += count;
+        *read += count;
+        break;
+      }
+#ifdef ENCODING_ZLIB
+      case STREAM_GZIP: {
+        z_stream* z = &stream->zlib;
+        z->next_in = stream->in + stream->in_pos;
+        z->avail_in = stream->in_size - stream->in_pos;
+        z->next_out = (unsigned char*)out + *read;
+        z->avail_out = size - *read;
+        int status = inflate(z, Z_NO_FLUSH);
+        stream->in_pos = stream->in_size - z->avail_in;
+        *read = size - z->avail_out;
+        /* rotated logs are often several gzip members concatenated */
+        if (status == Z_STREAM_END)
+          inflateReset(z);
+        else if (status != Z_OK && status != Z_BUF_ERROR) {
+          *errmsg = z->msg ? z->msg : "corrupted gzip stream";
+          return false;
+        }
+        break;
+      }
+#endif
+#ifdef ENCODING_ZSTD
+      case STREAM_ZSTD: {
+        ZSTD_inBuffer input = { stream->in, stream->in_size, stream->in_pos };
+        ZSTD_outBuffer output = { out, size, *read };
+        size_t status = ZSTD_decompressStream(stream->zstd, &output, &input);
+        if (ZSTD_isError(status)) {
+          *errmsg = ZSTD_getErrorName(status);
+          return false;
+        }
+        stream->in_pos = input.pos;
+        *read = output.pos;
+        break;
+      }
+#endif
+      default:
+        stream->done = true;
+        break;
+    }
+  }
+  return true;
+}
+
+
+/*
+ * encoding.read_lines(filename, options)
+ *
+ * Reads a file decompressing it on the fly when it is gzip or zstd, detects
+ * its charset from the first decompressed window and decodes it chunk by
+ * chunk into utf8 lines, so the whole file is never held in memory compressed,
+ * decompressed and converted at once.
+ *
+ * Arguments:
+ *  filename, path of the file to read
+ *  options, a table with the following fields:
+ *    charset, the charset of the file, detected if not given
+ *    window, amount of decompressed bytes used for detection, 64KB default
+ *    hash, a table with input and output fields set to true to compute the
+ *      XXH64 of the decompressed raw bytes and of the decoded text
+ *
+ * Returns:
+ *  The list of lines, each one ending with a newline, or nil
+ *  A table with charset, bom, crlf, compression, size and when hash was
+ *  given hashes fields, or the error
+ */
+int f_read_lines(lua_State *L) {
+  const char* filename = luaL_checkstring(L, 1);
+  const char* charset = NULL;
+  size_t window = STREAM_CHUNK_SIZE;
+  hash_state_t input_state, output_state;
+  hash_state_t* input_hash = NULL;
+  hash_state_t* output_hash = NULL;
+  if (lua_istable(L, 2)) {
+    lua_getfield(L, 2, "charset");
+    charset = luaL_optstring(L, -1, NULL);
+    lua_getfield(L, 2, "window");
+    lua_Integer value = luaL_optinteger(L, -1, window);
+    window = value > 1024 ? value : 1024;
+    lua_getfield(L, 2, "hash");
+    encoding_check_hashes(L, -1, &input_state, &output_state, &input_hash, &output_hash);
+  }
+  const char* errmsg = NULL;
+  encoding_stream_t* stream = malloc(sizeof(encoding_stream_t));
+  if (!stream)
+    return luaL_error(L, "out of memory");
+  if (!encoding_stream_open(stream, filename, &errmsg)) {
+    free(stream);
+    lua_pushnil(L);
+    lua_pushstring(L, errmsg);
+    return 2;
+  }
+  size_t chunk_size = window > STREAM_CHUNK_SIZE ? window : STREAM_CHUNK_SIZE;
+  char* chunk = malloc(chunk_size);
+  bytes_t pending = { NULL, 0, 0, NULL, 0 };
+  bytes_t line = { NULL, 0, 0, NULL, 0 };
+  encoding_conv_t conv = { .iconv = (iconv_t)-1 };
+  bool bom = false, crlf = false, utf8 = false;
+  char detected[CHARSET_NAME_MAX];
+  size_t count = 0, total = 0, converted = 0, read = 0;
+  bool success = chunk && encoding_stream_read(stream, chunk, window, &read, &errmsg);
+  if (success) {
+    if (input_hash)
+      hash_update(input_hash, chunk, read);
+    if (!charset) {
+      if (!encoding_detect(chunk, read, detected, &bom))
+        strcpy(detected, "ISO-8859-1");
+      charset = detected;
+    }
+    size_t bom_len = 0;
+    const char* bom_bytes = encoding_bom_from_charset(charset, &bom_len);
+    bom = bom_len > 0 && read >= bom_len && memcmp(chunk, bom_bytes, bom_len) == 0;
+    if (bom) {
+      memmove(chunk, chunk + bom_len, read - bom_len);
+      read -= bom_len;
+    }
+    utf8 = charset_from_name(charset)->kind == CHARSET_UTF8;
+    if (!utf8 && !encoding_conv_open(&conv, "UTF-8", charset, true)) {
+      errmsg = strerror(errno);
+      success = false;
+    }
+  } else if (!chunk) {
+    errmsg = "out of memory";
+  }
+  lua_newtable(L);
+  while (success) {
+    /* bytes of an incomplete character are carried over to the next chunk */
+    const char* input = chunk;
+    size_t input_len = read;
+    if (pending.size > 0) {
+      success = bytes_reserve(&pending, read);
+      if (!success)
+        break;
+      memcpy(pending.data + pending.size, chunk, read);
+      pending.size += read;
+      input = pending.data;
+      input_len = pending.size;
+    }
+    total += read;
+    bool last = read == 0;
+    size_t decoded = line.size;
+    if (utf8) {
+      success = bytes_reserve(&line, input_len);
+      if (success) {
+        memcpy(line.data + line.size, input, input_len);
+        line.size += input_len;
+        pending.size = 0;
+      }
+    } else {
+      const char* consumed = input;
+      size_t before = line.size;
+      success = encoding_conv_feed(&conv, input, input_len, false, !last, &line, &consumed)
+        && (!last || encoding_conv_append(&conv, NULL, 0, false, &line, NULL));
+      size_t left = input_len - (consumed - input);
+      if (success && input == pending.data) {
+        memmove(pending.data, consumed, left);
+      } else if (success) {
+        pending.size = 0;
+        success = bytes_reserve(&pending, left);
+        if (success && left > 0)
+          memcpy(pending.data, consumed, left);
+      }
+      pending.size = left;
+      converted += line.size - before;
+    }
+    if (!success) {
+      errmsg = errno == ENOMEM ? "out of memory" : "conversion failed";
+      break;
+    }
+    if (utf8)
+      converted += input_len;
+    if (output_hash)
+      hash_update(output_hash, line.data + decoded, line.size - decoded);
+    if (encoding_max_output && converted > encoding_max_output) {
+      success = false;
+      errmsg = "output limit reached";
+      break;
+    }
+    size_t used = encoding_append_lines(L, -1, &count, line.data, line.size, last, &crlf);
+    memmove(line.data, line.data + used, line.size - used);
+    line.size -= used;
+    if (last)
+      break;
+    success = encoding_stream_read(stream, chunk, chunk_size, &read, &errmsg);
+    if (success && input_hash)
+      hash_update(input_hash, chunk, read);
+  }
+  encoding_conv_close(&conv);
+  encoding_stream_close(stream);
+  encoding_stream_format_t format = stream->format;
+  free(stream);
+  free(chunk);
+  bytes_free(&pending);
+  bytes_free(&line);
+  if (!success) {
+    lua_pop(L, 1);
+    lua_pushnil(L);
+    lua_pushstring(L, errmsg ? errmsg : "out of memory");
+    return 2;
+  }
+  if (count == 0) {
+    lua_pushliteral(L, "\n");
+    lua_rawseti(L, -2, 1);
+  }
+  lua_createtable(L, 0, 6);
+  lua_pushstring(L, charset);
+  lua_setfield(L, -2, "charset");
+  lua_pushboolean(L, bom);
+  lua_setfield(L, -2, "bom");
+  lua_pushboolean(L, crlf);
+  lua_setfield(L, -2, "crlf");
+  lua_pushstring(L, encoding_stream_formats[format]);
+  lua_setfield(L, -2, "compression");
+  lua_pushinteger(L, total);
+  lua_setfield(L, -2, "size");
+  if (input_hash || output_hash) {
+    encoding_push_hashes(L, input_hash, output_hash);
+    lua_setfield(L, -2, "hashes");
+  }
+  return 2;
+}
+
+
+/*
+ * Reader of files that only grow, like logs. It remembers how far the file
+ * was decoded and the shift state of the conversion, so each read decodes
+ * just the bytes appended since the previous one. All the bytes read so far
+ * are hashed to notice when the file was rewritten instead, anywhere.
+*/
+#define TAIL_METATABLE "encoding.tail"
+
+typedef struct {
+  encoding_conv_t conv;
+  bool open;
+  char* path;
+  size_t offset;             /* first raw byte not consumed yet */
+  hash_state_t read;         /* hash of the bytes before offset */
+  bool open_line;            /* last line read has no newline yet */
+  bool crlf;
+  bytes_t line;              /* utf8 text of that last line */
+} encoding_tail_t;
+
+/*
+ * encoding.tail(filename, charset, offset)
+ *
+ * Create a reader for the bytes appended to a file from the given offset on.
+ * The line that offset falls in is decoded again so it can be continued.
+ *
+ * Arguments:
+ *  filename, path of the file to follow
+ *  charset, the charset of the file
+ *  offset, amount of bytes already loaded, the current size by default
+ *
+ * Returns:
+ *  The encoding.tail or nil
+ *  The error message
+ */
+int f_tail(lua_State *L) {
+  const char* filename = luaL_checkstring(L, 1);
+  const char* charset = luaL_checkstring(L, 2);
+  encoding_map_t map;
+  const char* errmsg = NULL;
+  if (!encoding_map_file(filename, &map, &errmsg)) {
+    lua_pushnil(L);
+    lua_pushstring(L, errmsg);
+    return 2;
+  }
+  lua_Integer offset = luaL_optinteger(L, 3, map.size);
+  if (offset < 0 || (size_t)offset > map.size) {
+    encoding_unmap_file(&map);
+    return luaL_argerror(L, 3, "offset out of the file");
+  }
+  /* decoding starts past the bom, so its byte order must be explicit */
+  size_t bom_len = 0;
+  const char* bom_charset = encoding_charset_from_bom(map.data, map.size, &bom_len);
+  if (bom_charset && (encoding_charset_equal(charset, "UTF-16") || encoding_charset_equal(charset, "UTF-32"))
+    && strncmp(bom_charset, "UTF-", 4) == 0 && bom_charset[4] == charset[4])
+    charset = bom_charset;
+  encoding_tail_t* tail = lua_newuserdata(L, sizeof(encoding_tail_t));
+  memset(tail, 0, sizeof(encoding_tail_t));
+  if (!encoding_conv_open(&tail->conv, "UTF-8", charset, false)) {
+    encoding_unmap_file(&map);
+    lua_pushnil(L);
+    lua_pushstring(L, strerror(errno));
+    return 2;
+  }
+  luaL_setmetatable(L, TAIL_METATABLE);
+  tail->open = true;
+  tail->path = malloc(strlen(filename) + 1);
+  if (!tail->path) {
+    encoding_unmap_file(&map);
+    return luaL_error(L, "out of memory");
+  }
+  strcpy(tail->path, filename);
+  size_t base = 0;
+  const char* bom = encoding_bom_from_charset(charset, &base);
+  if (base > map.size || memcmp(map.data, bom, base) != 0)
+    base = 0;
+  size_t end = (size_t)offset > base ? (size_t)offset : base;
+  /* the last line loaded is decoded again to continue it */
+  const charset_t* cs = charset_from_name(charset);
+  unsigned char newline = charset_newline(cs);
+  size_t start = base;
+  for (size_t p = end; p > base; --p) {
+    size_t next = 0;
+    if ((unsigned char)map.data[p - 1] == newline
+      && encoding_is_newline(cs, map.data, end, base, p - 1, &next)) {
+      start = next;
+      break;
+    }
+  }
+  tail->open_line = start < end || end == base;
+  const char* consumed = map.data + start;
+  bool success = encoding_conv_feed(
+    &tail->conv, map.data + start, end - start, false, true, &tail->line, &consumed
+  );
+  tail->offset = consumed - map.data;
+  hash_init(&tail->read, 0);
+  hash_update(&tail->read, map.data, tail->offset);
+  encoding_unmap_file(&map);
+  if (!success)
+    return luaL_error(L, "out of memory");
+  return 1;
+}
+
+/*
+ * tail:read()
+ *
+ * Decodes the bytes appended to the file since the last read. A character
+ * still incomplete at the end of the file is left for the next read.
+ *
+ * Returns:
+ *  The list of new lines, each one ending with a newline, or nil
+ *  True if the first line replaces the last one previously returned, since
+ *  it had no newline yet, or the error message
+ */
+static int f_tail_read(lua_State *L) {
+  encoding_tail_t* tail = luaL_checkudata(L, 1, TAIL_METATABLE);
+  if (!tail->open)
+    return luaL_error(L, "the tail is closed");
+  encoding_map_t map;
+  const char* errmsg = NULL;
+  if (!encoding_map_file(tail->path, &map, &errmsg)) {
+    lua_pushnil(L);
+    lua_pushstring(L, errmsg);
+    return 2;
+  }
+  if (map.size < tail->offset
+    || encoding_hash64(map.data, tail->offset, 0) != hash_digest(&tail->read)) {
+    encoding_unmap_file(&map);
+    lua_pushnil(L);
+    lua_pushstring(L, "the file was rewritten");
+    return 2;
+  }
+  size_t count = 0;
+  lua_newtable(L);
+  if (map.size > tail->offset) {
+    const char* consumed = map.data + tail->offset;
+    bool success = encoding_conv_feed(
+      &tail->conv, map.data + tail->offset, map.size - tail->offset, false, true,
+      &tail->line, &consumed
+    );
+    int error = errno;
+    hash_update(&tail->read, map.data + tail->offset, consumed - (map.data + tail->offset));
+    tail->offset = consumed - map.data;
+    encoding_unmap_file(&map);
+    if (!success) {
+      lua_pushnil(L);
+      lua_pushstring(L, error == ENOMEM ? "out of memory" : "illegal multibyte sequence");
+      return 2;
+    }
+    size_t used = encoding_append_lines(L, -1, &count, tail->line.data, tail->line.size, false, &tail->crlf);
+    memmove(tail->line.data, tail->line.data + used, tail->line.size - used);
+    tail->line.size -= used;
+    /* the line without newline yet is shown too, and kept to continue it */
+    if (tail->line.size > 0) {
+      bool crlf = false;
+      encoding_append_lines(L, -1, &count, tail->line.data, tail->line.size, true, &crlf);
+    }
+  } else {
+    encoding_unmap_file(&map);
+  }
+  lua_pushboolean(L, count > 0 && tail->open_line);
+  if (count > 0)
+    tail->open_line = tail->line.size > 0;
+  return 2;
+}
+
+static int f_tail_len(lua_State *L) {
+  lua_pushinteger(L, ((encoding_tail_t*)luaL_checkudata(L, 1, TAIL_METATABLE))->offset);
+  return 1;
+}
+
+static int f_tail_gc(lua_State *L) {
+  encoding_tail_t* tail = luaL_checkudata(L, 1, TAIL_METATABLE);
+  if (tail->open)
+    encoding_conv_close(&tail->conv);
+  tail->open = false;
+  free(tail->path);
+  tail->path = NULL;
+  bytes_free(&tail->line);
+  return 0;
+}
+
+
+static const luaL_Reg tail_lib[] = {
+  { "read",  f_tail_read },
+  { "__len", f_tail_len  },
+  { "__gc",  f_tail_gc   },
+  { NULL, NULL }
+};
+
+
+/*
+ * Process wide cache of detected charsets keyed by path, entries are only
+ * valid as long as the file size and modification time don't change.
+*/
+typedef struct detect_cache_entry_s {
+  char* path;
+  unsigned long long size;
+  long long mtime;
+  char charset[CHARSET_NAME_MAX];
+  bool bom;
+  bool binary;
+  struct detect_cache_entry_s* next;
+} detect_cache_entry_t;
+
+#define DETECT_CACHE_BUCKETS 4096
+#define DETECT_CACHE_MAX_ENTRIES 262144
+static detect_cache_entry_t* detect_cache[DETECT_CACHE_BUCKETS];
+static size_t detect_cache_entries = 0;
+static mutex_t detect_cache_mutex;
+
+static unsigned int encoding_hash_string(const char* str) {
+  unsigned int hash = 2166136261u;
+  while (*str)
+    hash = (hash ^ (unsigned char)*str++) * 16777619u;
+  return hash;
+}
+
+static bool detect_cache_get(
+  const char* path, unsigned long long size, long long mtime,
+  char* charset, bool* bom, bool* binary
+) {
+  bool found = false;
+  mutex_lock(&detect_cache_mutex);
+  detect_cache_entry_t* entry = detect_cache[encoding_hash_string(path) % DETECT_CACHE_BUCKETS];
+  for (; entry; entry = entry->next) {
+    if (strcmp(entry->path, path) == 0) {
+      if (entry->size == size && entry->mtime == mtime) {
+        strcpy(charset, entry->charset);
+        *bom = entry->bom;
+        *binary = entry->binary;
+        found = true;
+      }
+      break;
+    }
+  }
+  mutex_unlock(&detect_cache_mutex);
+  return found;
+}
+
+static void detect_cache_clear() {
+  for (size_t i = 0; i < DETECT_CACHE_BUCKETS; ++i) {
+    while (detect_cache[i]) {
+      detect_cache_entry_t* next = detect_cache[i]->next;
+      free(detect_cache[i]->path);
+      free(detect_cache[i]);
+      detect_cache[i] = next;
+    }
+  }
+  detect_cache_entries = 0;
+}
+
+static void detect_cache_set(
+  const char* path, unsigned long long size, long long mtime,
+  const char* charset, bool bom, bool binary
+) {
+  mutex_lock(&detect_cache_mutex);
+  detect_cache_entry_t** bucket = &detect_cache[encoding_hash_string(path) % DETECT_CACHE_BUCKETS];
+  detect_cache_entry_t* entry = *bucket;
+  while (entry && strcmp(entry->path, path) != 0)
+    entry = entry->next;
+  if (!entry) {
+    if (detect_cache_entries >= DETECT_CACHE_MAX_ENTRIES) {
+      detect_cache_clear();
+      bucket = &detect_cache[encoding_hash_string(path) % DETECT_CACHE_BUCKETS];
+    }
+    entry = calloc(1, sizeof(detect_cache_entry_t));
+    char* copy = entry ? strdup(path) : NULL;
+    if (!copy) {
+      /* not caching it only means detecting it again */
+      free(entry);
+      mutex_unlock(&detect_cache_mutex);
+      return;
+    }
+    entry->path = copy;
+    entry->next = *bucket;
+    *bucket = entry;
+    detect_cache_entries++;
+  }
+  entry->size = size;
+  entry->mtime = mtime;
+  snprintf(entry->charset, sizeof(entry->charset), "%s", charset);
+  entry->bom = bom;
+  entry->binary = binary;
+  mutex_unlock(&detect_cache_mutex);
+}
+
+/*
+ * Detects the charset of a mapped file using its first 100KB, consulting the
+ * cache first. Files with null bytes and no unicode bom are flagged binary.
+*/
+static void encoding_detect_file(
+  const char* path, const encoding_map_t* map, long long mtime,
+  char* charset, bool* bom, bool* binary
+) {
+  if (detect_cache_get(path, map->size, mtime, charset, bom, binary))
+    return;
+  size_t sample = map->size < DETECT_SAMPLE_SIZE ? map->size : DETECT_SAMPLE_SIZE;
+  *binary = false;
+  if (!encoding_detect(map->data, sample, charset, bom))
+    strcpy(charset, "ISO-8859-1");
+  if (!*bom && memchr(map->data, 0, sample))
+    *binary = true;
+  detect_cache_set(path, map->size, mtime, charset, *bom, *binary);
+}
+
+
+#define GREP_METATABLE "encoding.grep"
+
+typedef struct grep_file_s {
+  struct grep_file_s* next;
+  unsigned long long size;
+  long long mtime;
+  char charset[CHARSET_NAME_MAX];
+  char path[];
+} grep_file_t;
+
+typedef struct grep_result_s {
+  struct grep_result_s* next;
+  grep_file_t* file;
+  size_t line;
+  size_t col;
+  size_t offset;
+  size_t text_len;
+  char text[];
+} grep_result_t;
+
+typedef struct {
+  char* root;
+  char* needle;
+  size_t needle_len;
+  char** exclude;
+  size_t max_size;
+  size_t limit;
+  bool hidden;
+  /* work queue filled by the walker thread */
+  mutex_t mutex;
+  cond_t cond;
+  grep_file_t* pending;
+  grep_file_t* pending_tail;
+  bool walking;
+  bool cancelled;
+  size_t files_searched;
+  size_t files_skipped;
+  /* results waiting to be drained by lua */
+  grep_result_t* results;
+  grep_result_t* results_tail;
+  size_t matches;
+  grep_file_t* matched_files;
+  /* threads */
+  thread_t walker;
+  thread_t* workers;
+  int worker_count;
+  int workers_running;
+  /* no worker thread could be started, files are searched on poll */
+  bool inline_search;
+} grep_job_t;
+
+static bool grep_cancelled(grep_job_t* job) {
+  mutex_lock(&job->mutex);
+  bool cancelled = job->cancelled;
+  mutex_unlock(&job->mutex);
+  return cancelled;
+}
+
+static bool grep_is_excluded(grep_job_t* job, const char* name) {
+  if (!job->hidden && name[0] == '.')
+    return true;
+  for (size_t i = 0; job->exclude && job->exclude[i]; ++i) {
+    if (strcmp(job->exclude[i], name) == 0)
+      return true;
+  }
+  return false;
+}
+
+static void grep_queue_file(
+  grep_job_t* job, const char* path, unsigned long long size, long long mtime
+) {
+  if (job->max_size && size > job->max_size)
+    return;
+  size_t len = strlen(path);
+  grep_file_t* file = malloc(sizeof(grep_file_t) + len + 1);
+  if (!file) {
+    mutex_lock(&job->mutex);
+    job->files_skipped++;
+    mutex_unlock(&job->mutex);
+    return;
+  }
+  memcpy(file->path, path, len + 1);
+  file->size = size;
+  file->mtime = mtime;
+  file->next = NULL;
+  file->charset[0] = 0;
+  mutex_lock(&job->mutex);
+  if (job->pending_tail)
+    job->pending_tail->next = file;
+  else
+    job->pending = file;
+  job->pending_tail = file;
+  cond_signal(&job->cond);
+  mutex_unlock(&job->mutex);
+}
+
+/* Depth first walk of a directory tree, queuing every regular file found. */
+static void grep_walk(grep_job_t* job, char* path, size_t len, size_t capacity) {
+  if (grep_cancelled(job))
+    return;
+#ifdef _WIN32
+  char* pattern = malloc(len + 3);
+  memcpy(pattern, path, len);
+  strcpy(pattern + len, "\\*");
+  wchar_t* wide = encoding_wide_path(pattern);
+  free(pattern);
+  WIN32_FIND_DATAW data;
+  HANDLE find = wide ? FindFirstFileW(wide, &data) : INVALID_HANDLE_VALUE;
+  free(wide);
+  if (find == INVALID_HANDLE_VALUE)
+    return;
+  do {
+    char name[MAX_PATH * 4];
+    if (!WideCharToMultiByte(CP_UTF8, 0, data.cFileName, -1, name, sizeof(name), NULL, NULL))
+      continue;
+    if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0 || grep_is_excluded(job, name))
+      continue;
+    if (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
+      continue;
+    size_t name_len = strlen(name);
+    if (len + name_len + 2 > capacity)
+      continue;
+    path[len] = '\\';
+    memcpy(path + len + 1, name, name_len + 1);
+    if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+      grep_walk(job, path, len + name_len + 1, capacity);
+    } else {
+      unsigned long long size = ((unsigned long long)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+      long long mtime = ((long long)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+      grep_queue_file(job, path, size, mtime);
+    }
+    path[len] = 0;
+  } while (!grep_cancelled(job) && FindNextFileW(find, &data));
+  FindClose(find);
+#else
+  DIR* dir = opendir(path);
+  if (!dir)
+    return;
+  struct dirent* entry;
+  while (!grep_cancelled(job) && (entry = readdir(dir))) {
+    const char* name = entry->d_name;
+    if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0 || grep_is_excluded(job, name))
+      continue;
+    size_t name_len = strlen(name);
+    if (len + name_len + 2 > capacity)
+      continue;
+    path[len] = '/';
+    memcpy(path + len + 1, name, name_len + 1);
+    struct stat st;
+    if (lstat(path, &st) == 0) {
+      if (S_ISDIR(st.st_mode))
+        grep_walk(job, path, len + name_len + 1, capacity);
+      else if (S_ISREG(st.st_mode))
+        grep_queue_file(job, path, st.st_size, st.st_mtime);
+    }
+    path[len] = 0;
+  }
+  closedir(dir);
+#endif
+}
+
+static void* grep_walker_thread(void* data) {
+  grep_job_t* job = data;
+  size_t capacity = 4096;
+  char* path = malloc(capacity);
+  size_t len = strlen(job->root);
+  if (path && len + 1 < capacity) {
+    memcpy(path, job->root, len + 1);
+    while (len > 1 && (path[len - 1] == '/' || path[len - 1] == '\\'))
+      path[--len] = 0;
+    grep_walk(job, path, len, capacity);
+  }
+  free(path);
+  mutex_lock(&job->mutex);
+  job->walking = false;
+  cond_broadcast(&job->cond);
+  mutex_unlock(&job->mutex);
+  return NULL;
+}
+
 typedef struct {
-  const char* charset;
-  unsigned char bom[4];
-  int len;
-} bom_t;
+  grep_job_t* job;
+  grep_file_t* file;
+  bool matched;
+} grep_match_context_t;
+
+static bool grep_push_match(void* udata, const encoding_match_t* match) {
+  grep_match_context_t* context = udata;
+  grep_job_t* job = context->job;
+  grep_result_t* result = malloc(sizeof(grep_result_t) + match->text_len + 1);
+  if (!result)
+    return false;
+  result->next = NULL;
+  result->file = context->file;
+  result->line = match->line;
+  result->col = match->col;
+  result->offset = match->offset;
+  result->text_len = match->text_len;
+  memcpy(result->text, match->text, match->text_len);
+  result->text[match->text_len] = 0;
+  mutex_lock(&job->mutex);
+  if (!context->matched) {
+    context->matched = true;
+    context->file->next = job->matched_files;
+    job->matched_files = context->file;
+  }
+  if (job->results_tail)
+    job->results_tail->next = result;
+  else
+    job->results = result;
+  job->results_tail = result;
+  job->matches++;
+  if (job->limit && job->matches >= job->limit)
+    job->cancelled = true;
+  bool keep_going = !job->cancelled;
+  mutex_unlock(&job->mutex);
+  return keep_going;
+}
+
+/* Searches one file taken from the queue, returns the amount of bytes read. */
+static size_t grep_search_file(grep_job_t* job, grep_file_t* file) {
+  grep_match_context_t context = { job, file, false };
+  encoding_map_t map;
+  const char* errmsg = NULL;
+  bool searched = false;
+  size_t size = 0;
+  if (encoding_map_file(file->path, &map, &errmsg)) {
+    bool bom = false, binary = false;
+    size_t bom_len = 0;
+    size = map.size;
+    encoding_detect_file(file->path, &map, file->mtime, file->charset, &bom, &binary);
+    if (!binary) {
+      if (bom)
+        encoding_bom_from_charset(file->charset, &bom_len);
+      encoding_search_t search = {
+        file->charset, map.data, map.size, bom_len,
+        job->needle, job->needle_len, true,
+        grep_push_match, &context
+      };
+      searched = encoding_search(&search, &errmsg);
+    }
+    encoding_unmap_file(&map);
+  }
+  mutex_lock(&job->mutex);
+  if (searched)
+    job->files_searched++;
+  else
+    job->files_skipped++;
+  mutex_unlock(&job->mutex);
+  if (!context.matched)
+    free(file);
+  return size;
+}
+
+/* Takes the next queued file, waiting for the walker unless told not to. */
+static grep_file_t* grep_next_file(grep_job_t* job, bool wait) {
+  mutex_lock(&job->mutex);
+  while (wait && !job->pending && job->walking && !job->cancelled)
+    cond_wait(&job->cond, &job->mutex);
+  grep_file_t* file = job->cancelled ? NULL : job->pending;
+  if (file) {
+    job->pending = file->next;
+    if (!job->pending)
+      job->pending_tail = NULL;
+  }
+  mutex_unlock(&job->mutex);
+  return file;
+}
+
+static void* grep_worker_thread(void* data) {
+  grep_job_t* job = data;
+  grep_file_t* file;
+  while ((file = grep_next_file(job, true)))
+    grep_search_file(job, file);
+  mutex_lock(&job->mutex);
+  job->workers_running--;
+  mutex_unlock(&job->mutex);
+  return NULL;
+}
 
 /*
- * List of encodings that can have byte order marks.
- * Note: UTF-32 should be tested before UTF-16, the order matters.
+ * Without worker threads the files are searched from job:poll(), a few at a
+ * time so the lua side can yield between calls instead of blocking on the
+ * whole directory.
 */
-static bom_t bom_list[] = {
-  { "UTF-8",    {0xef, 0xbb, 0xbf},       3 },
-  { "UTF-32LE", {0xff, 0xfe, 0x00, 0x00}, 4 },
-  { "UTF-32BE", {0x00, 0x00, 0xfe, 0xff}, 4 },
-  { "UTF-16LE", {0xff, 0xfe},             2 },
-  { "UTF-16BE", {0xfe, 0xff},             2 },
-  { "GB18030",  {0x84, 0x31, 0x95, 0x33}, 4 },
-  { "UTF-7",    {0x2b, 0x2f, 0x76, 0x38}, 4 },
-  { "UTF-7",    {0x2b, 0x2f, 0x76, 0x39}, 4 },
-  { "UTF-7",    {0x2b, 0x2f, 0x76, 0x2b}, 4 },
-  { "UTF-7",    {0x2b, 0x2f, 0x76, 0x2f}, 4 },
-  { NULL }
-};
+#define GREP_INLINE_FILES 16
+#define GREP_INLINE_BYTES (4 * 1024 * 1024)
+
+static void grep_search_inline(grep_job_t* job) {
+  size_t bytes = 0;
+  grep_file_t* file;
+  for (int i = 0; i < GREP_INLINE_FILES && bytes < GREP_INLINE_BYTES; ++i) {
+    if (!(file = grep_next_file(job, false)))
+      break;
+    bytes += grep_search_file(job, file);
+  }
+}
+
+static void grep_job_stop(grep_job_t* job) {
+  if (!job->workers)
+    return;
+  mutex_lock(&job->mutex);
+  job->cancelled = true;
+  cond_broadcast(&job->cond);
+  mutex_unlock(&job->mutex);
+  thread_join(job->walker);
+  for (int i = 0; i < job->worker_count; ++i)
+    thread_join(job->workers[i]);
+  free(job->workers);
+  job->workers = NULL;
+}
+
 
 /*
- * NOTE:
- * Newer uchardet currently has some issues properly detecting some instances of
- * UTF-8 as seen on https://gitlab.freedesktop.org/uchardet/uchardet/-/issues.
- * REF: https://github.com/notepad-plus-plus/notepad-plus-plus/issues/5310
+ * encoding.grep(root, text, options)
  *
- * For this reason, we included a third party MIT function to check if a string
- * is valid utf8 and prefer this result over the one from uchardet.
-*/
-int utf8_validate(const char *str, size_t len) {
-  int bytes_left = 0;
-  for (size_t i = 0; i < len; i++) {
-    int state = str[i];
-    if (bytes_left) {
-      if ((state & 0xC0) != 0x80)
-        return 0;
-      bytes_left--;
-    } else {
-      switch (state & 0xf0) {
-        case 0xf0 :  bytes_left = 3;  break;
-        case 0xe0 :  bytes_left = 2;  break;
-        case 0xd0 :
-        case 0xc0 :  bytes_left = 1;  break;
-        default   :  break;
+ * Starts searching all files inside a directory for the given utf8 text on a
+ * pool of worker threads. Each file charset is detected (and cached) and the
+ * text is searched for on its raw bytes as with encoding.search.
+ *
+ * Arguments:
+ *  root, the directory to search
+ *  text, the utf8 string to find
+ *  options, a table with the following optional fields:
+ *    threads, the amount of worker threads, defaults to the cpu count
+ *    limit, stop after this amount of matches
+ *    max_size, skip files bigger than this amount of bytes
+ *    exclude, a list of file or directory names to skip
+ *    hidden, when true also search files and directories starting with a dot
+ *
+ * Returns:
+ *  A grep job which results can be retrieved with job:poll()
+ */
+int f_grep(lua_State *L) {
+  const char* root = luaL_checkstring(L, 1);
+  size_t needle_len = 0;
+  const char* needle = luaL_checklstring(L, 2, &needle_len);
+  int threads = thread_cpu_count();
+  grep_job_t* job = lua_newuserdata(L, sizeof(grep_job_t));
+  memset(job, 0, sizeof(grep_job_t));
+  luaL_setmetatable(L, GREP_METATABLE);
+  job->root = strdup(root);
+  job->needle = malloc(needle_len + 1);
+  if (!job->root || !job->needle) {
+    free(job->root);
+    free(job->needle);
+    job->root = NULL;
+    job->needle = NULL;
+    return luaL_error(L, "out of memory");
+  }
+  memcpy(job->needle, needle, needle_len + 1);
+  job->needle_len = needle_len;
+  mutex_init(&job->mutex);
+  cond_init(&job->cond);
+  if (lua_istable(L, 3)) {
+    lua_getfield(L, 3, "threads");
+    threads = luaL_optinteger(L, -1, threads);
+    lua_getfield(L, 3, "limit");
+    job->limit = luaL_optinteger(L, -1, 0);
+    lua_getfield(L, 3, "max_size");
+    job->max_size = luaL_optinteger(L, -1, 0);
+    lua_getfield(L, 3, "hidden");
+    job->hidden = lua_toboolean(L, -1);
+    lua_getfield(L, 3, "exclude");
+    if (lua_istable(L, -1)) {
+      size_t count = lua_rawlen(L, -1);
+      job->exclude = calloc(count + 1, sizeof(char*));
+      if (!job->exclude)
+        return luaL_error(L, "out of memory");
+      for (size_t i = 0; i < count; ++i) {
+        lua_rawgeti(L, -1, i + 1);
+        const char* name = lua_tostring(L, -1);
+        if (!(job->exclude[i] = strdup(name ? name : "")))
+          return luaL_error(L, "out of memory");
+        lua_pop(L, 1);
       }
     }
+    lua_pop(L, 5);
+  }
+  if (threads < 1)
+    threads = 1;
+  job->walking = true;
+  job->workers = calloc(threads, sizeof(thread_t));
+  if (!job->workers) {
+    job->walking = false;
+    return luaL_error(L, "out of memory");
+  }
+  if (!thread_create(&job->walker, grep_walker_thread, job)) {
+    free(job->workers);
+    job->workers = NULL;
+    job->walking = false;
+    return luaL_error(L, "unable to start the grep threads");
   }
+  for (int i = 0; i < threads; ++i) {
+    if (!thread_create(&job->workers[job->worker_count], grep_worker_thread, job))
+      break;
+    job->worker_count++;
+    job->workers_running++;
+  }
+  if (job->worker_count == 0)
+    job->inline_search = true;
   return 1;
 }
 
-/* Get the applicable byte order marks for the given charset */
-static const char* encoding_bom_from_charset(const char* charset, size_t* len) {
-  for (size_t i=0; bom_list[i].charset != NULL; i++){
-    if (strcmp(bom_list[i].charset, charset) == 0) {
-      if (len) *len = bom_list[i].len;
-      return bom_list[i].bom;
+
+/*
+ * job:poll(max)
+ *
+ * Retrieve the matches found since the last call. When no worker thread could
+ * be started the next few files are searched first, on the calling thread.
+ *
+ * Arguments:
+ *  max, the maximum amount of matches to retrieve, all if not given
+ *
+ * Returns:
+ *  A list of matches with file, charset, line, col, offset and text fields
+ *  True if the search finished and all matches were retrieved
+ */
+static int f_grep_poll(lua_State *L) {
+  grep_job_t* job = luaL_checkudata(L, 1, GREP_METATABLE);
+  size_t max = luaL_optinteger(L, 2, 0);
+  if (job->inline_search)
+    grep_search_inline(job);
+  mutex_lock(&job->mutex);
+  grep_result_t* results = job->results;
+  grep_result_t* last = NULL;
+  size_t count = 0;
+  for (grep_result_t* result = results; result && (!max || count < max); result = result->next) {
+    last = result;
+    count++;
+  }
+  if (last) {
+    job->results = last->next;
+    if (!job->results)
+      job->results_tail = NULL;
+    last->next = NULL;
+  }
+  bool done = !job->results && (!job->workers || (
+    job->workers_running == 0 && !job->walking
+    && (!job->inline_search || !job->pending || job->cancelled)
+  ));
+  mutex_unlock(&job->mutex);
+  lua_createtable(L, count, 0);
+  for (size_t i = 1; results; ++i) {
+    grep_result_t* next = results->next;
+    lua_createtable(L, 0, 6);
+    lua_pushstring(L, results->file->path);
+    lua_setfield(L, -2, "file");
+    lua_pushstring(L, results->file->charset);
+    lua_setfield(L, -2, "charset");
+    lua_pushinteger(L, results->line);
+    lua_setfield(L, -2, "line");
+    lua_pushinteger(L, results->col);
+    lua_setfield(L, -2, "col");
+    lua_pushinteger(L, results->offset + 1);
+    lua_setfield(L, -2, "offset");
+    lua_pushlstring(L, results->text, results->text_len);
+    lua_setfield(L, -2, "text");
+    lua_rawseti(L, -2, i);
+    free(results);
+    results = next;
+  }
+  lua_pushboolean(L, done);
+  return 2;
+}
+
+
+/*
+ * job:cancel()
+ *
+ * Stops the search, matches already found can still be polled.
+ */
+static int f_grep_cancel(lua_State *L) {
+  grep_job_t* job = luaL_checkudata(L, 1, GREP_METATABLE);
+  grep_job_stop(job);
+  return 0;
+}
+
+
+/*
+ * job:status()
+ *
+ * Returns:
+ *  The amount of files searched, skipped and the matches found so far
+ */
+static int f_grep_status(lua_State *L) {
+  grep_job_t* job = luaL_checkudata(L, 1, GREP_METATABLE);
+  mutex_lock(&job->mutex);
+  lua_pushinteger(L, job->files_searched);
+  lua_pushinteger(L, job->files_skipped);
+  lua_pushinteger(L, job->matches);
+  mutex_unlock(&job->mutex);
+  return 3;
+}
+
+
+static int f_grep_gc(lua_State *L) {
+  grep_job_t* job = luaL_checkudata(L, 1, GREP_METATABLE);
+  if (!job->root)
+    return 0;
+  grep_job_stop(job);
+  while (job->pending) {
+    grep_file_t* next = job->pending->next;
+    free(job->pending);
+    job->pending = next;
+  }
+  while (job->results) {
+    grep_result_t* next = job->results->next;
+    free(job->results);
+    job->results = next;
+  }
+  while (job->matched_files) {
+    grep_file_t* next = job->matched_files->next;
+    free(job->matched_files);
+    job->matched_files = next;
+  }
+  for (size_t i = 0; job->exclude && job->exclude[i]; ++i)
+    free(job->exclude[i]);
+  free(job->exclude);
+  free(job->needle);
+  free(job->root);
+  job->root = NULL;
+  mutex_destroy(&job->mutex);
+  cond_destroy(&job->cond);
+  return 0;
+}
+
+
+static const luaL_Reg grep_lib[] = {
+  { "poll",   f_grep_poll   },
+  { "cancel", f_grep_cancel },
+  { "status", f_grep_status },
+  { "__gc",   f_grep_gc     },
+  { NULL, NULL }
+};
+
+
+/*
+ * Catalogue of the charsets supported by iconv, built once and cached. The
+ * charsets the plugin knows get its friendly name and region, libiconv also
+ * reports every alias it accepts while other iconv implementations only list
+ * known ones.
+*/
+typedef struct {
+  char* charset;
+  char* name;
+  int group;
+} catalogue_info_t;
+
+/* Regions and charsets known by name, given with encoding.configure() */
+static char** catalogue_groups = NULL;
+static size_t catalogue_group_count = 0;
+static catalogue_info_t* catalogue_info = NULL;
+static size_t catalogue_info_count = 0;
+#define CATALOGUE_OTHER ((int)catalogue_group_count)
+
+typedef struct {
+  char* charset;
+  const char* name;
+  int group;
+  bool bom;
+  bool fast;
+  char** aliases;
+  size_t alias_count;
+  char** keys;        /* uppercase alphanumeric only, for matching */
+  size_t key_count;
+  char* name_key;
+} catalogue_entry_t;
+
+static catalogue_entry_t* catalogue = NULL;
+static size_t catalogue_count = 0;
+static size_t catalogue_capacity = 0;
+
+/* Uppercase copy keeping only letters and digits, so utf8 matches UTF-8 */
+static char* catalogue_key(const char* text) {
+  char* key = malloc(strlen(text) + 1);
+  if (!key)
+    return NULL;
+  size_t len = 0;
+  for (; *text; ++text) {
+    char c = *text;
+    if (c >= 'a' && c <= 'z')
+      key[len++] = c - 32;
+    else if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+      key[len++] = c;
+  }
+  key[len] = 0;
+  return key;
+}
+
+static const catalogue_info_t* catalogue_find_info(const char* charset) {
+  for (size_t i = 0; i < catalogue_info_count; ++i) {
+    if (encoding_charset_equal(catalogue_info[i].charset, charset))
+      return &catalogue_info[i];
+  }
+  return NULL;
+}
+
+static catalogue_entry_t* catalogue_find(const char* charset) {
+  for (size_t i = 0; i < catalogue_count; ++i) {
+    if (encoding_charset_equal(catalogue[i].charset, charset))
+      return &catalogue[i];
+    for (size_t j = 0; j < catalogue[i].alias_count; ++j) {
+      if (encoding_charset_equal(catalogue[i].aliases[j], charset))
+        return &catalogue[i];
     }
   }
-  if (len) *len = 0;
-  return "";
+  return NULL;
 }
 
+/*
+ * Adds a charset and its aliases, the canonical name is the first one known
+ * to the plugin when any, otherwise the first given.
+*/
+static void catalogue_add(const char* const* names, size_t count) {
+  const catalogue_info_t* info = NULL;
+  size_t canonical = 0;
+  for (size_t i = 0; i < count && !info; ++i) {
+    if ((info = catalogue_find_info(names[i])))
+      canonical = i;
+  }
+  if (catalogue_count == catalogue_capacity) {
+    size_t capacity = catalogue_capacity ? catalogue_capacity * 2 : 256;
+    catalogue_entry_t* entries = realloc(catalogue, capacity * sizeof(catalogue_entry_t));
+    if (!entries)
+      return;
+    catalogue = entries;
+    catalogue_capacity = capacity;
+  }
+  catalogue_entry_t* entry = &catalogue[catalogue_count];
+  memset(entry, 0, sizeof(catalogue_entry_t));
+  entry->charset = strdup(info ? info->charset : names[canonical]);
+  entry->name = info ? info->name : entry->charset;
+  entry->group = info ? info->group : CATALOGUE_OTHER;
+  entry->aliases = malloc(count * sizeof(char*));
+  entry->keys = malloc((count + 1) * sizeof(char*));
+  bool allocated = entry->charset && entry->aliases && entry->keys;
+  for (size_t i = 0; allocated && i < count; ++i) {
+    if (!encoding_charset_equal(names[i], entry->charset)) {
+      if (!(entry->aliases[entry->alias_count] = strdup(names[i])))
+        allocated = false;
+      else
+        entry->alias_count++;
+    }
+    if (charset_from_name(names[i])->kind != CHARSET_STATEFUL)
+      entry->fast = true;
+  }
+  if (allocated && !(entry->keys[entry->key_count++] = catalogue_key(entry->charset)))
+    allocated = false;
+  if (allocated && info && !(entry->name_key = catalogue_key(info->name)))
+    allocated = false;
+  for (size_t i = 0; allocated && i < entry->alias_count; ++i) {
+    if (!(entry->keys[entry->key_count++] = catalogue_key(entry->aliases[i])))
+      allocated = false;
+  }
+  if (!allocated) {
+    /* out of memory, the charset is left out of the catalogue */
+    for (size_t i = 0; i < entry->alias_count; ++i)
+      free(entry->aliases[i]);
+    for (size_t i = 0; entry->keys && i < entry->key_count; ++i)
+      free(entry->keys[i]);
+    free(entry->aliases);
+    free(entry->keys);
+    free(entry->name_key);
+    free(entry->charset);
+    return;
+  }
+  catalogue_count++;
+  size_t bom_len = 0;
+  encoding_bom_from_charset(entry->charset, &bom_len);
+  entry->bom = bom_len > 0;
+}
 
-/* Detect the encoding of the given string if a valid bom sequence is found */
-static const char* encoding_charset_from_bom(
-  const char* string, size_t len, size_t* bom_len
+#ifdef _LIBICONV_VERSION
+static int catalogue_add_iconv(
+  unsigned int count, const char* const* names, void* data
 ) {
-  const unsigned char* bytes = (unsigned char*) string;
+  (void)data;
+  catalogue_add(names, count);
+  return 0;
+}
+#endif
 
-  for (size_t i=0; bom_list[i].charset != NULL; i++) {
-    if (len >= bom_list[i].len) {
-      bool all_match = true;
-      for (size_t b = 0; b<bom_list[i].len; b++) {
-        if (bytes[b] != bom_list[i].bom[b]) {
-          all_match = false;
-          break;
+/* Keeps known charsets first in the plugin order and the rest sorted. */
+static int catalogue_compare(const void* a, const void* b) {
+  const catalogue_entry_t* ea = a;
+  const catalogue_entry_t* eb = b;
+  const catalogue_info_t* ia = catalogue_find_info(ea->charset);
+  const catalogue_info_t* ib = catalogue_find_info(eb->charset);
+  if (ia && ib)
+    return ia < ib ? -1 : (ia > ib);
+  if (ia || ib)
+    return ia ? -1 : 1;
+  return strcmp(ea->charset, eb->charset);
+}
+
+static void catalogue_build() {
+  if (catalogue)
+    return;
+#ifdef _LIBICONV_VERSION
+  iconvlist(catalogue_add_iconv, NULL);
+#endif
+  /* known charsets missing from the list, if they can be decoded */
+  for (size_t i = 0; i < catalogue_info_count; ++i) {
+    const char* charset = catalogue_info[i].charset;
+    if (catalogue_find(charset))
+      continue;
+    if (!encoding_conv_available("UTF-8", charset))
+      continue;
+    catalogue_add(&charset, 1);
+  }
+  for (size_t i = 0; charset_list[i].charset; ++i) {
+    catalogue_entry_t* entry = catalogue_find(charset_list[i].charset);
+    if (entry)
+      entry->fast = true;
+    else
+      catalogue_add(&charset_list[i].charset, 1);
+  }
+  qsort(catalogue, catalogue_count, sizeof(catalogue_entry_t), catalogue_compare);
+}
+
+static void catalogue_free() {
+  for (size_t i = 0; i < catalogue_count; ++i) {
+    catalogue_entry_t* entry = &catalogue[i];
+    for (size_t j = 0; j < entry->alias_count; ++j)
+      free(entry->aliases[j]);
+    for (size_t j = 0; j < entry->key_count; ++j)
+      free(entry->keys[j]);
+    free(entry->aliases);
+    free(entry->keys);
+    free(entry->name_key);
+    free(entry->charset);
+  }
+  free(catalogue);
+  catalogue = NULL;
+  catalogue_count = 0;
+  catalogue_capacity = 0;
+}
+
+static void catalogue_free_info(
+  char** groups, size_t group_count, catalogue_info_t* info, size_t info_count
+) {
+  for (size_t i = 0; i < group_count; ++i)
+    free(groups[i]);
+  for (size_t i = 0; i < info_count; ++i) {
+    free(info[i].charset);
+    free(info[i].name);
+  }
+  free(groups);
+  free(info);
+}
+
+/* Key of the catalogue table cached in the registry by encoding.charsets() */
+static const char catalogue_registry_key = 0;
+
+/*
+ * Takes the regions and charsets known by name from the known_groups and
+ * known_charsets fields of the table at idx, the charsets being a list for
+ * each region of tables with charset and name. The catalogue is built again
+ * on next use.
+*/
+static void catalogue_configure(lua_State* L, int idx) {
+  lua_getfield(L, idx, "known_groups");
+  lua_getfield(L, idx, "known_charsets");
+  if (lua_isnil(L, -2) && lua_isnil(L, -1)) {
+    lua_pop(L, 2);
+    return;
+  }
+  luaL_checktype(L, -2, LUA_TTABLE);
+  luaL_checktype(L, -1, LUA_TTABLE);
+  size_t group_count = lua_rawlen(L, -2), info_count = 0, info_capacity = 0;
+  char** groups = calloc(group_count + 1, sizeof(char*));
+  catalogue_info_t* info = NULL;
+  bool allocated = groups != NULL;
+  for (size_t i = 0; allocated && i < group_count; ++i) {
+    lua_rawgeti(L, -2, i + 1);
+    const char* group = lua_tostring(L, -1);
+    allocated = (groups[i] = strdup(group ? group : "")) != NULL;
+    lua_pop(L, 1);
+  }
+  for (size_t i = 0; allocated && i < group_count; ++i) {
+    if (lua_rawgeti(L, -1, i + 1) == LUA_TTABLE) {
+      size_t count = lua_rawlen(L, -1);
+      for (size_t j = 0; allocated && j < count; ++j) {
+        lua_rawgeti(L, -1, j + 1);
+        lua_getfield(L, -1, "charset");
+        lua_getfield(L, -2, "name");
+        const char* charset = lua_tostring(L, -2);
+        const char* name = lua_tostring(L, -1);
+        if (charset && info_count == info_capacity) {
+          size_t capacity = info_capacity ? info_capacity * 2 : 64;
+          catalogue_info_t* grown = realloc(info, capacity * sizeof(catalogue_info_t));
+          if ((allocated = grown != NULL)) {
+            info = grown;
+            info_capacity = capacity;
+          }
         }
-      }
-      if (all_match) {
-        if (bom_len) *bom_len = bom_list[i].len;
-        return bom_list[i].charset;
+        if (charset && allocated) {
+          catalogue_info_t* known = &info[info_count];
+          known->charset = strdup(charset);
+          known->name = strdup(name ? name : charset);
+          known->group = i;
+          if (known->charset && known->name)
+            info_count++;
+          else {
+            free(known->charset);
+            free(known->name);
+            allocated = false;
+          }
+        }
+        lua_pop(L, 3);
       }
     }
+    lua_pop(L, 1);
   }
-  if (bom_len) *bom_len = 0;
-  return NULL;
+  lua_pop(L, 2);
+  if (!allocated) {
+    catalogue_free_info(groups, group_count, info, info_count);
+    luaL_error(L, "out of memory");
+    return;
+  }
+  catalogue_free();
+  catalogue_free_info(catalogue_groups, catalogue_group_count, catalogue_info, catalogue_info_count);
+  catalogue_groups = groups;
+  catalogue_group_count = group_count;
+  catalogue_info = info;
+  catalogue_info_count = info_count;
+  lua_pushnil(L);
+  lua_rawsetp(L, LUA_REGISTRYINDEX, &catalogue_registry_key);
 }
 
+static void catalogue_push_entry(lua_State* L, const catalogue_entry_t* entry) {
+  lua_createtable(L, 0, 6);
+  lua_pushstring(L, entry->charset);
+  lua_setfield(L, -2, "charset");
+  lua_pushstring(L, entry->name);
+  lua_setfield(L, -2, "name");
+  lua_pushstring(L, entry->group < CATALOGUE_OTHER ? catalogue_groups[entry->group] : "Other");
+  lua_setfield(L, -2, "group");
+  lua_pushboolean(L, entry->bom);
+  lua_setfield(L, -2, "bom");
+  lua_pushboolean(L, entry->fast);
+  lua_setfield(L, -2, "fast");
+  lua_createtable(L, entry->alias_count, 0);
+  for (size_t i = 0; i < entry->alias_count; ++i) {
+    lua_pushstring(L, entry->aliases[i]);
+    lua_rawseti(L, -2, i + 1);
+  }
+  lua_setfield(L, -2, "aliases");
+}
 
 /*
- * encoding.detect(string)
- *
- * Detects a string's encoding.
+ * Scores how well query matches key, 0 if it doesn't: exact matches first,
+ * then prefixes, substrings and finally characters found in order.
+*/
+static int catalogue_score(const char* key, const char* query, size_t query_len) {
+  size_t key_len = strlen(key);
+  if (query_len > key_len)
+    return 0;
+  if (strncmp(key, query, query_len) == 0)
+    return query_len == key_len ? 4000 : 3000 - (int)(key_len - query_len);
+  const char* found = strstr(key, query);
+  if (found)
+    return 2000 - (int)(found - key) - (int)(key_len - query_len);
+  int gaps = 0;
+  const char* k = key;
+  for (size_t i = 0; i < query_len; ++i) {
+    const char* next = strchr(k, query[i]);
+    if (!next)
+      return 0;
+    gaps += next - k;
+    k = next + 1;
+  }
+  return 1000 - gaps * 10 - (int)(key_len - query_len);
+}
+
+typedef struct {
+  const catalogue_entry_t* entry;
+  int score;
+} catalogue_match_t;
+
+static int catalogue_match_compare(const void* a, const void* b) {
+  const catalogue_match_t* ma = a;
+  const catalogue_match_t* mb = b;
+  if (ma->score != mb->score)
+    return mb->score - ma->score;
+  return ma->entry < mb->entry ? -1 : (ma->entry > mb->entry);
+}
+
+
+/*
+ * encoding.charsets()
  *
- * Arguments:
- *  string, the string to check
+ * Get the catalogue of supported charsets, built on first use and cached.
  *
  * Returns:
- *  The charset string or nil
- *  Whether a BOM was present, or the error message
+ *  A list of tables with charset, name, group, aliases, bom and fast fields
  */
-int f_detect(lua_State *L) {
-	size_t string_len = 0;
-	const char* string = luaL_checklstring(L, 1, &string_len);
-  if (string_len > 0) {
-    size_t bom_len = 0;
-    const char* bom_charset = encoding_charset_from_bom(string, string_len, &bom_len);
-    if (bom_charset) {
-      lua_pushstring(L, bom_charset);
-      lua_pushboolean(L, 1);
-    } else if (utf8_validate(string, string_len)) {
-      lua_pushstring(L, "UTF-8");
-      lua_pushboolean(L, 0);
-    } else {
-      uchardet_t ud = uchardet_new();
-      const char* detected_charset = NULL;
-      if (uchardet_handle_data(ud, string, string_len) == 0) {
-        uchardet_data_end(ud);
-        detected_charset = uchardet_get_charset(ud);
-      }
-      if (detected_charset && *detected_charset) {
-        lua_pushstring(L, detected_charset);
-        lua_pushboolean(L, 0);
-      } else {
-        lua_pushnil(L);
-        lua_pushstring(L, "could not detect the file encoding");
-      }
-      uchardet_delete(ud); 
-    }
-  } else {
-    lua_pushstring(L, "UTF-8");
-    lua_pushboolean(L, 0);
+int f_charsets(lua_State *L) {
+  if (lua_rawgetp(L, LUA_REGISTRYINDEX, &catalogue_registry_key) == LUA_TTABLE)
+    return 1;
+  lua_pop(L, 1);
+  catalogue_build();
+  lua_createtable(L, catalogue_count, 0);
+  for (size_t i = 0; i < catalogue_count; ++i) {
+    catalogue_push_entry(L, &catalogue[i]);
+    lua_rawseti(L, -2, i + 1);
   }
-  return 2;
+  lua_pushvalue(L, -1);
+  lua_rawsetp(L, LUA_REGISTRYINDEX, &catalogue_registry_key);
+  return 1;
 }
 
 
 /*
- * encoding.convert(tocharset, fromcharset, text, options)
+ * encoding.suggest(text, max)
  *
- * Convert the given text from one charset into another if possible.
+ * Finds the charsets best matching the given text by name, alias or region
+ * name, ignoring case and punctuation. Without text the well known charsets
+ * are returned in order.
  *
  * Arguments:
- *  tocharset, a string representing a valid iconv charset
- *  fromcharset, a string representing a valid iconv charset
- *  text, the string to convert
- *  options, a table of conversion options
+ *  text, the partial charset name typed by the user
+ *  max, the maximum amount of results, 50 by default
  *
  * Returns:
- *  The converted ouput string or nil
- *  The error message
+ *  A list of catalogue entries like the ones of encoding.charsets()
  */
-int f_convert(lua_State *L) {
-  const char* to = luaL_checkstring(L, 1);
-  const char* from = luaL_checkstring(L, 2);
-  size_t text_len = 0;
-  const char* text = luaL_checklstring(L, 3, &text_len);
-  /* conversion options */
-  bool strict = false;
-  const unsigned char* bom;
-  size_t bom_len = 0;
-
-  if (lua_gettop(L) > 3 && lua_istable(L, 4)) {
-    lua_getfield(L, 4, "strict");
-    if (lua_isboolean(L, -1)) 
-      strict = lua_toboolean(L, -1);
+int f_suggest(lua_State *L) {
+  const char* text = luaL_optstring(L, 1, "");
+  lua_Integer max = luaL_optinteger(L, 2, 50);
+  catalogue_build();
+  char* query = catalogue_key(text);
+  catalogue_match_t* matches = query ? malloc((catalogue_count + 1) * sizeof(catalogue_match_t)) : NULL;
+  if (!matches) {
+    free(query);
+    return luaL_error(L, "out of memory");
   }
-  iconv_t conv = iconv_open(to, from);
-  if (conv == (iconv_t)-1) {
-    lua_pushnil(L);
-    lua_pushstring(L, strerror(errno));
-    return 2;
-  }
-  luaL_Buffer b;
-  luaL_buffinit(L, &b);
-  char buffer[4096];
-  const char* inbuf = (char*)text;
-  size_t inbytesleft = text_len;
-  while (inbytesleft > 0) {
-    size_t err = 0;
-    char* outbuf = buffer;
-    size_t outbytesleft = sizeof(buffer);
-    err = iconv(conv, &inbuf, &inbytesleft, &outbuf, &outbytesleft);
-    if (err == -1) {
-      if (strict) {
-        iconv_close(conv);
-        lua_pushnil(L);
-        lua_pushstring(L, "illegal multibyte sequence");
-        return 2;
-      } else {
-        ++inbuf;
-        --inbytesleft;
+  size_t query_len = strlen(query);
+  size_t count = 0;
+  for (size_t i = 0; i < catalogue_count; ++i) {
+    const catalogue_entry_t* entry = &catalogue[i];
+    int score = 0;
+    if (query_len == 0) {
+      score = entry->group != CATALOGUE_OTHER;
+    } else {
+      for (size_t j = 0; j < entry->key_count; ++j) {
+        int key_score = catalogue_score(entry->keys[j], query, query_len);
+        if (key_score > score)
+          score = key_score;
       }
+      if (entry->name_key) {
+        int name_score = catalogue_score(entry->name_key, query, query_len) / 2;
+        if (name_score > score)
+          score = name_score;
+      }
+    }
+    if (score > 0) {
+      matches[count].entry = entry;
+      matches[count++].score = score;
     }
-    luaL_addlstring(&b, buffer, outbuf - buffer);
   }
-  luaL_pushresult(&b);
+  free(query);
+  qsort(matches, count, sizeof(catalogue_match_t), catalogue_match_compare);
+  if (max > 0 && count > (size_t)max)
+    count = max;
+  lua_createtable(L, count, 0);
+  for (size_t i = 0; i < count; ++i) {
+    catalogue_push_entry(L, matches[i].entry);
+    lua_rawseti(L, -2, i + 1);
+  }
+  free(matches);
   return 1;
 }
 
 
 /*
- * encoding.bom(charset)
+ * encoding.stats()
  *
- * Retrieve the byte order marks sequence for the given charset if applicable.
- *
- * Arguments:
- *  charset, a string representing a valid iconv charset
+ * Retrieve counters about the native memory and resources being used.
  *
  * Returns:
- *  The bom sequence string or empty string if not applicable.
+ *  A table with the following fields:
+ *    arena_reserved, bytes held by the temporaries arena
+ *    arena_used, bytes of the arena currently in use
+ *    arena_peak, highest amount of arena bytes used at once
+ *    arena_allocations, amount of blocks the arena requested to lua
+ *    iconv_opens, amount of iconv descriptors opened
+ *    iconv_cache_hits, conversions that reused a cached descriptor
+ *    detector_allocations, amount of uchardet detectors created for reuse
+ *    backend_tunings, charset pairs benchmarked to choose their backend
+ *    snapshot_hits, documents loaded from a decoded snapshot
+ *    snapshot_writes, decoded snapshots written
+ *    prefetch_hits, documents loaded from their prefetched text
+ *    prefetch_misses, documents asked for that were not prefetched in time
+ *    prefetch_memory, bytes taken by the prefetched texts
+ *    backends, the backend chosen for each "FROM>TO" charset pair
+ *    isa, the instruction set chosen for the vectorized kernels
+ *    kernels, the instruction set of the variant running each kernel
  */
-int f_bom(lua_State *L) {
-  size_t bom_len = 0;
-  const char* bom = encoding_bom_from_charset(luaL_checkstring(L, 1), &bom_len);
-  lua_pushlstring(L, bom, bom_len);
+int f_stats(lua_State *L) {
+  lua_createtable(L, 0, 16);
+  lua_pushinteger(L, encoding_arena.reserved);
+  lua_setfield(L, -2, "arena_reserved");
+  lua_pushinteger(L, encoding_arena.used);
+  lua_setfield(L, -2, "arena_used");
+  lua_pushinteger(L, encoding_arena.peak);
+  lua_setfield(L, -2, "arena_peak");
+  lua_pushinteger(L, encoding_arena.block_allocations);
+  lua_setfield(L, -2, "arena_allocations");
+  lua_pushinteger(L, iconv_opens);
+  lua_setfield(L, -2, "iconv_opens");
+  lua_pushinteger(L, iconv_cache_hits);
+  lua_setfield(L, -2, "iconv_cache_hits");
+  lua_pushinteger(L, detector_allocations);
+  lua_setfield(L, -2, "detector_allocations");
+  lua_pushinteger(L, backend_tunings);
+  lua_setfield(L, -2, "backend_tunings");
+  lua_pushinteger(L, snapshot_hits);
+  lua_setfield(L, -2, "snapshot_hits");
+  lua_pushinteger(L, snapshot_writes);
+  lua_setfield(L, -2, "snapshot_writes");
+  lua_pushinteger(L, prefetch_hits);
+  lua_setfield(L, -2, "prefetch_hits");
+  lua_pushinteger(L, prefetch_misses);
+  lua_setfield(L, -2, "prefetch_misses");
+  mutex_lock(&prefetch_mutex);
+  lua_pushinteger(L, prefetch_memory);
+  mutex_unlock(&prefetch_mutex);
+  lua_setfield(L, -2, "prefetch_memory");
+  /* the backend chosen for each pair, keyed as "FROM>TO" */
+  mutex_lock(&backend_mutex);
+  lua_createtable(L, 0, backend_choice_count);
+  for (size_t i = 0; i < backend_choice_count; ++i) {
+    lua_pushfstring(L, "%s>%s", backend_choices[i].from, backend_choices[i].to);
+    lua_pushstring(L, encoding_backend_names[backend_choices[i].backend]);
+    lua_rawset(L, -3);
+  }
+  mutex_unlock(&backend_mutex);
+  lua_setfield(L, -2, "backends");
+  lua_pushstring(L, encoding_isa_names[encoding_isa]);
+  lua_setfield(L, -2, "isa");
+  lua_createtable(L, 0, KERNEL_COUNT);
+  for (size_t i = 0; i < KERNEL_COUNT; ++i) {
+    lua_pushstring(L, encoding_isa_names[kernel_isas[i]]);
+    lua_setfield(L, -2, encoding_kernel_names[i]);
+  }
+  lua_setfield(L, -2, "kernels");
   return 1;
 }
 
 
 static const luaL_Reg lib[] = {
-  { "detect",  f_detect  },
-  { "convert", f_convert },
-  { "bom",     f_bom     },
+  { "detect",          f_detect       },
+  { "convert",         f_convert      },
+  { "converter",       f_converter    },
+  { "bom",             f_bom          },
+  { "get_charset_bom", f_bom          },
+  { "strip_bom",       f_strip_bom    },
+  { "normalize",       f_normalize    },
+  { "search",          f_search       },
+  { "grep",            f_grep         },
+  { "buffer",          f_buffer       },
+  { "open",            f_open         },
+  { "load_snapshot",   f_load_snapshot },
+  { "prefetch",        f_prefetch     },
+  { "prefetched",      f_prefetched   },
+  { "open_batch",      f_open_batch   },
+  { "save_batch",      f_save_batch   },
+  { "segments",        f_segments     },
+  { "decode_mixed",    f_decode_mixed },
+  { "read_lines",      f_read_lines   },
+  { "tail",            f_tail         },
+  { "blocks",          f_blocks       },
+  { "charsets",        f_charsets     },
+  { "suggest",         f_suggest      },
+  { "stats",           f_stats        },
+  { "configure",       f_configure    },
   { NULL, NULL }
 };
 
 
 int luaopen_lite_xl_encoding(lua_State *L, void* (*api_require)(char *)) {
   lite_xl_plugin_init(api_require);
+  static bool initialized = false;
+  if (!initialized) {
+    mutex_init(&detect_cache_mutex);
+    mutex_init(&detector_mutex);
+    mutex_init(&backend_mutex);
+    mutex_init(&single_tables_mutex);
+    mutex_init(&prefetch_mutex);
+    cond_init(&prefetch_cond);
+    encoding_kernels_init();
+    encoding_arena.alloc = lua_getallocf(L, &encoding_arena.alloc_ud);
+    initialized = true;
+  }
+  luaL_newmetatable(L, BUFFER_METATABLE);
+  luaL_setfuncs(L, buffer_lib, 0);
+  lua_pushvalue(L, -1);
+  lua_setfield(L, -2, "__index");
+  lua_pop(L, 1);
+  luaL_newmetatable(L, SOURCE_METATABLE);
+  luaL_setfuncs(L, source_lib, 0);
+  lua_pushvalue(L, -1);
+  lua_setfield(L, -2, "__index");
+  lua_pop(L, 1);
+  luaL_newmetatable(L, CONVERTER_METATABLE);
+  luaL_setfuncs(L, converter_lib, 0);
+  lua_pushvalue(L, -1);
+  lua_setfield(L, -2, "__index");
+  lua_pop(L, 1);
+  luaL_newmetatable(L, TAIL_METATABLE);
+  luaL_setfuncs(L, tail_lib, 0);
+  lua_pushvalue(L, -1);
+  lua_setfield(L, -2, "__index");
+  lua_pop(L, 1);
+  luaL_newmetatable(L, BLOCKS_METATABLE);
+  luaL_setfuncs(L, blocks_lib, 0);
+  lua_pushvalue(L, -1);
+  lua_setfield(L, -2, "__index");
+  lua_pop(L, 1);
+  luaL_newmetatable(L, BATCH_METATABLE);
+  luaL_setfuncs(L, batch_lib, 0);
+  lua_pushvalue(L, -1);
+  lua_setfield(L, -2, "__index");
+  lua_pop(L, 1);
+  luaL_newmetatable(L, SAVE_METATABLE);
+  luaL_setfuncs(L, save_lib, 0);
+  lua_pushvalue(L, -1);
+  lua_setfield(L, -2, "__index");
+  lua_pop(L, 1);
+  luaL_newmetatable(L, GREP_METATABLE);
+  luaL_setfuncs(L, grep_lib, 0);
+  lua_pushvalue(L, -1);
+  lua_setfield(L, -2, "__index");
+  lua_pop(L, 1);
   luaL_newlib(L, lib);
   return 1;
 }
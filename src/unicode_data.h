@@ -0,0 +1,1738 @@
+/* Generated by scripts/unicode_data.py from Unicode 14.0.0, do not edit. */
+
+#define UNICODE_DATA_VERSION "14.0.0"
+
+typedef struct { unsigned int first, last; unsigned char value; } unicode_range_t;
+typedef struct { unsigned int codepoint; unsigned short index; unsigned char length; } unicode_decomposition_t;
+typedef struct { unsigned int first, second, composite; } unicode_composition_t;
+
+/* Canonical combining classes other than zero. */
+static const unicode_range_t unicode_combining[] = {
+  { 0x00300, 0x00314, 230 }, { 0x00315, 0x00315, 232 }, { 0x00316, 0x00319, 220 },
+  { 0x0031A, 0x0031A, 232 }, { 0x0031B, 0x0031B, 216 }, { 0x0031C, 0x00320, 220 },
+  { 0x00321, 0x00322, 202 }, { 0x00323, 0x00326, 220 }, { 0x00327, 0x00328, 202 },
+  { 0x00329, 0x00333, 220 }, { 0x00334, 0x00338,   1 }, { 0x00339, 0x0033C, 220 },
+  { 0x0033D, 0x00344, 230 }, { 0x00345, 0x00345, 240 }, { 0x00346, 0x00346, 230 },
+  { 0x00347, 0x00349, 220 }, { 0x0034A, 0x0034C, 230 }, { 0x0034D, 0x0034E, 220 },
+  { 0x00350, 0x00352, 230 }, { 0x00353, 0x00356, 220 }, { 0x00357, 0x00357, 230 },
+  { 0x00358, 0x00358, 232 }, { 0x00359, 0x0035A, 220 }, { 0x0035B, 0x0035B, 230 },
+  { 0x0035C, 0x0035C, 233 }, { 0x0035D, 0x0035E, 234 }, { 0x0035F, 0x0035F, 233 },
+  { 0x00360, 0x00361, 234 }, { 0x00362, 0x00362, 233 }, { 0x00363, 0x0036F, 230 },
+  { 0x00483, 0x00487, 230 }, { 0x00591, 0x00591, 220 }, { 0x00592, 0x00595, 230 },
+  { 0x00596, 0x00596, 220 }, { 0x00597, 0x00599, 230 }, { 0x0059A, 0x0059A, 222 },
+  { 0x0059B, 0x0059B, 220 }, { 0x0059C, 0x005A1, 230 }, { 0x005A2, 0x005A7, 220 },
+  { 0x005A8, 0x005A9, 230 }, { 0x005AA, 0x005AA, 220 }, { 0x005AB, 0x005AC, 230 },
+  { 0x005AD, 0x005AD, 222 }, { 0x005AE, 0x005AE, 228 }, { 0x005AF, 0x005AF, 230 },
+  { 0x005B0, 0x005B0,  10 }, { 0x005B1, 0x005B1,  11 }, { 0x005B2, 0x005B2,  12 },
+  { 0x005B3, 0x005B3,  13 }, { 0x005B4, 0x005B4,  14 }, { 0x005B5, 0x005B5,  15 },
+  { 0x005B6, 0x005B6,  16 }, { 0x005B7, 0x005B7,  17 }, { 0x005B8, 0x005B8,  18 },
+  { 0x005B9, 0x005BA,  19 }, { 0x005BB, 0x005BB,  20 }, { 0x005BC, 0x005BC,  21 },
+  { 0x005BD, 0x005BD,  22 }, { 0x005BF, 0x005BF,  23 }, { 0x005C1, 0x005C1,  24 },
+  { 0x005C2, 0x005C2,  25 }, { 0x005C4, 0x005C4, 230 }, { 0x005C5, 0x005C5, 220 },
+  { 0x005C7, 0x005C7,  18 }, { 0x00610, 0x00617, 230 }, { 0x00618, 0x00618,  30 },
+  { 0x00619, 0x00619,  31 }, { 0x0061A, 0x0061A,  32 }, { 0x0064B, 0x0064B,  27 },
+  { 0x0064C, 0x0064C,  28 }, { 0x0064D, 0x0064D,  29 }, { 0x0064E, 0x0064E,  30 },
+  { 0x0064F, 0x0064F,  31 }, { 0x00650, 0x00650,  32 }, { 0x00651, 0x00651,  33 },
+  { 0x00652, 0x00652,  34 }, { 0x00653, 0x00654, 230 }, { 0x00655, 0x00656, 220 },
+  { 0x00657, 0x0065B, 230 }, { 0x0065C, 0x0065C, 220 }, { 0x0065D, 0x0065E, 230 },
+  { 0x0065F, 0x0065F, 220 }, { 0x00670, 0x00670,  35 }, { 0x006D6, 0x006DC, 230 },
+  { 0x006DF, 0x006E2, 230 }, { 0x006E3, 0x006E3, 220 }, { 0x006E4, 0x006E4, 230 },
+  { 0x006E7, 0x006E8, 230 }, { 0x006EA, 0x006EA, 220 }, { 0x006EB, 0x006EC, 230 },
+  { 0x006ED, 0x006ED, 220 }, { 0x00711, 0x00711,  36 }, { 0x00730, 0x00730, 230 },
+  { 0x00731, 0x00731, 220 }, { 0x00732, 0x00733, 230 }, { 0x00734, 0x00734, 220 },
+  { 0x00735, 0x00736, 230 }, { 0x00737, 0x00739, 220 }, { 0x0073A, 0x0073A, 230 },
+  { 0x0073B, 0x0073C, 220 }, { 0x0073D, 0x0073D, 230 }, { 0x0073E, 0x0073E, 220 },
+  { 0x0073F, 0x00741, 230 }, { 0x00742, 0x00742, 220 }, { 0x00743, 0x00743, 230 },
+  { 0x00744, 0x00744, 220 }, { 0x00745, 0x00745, 230 }, { 0x00746, 0x00746, 220 },
+  { 0x00747, 0x00747, 230 }, { 0x00748, 0x00748, 220 }, { 0x00749, 0x0074A, 230 },
+  { 0x007EB, 0x007F1, 230 }, { 0x007F2, 0x007F2, 220 }, { 0x007F3, 0x007F3, 230 },
+  { 0x007FD, 0x007FD, 220 }, { 0x00816, 0x00819, 230 }, { 0x0081B, 0x00823, 230 },
+  { 0x00825, 0x00827, 230 }, { 0x00829, 0x0082D, 230 }, { 0x00859, 0x0085B, 220 },
+  { 0x00898, 0x00898, 230 }, { 0x00899, 0x0089B, 220 }, { 0x0089C, 0x0089F, 230 },
+  { 0x008CA, 0x008CE, 230 }, { 0x008CF, 0x008D3, 220 }, { 0x008D4, 0x008E1, 230 },
+  { 0x008E3, 0x008E3, 220 }, { 0x008E4, 0x008E5, 230 }, { 0x008E6, 0x008E6, 220 },
+  { 0x008E7, 0x008E8, 230 }, { 0x008E9, 0x008E9, 220 }, { 0x008EA, 0x008EC, 230 },
+  { 0x008ED, 0x008EF, 220 }, { 0x008F0, 0x008F0,  27 }, { 0x008F1, 0x008F1,  28 },
+  { 0x008F2, 0x008F2,  29 }, { 0x008F3, 0x008F5, 230 }, { 0x008F6, 0x008F6, 220 },
+  { 0x008F7, 0x008F8, 230 }, { 0x008F9, 0x008FA, 220 }, { 0x008FB, 0x008FF, 230 },
+  { 0x0093C, 0x0093C,   7 }, { 0x0094D, 0x0094D,   9 }, { 0x00951, 0x00951, 230 },
+  { 0x00952, 0x00952, 220 }, { 0x00953, 0x00954, 230 }, { 0x009BC, 0x009BC,   7 },
+  { 0x009CD, 0x009CD,   9 }, { 0x009FE, 0x009FE, 230 }, { 0x00A3C, 0x00A3C,   7 },
+  { 0x00A4D, 0x00A4D,   9 }, { 0x00ABC, 0x00ABC,   7 }, { 0x00ACD, 0x00ACD,   9 },
+  { 0x00B3C, 0x00B3C,   7 }, { 0x00B4D, 0x00B4D,   9 }, { 0x00BCD, 0x00BCD,   9 },
+  { 0x00C3C, 0x00C3C,   7 }, { 0x00C4D, 0x00C4D,   9 }, { 0x00C55, 0x00C55,  84 },
+  { 0x00C56, 0x00C56,  91 }, { 0x00CBC, 0x00CBC,   7 }, { 0x00CCD, 0x00CCD,   9 },
+  { 0x00D3B, 0x00D3C,   9 }, { 0x00D4D, 0x00D4D,   9 }, { 0x00DCA, 0x00DCA,   9 },
+  { 0x00E38, 0x00E39, 103 }, { 0x00E3A, 0x00E3A,   9 }, { 0x00E48, 0x00E4B, 107 },
+  { 0x00EB8, 0x00EB9, 118 }, { 0x00EBA, 0x00EBA,   9 }, { 0x00EC8, 0x00ECB, 122 },
+  { 0x00F18, 0x00F19, 220 }, { 0x00F35, 0x00F35, 220 }, { 0x00F37, 0x00F37, 220 },
+  { 0x00F39, 0x00F39, 216 }, { 0x00F71, 0x00F71, 129 }, { 0x00F72, 0x00F72, 130 },
+  { 0x00F74, 0x00F74, 132 }, { 0x00F7A, 0x00F7D, 130 }, { 0x00F80, 0x00F80, 130 },
+  { 0x00F82, 0x00F83, 230 }, { 0x00F84, 0x00F84,   9 }, { 0x00F86, 0x00F87, 230 },
+  { 0x00FC6, 0x00FC6, 220 }, { 0x01037, 0x01037,   7 }, { 0x01039, 0x0103A,   9 },
+  { 0x0108D, 0x0108D, 220 }, { 0x0135D, 0x0135F, 230 }, { 0x01714, 0x01715,   9 },
+  { 0x01734, 0x01734,   9 }, { 0x017D2, 0x017D2,   9 }, { 0x017DD, 0x017DD, 230 },
+  { 0x018A9, 0x018A9, 228 }, { 0x01939, 0x01939, 222 }, { 0x0193A, 0x0193A, 230 },
+  { 0x0193B, 0x0193B, 220 }, { 0x01A17, 0x01A17, 230 }, { 0x01A18, 0x01A18, 220 },
+  { 0x01A60, 0x01A60,   9 }, { 0x01A75, 0x01A7C, 230 }, { 0x01A7F, 0x01A7F, 220 },
+  { 0x01AB0, 0x01AB4, 230 }, { 0x01AB5, 0x01ABA, 220 }, { 0x01ABB, 0x01ABC, 230 },
+  { 0x01ABD, 0x01ABD, 220 }, { 0x01ABF, 0x01AC0, 220 }, { 0x01AC1, 0x01AC2, 230 },
+  { 0x01AC3, 0x01AC4, 220 }, { 0x01AC5, 0x01AC9, 230 }, { 0x01ACA, 0x01ACA, 220 },
+  { 0x01ACB, 0x01ACE, 230 }, { 0x01B34, 0x01B34,   7 }, { 0x01B44, 0x01B44,   9 },
+  { 0x01B6B, 0x01B6B, 230 }, { 0x01B6C, 0x01B6C, 220 }, { 0x01B6D, 0x01B73, 230 },
+  { 0x01BAA, 0x01BAB,   9 }, { 0x01BE6, 0x01BE6,   7 }, { 0x01BF2, 0x01BF3,   9 },
+  { 0x01C37, 0x01C37,   7 }, { 0x01CD0, 0x01CD2, 230 }, { 0x01CD4, 0x01CD4,   1 },
+  { 0x01CD5, 0x01CD9, 220 }, { 0x01CDA, 0x01CDB, 230 }, { 0x01CDC, 0x01CDF, 220 },
+  { 0x01CE0, 0x01CE0, 230 }, { 0x01CE2, 0x01CE8,   1 }, { 0x01CED, 0x01CED, 220 },
+  { 0x01CF4, 0x01CF4, 230 }, { 0x01CF8, 0x01CF9, 230 }, { 0x01DC0, 0x01DC1, 230 },
+  { 0x01DC2, 0x01DC2, 220 }, { 0x01DC3, 0x01DC9, 230 }, { 0x01DCA, 0x01DCA, 220 },
+  { 0x01DCB, 0x01DCC, 230 }, { 0x01DCD, 0x01DCD, 234 }, { 0x01DCE, 0x01DCE, 214 },
+  { 0x01DCF, 0x01DCF, 220 }, { 0x01DD0, 0x01DD0, 202 }, { 0x01DD1, 0x01DF5, 230 },
+  { 0x01DF6, 0x01DF6, 232 }, { 0x01DF7, 0x01DF8, 228 }, { 0x01DF9, 0x01DF9, 220 },
+  { 0x01DFA, 0x01DFA, 218 }, { 0x01DFB, 0x01DFB, 230 }, { 0x01DFC, 0x01DFC, 233 },
+  { 0x01DFD, 0x01DFD, 220 }, { 0x01DFE, 0x01DFE, 230 }, { 0x01DFF, 0x01DFF, 220 },
+  { 0x020D0, 0x020D1, 230 }, { 0x020D2, 0x020D3,   1 }, { 0x020D4, 0x020D7, 230 },
+  { 0x020D8, 0x020DA,   1 }, { 0x020DB, 0x020DC, 230 }, { 0x020E1, 0x020E1, 230 },
+  { 0x020E5, 0x020E6,   1 }, { 0x020E7, 0x020E7, 230 }, { 0x020E8, 0x020E8, 220 },
+  { 0x020E9, 0x020E9, 230 }, { 0x020EA, 0x020EB,   1 }, { 0x020EC, 0x020EF, 220 },
+  { 0x020F0, 0x020F0, 230 }, { 0x02CEF, 0x02CF1, 230 }, { 0x02D7F, 0x02D7F,   9 },
+  { 0x02DE0, 0x02DFF, 230 }, { 0x0302A, 0x0302A, 218 }, { 0x0302B, 0x0302B, 228 },
+  { 0x0302C, 0x0302C, 232 }, { 0x0302D, 0x0302D, 222 }, { 0x0302E, 0x0302F, 224 },
+  { 0x03099, 0x0309A,   8 }, { 0x0A66F, 0x0A66F, 230 }, { 0x0A674, 0x0A67D, 230 },
+  { 0x0A69E, 0x0A69F, 230 }, { 0x0A6F0, 0x0A6F1, 230 }, { 0x0A806, 0x0A806,   9 },
+  { 0x0A82C, 0x0A82C,   9 }, { 0x0A8C4, 0x0A8C4,   9 }, { 0x0A8E0, 0x0A8F1, 230 },
+  { 0x0A92B, 0x0A92D, 220 }, { 0x0A953, 0x0A953,   9 }, { 0x0A9B3, 0x0A9B3,   7 },
+  { 0x0A9C0, 0x0A9C0,   9 }, { 0x0AAB0, 0x0AAB0, 230 }, { 0x0AAB2, 0x0AAB3, 230 },
+  { 0x0AAB4, 0x0AAB4, 220 }, { 0x0AAB7, 0x0AAB8, 230 }, { 0x0AABE, 0x0AABF, 230 },
+  { 0x0AAC1, 0x0AAC1, 230 }, { 0x0AAF6, 0x0AAF6,   9 }, { 0x0ABED, 0x0ABED,   9 },
+  { 0x0FB1E, 0x0FB1E,  26 }, { 0x0FE20, 0x0FE26, 230 }, { 0x0FE27, 0x0FE2D, 220 },
+  { 0x0FE2E, 0x0FE2F, 230 }, { 0x101FD, 0x101FD, 220 }, { 0x102E0, 0x102E0, 220 },
+  { 0x10376, 0x1037A, 230 }, { 0x10A0D, 0x10A0D, 220 }, { 0x10A0F, 0x10A0F, 230 },
+  { 0x10A38, 0x10A38, 230 }, { 0x10A39, 0x10A39,   1 }, { 0x10A3A, 0x10A3A, 220 },
+  { 0x10A3F, 0x10A3F,   9 }, { 0x10AE5, 0x10AE5, 230 }, { 0x10AE6, 0x10AE6, 220 },
+  { 0x10D24, 0x10D27, 230 }, { 0x10EAB, 0x10EAC, 230 }, { 0x10F46, 0x10F47, 220 },
+  { 0x10F48, 0x10F4A, 230 }, { 0x10F4B, 0x10F4B, 220 }, { 0x10F4C, 0x10F4C, 230 },
+  { 0x10F4D, 0x10F50, 220 }, { 0x10F82, 0x10F82, 230 }, { 0x10F83, 0x10F83, 220 },
+  { 0x10F84, 0x10F84, 230 }, { 0x10F85, 0x10F85, 220 }, { 0x11046, 0x11046,   9 },
+  { 0x11070, 0x11070,   9 }, { 0x1107F, 0x1107F,   9 }, { 0x110B9, 0x110B9,   9 },
+  { 0x110BA, 0x110BA,   7 }, { 0x11100, 0x11102, 230 }, { 0x11133, 0x11134,   9 },
+  { 0x11173, 0x11173,   7 }, { 0x111C0, 0x111C0,   9 }, { 0x111CA, 0x111CA,   7 },
+  { 0x11235, 0x11235,   9 }, { 0x11236, 0x11236,   7 }, { 0x112E9, 0x112E9,   7 },
+  { 0x112EA, 0x112EA,   9 }, { 0x1133B, 0x1133C,   7 }, { 0x1134D, 0x1134D,   9 },
+  { 0x11366, 0x1136C, 230 }, { 0x11370, 0x11374, 230 }, { 0x11442, 0x11442,   9 },
+  { 0x11446, 0x11446,   7 }, { 0x1145E, 0x1145E, 230 }, { 0x114C2, 0x114C2,   9 },
+  { 0x114C3, 0x114C3,   7 }, { 0x115BF, 0x115BF,   9 }, { 0x115C0, 0x115C0,   7 },
+  { 0x1163F, 0x1163F,   9 }, { 0x116B6, 0x116B6,   9 }, { 0x116B7, 0x116B7,   7 },
+  { 0x1172B, 0x1172B,   9 }, { 0x11839, 0x11839,   9 }, { 0x1183A, 0x1183A,   7 },
+  { 0x1193D, 0x1193E,   9 }, { 0x11943, 0x11943,   7 }, { 0x119E0, 0x119E0,   9 },
+  { 0x11A34, 0x11A34,   9 }, { 0x11A47, 0x11A47,   9 }, { 0x11A99, 0x11A99,   9 },
+  { 0x11C3F, 0x11C3F,   9 }, { 0x11D42, 0x11D42,   7 }, { 0x11D44, 0x11D45,   9 },
+  { 0x11D97, 0x11D97,   9 }, { 0x16AF0, 0x16AF4,   1 }, { 0x16B30, 0x16B36, 230 },
+  { 0x16FF0, 0x16FF1,   6 }, { 0x1BC9E, 0x1BC9E,   1 }, { 0x1D165, 0x1D166, 216 },
+  { 0x1D167, 0x1D169,   1 }, { 0x1D16D, 0x1D16D, 226 }, { 0x1D16E, 0x1D172, 216 },
+  { 0x1D17B, 0x1D182, 220 }, { 0x1D185, 0x1D189, 230 }, { 0x1D18A, 0x1D18B, 220 },
+  { 0x1D1AA, 0x1D1AD, 230 }, { 0x1D242, 0x1D244, 230 }, { 0x1E000, 0x1E006, 230 },
+  { 0x1E008, 0x1E018, 230 }, { 0x1E01B, 0x1E021, 230 }, { 0x1E023, 0x1E024, 230 },
+  { 0x1E026, 0x1E02A, 230 }, { 0x1E130, 0x1E136, 230 }, { 0x1E2AE, 0x1E2AE, 230 },
+  { 0x1E2EC, 0x1E2EF, 230 }, { 0x1E8D0, 0x1E8D6, 220 }, { 0x1E944, 0x1E949, 230 },
+  { 0x1E94A, 0x1E94A,   7 },
+};
+
+/* NFC quick check values, 1 for maybe and 2 for no, the rest are yes. */
+static const unicode_range_t unicode_nfc_quick_check[] = {
+  { 0x00300, 0x00304, 1 }, { 0x00306, 0x0030C, 1 }, { 0x0030F, 0x0030F, 1 },
+  { 0x00311, 0x00311, 1 }, { 0x00313, 0x00314, 1 }, { 0x0031B, 0x0031B, 1 },
+  { 0x00323, 0x00328, 1 }, { 0x0032D, 0x0032E, 1 }, { 0x00330, 0x00331, 1 },
+  { 0x00338, 0x00338, 1 }, { 0x00340, 0x00341, 2 }, { 0x00342, 0x00342, 1 },
+  { 0x00343, 0x00344, 2 }, { 0x00345, 0x00345, 1 }, { 0x00374, 0x00374, 2 },
+  { 0x0037E, 0x0037E, 2 }, { 0x00387, 0x00387, 2 }, { 0x00653, 0x00655, 1 },
+  { 0x0093C, 0x0093C, 1 }, { 0x00958, 0x0095F, 2 }, { 0x009BE, 0x009BE, 1 },
+  { 0x009D7, 0x009D7, 1 }, { 0x009DC, 0x009DD, 2 }, { 0x009DF, 0x009DF, 2 },
+  { 0x00A33, 0x00A33, 2 }, { 0x00A36, 0x00A36, 2 }, { 0x00A59, 0x00A5B, 2 },
+  { 0x00A5E, 0x00A5E, 2 }, { 0x00B3E, 0x00B3E, 1 }, { 0x00B56, 0x00B57, 1 },
+  { 0x00B5C, 0x00B5D, 2 }, { 0x00BBE, 0x00BBE, 1 }, { 0x00BD7, 0x00BD7, 1 },
+  { 0x00C56, 0x00C56, 1 }, { 0x00CC2, 0x00CC2, 1 }, { 0x00CD5, 0x00CD6, 1 },
+  { 0x00D3E, 0x00D3E, 1 }, { 0x00D57, 0x00D57, 1 }, { 0x00DCA, 0x00DCA, 1 },
+  { 0x00DCF, 0x00DCF, 1 }, { 0x00DDF, 0x00DDF, 1 }, { 0x00F43, 0x00F43, 2 },
+  { 0x00F4D, 0x00F4D, 2 }, { 0x00F52, 0x00F52, 2 }, { 0x00F57, 0x00F57, 2 },
+  { 0x00F5C, 0x00F5C, 2 }, { 0x00F69, 0x00F69, 2 }, { 0x00F73, 0x00F73, 2 },
+  { 0x00F75, 0x00F76, 2 }, { 0x00F78, 0x00F78, 2 }, { 0x00F81, 0x00F81, 2 },
+  { 0x00F93, 0x00F93, 2 }, { 0x00F9D, 0x00F9D, 2 }, { 0x00FA2, 0x00FA2, 2 },
+  { 0x00FA7, 0x00FA7, 2 }, { 0x00FAC, 0x00FAC, 2 }, { 0x00FB9, 0x00FB9, 2 },
+  { 0x0102E, 0x0102E, 1 }, { 0x01161, 0x01175, 1 }, { 0x011A8, 0x011C2, 1 },
+  { 0x01B35, 0x01B35, 1 }, { 0x01F71, 0x01F71, 2 }, { 0x01F73, 0x01F73, 2 },
+  { 0x01F75, 0x01F75, 2 }, { 0x01F77, 0x01F77, 2 }, { 0x01F79, 0x01F79, 2 },
+  { 0x01F7B, 0x01F7B, 2 }, { 0x01F7D, 0x01F7D, 2 }, { 0x01FBB, 0x01FBB, 2 },
+  { 0x01FBE, 0x01FBE, 2 }, { 0x01FC9, 0x01FC9, 2 }, { 0x01FCB, 0x01FCB, 2 },
+  { 0x01FD3, 0x01FD3, 2 }, { 0x01FDB, 0x01FDB, 2 }, { 0x01FE3, 0x01FE3, 2 },
+  { 0x01FEB, 0x01FEB, 2 }, { 0x01FEE, 0x01FEF, 2 }, { 0x01FF9, 0x01FF9, 2 },
+  { 0x01FFB, 0x01FFB, 2 }, { 0x01FFD, 0x01FFD, 2 }, { 0x02000, 0x02001, 2 },
+  { 0x02126, 0x02126, 2 }, { 0x0212A, 0x0212B, 2 }, { 0x02329, 0x0232A, 2 },
+  { 0x02ADC, 0x02ADC, 2 }, { 0x03099, 0x0309A, 1 }, { 0x0F900, 0x0FA0D, 2 },
+  { 0x0FA10, 0x0FA10, 2 }, { 0x0FA12, 0x0FA12, 2 }, { 0x0FA15, 0x0FA1E, 2 },
+  { 0x0FA20, 0x0FA20, 2 }, { 0x0FA22, 0x0FA22, 2 }, { 0x0FA25, 0x0FA26, 2 },
+  { 0x0FA2A, 0x0FA6D, 2 }, { 0x0FA70, 0x0FAD9, 2 }, { 0x0FB1D, 0x0FB1D, 2 },
+  { 0x0FB1F, 0x0FB1F, 2 }, { 0x0FB2A, 0x0FB36, 2 }, { 0x0FB38, 0x0FB3C, 2 },
+  { 0x0FB3E, 0x0FB3E, 2 }, { 0x0FB40, 0x0FB41, 2 }, { 0x0FB43, 0x0FB44, 2 },
+  { 0x0FB46, 0x0FB4E, 2 }, { 0x110BA, 0x110BA, 1 }, { 0x11127, 0x11127, 1 },
+  { 0x1133E, 0x1133E, 1 }, { 0x11357, 0x11357, 1 }, { 0x114B0, 0x114B0, 1 },
+  { 0x114BA, 0x114BA, 1 }, { 0x114BD, 0x114BD, 1 }, { 0x115AF, 0x115AF, 1 },
+  { 0x11930, 0x11930, 1 }, { 0x1D15E, 0x1D164, 2 }, { 0x1D1BB, 0x1D1C0, 2 },
+  { 0x2F800, 0x2FA1D, 2 },
+};
+
+/* Canonical decompositions, one level deep, indexing unicode_decomposition_pool. */
+static const unicode_decomposition_t unicode_decompositions[] = {
+  { 0x000C0, 0, 2 }, { 0x000C1, 2, 2 }, { 0x000C2, 4, 2 },
+  { 0x000C3, 6, 2 }, { 0x000C4, 8, 2 }, { 0x000C5, 10, 2 },
+  { 0x000C7, 12, 2 }, { 0x000C8, 14, 2 }, { 0x000C9, 16, 2 },
+  { 0x000CA, 18, 2 }, { 0x000CB, 20, 2 }, { 0x000CC, 22, 2 },
+  { 0x000CD, 24, 2 }, { 0x000CE, 26, 2 }, { 0x000CF, 28, 2 },
+  { 0x000D1, 30, 2 }, { 0x000D2, 32, 2 }, { 0x000D3, 34, 2 },
+  { 0x000D4, 36, 2 }, { 0x000D5, 38, 2 }, { 0x000D6, 40, 2 },
+  { 0x000D9, 42, 2 }, { 0x000DA, 44, 2 }, { 0x000DB, 46, 2 },
+  { 0x000DC, 48, 2 }, { 0x000DD, 50, 2 }, { 0x000E0, 52, 2 },
+  { 0x000E1, 54, 2 }, { 0x000E2, 56, 2 }, { 0x000E3, 58, 2 },
+  { 0x000E4, 60, 2 }, { 0x000E5, 62, 2 }, { 0x000E7, 64, 2 },
+  { 0x000E8, 66, 2 }, { 0x000E9, 68, 2 }, { 0x000EA, 70, 2 },
+  { 0x000EB, 72, 2 }, { 0x000EC, 74, 2 }, { 0x000ED, 76, 2 },
+  { 0x000EE, 78, 2 }, { 0x000EF, 80, 2 }, { 0x000F1, 82, 2 },
+  { 0x000F2, 84, 2 }, { 0x000F3, 86, 2 }, { 0x000F4, 88, 2 },
+  { 0x000F5, 90, 2 }, { 0x000F6, 92, 2 }, { 0x000F9, 94, 2 },
+  { 0x000FA, 96, 2 }, { 0x000FB, 98, 2 }, { 0x000FC, 100, 2 },
+  { 0x000FD, 102, 2 }, { 0x000FF, 104, 2 }, { 0x00100, 106, 2 },
+  { 0x00101, 108, 2 }, { 0x00102, 110, 2 }, { 0x00103, 112, 2 },
+  { 0x00104, 114, 2 }, { 0x00105, 116, 2 }, { 0x00106, 118, 2 },
+  { 0x00107, 120, 2 }, { 0x00108, 122, 2 }, { 0x00109, 124, 2 },
+  { 0x0010A, 126, 2 }, { 0x0010B, 128, 2 }, { 0x0010C, 130, 2 },
+  { 0x0010D, 132, 2 }, { 0x0010E, 134, 2 }, { 0x0010F, 136, 2 },
+  { 0x00112, 138, 2 }, { 0x00113, 140, 2 }, { 0x00114, 142, 2 },
+  { 0x00115, 144, 2 }, { 0x00116, 146, 2 }, { 0x00117, 148, 2 },
+  { 0x00118, 150, 2 }, { 0x00119, 152, 2 }, { 0x0011A, 154, 2 },
+  { 0x0011B, 156, 2 }, { 0x0011C, 158, 2 }, { 0x0011D, 160, 2 },
+  { 0x0011E, 162, 2 }, { 0x0011F, 164, 2 }, { 0x00120, 166, 2 },
+  { 0x00121, 168, 2 }, { 0x00122, 170, 2 }, { 0x00123, 172, 2 },
+  { 0x00124, 174, 2 }, { 0x00125, 176, 2 }, { 0x00128, 178, 2 },
+  { 0x00129, 180, 2 }, { 0x0012A, 182, 2 }, { 0x0012B, 184, 2 },
+  { 0x0012C, 186, 2 }, { 0x0012D, 188, 2 }, { 0x0012E, 190, 2 },
+  { 0x0012F, 192, 2 }, { 0x00130, 194, 2 }, { 0x00134, 196, 2 },
+  { 0x00135, 198, 2 }, { 0x00136, 200, 2 }, { 0x00137, 202, 2 },
+  { 0x00139, 204, 2 }, { 0x0013A, 206, 2 }, { 0x0013B, 208, 2 },
+  { 0x0013C, 210, 2 }, { 0x0013D, 212, 2 }, { 0x0013E, 214, 2 },
+  { 0x00143, 216, 2 }, { 0x00144, 218, 2 }, { 0x00145, 220, 2 },
+  { 0x00146, 222, 2 }, { 0x00147, 224, 2 }, { 0x00148, 226, 2 },
+  { 0x0014C, 228, 2 }, { 0x0014D, 230, 2 }, { 0x0014E, 232, 2 },
+  { 0x0014F, 234, 2 }, { 0x00150, 236, 2 }, { 0x00151, 238, 2 },
+  { 0x00154, 240, 2 }, { 0x00155, 242, 2 }, { 0x00156, 244, 2 },
+  { 0x00157, 246, 2 }, { 0x00158, 248, 2 }, { 0x00159, 250, 2 },
+  { 0x0015A, 252, 2 }, { 0x0015B, 254, 2 }, { 0x0015C, 256, 2 },
+  { 0x0015D, 258, 2 }, { 0x0015E, 260, 2 }, { 0x0015F, 262, 2 },
+  { 0x00160, 264, 2 }, { 0x00161, 266, 2 }, { 0x00162, 268, 2 },
+  { 0x00163, 270, 2 }, { 0x00164, 272, 2 }, { 0x00165, 274, 2 },
+  { 0x00168, 276, 2 }, { 0x00169, 278, 2 }, { 0x0016A, 280, 2 },
+  { 0x0016B, 282, 2 }, { 0x0016C, 284, 2 }, { 0x0016D, 286, 2 },
+  { 0x0016E, 288, 2 }, { 0x0016F, 290, 2 }, { 0x00170, 292, 2 },
+  { 0x00171, 294, 2 }, { 0x00172, 296, 2 }, { 0x00173, 298, 2 },
+  { 0x00174, 300, 2 }, { 0x00175, 302, 2 }, { 0x00176, 304, 2 },
+  { 0x00177, 306, 2 }, { 0x00178, 308, 2 }, { 0x00179, 310, 2 },
+  { 0x0017A, 312, 2 }, { 0x0017B, 314, 2 }, { 0x0017C, 316, 2 },
+  { 0x0017D, 318, 2 }, { 0x0017E, 320, 2 }, { 0x001A0, 322, 2 },
+  { 0x001A1, 324, 2 }, { 0x001AF, 326, 2 }, { 0x001B0, 328, 2 },
+  { 0x001CD, 330, 2 }, { 0x001CE, 332, 2 }, { 0x001CF, 334, 2 },
+  { 0x001D0, 336, 2 }, { 0x001D1, 338, 2 }, { 0x001D2, 340, 2 },
+  { 0x001D3, 342, 2 }, { 0x001D4, 344, 2 }, { 0x001D5, 346, 2 },
+  { 0x001D6, 348, 2 }, { 0x001D7, 350, 2 }, { 0x001D8, 352, 2 },
+  { 0x001D9, 354, 2 }, { 0x001DA, 356, 2 }, { 0x001DB, 358, 2 },
+  { 0x001DC, 360, 2 }, { 0x001DE, 362, 2 }, { 0x001DF, 364, 2 },
+  { 0x001E0, 366, 2 }, { 0x001E1, 368, 2 }, { 0x001E2, 370, 2 },
+  { 0x001E3, 372, 2 }, { 0x001E6, 374, 2 }, { 0x001E7, 376, 2 },
+  { 0x001E8, 378, 2 }, { 0x001E9, 380, 2 }, { 0x001EA, 382, 2 },
+  { 0x001EB, 384, 2 }, { 0x001EC, 386, 2 }, { 0x001ED, 388, 2 },
+  { 0x001EE, 390, 2 }, { 0x001EF, 392, 2 }, { 0x001F0, 394, 2 },
+  { 0x001F4, 396, 2 }, { 0x001F5, 398, 2 }, { 0x001F8, 400, 2 },
+  { 0x001F9, 402, 2 }, { 0x001FA, 404, 2 }, { 0x001FB, 406, 2 },
+  { 0x001FC, 408, 2 }, { 0x001FD, 410, 2 }, { 0x001FE, 412, 2 },
+  { 0x001FF, 414, 2 }, { 0x00200, 416, 2 }, { 0x00201, 418, 2 },
+  { 0x00202, 420, 2 }, { 0x00203, 422, 2 }, { 0x00204, 424, 2 },
+  { 0x00205, 426, 2 }, { 0x00206, 428, 2 }, { 0x00207, 430, 2 },
+  { 0x00208, 432, 2 }, { 0x00209, 434, 2 }, { 0x0020A, 436, 2 },
+  { 0x0020B, 438, 2 }, { 0x0020C, 440, 2 }, { 0x0020D, 442, 2 },
+  { 0x0020E, 444, 2 }, { 0x0020F, 446, 2 }, { 0x00210, 448, 2 },
+  { 0x00211, 450, 2 }, { 0x00212, 452, 2 }, { 0x00213, 454, 2 },
+  { 0x00214, 456, 2 }, { 0x00215, 458, 2 }, { 0x00216, 460, 2 },
+  { 0x00217, 462, 2 }, { 0x00218, 464, 2 }, { 0x00219, 466, 2 },
+  { 0x0021A, 468, 2 }, { 0x0021B, 470, 2 }, { 0x0021E, 472, 2 },
+  { 0x0021F, 474, 2 }, { 0x00226, 476, 2 }, { 0x00227, 478, 2 },
+  { 0x00228, 480, 2 }, { 0x00229, 482, 2 }, { 0x0022A, 484, 2 },
+  { 0x0022B, 486, 2 }, { 0x0022C, 488, 2 }, { 0x0022D, 490, 2 },
+  { 0x0022E, 492, 2 }, { 0x0022F, 494, 2 }, { 0x00230, 496, 2 },
+  { 0x00231, 498, 2 }, { 0x00232, 500, 2 }, { 0x00233, 502, 2 },
+  { 0x00340, 504, 1 }, { 0x00341, 505, 1 }, { 0x00343, 506, 1 },
+  { 0x00344, 507, 2 }, { 0x00374, 509, 1 }, { 0x0037E, 510, 1 },
+  { 0x00385, 511, 2 }, { 0x00386, 513, 2 }, { 0x00387, 515, 1 },
+  { 0x00388, 516, 2 }, { 0x00389, 518, 2 }, { 0x0038A, 520, 2 },
+  { 0x0038C, 522, 2 }, { 0x0038E, 524, 2 }, { 0x0038F, 526, 2 },
+  { 0x00390, 528, 2 }, { 0x003AA, 530, 2 }, { 0x003AB, 532, 2 },
+  { 0x003AC, 534, 2 }, { 0x003AD, 536, 2 }, { 0x003AE, 538, 2 },
+  { 0x003AF, 540, 2 }, { 0x003B0, 542, 2 }, { 0x003CA, 544, 2 },
+  { 0x003CB, 546, 2 }, { 0x003CC, 548, 2 }, { 0x003CD, 550, 2 },
+  { 0x003CE, 552, 2 }, { 0x003D3, 554, 2 }, { 0x003D4, 556, 2 },
+  { 0x00400, 558, 2 }, { 0x00401, 560, 2 }, { 0x00403, 562, 2 },
+  { 0x00407, 564, 2 }, { 0x0040C, 566, 2 }, { 0x0040D, 568, 2 },
+  { 0x0040E, 570, 2 }, { 0x00419, 572, 2 }, { 0x00439, 574, 2 },
+  { 0x00450, 576, 2 }, { 0x00451, 578, 2 }, { 0x00453, 580, 2 },
+  { 0x00457, 582, 2 }, { 0x0045C, 584, 2 }, { 0x0045D, 586, 2 },
+  { 0x0045E, 588, 2 }, { 0x00476, 590, 2 }, { 0x00477, 592, 2 },
+  { 0x004C1, 594, 2 }, { 0x004C2, 596, 2 }, { 0x004D0, 598, 2 },
+  { 0x004D1, 600, 2 }, { 0x004D2, 602, 2 }, { 0x004D3, 604, 2 },
+  { 0x004D6, 606, 2 }, { 0x004D7, 608, 2 }, { 0x004DA, 610, 2 },
+  { 0x004DB, 612, 2 }, { 0x004DC, 614, 2 }, { 0x004DD, 616, 2 },
+  { 0x004DE, 618, 2 }, { 0x004DF, 620, 2 }, { 0x004E2, 622, 2 },
+  { 0x004E3, 624, 2 }, { 0x004E4, 626, 2 }, { 0x004E5, 628, 2 },
+  { 0x004E6, 630, 2 }, { 0x004E7, 632, 2 }, { 0x004EA, 634, 2 },
+  { 0x004EB, 636, 2 }, { 0x004EC, 638, 2 }, { 0x004ED, 640, 2 },
+  { 0x004EE, 642, 2 }, { 0x004EF, 644, 2 }, { 0x004F0, 646, 2 },
+  { 0x004F1, 648, 2 }, { 0x004F2, 650, 2 }, { 0x004F3, 652, 2 },
+  { 0x004F4, 654, 2 }, { 0x004F5, 656, 2 }, { 0x004F8, 658, 2 },
+  { 0x004F9, 660, 2 }, { 0x00622, 662, 2 }, { 0x00623, 664, 2 },
+  { 0x00624, 666, 2 }, { 0x00625, 668, 2 }, { 0x00626, 670, 2 },
+  { 0x006C0, 672, 2 }, { 0x006C2, 674, 2 }, { 0x006D3, 676, 2 },
+  { 0x00929, 678, 2 }, { 0x00931, 680, 2 }, { 0x00934, 682, 2 },
+  { 0x00958, 684, 2 }, { 0x00959, 686, 2 }, { 0x0095A, 688, 2 },
+  { 0x0095B, 690, 2 }, { 0x0095C, 692, 2 }, { 0x0095D, 694, 2 },
+  { 0x0095E, 696, 2 }, { 0x0095F, 698, 2 }, { 0x009CB, 700, 2 },
+  { 0x009CC, 702, 2 }, { 0x009DC, 704, 2 }, { 0x009DD, 706, 2 },
+  { 0x009DF, 708, 2 }, { 0x00A33, 710, 2 }, { 0x00A36, 712, 2 },
+  { 0x00A59, 714, 2 }, { 0x00A5A, 716, 2 }, { 0x00A5B, 718, 2 },
+  { 0x00A5E, 720, 2 }, { 0x00B48, 722, 2 }, { 0x00B4B, 724, 2 },
+  { 0x00B4C, 726, 2 }, { 0x00B5C, 728, 2 }, { 0x00B5D, 730, 2 },
+  { 0x00B94, 732, 2 }, { 0x00BCA, 734, 2 }, { 0x00BCB, 736, 2 },
+  { 0x00BCC, 738, 2 }, { 0x00C48, 740, 2 }, { 0x00CC0, 742, 2 },
+  { 0x00CC7, 744, 2 }, { 0x00CC8, 746, 2 }, { 0x00CCA, 748, 2 },
+  { 0x00CCB, 750, 2 }, { 0x00D4A, 752, 2 }, { 0x00D4B, 754, 2 },
+  { 0x00D4C, 756, 2 }, { 0x00DDA, 758, 2 }, { 0x00DDC, 760, 2 },
+  { 0x00DDD, 762, 2 }, { 0x00DDE, 764, 2 }, { 0x00F43, 766, 2 },
+  { 0x00F4D, 768, 2 }, { 0x00F52, 770, 2 }, { 0x00F57, 772, 2 },
+  { 0x00F5C, 774, 2 }, { 0x00F69, 776, 2 }, { 0x00F73, 778, 2 },
+  { 0x00F75, 780, 2 }, { 0x00F76, 782, 2 }, { 0x00F78, 784, 2 },
+  { 0x00F81, 786, 2 }, { 0x00F93, 788, 2 }, { 0x00F9D, 790, 2 },
+  { 0x00FA2, 792, 2 }, { 0x00FA7, 794, 2 }, { 0x00FAC, 796, 2 },
+  { 0x00FB9, 798, 2 }, { 0x01026, 800, 2 }, { 0x01B06, 802, 2 },
+  { 0x01B08, 804, 2 }, { 0x01B0A, 806, 2 }, { 0x01B0C, 808, 2 },
+  { 0x01B0E, 810, 2 }, { 0x01B12, 812, 2 }, { 0x01B3B, 814, 2 },
+  { 0x01B3D, 816, 2 }, { 0x01B40, 818, 2 }, { 0x01B41, 820, 2 },
+  { 0x01B43, 822, 2 }, { 0x01E00, 824, 2 }, { 0x01E01, 826, 2 },
+  { 0x01E02, 828, 2 }, { 0x01E03, 830, 2 }, { 0x01E04, 832, 2 },
+  { 0x01E05, 834, 2 }, { 0x01E06, 836, 2 }, { 0x01E07, 838, 2 },
+  { 0x01E08, 840, 2 }, { 0x01E09, 842, 2 }, { 0x01E0A, 844, 2 },
+  { 0x01E0B, 846, 2 }, { 0x01E0C, 848, 2 }, { 0x01E0D, 850, 2 },
+  { 0x01E0E, 852, 2 }, { 0x01E0F, 854, 2 }, { 0x01E10, 856, 2 },
+  { 0x01E11, 858, 2 }, { 0x01E12, 860, 2 }, { 0x01E13, 862, 2 },
+  { 0x01E14, 864, 2 }, { 0x01E15, 866, 2 }, { 0x01E16, 868, 2 },
+  { 0x01E17, 870, 2 }, { 0x01E18, 872, 2 }, { 0x01E19, 874, 2 },
+  { 0x01E1A, 876, 2 }, { 0x01E1B, 878, 2 }, { 0x01E1C, 880, 2 },
+  { 0x01E1D, 882, 2 }, { 0x01E1E, 884, 2 }, { 0x01E1F, 886, 2 },
+  { 0x01E20, 888, 2 }, { 0x01E21, 890, 2 }, { 0x01E22, 892, 2 },
+  { 0x01E23, 894, 2 }, { 0x01E24, 896, 2 }, { 0x01E25, 898, 2 },
+  { 0x01E26, 900, 2 }, { 0x01E27, 902, 2 }, { 0x01E28, 904, 2 },
+  { 0x01E29, 906, 2 }, { 0x01E2A, 908, 2 }, { 0x01E2B, 910, 2 },
+  { 0x01E2C, 912, 2 }, { 0x01E2D, 914, 2 }, { 0x01E2E, 916, 2 },
+  { 0x01E2F, 918, 2 }, { 0x01E30, 920, 2 }, { 0x01E31, 922, 2 },
+  { 0x01E32, 924, 2 }, { 0x01E33, 926, 2 }, { 0x01E34, 928, 2 },
+  { 0x01E35, 930, 2 }, { 0x01E36, 932, 2 }, { 0x01E37, 934, 2 },
+  { 0x01E38, 936, 2 }, { 0x01E39, 938, 2 }, { 0x01E3A, 940, 2 },
+  { 0x01E3B, 942, 2 }, { 0x01E3C, 944, 2 }, { 0x01E3D, 946, 2 },
+  { 0x01E3E, 948, 2 }, { 0x01E3F, 950, 2 }, { 0x01E40, 952, 2 },
+  { 0x01E41, 954, 2 }, { 0x01E42, 956, 2 }, { 0x01E43, 958, 2 },
+  { 0x01E44, 960, 2 }, { 0x01E45, 962, 2 }, { 0x01E46, 964, 2 },
+  { 0x01E47, 966, 2 }, { 0x01E48, 968, 2 }, { 0x01E49, 970, 2 },
+  { 0x01E4A, 972, 2 }, { 0x01E4B, 974, 2 }, { 0x01E4C, 976, 2 },
+  { 0x01E4D, 978, 2 }, { 0x01E4E, 980, 2 }, { 0x01E4F, 982, 2 },
+  { 0x01E50, 984, 2 }, { 0x01E51, 986, 2 }, { 0x01E52, 988, 2 },
+  { 0x01E53, 990, 2 }, { 0x01E54, 992, 2 }, { 0x01E55, 994, 2 },
+  { 0x01E56, 996, 2 }, { 0x01E57, 998, 2 }, { 0x01E58, 1000, 2 },
+  { 0x01E59, 1002, 2 }, { 0x01E5A, 1004, 2 }, { 0x01E5B, 1006, 2 },
+  { 0x01E5C, 1008, 2 }, { 0x01E5D, 1010, 2 }, { 0x01E5E, 1012, 2 },
+  { 0x01E5F, 1014, 2 }, { 0x01E60, 1016, 2 }, { 0x01E61, 1018, 2 },
+  { 0x01E62, 1020, 2 }, { 0x01E63, 1022, 2 }, { 0x01E64, 1024, 2 },
+  { 0x01E65, 1026, 2 }, { 0x01E66, 1028, 2 }, { 0x01E67, 1030, 2 },
+  { 0x01E68, 1032, 2 }, { 0x01E69, 1034, 2 }, { 0x01E6A, 1036, 2 },
+  { 0x01E6B, 1038, 2 }, { 0x01E6C, 1040, 2 }, { 0x01E6D, 1042, 2 },
+  { 0x01E6E, 1044, 2 }, { 0x01E6F, 1046, 2 }, { 0x01E70, 1048, 2 },
+  { 0x01E71, 1050, 2 }, { 0x01E72, 1052, 2 }, { 0x01E73, 1054, 2 },
+  { 0x01E74, 1056, 2 }, { 0x01E75, 1058, 2 }, { 0x01E76, 1060, 2 },
+  { 0x01E77, 1062, 2 }, { 0x01E78, 1064, 2 }, { 0x01E79, 1066, 2 },
+  { 0x01E7A, 1068, 2 }, { 0x01E7B, 1070, 2 }, { 0x01E7C, 1072, 2 },
+  { 0x01E7D, 1074, 2 }, { 0x01E7E, 1076, 2 }, { 0x01E7F, 1078, 2 },
+  { 0x01E80, 1080, 2 }, { 0x01E81, 1082, 2 }, { 0x01E82, 1084, 2 },
+  { 0x01E83, 1086, 2 }, { 0x01E84, 1088, 2 }, { 0x01E85, 1090, 2 },
+  { 0x01E86, 1092, 2 }, { 0x01E87, 1094, 2 }, { 0x01E88, 1096, 2 },
+  { 0x01E89, 1098, 2 }, { 0x01E8A, 1100, 2 }, { 0x01E8B, 1102, 2 },
+  { 0x01E8C, 1104, 2 }, { 0x01E8D, 1106, 2 }, { 0x01E8E, 1108, 2 },
+  { 0x01E8F, 1110, 2 }, { 0x01E90, 1112, 2 }, { 0x01E91, 1114, 2 },
+  { 0x01E92, 1116, 2 }, { 0x01E93, 1118, 2 }, { 0x01E94, 1120, 2 },
+  { 0x01E95, 1122, 2 }, { 0x01E96, 1124, 2 }, { 0x01E97, 1126, 2 },
+  { 0x01E98, 1128, 2 }, { 0x01E99, 1130, 2 }, { 0x01E9B, 1132, 2 },
+  { 0x01EA0, 1134, 2 }, { 0x01EA1, 1136, 2 }, { 0x01EA2, 1138, 2 },
+  { 0x01EA3, 1140, 2 }, { 0x01EA4, 1142, 2 }, { 0x01EA5, 1144, 2 },
+  { 0x01EA6, 1146, 2 }, { 0x01EA7, 1148, 2 }, { 0x01EA8, 1150, 2 },
+  { 0x01EA9, 1152, 2 }, { 0x01EAA, 1154, 2 }, { 0x01EAB, 1156, 2 },
+  { 0x01EAC, 1158, 2 }, { 0x01EAD, 1160, 2 }, { 0x01EAE, 1162, 2 },
+  { 0x01EAF, 1164, 2 }, { 0x01EB0, 1166, 2 }, { 0x01EB1, 1168, 2 },
+  { 0x01EB2, 1170, 2 }, { 0x01EB3, 1172, 2 }, { 0x01EB4, 1174, 2 },
+  { 0x01EB5, 1176, 2 }, { 0x01EB6, 1178, 2 }, { 0x01EB7, 1180, 2 },
+  { 0x01EB8, 1182, 2 }, { 0x01EB9, 1184, 2 }, { 0x01EBA, 1186, 2 },
+  { 0x01EBB, 1188, 2 }, { 0x01EBC, 1190, 2 }, { 0x01EBD, 1192, 2 },
+  { 0x01EBE, 1194, 2 }, { 0x01EBF, 1196, 2 }, { 0x01EC0, 1198, 2 },
+  { 0x01EC1, 1200, 2 }, { 0x01EC2, 1202, 2 }, { 0x01EC3, 1204, 2 },
+  { 0x01EC4, 1206, 2 }, { 0x01EC5, 1208, 2 }, { 0x01EC6, 1210, 2 },
+  { 0x01EC7, 1212, 2 }, { 0x01EC8, 1214, 2 }, { 0x01EC9, 1216, 2 },
+  { 0x01ECA, 1218, 2 }, { 0x01ECB, 1220, 2 }, { 0x01ECC, 1222, 2 },
+  { 0x01ECD, 1224, 2 }, { 0x01ECE, 1226, 2 }, { 0x01ECF, 1228, 2 },
+  { 0x01ED0, 1230, 2 }, { 0x01ED1, 1232, 2 }, { 0x01ED2, 1234, 2 },
+  { 0x01ED3, 1236, 2 }, { 0x01ED4, 1238, 2 }, { 0x01ED5, 1240, 2 },
+  { 0x01ED6, 1242, 2 }, { 0x01ED7, 1244, 2 }, { 0x01ED8, 1246, 2 },
+  { 0x01ED9, 1248, 2 }, { 0x01EDA, 1250, 2 }, { 0x01EDB, 1252, 2 },
+  { 0x01EDC, 1254, 2 }, { 0x01EDD, 1256, 2 }, { 0x01EDE, 1258, 2 },
+  { 0x01EDF, 1260, 2 }, { 0x01EE0, 1262, 2 }, { 0x01EE1, 1264, 2 },
+  { 0x01EE2, 1266, 2 }, { 0x01EE3, 1268, 2 }, { 0x01EE4, 1270, 2 },
+  { 0x01EE5, 1272, 2 }, { 0x01EE6, 1274, 2 }, { 0x01EE7, 1276, 2 },
+  { 0x01EE8, 1278, 2 }, { 0x01EE9, 1280, 2 }, { 0x01EEA, 1282, 2 },
+  { 0x01EEB, 1284, 2 }, { 0x01EEC, 1286, 2 }, { 0x01EED, 1288, 2 },
+  { 0x01EEE, 1290, 2 }, { 0x01EEF, 1292, 2 }, { 0x01EF0, 1294, 2 },
+  { 0x01EF1, 1296, 2 }, { 0x01EF2, 1298, 2 }, { 0x01EF3, 1300, 2 },
+  { 0x01EF4, 1302, 2 }, { 0x01EF5, 1304, 2 }, { 0x01EF6, 1306, 2 },
+  { 0x01EF7, 1308, 2 }, { 0x01EF8, 1310, 2 }, { 0x01EF9, 1312, 2 },
+  { 0x01F00, 1314, 2 }, { 0x01F01, 1316, 2 }, { 0x01F02, 1318, 2 },
+  { 0x01F03, 1320, 2 }, { 0x01F04, 1322, 2 }, { 0x01F05, 1324, 2 },
+  { 0x01F06, 1326, 2 }, { 0x01F07, 1328, 2 }, { 0x01F08, 1330, 2 },
+  { 0x01F09, 1332, 2 }, { 0x01F0A, 1334, 2 }, { 0x01F0B, 1336, 2 },
+  { 0x01F0C, 1338, 2 }, { 0x01F0D, 1340, 2 }, { 0x01F0E, 1342, 2 },
+  { 0x01F0F, 1344, 2 }, { 0x01F10, 1346, 2 }, { 0x01F11, 1348, 2 },
+  { 0x01F12, 1350, 2 }, { 0x01F13, 1352, 2 }, { 0x01F14, 1354, 2 },
+  { 0x01F15, 1356, 2 }, { 0x01F18, 1358, 2 }, { 0x01F19, 1360, 2 },
+  { 0x01F1A, 1362, 2 }, { 0x01F1B, 1364, 2 }, { 0x01F1C, 1366, 2 },
+  { 0x01F1D, 1368, 2 }, { 0x01F20, 1370, 2 }, { 0x01F21, 1372, 2 },
+  { 0x01F22, 1374, 2 }, { 0x01F23, 1376, 2 }, { 0x01F24, 1378, 2 },
+  { 0x01F25, 1380, 2 }, { 0x01F26, 1382, 2 }, { 0x01F27, 1384, 2 },
+  { 0x01F28, 1386, 2 }, { 0x01F29, 1388, 2 }, { 0x01F2A, 1390, 2 },
+  { 0x01F2B, 1392, 2 }, { 0x01F2C, 1394, 2 }, { 0x01F2D, 1396, 2 },
+  { 0x01F2E, 1398, 2 }, { 0x01F2F, 1400, 2 }, { 0x01F30, 1402, 2 },
+  { 0x01F31, 1404, 2 }, { 0x01F32, 1406, 2 }, { 0x01F33, 1408, 2 },
+  { 0x01F34, 1410, 2 }, { 0x01F35, 1412, 2 }, { 0x01F36, 1414, 2 },
+  { 0x01F37, 1416, 2 }, { 0x01F38, 1418, 2 }, { 0x01F39, 1420, 2 },
+  { 0x01F3A, 1422, 2 }, { 0x01F3B, 1424, 2 }, { 0x01F3C, 1426, 2 },
+  { 0x01F3D, 1428, 2 }, { 0x01F3E, 1430, 2 }, { 0x01F3F, 1432, 2 },
+  { 0x01F40, 1434, 2 }, { 0x01F41, 1436, 2 }, { 0x01F42, 1438, 2 },
+  { 0x01F43, 1440, 2 }, { 0x01F44, 1442, 2 }, { 0x01F45, 1444, 2 },
+  { 0x01F48, 1446, 2 }, { 0x01F49, 1448, 2 }, { 0x01F4A, 1450, 2 },
+  { 0x01F4B, 1452, 2 }, { 0x01F4C, 1454, 2 }, { 0x01F4D, 1456, 2 },
+  { 0x01F50, 1458, 2 }, { 0x01F51, 1460, 2 }, { 0x01F52, 1462, 2 },
+  { 0x01F53, 1464, 2 }, { 0x01F54, 1466, 2 }, { 0x01F55, 1468, 2 },
+  { 0x01F56, 1470, 2 }, { 0x01F57, 1472, 2 }, { 0x01F59, 1474, 2 },
+  { 0x01F5B, 1476, 2 }, { 0x01F5D, 1478, 2 }, { 0x01F5F, 1480, 2 },
+  { 0x01F60, 1482, 2 }, { 0x01F61, 1484, 2 }, { 0x01F62, 1486, 2 },
+  { 0x01F63, 1488, 2 }, { 0x01F64, 1490, 2 }, { 0x01F65, 1492, 2 },
+  { 0x01F66, 1494, 2 }, { 0x01F67, 1496, 2 }, { 0x01F68, 1498, 2 },
+  { 0x01F69, 1500, 2 }, { 0x01F6A, 1502, 2 }, { 0x01F6B, 1504, 2 },
+  { 0x01F6C, 1506, 2 }, { 0x01F6D, 1508, 2 }, { 0x01F6E, 1510, 2 },
+  { 0x01F6F, 1512, 2 }, { 0x01F70, 1514, 2 }, { 0x01F71, 1516, 1 },
+  { 0x01F72, 1517, 2 }, { 0x01F73, 1519, 1 }, { 0x01F74, 1520, 2 },
+  { 0x01F75, 1522, 1 }, { 0x01F76, 1523, 2 }, { 0x01F77, 1525, 1 },
+  { 0x01F78, 1526, 2 }, { 0x01F79, 1528, 1 }, { 0x01F7A, 1529, 2 },
+  { 0x01F7B, 1531, 1 }, { 0x01F7C, 1532, 2 }, { 0x01F7D, 1534, 1 },
+  { 0x01F80, 1535, 2 }, { 0x01F81, 1537, 2 }, { 0x01F82, 1539, 2 },
+  { 0x01F83, 1541, 2 }, { 0x01F84, 1543, 2 }, { 0x01F85, 1545, 2 },
+  { 0x01F86, 1547, 2 }, { 0x01F87, 1549, 2 }, { 0x01F88, 1551, 2 },
+  { 0x01F89, 1553, 2 }, { 0x01F8A, 1555, 2 }, { 0x01F8B, 1557, 2 },
+  { 0x01F8C, 1559, 2 }, { 0x01F8D, 1561, 2 }, { 0x01F8E, 1563, 2 },
+  { 0x01F8F, 1565, 2 }, { 0x01F90, 1567, 2 }, { 0x01F91, 1569, 2 },
+  { 0x01F92, 1571, 2 }, { 0x01F93, 1573, 2 }, { 0x01F94, 1575, 2 },
+  { 0x01F95, 1577, 2 }, { 0x01F96, 1579, 2 }, { 0x01F97, 1581, 2 },
+  { 0x01F98, 1583, 2 }, { 0x01F99, 1585, 2 }, { 0x01F9A, 1587, 2 },
+  { 0x01F9B, 1589, 2 }, { 0x01F9C, 1591, 2 }, { 0x01F9D, 1593, 2 },
+  { 0x01F9E, 1595, 2 }, { 0x01F9F, 1597, 2 }, { 0x01FA0, 1599, 2 },
+  { 0x01FA1, 1601, 2 }, { 0x01FA2, 1603, 2 }, { 0x01FA3, 1605, 2 },
+  { 0x01FA4, 1607, 2 }, { 0x01FA5, 1609, 2 }, { 0x01FA6, 1611, 2 },
+  { 0x01FA7, 1613, 2 }, { 0x01FA8, 1615, 2 }, { 0x01FA9, 1617, 2 },
+  { 0x01FAA, 1619, 2 }, { 0x01FAB, 1621, 2 }, { 0x01FAC, 1623, 2 },
+  { 0x01FAD, 1625, 2 }, { 0x01FAE, 1627, 2 }, { 0x01FAF, 1629, 2 },
+  { 0x01FB0, 1631, 2 }, { 0x01FB1, 1633, 2 }, { 0x01FB2, 1635, 2 },
+  { 0x01FB3, 1637, 2 }, { 0x01FB4, 1639, 2 }, { 0x01FB6, 1641, 2 },
+  { 0x01FB7, 1643, 2 }, { 0x01FB8, 1645, 2 }, { 0x01FB9, 1647, 2 },
+  { 0x01FBA, 1649, 2 }, { 0x01FBB, 1651, 1 }, { 0x01FBC, 1652, 2 },
+  { 0x01FBE, 1654, 1 }, { 0x01FC1, 1655, 2 }, { 0x01FC2, 1657, 2 },
+  { 0x01FC3, 1659, 2 }, { 0x01FC4, 1661, 2 }, { 0x01FC6, 1663, 2 },
+  { 0x01FC7, 1665, 2 }, { 0x01FC8, 1667, 2 }, { 0x01FC9, 1669, 1 },
+  { 0x01FCA, 1670, 2 }, { 0x01FCB, 1672, 1 }, { 0x01FCC, 1673, 2 },
+  { 0x01FCD, 1675, 2 }, { 0x01FCE, 1677, 2 }, { 0x01FCF, 1679, 2 },
+  { 0x01FD0, 1681, 2 }, { 0x01FD1, 1683, 2 }, { 0x01FD2, 1685, 2 },
+  { 0x01FD3, 1687, 1 }, { 0x01FD6, 1688, 2 }, { 0x01FD7, 1690, 2 },
+  { 0x01FD8, 1692, 2 }, { 0x01FD9, 1694, 2 }, { 0x01FDA, 1696, 2 },
+  { 0x01FDB, 1698, 1 }, { 0x01FDD, 1699, 2 }, { 0x01FDE, 1701, 2 },
+  { 0x01FDF, 1703, 2 }, { 0x01FE0, 1705, 2 }, { 0x01FE1, 1707, 2 },
+  { 0x01FE2, 1709, 2 }, { 0x01FE3, 1711, 1 }, { 0x01FE4, 1712, 2 },
+  { 0x01FE5, 1714, 2 }, { 0x01FE6, 1716, 2 }, { 0x01FE7, 1718, 2 },
+  { 0x01FE8, 1720, 2 }, { 0x01FE9, 1722, 2 }, { 0x01FEA, 1724, 2 },
+  { 0x01FEB, 1726, 1 }, { 0x01FEC, 1727, 2 }, { 0x01FED, 1729, 2 },
+  { 0x01FEE, 1731, 1 }, { 0x01FEF, 1732, 1 }, { 0x01FF2, 1733, 2 },
+  { 0x01FF3, 1735, 2 }, { 0x01FF4, 1737, 2 }, { 0x01FF6, 1739, 2 },
+  { 0x01FF7, 1741, 2 }, { 0x01FF8, 1743, 2 }, { 0x01FF9, 1745, 1 },
+  { 0x01FFA, 1746, 2 }, { 0x01FFB, 1748, 1 }, { 0x01FFC, 1749, 2 },
+  { 0x01FFD, 1751, 1 }, { 0x02000, 1752, 1 }, { 0x02001, 1753, 1 },
+  { 0x02126, 1754, 1 }, { 0x0212A, 1755, 1 }, { 0x0212B, 1756, 1 },
+  { 0x0219A, 1757, 2 }, { 0x0219B, 1759, 2 }, { 0x021AE, 1761, 2 },
+  { 0x021CD, 1763, 2 }, { 0x021CE, 1765, 2 }, { 0x021CF, 1767, 2 },
+  { 0x02204, 1769, 2 }, { 0x02209, 1771, 2 }, { 0x0220C, 1773, 2 },
+  { 0x02224, 1775, 2 }, { 0x02226, 1777, 2 }, { 0x02241, 1779, 2 },
+  { 0x02244, 1781, 2 }, { 0x02247, 1783, 2 }, { 0x02249, 1785, 2 },
+  { 0x02260, 1787, 2 }, { 0x02262, 1789, 2 }, { 0x0226D, 1791, 2 },
+  { 0x0226E, 1793, 2 }, { 0x0226F, 1795, 2 }, { 0x02270, 1797, 2 },
+  { 0x02271, 1799, 2 }, { 0x02274, 1801, 2 }, { 0x02275, 1803, 2 },
+  { 0x02278, 1805, 2 }, { 0x02279, 1807, 2 }, { 0x02280, 1809, 2 },
+  { 0x02281, 1811, 2 }, { 0x02284, 1813, 2 }, { 0x02285, 1815, 2 },
+  { 0x02288, 1817, 2 }, { 0x02289, 1819, 2 }, { 0x022AC, 1821, 2 },
+  { 0x022AD, 1823, 2 }, { 0x022AE, 1825, 2 }, { 0x022AF, 1827, 2 },
+  { 0x022E0, 1829, 2 }, { 0x022E1, 1831, 2 }, { 0x022E2, 1833, 2 },
+  { 0x022E3, 1835, 2 }, { 0x022EA, 1837, 2 }, { 0x022EB, 1839, 2 },
+  { 0x022EC, 1841, 2 }, { 0x022ED, 1843, 2 }, { 0x02329, 1845, 1 },
+  { 0x0232A, 1846, 1 }, { 0x02ADC, 1847, 2 }, { 0x0304C, 1849, 2 },
+  { 0x0304E, 1851, 2 }, { 0x03050, 1853, 2 }, { 0x03052, 1855, 2 },
+  { 0x03054, 1857, 2 }, { 0x03056, 1859, 2 }, { 0x03058, 1861, 2 },
+  { 0x0305A, 1863, 2 }, { 0x0305C, 1865, 2 }, { 0x0305E, 1867, 2 },
+  { 0x03060, 1869, 2 }, { 0x03062, 1871, 2 }, { 0x03065, 1873, 2 },
+  { 0x03067, 1875, 2 }, { 0x03069, 1877, 2 }, { 0x03070, 1879, 2 },
+  { 0x03071, 1881, 2 }, { 0x03073, 1883, 2 }, { 0x03074, 1885, 2 },
+  { 0x03076, 1887, 2 }, { 0x03077, 1889, 2 }, { 0x03079, 1891, 2 },
+  { 0x0307A, 1893, 2 }, { 0x0307C, 1895, 2 }, { 0x0307D, 1897, 2 },
+  { 0x03094, 1899, 2 }, { 0x0309E, 1901, 2 }, { 0x030AC, 1903, 2 },
+  { 0x030AE, 1905, 2 }, { 0x030B0, 1907, 2 }, { 0x030B2, 1909, 2 },
+  { 0x030B4, 1911, 2 }, { 0x030B6, 1913, 2 }, { 0x030B8, 1915, 2 },
+  { 0x030BA, 1917, 2 }, { 0x030BC, 1919, 2 }, { 0x030BE, 1921, 2 },
+  { 0x030C0, 1923, 2 }, { 0x030C2, 1925, 2 }, { 0x030C5, 1927, 2 },
+  { 0x030C7, 1929, 2 }, { 0x030C9, 1931, 2 }, { 0x030D0, 1933, 2 },
+  { 0x030D1, 1935, 2 }, { 0x030D3, 1937, 2 }, { 0x030D4, 1939, 2 },
+  { 0x030D6, 1941, 2 }, { 0x030D7, 1943, 2 }, { 0x030D9, 1945, 2 },
+  { 0x030DA, 1947, 2 }, { 0x030DC, 1949, 2 }, { 0x030DD, 1951, 2 },
+  { 0x030F4, 1953, 2 }, { 0x030F7, 1955, 2 }, { 0x030F8, 1957, 2 },
+  { 0x030F9, 1959, 2 }, { 0x030FA, 1961, 2 }, { 0x030FE, 1963, 2 },
+  { 0x0F900, 1965, 1 }, { 0x0F901, 1966, 1 }, { 0x0F902, 1967, 1 },
+  { 0x0F903, 1968, 1 }, { 0x0F904, 1969, 1 }, { 0x0F905, 1970, 1 },
+  { 0x0F906, 1971, 1 }, { 0x0F907, 1972, 1 }, { 0x0F908, 1973, 1 },
+  { 0x0F909, 1974, 1 }, { 0x0F90A, 1975, 1 }, { 0x0F90B, 1976, 1 },
+  { 0x0F90C, 1977, 1 }, { 0x0F90D, 1978, 1 }, { 0x0F90E, 1979, 1 },
+  { 0x0F90F, 1980, 1 }, { 0x0F910, 1981, 1 }, { 0x0F911, 1982, 1 },
+  { 0x0F912, 1983, 1 }, { 0x0F913, 1984, 1 }, { 0x0F914, 1985, 1 },
+  { 0x0F915, 1986, 1 }, { 0x0F916, 1987, 1 }, { 0x0F917, 1988, 1 },
+  { 0x0F918, 1989, 1 }, { 0x0F919, 1990, 1 }, { 0x0F91A, 1991, 1 },
+  { 0x0F91B, 1992, 1 }, { 0x0F91C, 1993, 1 }, { 0x0F91D, 1994, 1 },
+  { 0x0F91E, 1995, 1 }, { 0x0F91F, 1996, 1 }, { 0x0F920, 1997, 1 },
+  { 0x0F921, 1998, 1 }, { 0x0F922, 1999, 1 }, { 0x0F923, 2000, 1 },
+  { 0x0F924, 2001, 1 }, { 0x0F925, 2002, 1 }, { 0x0F926, 2003, 1 },
+  { 0x0F927, 2004, 1 }, { 0x0F928, 2005, 1 }, { 0x0F929, 2006, 1 },
+  { 0x0F92A, 2007, 1 }, { 0x0F92B, 2008, 1 }, { 0x0F92C, 2009, 1 },
+  { 0x0F92D, 2010, 1 }, { 0x0F92E, 2011, 1 }, { 0x0F92F, 2012, 1 },
+  { 0x0F930, 2013, 1 }, { 0x0F931, 2014, 1 }, { 0x0F932, 2015, 1 },
+  { 0x0F933, 2016, 1 }, { 0x0F934, 2017, 1 }, { 0x0F935, 2018, 1 },
+  { 0x0F936, 2019, 1 }, { 0x0F937, 2020, 1 }, { 0x0F938, 2021, 1 },
+  { 0x0F939, 2022, 1 }, { 0x0F93A, 2023, 1 }, { 0x0F93B, 2024, 1 },
+  { 0x0F93C, 2025, 1 }, { 0x0F93D, 2026, 1 }, { 0x0F93E, 2027, 1 },
+  { 0x0F93F, 2028, 1 }, { 0x0F940, 2029, 1 }, { 0x0F941, 2030, 1 },
+  { 0x0F942, 2031, 1 }, { 0x0F943, 2032, 1 }, { 0x0F944, 2033, 1 },
+  { 0x0F945, 2034, 1 }, { 0x0F946, 2035, 1 }, { 0x0F947, 2036, 1 },
+  { 0x0F948, 2037, 1 }, { 0x0F949, 2038, 1 }, { 0x0F94A, 2039, 1 },
+  { 0x0F94B, 2040, 1 }, { 0x0F94C, 2041, 1 }, { 0x0F94D, 2042, 1 },
+  { 0x0F94E, 2043, 1 }, { 0x0F94F, 2044, 1 }, { 0x0F950, 2045, 1 },
+  { 0x0F951, 2046, 1 }, { 0x0F952, 2047, 1 }, { 0x0F953, 2048, 1 },
+  { 0x0F954, 2049, 1 }, { 0x0F955, 2050, 1 }, { 0x0F956, 2051, 1 },
+  { 0x0F957, 2052, 1 }, { 0x0F958, 2053, 1 }, { 0x0F959, 2054, 1 },
+  { 0x0F95A, 2055, 1 }, { 0x0F95B, 2056, 1 }, { 0x0F95C, 2057, 1 },
+  { 0x0F95D, 2058, 1 }, { 0x0F95E, 2059, 1 }, { 0x0F95F, 2060, 1 },
+  { 0x0F960, 2061, 1 }, { 0x0F961, 2062, 1 }, { 0x0F962, 2063, 1 },
+  { 0x0F963, 2064, 1 }, { 0x0F964, 2065, 1 }, { 0x0F965, 2066, 1 },
+  { 0x0F966, 2067, 1 }, { 0x0F967, 2068, 1 }, { 0x0F968, 2069, 1 },
+  { 0x0F969, 2070, 1 }, { 0x0F96A, 2071, 1 }, { 0x0F96B, 2072, 1 },
+  { 0x0F96C, 2073, 1 }, { 0x0F96D, 2074, 1 }, { 0x0F96E, 2075, 1 },
+  { 0x0F96F, 2076, 1 }, { 0x0F970, 2077, 1 }, { 0x0F971, 2078, 1 },
+  { 0x0F972, 2079, 1 }, { 0x0F973, 2080, 1 }, { 0x0F974, 2081, 1 },
+  { 0x0F975, 2082, 1 }, { 0x0F976, 2083, 1 }, { 0x0F977, 2084, 1 },
+  { 0x0F978, 2085, 1 }, { 0x0F979, 2086, 1 }, { 0x0F97A, 2087, 1 },
+  { 0x0F97B, 2088, 1 }, { 0x0F97C, 2089, 1 }, { 0x0F97D, 2090, 1 },
+  { 0x0F97E, 2091, 1 }, { 0x0F97F, 2092, 1 }, { 0x0F980, 2093, 1 },
+  { 0x0F981, 2094, 1 }, { 0x0F982, 2095, 1 }, { 0x0F983, 2096, 1 },
+  { 0x0F984, 2097, 1 }, { 0x0F985, 2098, 1 }, { 0x0F986, 2099, 1 },
+  { 0x0F987, 2100, 1 }, { 0x0F988, 2101, 1 }, { 0x0F989, 2102, 1 },
+  { 0x0F98A, 2103, 1 }, { 0x0F98B, 2104, 1 }, { 0x0F98C, 2105, 1 },
+  { 0x0F98D, 2106, 1 }, { 0x0F98E, 2107, 1 }, { 0x0F98F, 2108, 1 },
+  { 0x0F990, 2109, 1 }, { 0x0F991, 2110, 1 }, { 0x0F992, 2111, 1 },
+  { 0x0F993, 2112, 1 }, { 0x0F994, 2113, 1 }, { 0x0F995, 2114, 1 },
+  { 0x0F996, 2115, 1 }, { 0x0F997, 2116, 1 }, { 0x0F998, 2117, 1 },
+  { 0x0F999, 2118, 1 }, { 0x0F99A, 2119, 1 }, { 0x0F99B, 2120, 1 },
+  { 0x0F99C, 2121, 1 }, { 0x0F99D, 2122, 1 }, { 0x0F99E, 2123, 1 },
+  { 0x0F99F, 2124, 1 }, { 0x0F9A0, 2125, 1 }, { 0x0F9A1, 2126, 1 },
+  { 0x0F9A2, 2127, 1 }, { 0x0F9A3, 2128, 1 }, { 0x0F9A4, 2129, 1 },
+  { 0x0F9A5, 2130, 1 }, { 0x0F9A6, 2131, 1 }, { 0x0F9A7, 2132, 1 },
+  { 0x0F9A8, 2133, 1 }, { 0x0F9A9, 2134, 1 }, { 0x0F9AA, 2135, 1 },
+  { 0x0F9AB, 2136, 1 }, { 0x0F9AC, 2137, 1 }, { 0x0F9AD, 2138, 1 },
+  { 0x0F9AE, 2139, 1 }, { 0x0F9AF, 2140, 1 }, { 0x0F9B0, 2141, 1 },
+  { 0x0F9B1, 2142, 1 }, { 0x0F9B2, 2143, 1 }, { 0x0F9B3, 2144, 1 },
+  { 0x0F9B4, 2145, 1 }, { 0x0F9B5, 2146, 1 }, { 0x0F9B6, 2147, 1 },
+  { 0x0F9B7, 2148, 1 }, { 0x0F9B8, 2149, 1 }, { 0x0F9B9, 2150, 1 },
+  { 0x0F9BA, 2151, 1 }, { 0x0F9BB, 2152, 1 }, { 0x0F9BC, 2153, 1 },
+  { 0x0F9BD, 2154, 1 }, { 0x0F9BE, 2155, 1 }, { 0x0F9BF, 2156, 1 },
+  { 0x0F9C0, 2157, 1 }, { 0x0F9C1, 2158, 1 }, { 0x0F9C2, 2159, 1 },
+  { 0x0F9C3, 2160, 1 }, { 0x0F9C4, 2161, 1 }, { 0x0F9C5, 2162, 1 },
+  { 0x0F9C6, 2163, 1 }, { 0x0F9C7, 2164, 1 }, { 0x0F9C8, 2165, 1 },
+  { 0x0F9C9, 2166, 1 }, { 0x0F9CA, 2167, 1 }, { 0x0F9CB, 2168, 1 },
+  { 0x0F9CC, 2169, 1 }, { 0x0F9CD, 2170, 1 }, { 0x0F9CE, 2171, 1 },
+  { 0x0F9CF, 2172, 1 }, { 0x0F9D0, 2173, 1 }, { 0x0F9D1, 2174, 1 },
+  { 0x0F9D2, 2175, 1 }, { 0x0F9D3, 2176, 1 }, { 0x0F9D4, 2177, 1 },
+  { 0x0F9D5, 2178, 1 }, { 0x0F9D6, 2179, 1 }, { 0x0F9D7, 2180, 1 },
+  { 0x0F9D8, 2181, 1 }, { 0x0F9D9, 2182, 1 }, { 0x0F9DA, 2183, 1 },
+  { 0x0F9DB, 2184, 1 }, { 0x0F9DC, 2185, 1 }, { 0x0F9DD, 2186, 1 },
+  { 0x0F9DE, 2187, 1 }, { 0x0F9DF, 2188, 1 }, { 0x0F9E0, 2189, 1 },
+  { 0x0F9E1, 2190, 1 }, { 0x0F9E2, 2191, 1 }, { 0x0F9E3, 2192, 1 },
+  { 0x0F9E4, 2193, 1 }, { 0x0F9E5, 2194, 1 }, { 0x0F9E6, 2195, 1 },
+  { 0x0F9E7, 2196, 1 }, { 0x0F9E8, 2197, 1 }, { 0x0F9E9, 2198, 1 },
+  { 0x0F9EA, 2199, 1 }, { 0x0F9EB, 2200, 1 }, { 0x0F9EC, 2201, 1 },
+  { 0x0F9ED, 2202, 1 }, { 0x0F9EE, 2203, 1 }, { 0x0F9EF, 2204, 1 },
+  { 0x0F9F0, 2205, 1 }, { 0x0F9F1, 2206, 1 }, { 0x0F9F2, 2207, 1 },
+  { 0x0F9F3, 2208, 1 }, { 0x0F9F4, 2209, 1 }, { 0x0F9F5, 2210, 1 },
+  { 0x0F9F6, 2211, 1 }, { 0x0F9F7, 2212, 1 }, { 0x0F9F8, 2213, 1 },
+  { 0x0F9F9, 2214, 1 }, { 0x0F9FA, 2215, 1 }, { 0x0F9FB, 2216, 1 },
+  { 0x0F9FC, 2217, 1 }, { 0x0F9FD, 2218, 1 }, { 0x0F9FE, 2219, 1 },
+  { 0x0F9FF, 2220, 1 }, { 0x0FA00, 2221, 1 }, { 0x0FA01, 2222, 1 },
+  { 0x0FA02, 2223, 1 }, { 0x0FA03, 2224, 1 }, { 0x0FA04, 2225, 1 },
+  { 0x0FA05, 2226, 1 }, { 0x0FA06, 2227, 1 }, { 0x0FA07, 2228, 1 },
+  { 0x0FA08, 2229, 1 }, { 0x0FA09, 2230, 1 }, { 0x0FA0A, 2231, 1 },
+  { 0x0FA0B, 2232, 1 }, { 0x0FA0C, 2233, 1 }, { 0x0FA0D, 2234, 1 },
+  { 0x0FA10, 2235, 1 }, { 0x0FA12, 2236, 1 }, { 0x0FA15, 2237, 1 },
+  { 0x0FA16, 2238, 1 }, { 0x0FA17, 2239, 1 }, { 0x0FA18, 2240, 1 },
+  { 0x0FA19, 2241, 1 }, { 0x0FA1A, 2242, 1 }, { 0x0FA1B, 2243, 1 },
+  { 0x0FA1C, 2244, 1 }, { 0x0FA1D, 2245, 1 }, { 0x0FA1E, 2246, 1 },
+  { 0x0FA20, 2247, 1 }, { 0x0FA22, 2248, 1 }, { 0x0FA25, 2249, 1 },
+  { 0x0FA26, 2250, 1 }, { 0x0FA2A, 2251, 1 }, { 0x0FA2B, 2252, 1 },
+  { 0x0FA2C, 2253, 1 }, { 0x0FA2D, 2254, 1 }, { 0x0FA2E, 2255, 1 },
+  { 0x0FA2F, 2256, 1 }, { 0x0FA30, 2257, 1 }, { 0x0FA31, 2258, 1 },
+  { 0x0FA32, 2259, 1 }, { 0x0FA33, 2260, 1 }, { 0x0FA34, 2261, 1 },
+  { 0x0FA35, 2262, 1 }, { 0x0FA36, 2263, 1 }, { 0x0FA37, 2264, 1 },
+  { 0x0FA38, 2265, 1 }, { 0x0FA39, 2266, 1 }, { 0x0FA3A, 2267, 1 },
+  { 0x0FA3B, 2268, 1 }, { 0x0FA3C, 2269, 1 }, { 0x0FA3D, 2270, 1 },
+  { 0x0FA3E, 2271, 1 }, { 0x0FA3F, 2272, 1 }, { 0x0FA40, 2273, 1 },
+  { 0x0FA41, 2274, 1 }, { 0x0FA42, 2275, 1 }, { 0x0FA43, 2276, 1 },
+  { 0x0FA44, 2277, 1 }, { 0x0FA45, 2278, 1 }, { 0x0FA46, 2279, 1 },
+  { 0x0FA47, 2280, 1 }, { 0x0FA48, 2281, 1 }, { 0x0FA49, 2282, 1 },
+  { 0x0FA4A, 2283, 1 }, { 0x0FA4B, 2284, 1 }, { 0x0FA4C, 2285, 1 },
+  { 0x0FA4D, 2286, 1 }, { 0x0FA4E, 2287, 1 }, { 0x0FA4F, 2288, 1 },
+  { 0x0FA50, 2289, 1 }, { 0x0FA51, 2290, 1 }, { 0x0FA52, 2291, 1 },
+  { 0x0FA53, 2292, 1 }, { 0x0FA54, 2293, 1 }, { 0x0FA55, 2294, 1 },
+  { 0x0FA56, 2295, 1 }, { 0x0FA57, 2296, 1 }, { 0x0FA58, 2297, 1 },
+  { 0x0FA59, 2298, 1 }, { 0x0FA5A, 2299, 1 }, { 0x0FA5B, 2300, 1 },
+  { 0x0FA5C, 2301, 1 }, { 0x0FA5D, 2302, 1 }, { 0x0FA5E, 2303, 1 },
+  { 0x0FA5F, 2304, 1 }, { 0x0FA60, 2305, 1 }, { 0x0FA61, 2306, 1 },
+  { 0x0FA62, 2307, 1 }, { 0x0FA63, 2308, 1 }, { 0x0FA64, 2309, 1 },
+  { 0x0FA65, 2310, 1 }, { 0x0FA66, 2311, 1 }, { 0x0FA67, 2312, 1 },
+  { 0x0FA68, 2313, 1 }, { 0x0FA69, 2314, 1 }, { 0x0FA6A, 2315, 1 },
+  { 0x0FA6B, 2316, 1 }, { 0x0FA6C, 2317, 1 }, { 0x0FA6D, 2318, 1 },
+  { 0x0FA70, 2319, 1 }, { 0x0FA71, 2320, 1 }, { 0x0FA72, 2321, 1 },
+  { 0x0FA73, 2322, 1 }, { 0x0FA74, 2323, 1 }, { 0x0FA75, 2324, 1 },
+  { 0x0FA76, 2325, 1 }, { 0x0FA77, 2326, 1 }, { 0x0FA78, 2327, 1 },
+  { 0x0FA79, 2328, 1 }, { 0x0FA7A, 2329, 1 }, { 0x0FA7B, 2330, 1 },
+  { 0x0FA7C, 2331, 1 }, { 0x0FA7D, 2332, 1 }, { 0x0FA7E, 2333, 1 },
+  { 0x0FA7F, 2334, 1 }, { 0x0FA80, 2335, 1 }, { 0x0FA81, 2336, 1 },
+  { 0x0FA82, 2337, 1 }, { 0x0FA83, 2338, 1 }, { 0x0FA84, 2339, 1 },
+  { 0x0FA85, 2340, 1 }, { 0x0FA86, 2341, 1 }, { 0x0FA87, 2342, 1 },
+  { 0x0FA88, 2343, 1 }, { 0x0FA89, 2344, 1 }, { 0x0FA8A, 2345, 1 },
+  { 0x0FA8B, 2346, 1 }, { 0x0FA8C, 2347, 1 }, { 0x0FA8D, 2348, 1 },
+  { 0x0FA8E, 2349, 1 }, { 0x0FA8F, 2350, 1 }, { 0x0FA90, 2351, 1 },
+  { 0x0FA91, 2352, 1 }, { 0x0FA92, 2353, 1 }, { 0x0FA93, 2354, 1 },
+  { 0x0FA94, 2355, 1 }, { 0x0FA95, 2356, 1 }, { 0x0FA96, 2357, 1 },
+  { 0x0FA97, 2358, 1 }, { 0x0FA98, 2359, 1 }, { 0x0FA99, 2360, 1 },
+  { 0x0FA9A, 2361, 1 }, { 0x0FA9B, 2362, 1 }, { 0x0FA9C, 2363, 1 },
+  { 0x0FA9D, 2364, 1 }, { 0x0FA9E, 2365, 1 }, { 0x0FA9F, 2366, 1 },
+  { 0x0FAA0, 2367, 1 }, { 0x0FAA1, 2368, 1 }, { 0x0FAA2, 2369, 1 },
+  { 0x0FAA3, 2370, 1 }, { 0x0FAA4, 2371, 1 }, { 0x0FAA5, 2372, 1 },
+  { 0x0FAA6, 2373, 1 }, { 0x0FAA7, 2374, 1 }, { 0x0FAA8, 2375, 1 },
+  { 0x0FAA9, 2376, 1 }, { 0x0FAAA, 2377, 1 }, { 0x0FAAB, 2378, 1 },
+  { 0x0FAAC, 2379, 1 }, { 0x0FAAD, 2380, 1 }, { 0x0FAAE, 2381, 1 },
+  { 0x0FAAF, 2382, 1 }, { 0x0FAB0, 2383, 1 }, { 0x0FAB1, 2384, 1 },
+  { 0x0FAB2, 2385, 1 }, { 0x0FAB3, 2386, 1 }, { 0x0FAB4, 2387, 1 },
+  { 0x0FAB5, 2388, 1 }, { 0x0FAB6, 2389, 1 }, { 0x0FAB7, 2390, 1 },
+  { 0x0FAB8, 2391, 1 }, { 0x0FAB9, 2392, 1 }, { 0x0FABA, 2393, 1 },
+  { 0x0FABB, 2394, 1 }, { 0x0FABC, 2395, 1 }, { 0x0FABD, 2396, 1 },
+  { 0x0FABE, 2397, 1 }, { 0x0FABF, 2398, 1 }, { 0x0FAC0, 2399, 1 },
+  { 0x0FAC1, 2400, 1 }, { 0x0FAC2, 2401, 1 }, { 0x0FAC3, 2402, 1 },
+  { 0x0FAC4, 2403, 1 }, { 0x0FAC5, 2404, 1 }, { 0x0FAC6, 2405, 1 },
+  { 0x0FAC7, 2406, 1 }, { 0x0FAC8, 2407, 1 }, { 0x0FAC9, 2408, 1 },
+  { 0x0FACA, 2409, 1 }, { 0x0FACB, 2410, 1 }, { 0x0FACC, 2411, 1 },
+  { 0x0FACD, 2412, 1 }, { 0x0FACE, 2413, 1 }, { 0x0FACF, 2414, 1 },
+  { 0x0FAD0, 2415, 1 }, { 0x0FAD1, 2416, 1 }, { 0x0FAD2, 2417, 1 },
+  { 0x0FAD3, 2418, 1 }, { 0x0FAD4, 2419, 1 }, { 0x0FAD5, 2420, 1 },
+  { 0x0FAD6, 2421, 1 }, { 0x0FAD7, 2422, 1 }, { 0x0FAD8, 2423, 1 },
+  { 0x0FAD9, 2424, 1 }, { 0x0FB1D, 2425, 2 }, { 0x0FB1F, 2427, 2 },
+  { 0x0FB2A, 2429, 2 }, { 0x0FB2B, 2431, 2 }, { 0x0FB2C, 2433, 2 },
+  { 0x0FB2D, 2435, 2 }, { 0x0FB2E, 2437, 2 }, { 0x0FB2F, 2439, 2 },
+  { 0x0FB30, 2441, 2 }, { 0x0FB31, 2443, 2 }, { 0x0FB32, 2445, 2 },
+  { 0x0FB33, 2447, 2 }, { 0x0FB34, 2449, 2 }, { 0x0FB35, 2451, 2 },
+  { 0x0FB36, 2453, 2 }, { 0x0FB38, 2455, 2 }, { 0x0FB39, 2457, 2 },
+  { 0x0FB3A, 2459, 2 }, { 0x0FB3B, 2461, 2 }, { 0x0FB3C, 2463, 2 },
+  { 0x0FB3E, 2465, 2 }, { 0x0FB40, 2467, 2 }, { 0x0FB41, 2469, 2 },
+  { 0x0FB43, 2471, 2 }, { 0x0FB44, 2473, 2 }, { 0x0FB46, 2475, 2 },
+  { 0x0FB47, 2477, 2 }, { 0x0FB48, 2479, 2 }, { 0x0FB49, 2481, 2 },
+  { 0x0FB4A, 2483, 2 }, { 0x0FB4B, 2485, 2 }, { 0x0FB4C, 2487, 2 },
+  { 0x0FB4D, 2489, 2 }, { 0x0FB4E, 2491, 2 }, { 0x1109A, 2493, 2 },
+  { 0x1109C, 2495, 2 }, { 0x110AB, 2497, 2 }, { 0x1112E, 2499, 2 },
+  { 0x1112F, 2501, 2 }, { 0x1134B, 2503, 2 }, { 0x1134C, 2505, 2 },
+  { 0x114BB, 2507, 2 }, { 0x114BC, 2509, 2 }, { 0x114BE, 2511, 2 },
+  { 0x115BA, 2513, 2 }, { 0x115BB, 2515, 2 }, { 0x11938, 2517, 2 },
+  { 0x1D15E, 2519, 2 }, { 0x1D15F, 2521, 2 }, { 0x1D160, 2523, 2 },
+  { 0x1D161, 2525, 2 }, { 0x1D162, 2527, 2 }, { 0x1D163, 2529, 2 },
+  { 0x1D164, 2531, 2 }, { 0x1D1BB, 2533, 2 }, { 0x1D1BC, 2535, 2 },
+  { 0x1D1BD, 2537, 2 }, { 0x1D1BE, 2539, 2 }, { 0x1D1BF, 2541, 2 },
+  { 0x1D1C0, 2543, 2 }, { 0x2F800, 2545, 1 }, { 0x2F801, 2546, 1 },
+  { 0x2F802, 2547, 1 }, { 0x2F803, 2548, 1 }, { 0x2F804, 2549, 1 },
+  { 0x2F805, 2550, 1 }, { 0x2F806, 2551, 1 }, { 0x2F807, 2552, 1 },
+  { 0x2F808, 2553, 1 }, { 0x2F809, 2554, 1 }, { 0x2F80A, 2555, 1 },
+  { 0x2F80B, 2556, 1 }, { 0x2F80C, 2557, 1 }, { 0x2F80D, 2558, 1 },
+  { 0x2F80E, 2559, 1 }, { 0x2F80F, 2560, 1 }, { 0x2F810, 2561, 1 },
+  { 0x2F811, 2562, 1 }, { 0x2F812, 2563, 1 }, { 0x2F813, 2564, 1 },
+  { 0x2F814, 2565, 1 }, { 0x2F815, 2566, 1 }, { 0x2F816, 2567, 1 },
+  { 0x2F817, 2568, 1 }, { 0x2F818, 2569, 1 }, { 0x2F819, 2570, 1 },
+  { 0x2F81A, 2571, 1 }, { 0x2F81B, 2572, 1 }, { 0x2F81C, 2573, 1 },
+  { 0x2F81D, 2574, 1 }, { 0x2F81E, 2575, 1 }, { 0x2F81F, 2576, 1 },
+  { 0x2F820, 2577, 1 }, { 0x2F821, 2578, 1 }, { 0x2F822, 2579, 1 },
+  { 0x2F823, 2580, 1 }, { 0x2F824, 2581, 1 }, { 0x2F825, 2582, 1 },
+  { 0x2F826, 2583, 1 }, { 0x2F827, 2584, 1 }, { 0x2F828, 2585, 1 },
+  { 0x2F829, 2586, 1 }, { 0x2F82A, 2587, 1 }, { 0x2F82B, 2588, 1 },
+  { 0x2F82C, 2589, 1 }, { 0x2F82D, 2590, 1 }, { 0x2F82E, 2591, 1 },
+  { 0x2F82F, 2592, 1 }, { 0x2F830, 2593, 1 }, { 0x2F831, 2594, 1 },
+  { 0x2F832, 2595, 1 }, { 0x2F833, 2596, 1 }, { 0x2F834, 2597, 1 },
+  { 0x2F835, 2598, 1 }, { 0x2F836, 2599, 1 }, { 0x2F837, 2600, 1 },
+  { 0x2F838, 2601, 1 }, { 0x2F839, 2602, 1 }, { 0x2F83A, 2603, 1 },
+  { 0x2F83B, 2604, 1 }, { 0x2F83C, 2605, 1 }, { 0x2F83D, 2606, 1 },
+  { 0x2F83E, 2607, 1 }, { 0x2F83F, 2608, 1 }, { 0x2F840, 2609, 1 },
+  { 0x2F841, 2610, 1 }, { 0x2F842, 2611, 1 }, { 0x2F843, 2612, 1 },
+  { 0x2F844, 2613, 1 }, { 0x2F845, 2614, 1 }, { 0x2F846, 2615, 1 },
+  { 0x2F847, 2616, 1 }, { 0x2F848, 2617, 1 }, { 0x2F849, 2618, 1 },
+  { 0x2F84A, 2619, 1 }, { 0x2F84B, 2620, 1 }, { 0x2F84C, 2621, 1 },
+  { 0x2F84D, 2622, 1 }, { 0x2F84E, 2623, 1 }, { 0x2F84F, 2624, 1 },
+  { 0x2F850, 2625, 1 }, { 0x2F851, 2626, 1 }, { 0x2F852, 2627, 1 },
+  { 0x2F853, 2628, 1 }, { 0x2F854, 2629, 1 }, { 0x2F855, 2630, 1 },
+  { 0x2F856, 2631, 1 }, { 0x2F857, 2632, 1 }, { 0x2F858, 2633, 1 },
+  { 0x2F859, 2634, 1 }, { 0x2F85A, 2635, 1 }, { 0x2F85B, 2636, 1 },
+  { 0x2F85C, 2637, 1 }, { 0x2F85D, 2638, 1 }, { 0x2F85E, 2639, 1 },
+  { 0x2F85F, 2640, 1 }, { 0x2F860, 2641, 1 }, { 0x2F861, 2642, 1 },
+  { 0x2F862, 2643, 1 }, { 0x2F863, 2644, 1 }, { 0x2F864, 2645, 1 },
+  { 0x2F865, 2646, 1 }, { 0x2F866, 2647, 1 }, { 0x2F867, 2648, 1 },
+  { 0x2F868, 2649, 1 }, { 0x2F869, 2650, 1 }, { 0x2F86A, 2651, 1 },
+  { 0x2F86B, 2652, 1 }, { 0x2F86C, 2653, 1 }, { 0x2F86D, 2654, 1 },
+  { 0x2F86E, 2655, 1 }, { 0x2F86F, 2656, 1 }, { 0x2F870, 2657, 1 },
+  { 0x2F871, 2658, 1 }, { 0x2F872, 2659, 1 }, { 0x2F873, 2660, 1 },
+  { 0x2F874, 2661, 1 }, { 0x2F875, 2662, 1 }, { 0x2F876, 2663, 1 },
+  { 0x2F877, 2664, 1 }, { 0x2F878, 2665, 1 }, { 0x2F879, 2666, 1 },
+  { 0x2F87A, 2667, 1 }, { 0x2F87B, 2668, 1 }, { 0x2F87C, 2669, 1 },
+  { 0x2F87D, 2670, 1 }, { 0x2F87E, 2671, 1 }, { 0x2F87F, 2672, 1 },
+  { 0x2F880, 2673, 1 }, { 0x2F881, 2674, 1 }, { 0x2F882, 2675, 1 },
+  { 0x2F883, 2676, 1 }, { 0x2F884, 2677, 1 }, { 0x2F885, 2678, 1 },
+  { 0x2F886, 2679, 1 }, { 0x2F887, 2680, 1 }, { 0x2F888, 2681, 1 },
+  { 0x2F889, 2682, 1 }, { 0x2F88A, 2683, 1 }, { 0x2F88B, 2684, 1 },
+  { 0x2F88C, 2685, 1 }, { 0x2F88D, 2686, 1 }, { 0x2F88E, 2687, 1 },
+  { 0x2F88F, 2688, 1 }, { 0x2F890, 2689, 1 }, { 0x2F891, 2690, 1 },
+  { 0x2F892, 2691, 1 }, { 0x2F893, 2692, 1 }, { 0x2F894, 2693, 1 },
+  { 0x2F895, 2694, 1 }, { 0x2F896, 2695, 1 }, { 0x2F897, 2696, 1 },
+  { 0x2F898, 2697, 1 }, { 0x2F899, 2698, 1 }, { 0x2F89A, 2699, 1 },
+  { 0x2F89B, 2700, 1 }, { 0x2F89C, 2701, 1 }, { 0x2F89D, 2702, 1 },
+  { 0x2F89E, 2703, 1 }, { 0x2F89F, 2704, 1 }, { 0x2F8A0, 2705, 1 },
+  { 0x2F8A1, 2706, 1 }, { 0x2F8A2, 2707, 1 }, { 0x2F8A3, 2708, 1 },
+  { 0x2F8A4, 2709, 1 }, { 0x2F8A5, 2710, 1 }, { 0x2F8A6, 2711, 1 },
+  { 0x2F8A7, 2712, 1 }, { 0x2F8A8, 2713, 1 }, { 0x2F8A9, 2714, 1 },
+  { 0x2F8AA, 2715, 1 }, { 0x2F8AB, 2716, 1 }, { 0x2F8AC, 2717, 1 },
+  { 0x2F8AD, 2718, 1 }, { 0x2F8AE, 2719, 1 }, { 0x2F8AF, 2720, 1 },
+  { 0x2F8B0, 2721, 1 }, { 0x2F8B1, 2722, 1 }, { 0x2F8B2, 2723, 1 },
+  { 0x2F8B3, 2724, 1 }, { 0x2F8B4, 2725, 1 }, { 0x2F8B5, 2726, 1 },
+  { 0x2F8B6, 2727, 1 }, { 0x2F8B7, 2728, 1 }, { 0x2F8B8, 2729, 1 },
+  { 0x2F8B9, 2730, 1 }, { 0x2F8BA, 2731, 1 }, { 0x2F8BB, 2732, 1 },
+  { 0x2F8BC, 2733, 1 }, { 0x2F8BD, 2734, 1 }, { 0x2F8BE, 2735, 1 },
+  { 0x2F8BF, 2736, 1 }, { 0x2F8C0, 2737, 1 }, { 0x2F8C1, 2738, 1 },
+  { 0x2F8C2, 2739, 1 }, { 0x2F8C3, 2740, 1 }, { 0x2F8C4, 2741, 1 },
+  { 0x2F8C5, 2742, 1 }, { 0x2F8C6, 2743, 1 }, { 0x2F8C7, 2744, 1 },
+  { 0x2F8C8, 2745, 1 }, { 0x2F8C9, 2746, 1 }, { 0x2F8CA, 2747, 1 },
+  { 0x2F8CB, 2748, 1 }, { 0x2F8CC, 2749, 1 }, { 0x2F8CD, 2750, 1 },
+  { 0x2F8CE, 2751, 1 }, { 0x2F8CF, 2752, 1 }, { 0x2F8D0, 2753, 1 },
+  { 0x2F8D1, 2754, 1 }, { 0x2F8D2, 2755, 1 }, { 0x2F8D3, 2756, 1 },
+  { 0x2F8D4, 2757, 1 }, { 0x2F8D5, 2758, 1 }, { 0x2F8D6, 2759, 1 },
+  { 0x2F8D7, 2760, 1 }, { 0x2F8D8, 2761, 1 }, { 0x2F8D9, 2762, 1 },
+  { 0x2F8DA, 2763, 1 }, { 0x2F8DB, 2764, 1 }, { 0x2F8DC, 2765, 1 },
+  { 0x2F8DD, 2766, 1 }, { 0x2F8DE, 2767, 1 }, { 0x2F8DF, 2768, 1 },
+  { 0x2F8E0, 2769, 1 }, { 0x2F8E1, 2770, 1 }, { 0x2F8E2, 2771, 1 },
+  { 0x2F8E3, 2772, 1 }, { 0x2F8E4, 2773, 1 }, { 0x2F8E5, 2774, 1 },
+  { 0x2F8E6, 2775, 1 }, { 0x2F8E7, 2776, 1 }, { 0x2F8E8, 2777, 1 },
+  { 0x2F8E9, 2778, 1 }, { 0x2F8EA, 2779, 1 }, { 0x2F8EB, 2780, 1 },
+  { 0x2F8EC, 2781, 1 }, { 0x2F8ED, 2782, 1 }, { 0x2F8EE, 2783, 1 },
+  { 0x2F8EF, 2784, 1 }, { 0x2F8F0, 2785, 1 }, { 0x2F8F1, 2786, 1 },
+  { 0x2F8F2, 2787, 1 }, { 0x2F8F3, 2788, 1 }, { 0x2F8F4, 2789, 1 },
+  { 0x2F8F5, 2790, 1 }, { 0x2F8F6, 2791, 1 }, { 0x2F8F7, 2792, 1 },
+  { 0x2F8F8, 2793, 1 }, { 0x2F8F9, 2794, 1 }, { 0x2F8FA, 2795, 1 },
+  { 0x2F8FB, 2796, 1 }, { 0x2F8FC, 2797, 1 }, { 0x2F8FD, 2798, 1 },
+  { 0x2F8FE, 2799, 1 }, { 0x2F8FF, 2800, 1 }, { 0x2F900, 2801, 1 },
+  { 0x2F901, 2802, 1 }, { 0x2F902, 2803, 1 }, { 0x2F903, 2804, 1 },
+  { 0x2F904, 2805, 1 }, { 0x2F905, 2806, 1 }, { 0x2F906, 2807, 1 },
+  { 0x2F907, 2808, 1 }, { 0x2F908, 2809, 1 }, { 0x2F909, 2810, 1 },
+  { 0x2F90A, 2811, 1 }, { 0x2F90B, 2812, 1 }, { 0x2F90C, 2813, 1 },
+  { 0x2F90D, 2814, 1 }, { 0x2F90E, 2815, 1 }, { 0x2F90F, 2816, 1 },
+  { 0x2F910, 2817, 1 }, { 0x2F911, 2818, 1 }, { 0x2F912, 2819, 1 },
+  { 0x2F913, 2820, 1 }, { 0x2F914, 2821, 1 }, { 0x2F915, 2822, 1 },
+  { 0x2F916, 2823, 1 }, { 0x2F917, 2824, 1 }, { 0x2F918, 2825, 1 },
+  { 0x2F919, 2826, 1 }, { 0x2F91A, 2827, 1 }, { 0x2F91B, 2828, 1 },
+  { 0x2F91C, 2829, 1 }, { 0x2F91D, 2830, 1 }, { 0x2F91E, 2831, 1 },
+  { 0x2F91F, 2832, 1 }, { 0x2F920, 2833, 1 }, { 0x2F921, 2834, 1 },
+  { 0x2F922, 2835, 1 }, { 0x2F923, 2836, 1 }, { 0x2F924, 2837, 1 },
+  { 0x2F925, 2838, 1 }, { 0x2F926, 2839, 1 }, { 0x2F927, 2840, 1 },
+  { 0x2F928, 2841, 1 }, { 0x2F929, 2842, 1 }, { 0x2F92A, 2843, 1 },
+  { 0x2F92B, 2844, 1 }, { 0x2F92C, 2845, 1 }, { 0x2F92D, 2846, 1 },
+  { 0x2F92E, 2847, 1 }, { 0x2F92F, 2848, 1 }, { 0x2F930, 2849, 1 },
+  { 0x2F931, 2850, 1 }, { 0x2F932, 2851, 1 }, { 0x2F933, 2852, 1 },
+  { 0x2F934, 2853, 1 }, { 0x2F935, 2854, 1 }, { 0x2F936, 2855, 1 },
+  { 0x2F937, 2856, 1 }, { 0x2F938, 2857, 1 }, { 0x2F939, 2858, 1 },
+  { 0x2F93A, 2859, 1 }, { 0x2F93B, 2860, 1 }, { 0x2F93C, 2861, 1 },
+  { 0x2F93D, 2862, 1 }, { 0x2F93E, 2863, 1 }, { 0x2F93F, 2864, 1 },
+  { 0x2F940, 2865, 1 }, { 0x2F941, 2866, 1 }, { 0x2F942, 2867, 1 },
+  { 0x2F943, 2868, 1 }, { 0x2F944, 2869, 1 }, { 0x2F945, 2870, 1 },
+  { 0x2F946, 2871, 1 }, { 0x2F947, 2872, 1 }, { 0x2F948, 2873, 1 },
+  { 0x2F949, 2874, 1 }, { 0x2F94A, 2875, 1 }, { 0x2F94B, 2876, 1 },
+  { 0x2F94C, 2877, 1 }, { 0x2F94D, 2878, 1 }, { 0x2F94E, 2879, 1 },
+  { 0x2F94F, 2880, 1 }, { 0x2F950, 2881, 1 }, { 0x2F951, 2882, 1 },
+  { 0x2F952, 2883, 1 }, { 0x2F953, 2884, 1 }, { 0x2F954, 2885, 1 },
+  { 0x2F955, 2886, 1 }, { 0x2F956, 2887, 1 }, { 0x2F957, 2888, 1 },
+  { 0x2F958, 2889, 1 }, { 0x2F959, 2890, 1 }, { 0x2F95A, 2891, 1 },
+  { 0x2F95B, 2892, 1 }, { 0x2F95C, 2893, 1 }, { 0x2F95D, 2894, 1 },
+  { 0x2F95E, 2895, 1 }, { 0x2F95F, 2896, 1 }, { 0x2F960, 2897, 1 },
+  { 0x2F961, 2898, 1 }, { 0x2F962, 2899, 1 }, { 0x2F963, 2900, 1 },
+  { 0x2F964, 2901, 1 }, { 0x2F965, 2902, 1 }, { 0x2F966, 2903, 1 },
+  { 0x2F967, 2904, 1 }, { 0x2F968, 2905, 1 }, { 0x2F969, 2906, 1 },
+  { 0x2F96A, 2907, 1 }, { 0x2F96B, 2908, 1 }, { 0x2F96C, 2909, 1 },
+  { 0x2F96D, 2910, 1 }, { 0x2F96E, 2911, 1 }, { 0x2F96F, 2912, 1 },
+  { 0x2F970, 2913, 1 }, { 0x2F971, 2914, 1 }, { 0x2F972, 2915, 1 },
+  { 0x2F973, 2916, 1 }, { 0x2F974, 2917, 1 }, { 0x2F975, 2918, 1 },
+  { 0x2F976, 2919, 1 }, { 0x2F977, 2920, 1 }, { 0x2F978, 2921, 1 },
+  { 0x2F979, 2922, 1 }, { 0x2F97A, 2923, 1 }, { 0x2F97B, 2924, 1 },
+  { 0x2F97C, 2925, 1 }, { 0x2F97D, 2926, 1 }, { 0x2F97E, 2927, 1 },
+  { 0x2F97F, 2928, 1 }, { 0x2F980, 2929, 1 }, { 0x2F981, 2930, 1 },
+  { 0x2F982, 2931, 1 }, { 0x2F983, 2932, 1 }, { 0x2F984, 2933, 1 },
+  { 0x2F985, 2934, 1 }, { 0x2F986, 2935, 1 }, { 0x2F987, 2936, 1 },
+  { 0x2F988, 2937, 1 }, { 0x2F989, 2938, 1 }, { 0x2F98A, 2939, 1 },
+  { 0x2F98B, 2940, 1 }, { 0x2F98C, 2941, 1 }, { 0x2F98D, 2942, 1 },
+  { 0x2F98E, 2943, 1 }, { 0x2F98F, 2944, 1 }, { 0x2F990, 2945, 1 },
+  { 0x2F991, 2946, 1 }, { 0x2F992, 2947, 1 }, { 0x2F993, 2948, 1 },
+  { 0x2F994, 2949, 1 }, { 0x2F995, 2950, 1 }, { 0x2F996, 2951, 1 },
+  { 0x2F997, 2952, 1 }, { 0x2F998, 2953, 1 }, { 0x2F999, 2954, 1 },
+  { 0x2F99A, 2955, 1 }, { 0x2F99B, 2956, 1 }, { 0x2F99C, 2957, 1 },
+  { 0x2F99D, 2958, 1 }, { 0x2F99E, 2959, 1 }, { 0x2F99F, 2960, 1 },
+  { 0x2F9A0, 2961, 1 }, { 0x2F9A1, 2962, 1 }, { 0x2F9A2, 2963, 1 },
+  { 0x2F9A3, 2964, 1 }, { 0x2F9A4, 2965, 1 }, { 0x2F9A5, 2966, 1 },
+  { 0x2F9A6, 2967, 1 }, { 0x2F9A7, 2968, 1 }, { 0x2F9A8, 2969, 1 },
+  { 0x2F9A9, 2970, 1 }, { 0x2F9AA, 2971, 1 }, { 0x2F9AB, 2972, 1 },
+  { 0x2F9AC, 2973, 1 }, { 0x2F9AD, 2974, 1 }, { 0x2F9AE, 2975, 1 },
+  { 0x2F9AF, 2976, 1 }, { 0x2F9B0, 2977, 1 }, { 0x2F9B1, 2978, 1 },
+  { 0x2F9B2, 2979, 1 }, { 0x2F9B3, 2980, 1 }, { 0x2F9B4, 2981, 1 },
+  { 0x2F9B5, 2982, 1 }, { 0x2F9B6, 2983, 1 }, { 0x2F9B7, 2984, 1 },
+  { 0x2F9B8, 2985, 1 }, { 0x2F9B9, 2986, 1 }, { 0x2F9BA, 2987, 1 },
+  { 0x2F9BB, 2988, 1 }, { 0x2F9BC, 2989, 1 }, { 0x2F9BD, 2990, 1 },
+  { 0x2F9BE, 2991, 1 }, { 0x2F9BF, 2992, 1 }, { 0x2F9C0, 2993, 1 },
+  { 0x2F9C1, 2994, 1 }, { 0x2F9C2, 2995, 1 }, { 0x2F9C3, 2996, 1 },
+  { 0x2F9C4, 2997, 1 }, { 0x2F9C5, 2998, 1 }, { 0x2F9C6, 2999, 1 },
+  { 0x2F9C7, 3000, 1 }, { 0x2F9C8, 3001, 1 }, { 0x2F9C9, 3002, 1 },
+  { 0x2F9CA, 3003, 1 }, { 0x2F9CB, 3004, 1 }, { 0x2F9CC, 3005, 1 },
+  { 0x2F9CD, 3006, 1 }, { 0x2F9CE, 3007, 1 }, { 0x2F9CF, 3008, 1 },
+  { 0x2F9D0, 3009, 1 }, { 0x2F9D1, 3010, 1 }, { 0x2F9D2, 3011, 1 },
+  { 0x2F9D3, 3012, 1 }, { 0x2F9D4, 3013, 1 }, { 0x2F9D5, 3014, 1 },
+  { 0x2F9D6, 3015, 1 }, { 0x2F9D7, 3016, 1 }, { 0x2F9D8, 3017, 1 },
+  { 0x2F9D9, 3018, 1 }, { 0x2F9DA, 3019, 1 }, { 0x2F9DB, 3020, 1 },
+  { 0x2F9DC, 3021, 1 }, { 0x2F9DD, 3022, 1 }, { 0x2F9DE, 3023, 1 },
+  { 0x2F9DF, 3024, 1 }, { 0x2F9E0, 3025, 1 }, { 0x2F9E1, 3026, 1 },
+  { 0x2F9E2, 3027, 1 }, { 0x2F9E3, 3028, 1 }, { 0x2F9E4, 3029, 1 },
+  { 0x2F9E5, 3030, 1 }, { 0x2F9E6, 3031, 1 }, { 0x2F9E7, 3032, 1 },
+  { 0x2F9E8, 3033, 1 }, { 0x2F9E9, 3034, 1 }, { 0x2F9EA, 3035, 1 },
+  { 0x2F9EB, 3036, 1 }, { 0x2F9EC, 3037, 1 }, { 0x2F9ED, 3038, 1 },
+  { 0x2F9EE, 3039, 1 }, { 0x2F9EF, 3040, 1 }, { 0x2F9F0, 3041, 1 },
+  { 0x2F9F1, 3042, 1 }, { 0x2F9F2, 3043, 1 }, { 0x2F9F3, 3044, 1 },
+  { 0x2F9F4, 3045, 1 }, { 0x2F9F5, 3046, 1 }, { 0x2F9F6, 3047, 1 },
+  { 0x2F9F7, 3048, 1 }, { 0x2F9F8, 3049, 1 }, { 0x2F9F9, 3050, 1 },
+  { 0x2F9FA, 3051, 1 }, { 0x2F9FB, 3052, 1 }, { 0x2F9FC, 3053, 1 },
+  { 0x2F9FD, 3054, 1 }, { 0x2F9FE, 3055, 1 }, { 0x2F9FF, 3056, 1 },
+  { 0x2FA00, 3057, 1 }, { 0x2FA01, 3058, 1 }, { 0x2FA02, 3059, 1 },
+  { 0x2FA03, 3060, 1 }, { 0x2FA04, 3061, 1 }, { 0x2FA05, 3062, 1 },
+  { 0x2FA06, 3063, 1 }, { 0x2FA07, 3064, 1 }, { 0x2FA08, 3065, 1 },
+  { 0x2FA09, 3066, 1 }, { 0x2FA0A, 3067, 1 }, { 0x2FA0B, 3068, 1 },
+  { 0x2FA0C, 3069, 1 }, { 0x2FA0D, 3070, 1 }, { 0x2FA0E, 3071, 1 },
+  { 0x2FA0F, 3072, 1 }, { 0x2FA10, 3073, 1 }, { 0x2FA11, 3074, 1 },
+  { 0x2FA12, 3075, 1 }, { 0x2FA13, 3076, 1 }, { 0x2FA14, 3077, 1 },
+  { 0x2FA15, 3078, 1 }, { 0x2FA16, 3079, 1 }, { 0x2FA17, 3080, 1 },
+  { 0x2FA18, 3081, 1 }, { 0x2FA19, 3082, 1 }, { 0x2FA1A, 3083, 1 },
+  { 0x2FA1B, 3084, 1 }, { 0x2FA1C, 3085, 1 }, { 0x2FA1D, 3086, 1 },
+};
+
+static const unsigned int unicode_decomposition_pool[] = {
+  0x00041, 0x00300, 0x00041, 0x00301, 0x00041, 0x00302, 0x00041, 0x00303,
+  0x00041, 0x00308, 0x00041, 0x0030A, 0x00043, 0x00327, 0x00045, 0x00300,
+  0x00045, 0x00301, 0x00045, 0x00302, 0x00045, 0x00308, 0x00049, 0x00300,
+  0x00049, 0x00301, 0x00049, 0x00302, 0x00049, 0x00308, 0x0004E, 0x00303,
+  0x0004F, 0x00300, 0x0004F, 0x00301, 0x0004F, 0x00302, 0x0004F, 0x00303,
+  0x0004F, 0x00308, 0x00055, 0x00300, 0x00055, 0x00301, 0x00055, 0x00302,
+  0x00055, 0x00308, 0x00059, 0x00301, 0x00061, 0x00300, 0x00061, 0x00301,
+  0x00061, 0x00302, 0x00061, 0x00303, 0x00061, 0x00308, 0x00061, 0x0030A,
+  0x00063, 0x00327, 0x00065, 0x00300, 0x00065, 0x00301, 0x00065, 0x00302,
+  0x00065, 0x00308, 0x00069, 0x00300, 0x00069, 0x00301, 0x00069, 0x00302,
+  0x00069, 0x00308, 0x0006E, 0x00303, 0x0006F, 0x00300, 0x0006F, 0x00301,
+  0x0006F, 0x00302, 0x0006F, 0x00303, 0x0006F, 0x00308, 0x00075, 0x00300,
+  0x00075, 0x00301, 0x00075, 0x00302, 0x00075, 0x00308, 0x00079, 0x00301,
+  0x00079, 0x00308, 0x00041, 0x00304, 0x00061, 0x00304, 0x00041, 0x00306,
+  0x00061, 0x00306, 0x00041, 0x00328, 0x00061, 0x00328, 0x00043, 0x00301,
+  0x00063, 0x00301, 0x00043, 0x00302, 0x00063, 0x00302, 0x00043, 0x00307,
+  0x00063, 0x00307, 0x00043, 0x0030C, 0x00063, 0x0030C, 0x00044, 0x0030C,
+  0x00064, 0x0030C, 0x00045, 0x00304, 0x00065, 0x00304, 0x00045, 0x00306,
+  0x00065, 0x00306, 0x00045, 0x00307, 0x00065, 0x00307, 0x00045, 0x00328,
+  0x00065, 0x00328, 0x00045, 0x0030C, 0x00065, 0x0030C, 0x00047, 0x00302,
+  0x00067, 0x00302, 0x00047, 0x00306, 0x00067, 0x00306, 0x00047, 0x00307,
+  0x00067, 0x00307, 0x00047, 0x00327, 0x00067, 0x00327, 0x00048, 0x00302,
+  0x00068, 0x00302, 0x00049, 0x00303, 0x00069, 0x00303, 0x00049, 0x00304,
+  0x00069, 0x00304, 0x00049, 0x00306, 0x00069, 0x00306, 0x00049, 0x00328,
+  0x00069, 0x00328, 0x00049, 0x00307, 0x0004A, 0x00302, 0x0006A, 0x00302,
+  0x0004B, 0x00327, 0x0006B, 0x00327, 0x0004C, 0x00301, 0x0006C, 0x00301,
+  0x0004C, 0x00327, 0x0006C, 0x00327, 0x0004C, 0x0030C, 0x0006C, 0x0030C,
+  0x0004E, 0x00301, 0x0006E, 0x00301, 0x0004E, 0x00327, 0x0006E, 0x00327,
+  0x0004E, 0x0030C, 0x0006E, 0x0030C, 0x0004F, 0x00304, 0x0006F, 0x00304,
+  0x0004F, 0x00306, 0x0006F, 0x00306, 0x0004F, 0x0030B, 0x0006F, 0x0030B,
+  0x00052, 0x00301, 0x00072, 0x00301, 0x00052, 0x00327, 0x00072, 0x00327,
+  0x00052, 0x0030C, 0x00072, 0x0030C, 0x00053, 0x00301, 0x00073, 0x00301,
+  0x00053, 0x00302, 0x00073, 0x00302, 0x00053, 0x00327, 0x00073, 0x00327,
+  0x00053, 0x0030C, 0x00073, 0x0030C, 0x00054, 0x00327, 0x00074, 0x00327,
+  0x00054, 0x0030C, 0x00074, 0x0030C, 0x00055, 0x00303, 0x00075, 0x00303,
+  0x00055, 0x00304, 0x00075, 0x00304, 0x00055, 0x00306, 0x00075, 0x00306,
+  0x00055, 0x0030A, 0x00075, 0x0030A, 0x00055, 0x0030B, 0x00075, 0x0030B,
+  0x00055, 0x00328, 0x00075, 0x00328, 0x00057, 0x00302, 0x00077, 0x00302,
+  0x00059, 0x00302, 0x00079, 0x00302, 0x00059, 0x00308, 0x0005A, 0x00301,
+  0x0007A, 0x00301, 0x0005A, 0x00307, 0x0007A, 0x00307, 0x0005A, 0x0030C,
+  0x0007A, 0x0030C, 0x0004F, 0x0031B, 0x0006F, 0x0031B, 0x00055, 0x0031B,
+  0x00075, 0x0031B, 0x00041, 0x0030C, 0x00061, 0x0030C, 0x00049, 0x0030C,
+  0x00069, 0x0030C, 0x0004F, 0x0030C, 0x0006F, 0x0030C, 0x00055, 0x0030C,
+  0x00075, 0x0030C, 0x000DC, 0x00304, 0x000FC, 0x00304, 0x000DC, 0x00301,
+  0x000FC, 0x00301, 0x000DC, 0x0030C, 0x000FC, 0x0030C, 0x000DC, 0x00300,
+  0x000FC, 0x00300, 0x000C4, 0x00304, 0x000E4, 0x00304, 0x00226, 0x00304,
+  0x00227, 0x00304, 0x000C6, 0x00304, 0x000E6, 0x00304, 0x00047, 0x0030C,
+  0x00067, 0x0030C, 0x0004B, 0x0030C, 0x0006B, 0x0030C, 0x0004F, 0x00328,
+  0x0006F, 0x00328, 0x001EA, 0x00304, 0x001EB, 0x00304, 0x001B7, 0x0030C,
+  0x00292, 0x0030C, 0x0006A, 0x0030C, 0x00047, 0x00301, 0x00067, 0x00301,
+  0x0004E, 0x00300, 0x0006E, 0x00300, 0x000C5, 0x00301, 0x000E5, 0x00301,
+  0x000C6, 0x00301, 0x000E6, 0x00301, 0x000D8, 0x00301, 0x000F8, 0x00301,
+  0x00041, 0x0030F, 0x00061, 0x0030F, 0x00041, 0x00311, 0x00061, 0x00311,
+  0x00045, 0x0030F, 0x00065, 0x0030F, 0x00045, 0x00311, 0x00065, 0x00311,
+  0x00049, 0x0030F, 0x00069, 0x0030F, 0x00049, 0x00311, 0x00069, 0x00311,
+  0x0004F, 0x0030F, 0x0006F, 0x0030F, 0x0004F, 0x00311, 0x0006F, 0x00311,
+  0x00052, 0x0030F, 0x00072, 0x0030F, 0x00052, 0x00311, 0x00072, 0x00311,
+  0x00055, 0x0030F, 0x00075, 0x0030F, 0x00055, 0x00311, 0x00075, 0x00311,
+  0x00053, 0x00326, 0x00073, 0x00326, 0x00054, 0x00326, 0x00074, 0x00326,
+  0x00048, 0x0030C, 0x00068, 0x0030C, 0x00041, 0x00307, 0x00061, 0x00307,
+  0x00045, 0x00327, 0x00065, 0x00327, 0x000D6, 0x00304, 0x000F6, 0x00304,
+  0x000D5, 0x00304, 0x000F5, 0x00304, 0x0004F, 0x00307, 0x0006F, 0x00307,
+  0x0022E, 0x00304, 0x0022F, 0x00304, 0x00059, 0x00304, 0x00079, 0x00304,
+  0x00300, 0x00301, 0x00313, 0x00308, 0x00301, 0x002B9, 0x0003B, 0x000A8,
+  0x00301, 0x00391, 0x00301, 0x000B7, 0x00395, 0x00301, 0x00397, 0x00301,
+  0x00399, 0x00301, 0x0039F, 0x00301, 0x003A5, 0x00301, 0x003A9, 0x00301,
+  0x003CA, 0x00301, 0x00399, 0x00308, 0x003A5, 0x00308, 0x003B1, 0x00301,
+  0x003B5, 0x00301, 0x003B7, 0x00301, 0x003B9, 0x00301, 0x003CB, 0x00301,
+  0x003B9, 0x00308, 0x003C5, 0x00308, 0x003BF, 0x00301, 0x003C5, 0x00301,
+  0x003C9, 0x00301, 0x003D2, 0x00301, 0x003D2, 0x00308, 0x00415, 0x00300,
+  0x00415, 0x00308, 0x00413, 0x00301, 0x00406, 0x00308, 0x0041A, 0x00301,
+  0x00418, 0x00300, 0x00423, 0x00306, 0x00418, 0x00306, 0x00438, 0x00306,
+  0x00435, 0x00300, 0x00435, 0x00308, 0x00433, 0x00301, 0x00456, 0x00308,
+  0x0043A, 0x00301, 0x00438, 0x00300, 0x00443, 0x00306, 0x00474, 0x0030F,
+  0x00475, 0x0030F, 0x00416, 0x00306, 0x00436, 0x00306, 0x00410, 0x00306,
+  0x00430, 0x00306, 0x00410, 0x00308, 0x00430, 0x00308, 0x00415, 0x00306,
+  0x00435, 0x00306, 0x004D8, 0x00308, 0x004D9, 0x00308, 0x00416, 0x00308,
+  0x00436, 0x00308, 0x00417, 0x00308, 0x00437, 0x00308, 0x00418, 0x00304,
+  0x00438, 0x00304, 0x00418, 0x00308, 0x00438, 0x00308, 0x0041E, 0x00308,
+  0x0043E, 0x00308, 0x004E8, 0x00308, 0x004E9, 0x00308, 0x0042D, 0x00308,
+  0x0044D, 0x00308, 0x00423, 0x00304, 0x00443, 0x00304, 0x00423, 0x00308,
+  0x00443, 0x00308, 0x00423, 0x0030B, 0x00443, 0x0030B, 0x00427, 0x00308,
+  0x00447, 0x00308, 0x0042B, 0x00308, 0x0044B, 0x00308, 0x00627, 0x00653,
+  0x00627, 0x00654, 0x00648, 0x00654, 0x00627, 0x00655, 0x0064A, 0x00654,
+  0x006D5, 0x00654, 0x006C1, 0x00654, 0x006D2, 0x00654, 0x00928, 0x0093C,
+  0x00930, 0x0093C, 0x00933, 0x0093C, 0x00915, 0x0093C, 0x00916, 0x0093C,
+  0x00917, 0x0093C, 0x0091C, 0x0093C, 0x00921, 0x0093C, 0x00922, 0x0093C,
+  0x0092B, 0x0093C, 0x0092F, 0x0093C, 0x009C7, 0x009BE, 0x009C7, 0x009D7,
+  0x009A1, 0x009BC, 0x009A2, 0x009BC, 0x009AF, 0x009BC, 0x00A32, 0x00A3C,
+  0x00A38, 0x00A3C, 0x00A16, 0x00A3C, 0x00A17, 0x00A3C, 0x00A1C, 0x00A3C,
+  0x00A2B, 0x00A3C, 0x00B47, 0x00B56, 0x00B47, 0x00B3E, 0x00B47, 0x00B57,
+  0x00B21, 0x00B3C, 0x00B22, 0x00B3C, 0x00B92, 0x00BD7, 0x00BC6, 0x00BBE,
+  0x00BC7, 0x00BBE, 0x00BC6, 0x00BD7, 0x00C46, 0x00C56, 0x00CBF, 0x00CD5,
+  0x00CC6, 0x00CD5, 0x00CC6, 0x00CD6, 0x00CC6, 0x00CC2, 0x00CCA, 0x00CD5,
+  0x00D46, 0x00D3E, 0x00D47, 0x00D3E, 0x00D46, 0x00D57, 0x00DD9, 0x00DCA,
+  0x00DD9, 0x00DCF, 0x00DDC, 0x00DCA, 0x00DD9, 0x00DDF, 0x00F42, 0x00FB7,
+  0x00F4C, 0x00FB7, 0x00F51, 0x00FB7, 0x00F56, 0x00FB7, 0x00F5B, 0x00FB7,
+  0x00F40, 0x00FB5, 0x00F71, 0x00F72, 0x00F71, 0x00F74, 0x00FB2, 0x00F80,
+  0x00FB3, 0x00F80, 0x00F71, 0x00F80, 0x00F92, 0x00FB7, 0x00F9C, 0x00FB7,
+  0x00FA1, 0x00FB7, 0x00FA6, 0x00FB7, 0x00FAB, 0x00FB7, 0x00F90, 0x00FB5,
+  0x01025, 0x0102E, 0x01B05, 0x01B35, 0x01B07, 0x01B35, 0x01B09, 0x01B35,
+  0x01B0B, 0x01B35, 0x01B0D, 0x01B35, 0x01B11, 0x01B35, 0x01B3A, 0x01B35,
+  0x01B3C, 0x01B35, 0x01B3E, 0x01B35, 0x01B3F, 0x01B35, 0x01B42, 0x01B35,
+  0x00041, 0x00325, 0x00061, 0x00325, 0x00042, 0x00307, 0x00062, 0x00307,
+  0x00042, 0x00323, 0x00062, 0x00323, 0x00042, 0x00331, 0x00062, 0x00331,
+  0x000C7, 0x00301, 0x000E7, 0x00301, 0x00044, 0x00307, 0x00064, 0x00307,
+  0x00044, 0x00323, 0x00064, 0x00323, 0x00044, 0x00331, 0x00064, 0x00331,
+  0x00044, 0x00327, 0x00064, 0x00327, 0x00044, 0x0032D, 0x00064, 0x0032D,
+  0x00112, 0x00300, 0x00113, 0x00300, 0x00112, 0x00301, 0x00113, 0x00301,
+  0x00045, 0x0032D, 0x00065, 0x0032D, 0x00045, 0x00330, 0x00065, 0x00330,
+  0x00228, 0x00306, 0x00229, 0x00306, 0x00046, 0x00307, 0x00066, 0x00307,
+  0x00047, 0x00304, 0x00067, 0x00304, 0x00048, 0x00307, 0x00068, 0x00307,
+  0x00048, 0x00323, 0x00068, 0x00323, 0x00048, 0x00308, 0x00068, 0x00308,
+  0x00048, 0x00327, 0x00068, 0x00327, 0x00048, 0x0032E, 0x00068, 0x0032E,
+  0x00049, 0x00330, 0x00069, 0x00330, 0x000CF, 0x00301, 0x000EF, 0x00301,
+  0x0004B, 0x00301, 0x0006B, 0x00301, 0x0004B, 0x00323, 0x0006B, 0x00323,
+  0x0004B, 0x00331, 0x0006B, 0x00331, 0x0004C, 0x00323, 0x0006C, 0x00323,
+  0x01E36, 0x00304, 0x01E37, 0x00304, 0x0004C, 0x00331, 0x0006C, 0x00331,
+  0x0004C, 0x0032D, 0x0006C, 0x0032D, 0x0004D, 0x00301, 0x0006D, 0x00301,
+  0x0004D, 0x00307, 0x0006D, 0x00307, 0x0004D, 0x00323, 0x0006D, 0x00323,
+  0x0004E, 0x00307, 0x0006E, 0x00307, 0x0004E, 0x00323, 0x0006E, 0x00323,
+  0x0004E, 0x00331, 0x0006E, 0x00331, 0x0004E, 0x0032D, 0x0006E, 0x0032D,
+  0x000D5, 0x00301, 0x000F5, 0x00301, 0x000D5, 0x00308, 0x000F5, 0x00308,
+  0x0014C, 0x00300, 0x0014D, 0x00300, 0x0014C, 0x00301, 0x0014D, 0x00301,
+  0x00050, 0x00301, 0x00070, 0x00301, 0x00050, 0x00307, 0x00070, 0x00307,
+  0x00052, 0x00307, 0x00072, 0x00307, 0x00052, 0x00323, 0x00072, 0x00323,
+  0x01E5A, 0x00304, 0x01E5B, 0x00304, 0x00052, 0x00331, 0x00072, 0x00331,
+  0x00053, 0x00307, 0x00073, 0x00307, 0x00053, 0x00323, 0x00073, 0x00323,
+  0x0015A, 0x00307, 0x0015B, 0x00307, 0x00160, 0x00307, 0x00161, 0x00307,
+  0x01E62, 0x00307, 0x01E63, 0x00307, 0x00054, 0x00307, 0x00074, 0x00307,
+  0x00054, 0x00323, 0x00074, 0x00323, 0x00054, 0x00331, 0x00074, 0x00331,
+  0x00054, 0x0032D, 0x00074, 0x0032D, 0x00055, 0x00324, 0x00075, 0x00324,
+  0x00055, 0x00330, 0x00075, 0x00330, 0x00055, 0x0032D, 0x00075, 0x0032D,
+  0x00168, 0x00301, 0x00169, 0x00301, 0x0016A, 0x00308, 0x0016B, 0x00308,
+  0x00056, 0x00303, 0x00076, 0x00303, 0x00056, 0x00323, 0x00076, 0x00323,
+  0x00057, 0x00300, 0x00077, 0x00300, 0x00057, 0x00301, 0x00077, 0x00301,
+  0x00057, 0x00308, 0x00077, 0x00308, 0x00057, 0x00307, 0x00077, 0x00307,
+  0x00057, 0x00323, 0x00077, 0x00323, 0x00058, 0x00307, 0x00078, 0x00307,
+  0x00058, 0x00308, 0x00078, 0x00308, 0x00059, 0x00307, 0x00079, 0x00307,
+  0x0005A, 0x00302, 0x0007A, 0x00302, 0x0005A, 0x00323, 0x0007A, 0x00323,
+  0x0005A, 0x00331, 0x0007A, 0x00331, 0x00068, 0x00331, 0x00074, 0x00308,
+  0x00077, 0x0030A, 0x00079, 0x0030A, 0x0017F, 0x00307, 0x00041, 0x00323,
+  0x00061, 0x00323, 0x00041, 0x00309, 0x00061, 0x00309, 0x000C2, 0x00301,
+  0x000E2, 0x00301, 0x000C2, 0x00300, 0x000E2, 0x00300, 0x000C2, 0x00309,
+  0x000E2, 0x00309, 0x000C2, 0x00303, 0x000E2, 0x00303, 0x01EA0, 0x00302,
+  0x01EA1, 0x00302, 0x00102, 0x00301, 0x00103, 0x00301, 0x00102, 0x00300,
+  0x00103, 0x00300, 0x00102, 0x00309, 0x00103, 0x00309, 0x00102, 0x00303,
+  0x00103, 0x00303, 0x01EA0, 0x00306, 0x01EA1, 0x00306, 0x00045, 0x00323,
+  0x00065, 0x00323, 0x00045, 0x00309, 0x00065, 0x00309, 0x00045, 0x00303,
+  0x00065, 0x00303, 0x000CA, 0x00301, 0x000EA, 0x00301, 0x000CA, 0x00300,
+  0x000EA, 0x00300, 0x000CA, 0x00309, 0x000EA, 0x00309, 0x000CA, 0x00303,
+  0x000EA, 0x00303, 0x01EB8, 0x00302, 0x01EB9, 0x00302, 0x00049, 0x00309,
+  0x00069, 0x00309, 0x00049, 0x00323, 0x00069, 0x00323, 0x0004F, 0x00323,
+  0x0006F, 0x00323, 0x0004F, 0x00309, 0x0006F, 0x00309, 0x000D4, 0x00301,
+  0x000F4, 0x00301, 0x000D4, 0x00300, 0x000F4, 0x00300, 0x000D4, 0x00309,
+  0x000F4, 0x00309, 0x000D4, 0x00303, 0x000F4, 0x00303, 0x01ECC, 0x00302,
+  0x01ECD, 0x00302, 0x001A0, 0x00301, 0x001A1, 0x00301, 0x001A0, 0x00300,
+  0x001A1, 0x00300, 0x001A0, 0x00309, 0x001A1, 0x00309, 0x001A0, 0x00303,
+  0x001A1, 0x00303, 0x001A0, 0x00323, 0x001A1, 0x00323, 0x00055, 0x00323,
+  0x00075, 0x00323, 0x00055, 0x00309, 0x00075, 0x00309, 0x001AF, 0x00301,
+  0x001B0, 0x00301, 0x001AF, 0x00300, 0x001B0, 0x00300, 0x001AF, 0x00309,
+  0x001B0, 0x00309, 0x001AF, 0x00303, 0x001B0, 0x00303, 0x001AF, 0x00323,
+  0x001B0, 0x00323, 0x00059, 0x00300, 0x00079, 0x00300, 0x00059, 0x00323,
+  0x00079, 0x00323, 0x00059, 0x00309, 0x00079, 0x00309, 0x00059, 0x00303,
+  0x00079, 0x00303, 0x003B1, 0x00313, 0x003B1, 0x00314, 0x01F00, 0x00300,
+  0x01F01, 0x00300, 0x01F00, 0x00301, 0x01F01, 0x00301, 0x01F00, 0x00342,
+  0x01F01, 0x00342, 0x00391, 0x00313, 0x00391, 0x00314, 0x01F08, 0x00300,
+  0x01F09, 0x00300, 0x01F08, 0x00301, 0x01F09, 0x00301, 0x01F08, 0x00342,
+  0x01F09, 0x00342, 0x003B5, 0x00313, 0x003B5, 0x00314, 0x01F10, 0x00300,
+  0x01F11, 0x00300, 0x01F10, 0x00301, 0x01F11, 0x00301, 0x00395, 0x00313,
+  0x00395, 0x00314, 0x01F18, 0x00300, 0x01F19, 0x00300, 0x01F18, 0x00301,
+  0x01F19, 0x00301, 0x003B7, 0x00313, 0x003B7, 0x00314, 0x01F20, 0x00300,
+  0x01F21, 0x00300, 0x01F20, 0x00301, 0x01F21, 0x00301, 0x01F20, 0x00342,
+  0x01F21, 0x00342, 0x00397, 0x00313, 0x00397, 0x00314, 0x01F28, 0x00300,
+  0x01F29, 0x00300, 0x01F28, 0x00301, 0x01F29, 0x00301, 0x01F28, 0x00342,
+  0x01F29, 0x00342, 0x003B9, 0x00313, 0x003B9, 0x00314, 0x01F30, 0x00300,
+  0x01F31, 0x00300, 0x01F30, 0x00301, 0x01F31, 0x00301, 0x01F30, 0x00342,
+  0x01F31, 0x00342, 0x00399, 0x00313, 0x00399, 0x00314, 0x01F38, 0x00300,
+  0x01F39, 0x00300, 0x01F38, 0x00301, 0x01F39, 0x00301, 0x01F38, 0x00342,
+  0x01F39, 0x00342, 0x003BF, 0x00313, 0x003BF, 0x00314, 0x01F40, 0x00300,
+  0x01F41, 0x00300, 0x01F40, 0x00301, 0x01F41, 0x00301, 0x0039F, 0x00313,
+  0x0039F, 0x00314, 0x01F48, 0x00300, 0x01F49, 0x00300, 0x01F48, 0x00301,
+  0x01F49, 0x00301, 0x003C5, 0x00313, 0x003C5, 0x00314, 0x01F50, 0x00300,
+  0x01F51, 0x00300, 0x01F50, 0x00301, 0x01F51, 0x00301, 0x01F50, 0x00342,
+  0x01F51, 0x00342, 0x003A5, 0x00314, 0x01F59, 0x00300, 0x01F59, 0x00301,
+  0x01F59, 0x00342, 0x003C9, 0x00313, 0x003C9, 0x00314, 0x01F60, 0x00300,
+  0x01F61, 0x00300, 0x01F60, 0x00301, 0x01F61, 0x00301, 0x01F60, 0x00342,
+  0x01F61, 0x00342, 0x003A9, 0x00313, 0x003A9, 0x00314, 0x01F68, 0x00300,
+  0x01F69, 0x00300, 0x01F68, 0x00301, 0x01F69, 0x00301, 0x01F68, 0x00342,
+  0x01F69, 0x00342, 0x003B1, 0x00300, 0x003AC, 0x003B5, 0x00300, 0x003AD,
+  0x003B7, 0x00300, 0x003AE, 0x003B9, 0x00300, 0x003AF, 0x003BF, 0x00300,
+  0x003CC, 0x003C5, 0x00300, 0x003CD, 0x003C9, 0x00300, 0x003CE, 0x01F00,
+  0x00345, 0x01F01, 0x00345, 0x01F02, 0x00345, 0x01F03, 0x00345, 0x01F04,
+  0x00345, 0x01F05, 0x00345, 0x01F06, 0x00345, 0x01F07, 0x00345, 0x01F08,
+  0x00345, 0x01F09, 0x00345, 0x01F0A, 0x00345, 0x01F0B, 0x00345, 0x01F0C,
+  0x00345, 0x01F0D, 0x00345, 0x01F0E, 0x00345, 0x01F0F, 0x00345, 0x01F20,
+  0x00345, 0x01F21, 0x00345, 0x01F22, 0x00345, 0x01F23, 0x00345, 0x01F24,
+  0x00345, 0x01F25, 0x00345, 0x01F26, 0x00345, 0x01F27, 0x00345, 0x01F28,
+  0x00345, 0x01F29, 0x00345, 0x01F2A, 0x00345, 0x01F2B, 0x00345, 0x01F2C,
+  0x00345, 0x01F2D, 0x00345, 0x01F2E, 0x00345, 0x01F2F, 0x00345, 0x01F60,
+  0x00345, 0x01F61, 0x00345, 0x01F62, 0x00345, 0x01F63, 0x00345, 0x01F64,
+  0x00345, 0x01F65, 0x00345, 0x01F66, 0x00345, 0x01F67, 0x00345, 0x01F68,
+  0x00345, 0x01F69, 0x00345, 0x01F6A, 0x00345, 0x01F6B, 0x00345, 0x01F6C,
+  0x00345, 0x01F6D, 0x00345, 0x01F6E, 0x00345, 0x01F6F, 0x00345, 0x003B1,
+  0x00306, 0x003B1, 0x00304, 0x01F70, 0x00345, 0x003B1, 0x00345, 0x003AC,
+  0x00345, 0x003B1, 0x00342, 0x01FB6, 0x00345, 0x00391, 0x00306, 0x00391,
+  0x00304, 0x00391, 0x00300, 0x00386, 0x00391, 0x00345, 0x003B9, 0x000A8,
+  0x00342, 0x01F74, 0x00345, 0x003B7, 0x00345, 0x003AE, 0x00345, 0x003B7,
+  0x00342, 0x01FC6, 0x00345, 0x00395, 0x00300, 0x00388, 0x00397, 0x00300,
+  0x00389, 0x00397, 0x00345, 0x01FBF, 0x00300, 0x01FBF, 0x00301, 0x01FBF,
+  0x00342, 0x003B9, 0x00306, 0x003B9, 0x00304, 0x003CA, 0x00300, 0x00390,
+  0x003B9, 0x00342, 0x003CA, 0x00342, 0x00399, 0x00306, 0x00399, 0x00304,
+  0x00399, 0x00300, 0x0038A, 0x01FFE, 0x00300, 0x01FFE, 0x00301, 0x01FFE,
+  0x00342, 0x003C5, 0x00306, 0x003C5, 0x00304, 0x003CB, 0x00300, 0x003B0,
+  0x003C1, 0x00313, 0x003C1, 0x00314, 0x003C5, 0x00342, 0x003CB, 0x00342,
+  0x003A5, 0x00306, 0x003A5, 0x00304, 0x003A5, 0x00300, 0x0038E, 0x003A1,
+  0x00314, 0x000A8, 0x00300, 0x00385, 0x00060, 0x01F7C, 0x00345, 0x003C9,
+  0x00345, 0x003CE, 0x00345, 0x003C9, 0x00342, 0x01FF6, 0x00345, 0x0039F,
+  0x00300, 0x0038C, 0x003A9, 0x00300, 0x0038F, 0x003A9, 0x00345, 0x000B4,
+  0x02002, 0x02003, 0x003A9, 0x0004B, 0x000C5, 0x02190, 0x00338, 0x02192,
+  0x00338, 0x02194, 0x00338, 0x021D0, 0x00338, 0x021D4, 0x00338, 0x021D2,
+  0x00338, 0x02203, 0x00338, 0x02208, 0x00338, 0x0220B, 0x00338, 0x02223,
+  0x00338, 0x02225, 0x00338, 0x0223C, 0x00338, 0x02243, 0x00338, 0x02245,
+  0x00338, 0x02248, 0x00338, 0x0003D, 0x00338, 0x02261, 0x00338, 0x0224D,
+  0x00338, 0x0003C, 0x00338, 0x0003E, 0x00338, 0x02264, 0x00338, 0x02265,
+  0x00338, 0x02272, 0x00338, 0x02273, 0x00338, 0x02276, 0x00338, 0x02277,
+  0x00338, 0x0227A, 0x00338, 0x0227B, 0x00338, 0x02282, 0x00338, 0x02283,
+  0x00338, 0x02286, 0x00338, 0x02287, 0x00338, 0x022A2, 0x00338, 0x022A8,
+  0x00338, 0x022A9, 0x00338, 0x022AB, 0x00338, 0x0227C, 0x00338, 0x0227D,
+  0x00338, 0x02291, 0x00338, 0x02292, 0x00338, 0x022B2, 0x00338, 0x022B3,
+  0x00338, 0x022B4, 0x00338, 0x022B5, 0x00338, 0x03008, 0x03009, 0x02ADD,
+  0x00338, 0x0304B, 0x03099, 0x0304D, 0x03099, 0x0304F, 0x03099, 0x03051,
+  0x03099, 0x03053, 0x03099, 0x03055, 0x03099, 0x03057, 0x03099, 0x03059,
+  0x03099, 0x0305B, 0x03099, 0x0305D, 0x03099, 0x0305F, 0x03099, 0x03061,
+  0x03099, 0x03064, 0x03099, 0x03066, 0x03099, 0x03068, 0x03099, 0x0306F,
+  0x03099, 0x0306F, 0x0309A, 0x03072, 0x03099, 0x03072, 0x0309A, 0x03075,
+  0x03099, 0x03075, 0x0309A, 0x03078, 0x03099, 0x03078, 0x0309A, 0x0307B,
+  0x03099, 0x0307B, 0x0309A, 0x03046, 0x03099, 0x0309D, 0x03099, 0x030AB,
+  0x03099, 0x030AD, 0x03099, 0x030AF, 0x03099, 0x030B1, 0x03099, 0x030B3,
+  0x03099, 0x030B5, 0x03099, 0x030B7, 0x03099, 0x030B9, 0x03099, 0x030BB,
+  0x03099, 0x030BD, 0x03099, 0x030BF, 0x03099, 0x030C1, 0x03099, 0x030C4,
+  0x03099, 0x030C6, 0x03099, 0x030C8, 0x03099, 0x030CF, 0x03099, 0x030CF,
+  0x0309A, 0x030D2, 0x03099, 0x030D2, 0x0309A, 0x030D5, 0x03099, 0x030D5,
+  0x0309A, 0x030D8, 0x03099, 0x030D8, 0x0309A, 0x030DB, 0x03099, 0x030DB,
+  0x0309A, 0x030A6, 0x03099, 0x030EF, 0x03099, 0x030F0, 0x03099, 0x030F1,
+  0x03099, 0x030F2, 0x03099, 0x030FD, 0x03099, 0x08C48, 0x066F4, 0x08ECA,
+  0x08CC8, 0x06ED1, 0x04E32, 0x053E5, 0x09F9C, 0x09F9C, 0x05951, 0x091D1,
+  0x05587, 0x05948, 0x061F6, 0x07669, 0x07F85, 0x0863F, 0x087BA, 0x088F8,
+  0x0908F, 0x06A02, 0x06D1B, 0x070D9, 0x073DE, 0x0843D, 0x0916A, 0x099F1,
+  0x04E82, 0x05375, 0x06B04, 0x0721B, 0x0862D, 0x09E1E, 0x05D50, 0x06FEB,
+  0x085CD, 0x08964, 0x062C9, 0x081D8, 0x0881F, 0x05ECA, 0x06717, 0x06D6A,
+  0x072FC, 0x090CE, 0x04F86, 0x051B7, 0x052DE, 0x064C4, 0x06AD3, 0x07210,
+  0x076E7, 0x08001, 0x08606, 0x0865C, 0x08DEF, 0x09732, 0x09B6F, 0x09DFA,
+  0x0788C, 0x0797F, 0x07DA0, 0x083C9, 0x09304, 0x09E7F, 0x08AD6, 0x058DF,
+  0x05F04, 0x07C60, 0x0807E, 0x07262, 0x078CA, 0x08CC2, 0x096F7, 0x058D8,
+  0x05C62, 0x06A13, 0x06DDA, 0x06F0F, 0x07D2F, 0x07E37, 0x0964B, 0x052D2,
+  0x0808B, 0x051DC, 0x051CC, 0x07A1C, 0x07DBE, 0x083F1, 0x09675, 0x08B80,
+  0x062CF, 0x06A02, 0x08AFE, 0x04E39, 0x05BE7, 0x06012, 0x07387, 0x07570,
+  0x05317, 0x078FB, 0x04FBF, 0x05FA9, 0x04E0D, 0x06CCC, 0x06578, 0x07D22,
+  0x053C3, 0x0585E, 0x07701, 0x08449, 0x08AAA, 0x06BBA, 0x08FB0, 0x06C88,
+  0x062FE, 0x082E5, 0x063A0, 0x07565, 0x04EAE, 0x05169, 0x051C9, 0x06881,
+  0x07CE7, 0x0826F, 0x08AD2, 0x091CF, 0x052F5, 0x05442, 0x05973, 0x05EEC,
+  0x065C5, 0x06FFE, 0x0792A, 0x095AD, 0x09A6A, 0x09E97, 0x09ECE, 0x0529B,
+  0x066C6, 0x06B77, 0x08F62, 0x05E74, 0x06190, 0x06200, 0x0649A, 0x06F23,
+  0x07149, 0x07489, 0x079CA, 0x07DF4, 0x0806F, 0x08F26, 0x084EE, 0x09023,
+  0x0934A, 0x05217, 0x052A3, 0x054BD, 0x070C8, 0x088C2, 0x08AAA, 0x05EC9,
+  0x05FF5, 0x0637B, 0x06BAE, 0x07C3E, 0x07375, 0x04EE4, 0x056F9, 0x05BE7,
+  0x05DBA, 0x0601C, 0x073B2, 0x07469, 0x07F9A, 0x08046, 0x09234, 0x096F6,
+  0x09748, 0x09818, 0x04F8B, 0x079AE, 0x091B4, 0x096B8, 0x060E1, 0x04E86,
+  0x050DA, 0x05BEE, 0x05C3F, 0x06599, 0x06A02, 0x071CE, 0x07642, 0x084FC,
+  0x0907C, 0x09F8D, 0x06688, 0x0962E, 0x05289, 0x0677B, 0x067F3, 0x06D41,
+  0x06E9C, 0x07409, 0x07559, 0x0786B, 0x07D10, 0x0985E, 0x0516D, 0x0622E,
+  0x09678, 0x0502B, 0x05D19, 0x06DEA, 0x08F2A, 0x05F8B, 0x06144, 0x06817,
+  0x07387, 0x09686, 0x05229, 0x0540F, 0x05C65, 0x06613, 0x0674E, 0x068A8,
+  0x06CE5, 0x07406, 0x075E2, 0x07F79, 0x088CF, 0x088E1, 0x091CC, 0x096E2,
+  0x0533F, 0x06EBA, 0x0541D, 0x071D0, 0x07498, 0x085FA, 0x096A3, 0x09C57,
+  0x09E9F, 0x06797, 0x06DCB, 0x081E8, 0x07ACB, 0x07B20, 0x07C92, 0x072C0,
+  0x07099, 0x08B58, 0x04EC0, 0x08336, 0x0523A, 0x05207, 0x05EA6, 0x062D3,
+  0x07CD6, 0x05B85, 0x06D1E, 0x066B4, 0x08F3B, 0x0884C, 0x0964D, 0x0898B,
+  0x05ED3, 0x05140, 0x055C0, 0x0585A, 0x06674, 0x051DE, 0x0732A, 0x076CA,
+  0x0793C, 0x0795E, 0x07965, 0x0798F, 0x09756, 0x07CBE, 0x07FBD, 0x08612,
+  0x08AF8, 0x09038, 0x090FD, 0x098EF, 0x098FC, 0x09928, 0x09DB4, 0x090DE,
+  0x096B7, 0x04FAE, 0x050E7, 0x0514D, 0x052C9, 0x052E4, 0x05351, 0x0559D,
+  0x05606, 0x05668, 0x05840, 0x058A8, 0x05C64, 0x05C6E, 0x06094, 0x06168,
+  0x0618E, 0x061F2, 0x0654F, 0x065E2, 0x06691, 0x06885, 0x06D77, 0x06E1A,
+  0x06F22, 0x0716E, 0x0722B, 0x07422, 0x07891, 0x0793E, 0x07949, 0x07948,
+  0x07950, 0x07956, 0x0795D, 0x0798D, 0x0798E, 0x07A40, 0x07A81, 0x07BC0,
+  0x07DF4, 0x07E09, 0x07E41, 0x07F72, 0x08005, 0x081ED, 0x08279, 0x08279,
+  0x08457, 0x08910, 0x08996, 0x08B01, 0x08B39, 0x08CD3, 0x08D08, 0x08FB6,
+  0x09038, 0x096E3, 0x097FF, 0x0983B, 0x06075, 0x242EE, 0x08218, 0x04E26,
+  0x051B5, 0x05168, 0x04F80, 0x05145, 0x05180, 0x052C7, 0x052FA, 0x0559D,
+  0x05555, 0x05599, 0x055E2, 0x0585A, 0x058B3, 0x05944, 0x05954, 0x05A62,
+  0x05B28, 0x05ED2, 0x05ED9, 0x05F69, 0x05FAD, 0x060D8, 0x0614E, 0x06108,
+  0x0618E, 0x06160, 0x061F2, 0x06234, 0x063C4, 0x0641C, 0x06452, 0x06556,
+  0x06674, 0x06717, 0x0671B, 0x06756, 0x06B79, 0x06BBA, 0x06D41, 0x06EDB,
+  0x06ECB, 0x06F22, 0x0701E, 0x0716E, 0x077A7, 0x07235, 0x072AF, 0x0732A,
+  0x07471, 0x07506, 0x0753B, 0x0761D, 0x0761F, 0x076CA, 0x076DB, 0x076F4,
+  0x0774A, 0x07740, 0x078CC, 0x07AB1, 0x07BC0, 0x07C7B, 0x07D5B, 0x07DF4,
+  0x07F3E, 0x08005, 0x08352, 0x083EF, 0x08779, 0x08941, 0x08986, 0x08996,
+  0x08ABF, 0x08AF8, 0x08ACB, 0x08B01, 0x08AFE, 0x08AED, 0x08B39, 0x08B8A,
+  0x08D08, 0x08F38, 0x09072, 0x09199, 0x09276, 0x0967C, 0x096E3, 0x09756,
+  0x097DB, 0x097FF, 0x0980B, 0x0983B, 0x09B12, 0x09F9C, 0x2284A, 0x22844,
+  0x233D5, 0x03B9D, 0x04018, 0x04039, 0x25249, 0x25CD0, 0x27ED3, 0x09F43,
+  0x09F8E, 0x005D9, 0x005B4, 0x005F2, 0x005B7, 0x005E9, 0x005C1, 0x005E9,
+  0x005C2, 0x0FB49, 0x005C1, 0x0FB49, 0x005C2, 0x005D0, 0x005B7, 0x005D0,
+  0x005B8, 0x005D0, 0x005BC, 0x005D1, 0x005BC, 0x005D2, 0x005BC, 0x005D3,
+  0x005BC, 0x005D4, 0x005BC, 0x005D5, 0x005BC, 0x005D6, 0x005BC, 0x005D8,
+  0x005BC, 0x005D9, 0x005BC, 0x005DA, 0x005BC, 0x005DB, 0x005BC, 0x005DC,
+  0x005BC, 0x005DE, 0x005BC, 0x005E0, 0x005BC, 0x005E1, 0x005BC, 0x005E3,
+  0x005BC, 0x005E4, 0x005BC, 0x005E6, 0x005BC, 0x005E7, 0x005BC, 0x005E8,
+  0x005BC, 0x005E9, 0x005BC, 0x005EA, 0x005BC, 0x005D5, 0x005B9, 0x005D1,
+  0x005BF, 0x005DB, 0x005BF, 0x005E4, 0x005BF, 0x11099, 0x110BA, 0x1109B,
+  0x110BA, 0x110A5, 0x110BA, 0x11131, 0x11127, 0x11132, 0x11127, 0x11347,
+  0x1133E, 0x11347, 0x11357, 0x114B9, 0x114BA, 0x114B9, 0x114B0, 0x114B9,
+  0x114BD, 0x115B8, 0x115AF, 0x115B9, 0x115AF, 0x11935, 0x11930, 0x1D157,
+  0x1D165, 0x1D158, 0x1D165, 0x1D15F, 0x1D16E, 0x1D15F, 0x1D16F, 0x1D15F,
+  0x1D170, 0x1D15F, 0x1D171, 0x1D15F, 0x1D172, 0x1D1B9, 0x1D165, 0x1D1BA,
+  0x1D165, 0x1D1BB, 0x1D16E, 0x1D1BC, 0x1D16E, 0x1D1BB, 0x1D16F, 0x1D1BC,
+  0x1D16F, 0x04E3D, 0x04E38, 0x04E41, 0x20122, 0x04F60, 0x04FAE, 0x04FBB,
+  0x05002, 0x0507A, 0x05099, 0x050E7, 0x050CF, 0x0349E, 0x2063A, 0x0514D,
+  0x05154, 0x05164, 0x05177, 0x2051C, 0x034B9, 0x05167, 0x0518D, 0x2054B,
+  0x05197, 0x051A4, 0x04ECC, 0x051AC, 0x051B5, 0x291DF, 0x051F5, 0x05203,
+  0x034DF, 0x0523B, 0x05246, 0x05272, 0x05277, 0x03515, 0x052C7, 0x052C9,
+  0x052E4, 0x052FA, 0x05305, 0x05306, 0x05317, 0x05349, 0x05351, 0x0535A,
+  0x05373, 0x0537D, 0x0537F, 0x0537F, 0x0537F, 0x20A2C, 0x07070, 0x053CA,
+  0x053DF, 0x20B63, 0x053EB, 0x053F1, 0x05406, 0x0549E, 0x05438, 0x05448,
+  0x05468, 0x054A2, 0x054F6, 0x05510, 0x05553, 0x05563, 0x05584, 0x05584,
+  0x05599, 0x055AB, 0x055B3, 0x055C2, 0x05716, 0x05606, 0x05717, 0x05651,
+  0x05674, 0x05207, 0x058EE, 0x057CE, 0x057F4, 0x0580D, 0x0578B, 0x05832,
+  0x05831, 0x058AC, 0x214E4, 0x058F2, 0x058F7, 0x05906, 0x0591A, 0x05922,
+  0x05962, 0x216A8, 0x216EA, 0x059EC, 0x05A1B, 0x05A27, 0x059D8, 0x05A66,
+  0x036EE, 0x036FC, 0x05B08, 0x05B3E, 0x05B3E, 0x219C8, 0x05BC3, 0x05BD8,
+  0x05BE7, 0x05BF3, 0x21B18, 0x05BFF, 0x05C06, 0x05F53, 0x05C22, 0x03781,
+  0x05C60, 0x05C6E, 0x05CC0, 0x05C8D, 0x21DE4, 0x05D43, 0x21DE6, 0x05D6E,
+  0x05D6B, 0x05D7C, 0x05DE1, 0x05DE2, 0x0382F, 0x05DFD, 0x05E28, 0x05E3D,
+  0x05E69, 0x03862, 0x22183, 0x0387C, 0x05EB0, 0x05EB3, 0x05EB6, 0x05ECA,
+  0x2A392, 0x05EFE, 0x22331, 0x22331, 0x08201, 0x05F22, 0x05F22, 0x038C7,
+  0x232B8, 0x261DA, 0x05F62, 0x05F6B, 0x038E3, 0x05F9A, 0x05FCD, 0x05FD7,
+  0x05FF9, 0x06081, 0x0393A, 0x0391C, 0x06094, 0x226D4, 0x060C7, 0x06148,
+  0x0614C, 0x0614E, 0x0614C, 0x0617A, 0x0618E, 0x061B2, 0x061A4, 0x061AF,
+  0x061DE, 0x061F2, 0x061F6, 0x06210, 0x0621B, 0x0625D, 0x062B1, 0x062D4,
+  0x06350, 0x22B0C, 0x0633D, 0x062FC, 0x06368, 0x06383, 0x063E4, 0x22BF1,
+  0x06422, 0x063C5, 0x063A9, 0x03A2E, 0x06469, 0x0647E, 0x0649D, 0x06477,
+  0x03A6C, 0x0654F, 0x0656C, 0x2300A, 0x065E3, 0x066F8, 0x06649, 0x03B19,
+  0x06691, 0x03B08, 0x03AE4, 0x05192, 0x05195, 0x06700, 0x0669C, 0x080AD,
+  0x043D9, 0x06717, 0x0671B, 0x06721, 0x0675E, 0x06753, 0x233C3, 0x03B49,
+  0x067FA, 0x06785, 0x06852, 0x06885, 0x2346D, 0x0688E, 0x0681F, 0x06914,
+  0x03B9D, 0x06942, 0x069A3, 0x069EA, 0x06AA8, 0x236A3, 0x06ADB, 0x03C18,
+  0x06B21, 0x238A7, 0x06B54, 0x03C4E, 0x06B72, 0x06B9F, 0x06BBA, 0x06BBB,
+  0x23A8D, 0x21D0B, 0x23AFA, 0x06C4E, 0x23CBC, 0x06CBF, 0x06CCD, 0x06C67,
+  0x06D16, 0x06D3E, 0x06D77, 0x06D41, 0x06D69, 0x06D78, 0x06D85, 0x23D1E,
+  0x06D34, 0x06E2F, 0x06E6E, 0x03D33, 0x06ECB, 0x06EC7, 0x23ED1, 0x06DF9,
+  0x06F6E, 0x23F5E, 0x23F8E, 0x06FC6, 0x07039, 0x0701E, 0x0701B, 0x03D96,
+  0x0704A, 0x0707D, 0x07077, 0x070AD, 0x20525, 0x07145, 0x24263, 0x0719C,
+  0x243AB, 0x07228, 0x07235, 0x07250, 0x24608, 0x07280, 0x07295, 0x24735,
+  0x24814, 0x0737A, 0x0738B, 0x03EAC, 0x073A5, 0x03EB8, 0x03EB8, 0x07447,
+  0x0745C, 0x07471, 0x07485, 0x074CA, 0x03F1B, 0x07524, 0x24C36, 0x0753E,
+  0x24C92, 0x07570, 0x2219F, 0x07610, 0x24FA1, 0x24FB8, 0x25044, 0x03FFC,
+  0x04008, 0x076F4, 0x250F3, 0x250F2, 0x25119, 0x25133, 0x0771E, 0x0771F,
+  0x0771F, 0x0774A, 0x04039, 0x0778B, 0x04046, 0x04096, 0x2541D, 0x0784E,
+  0x0788C, 0x078CC, 0x040E3, 0x25626, 0x07956, 0x2569A, 0x256C5, 0x0798F,
+  0x079EB, 0x0412F, 0x07A40, 0x07A4A, 0x07A4F, 0x2597C, 0x25AA7, 0x25AA7,
+  0x07AEE, 0x04202, 0x25BAB, 0x07BC6, 0x07BC9, 0x04227, 0x25C80, 0x07CD2,
+  0x042A0, 0x07CE8, 0x07CE3, 0x07D00, 0x25F86, 0x07D63, 0x04301, 0x07DC7,
+  0x07E02, 0x07E45, 0x04334, 0x26228, 0x26247, 0x04359, 0x262D9, 0x07F7A,
+  0x2633E, 0x07F95, 0x07FFA, 0x08005, 0x264DA, 0x26523, 0x08060, 0x265A8,
+  0x08070, 0x2335F, 0x043D5, 0x080B2, 0x08103, 0x0440B, 0x0813E, 0x05AB5,
+  0x267A7, 0x267B5, 0x23393, 0x2339C, 0x08201, 0x08204, 0x08F9E, 0x0446B,
+  0x08291, 0x0828B, 0x0829D, 0x052B3, 0x082B1, 0x082B3, 0x082BD, 0x082E6,
+  0x26B3C, 0x082E5, 0x0831D, 0x08363, 0x083AD, 0x08323, 0x083BD, 0x083E7,
+  0x08457, 0x08353, 0x083CA, 0x083CC, 0x083DC, 0x26C36, 0x26D6B, 0x26CD5,
+  0x0452B, 0x084F1, 0x084F3, 0x08516, 0x273CA, 0x08564, 0x26F2C, 0x0455D,
+  0x04561, 0x26FB1, 0x270D2, 0x0456B, 0x08650, 0x0865C, 0x08667, 0x08669,
+  0x086A9, 0x08688, 0x0870E, 0x086E2, 0x08779, 0x08728, 0x0876B, 0x08786,
+  0x045D7, 0x087E1, 0x08801, 0x045F9, 0x08860, 0x08863, 0x27667, 0x088D7,
+  0x088DE, 0x04635, 0x088FA, 0x034BB, 0x278AE, 0x27966, 0x046BE, 0x046C7,
+  0x08AA0, 0x08AED, 0x08B8A, 0x08C55, 0x27CA8, 0x08CAB, 0x08CC1, 0x08D1B,
+  0x08D77, 0x27F2F, 0x20804, 0x08DCB, 0x08DBC, 0x08DF0, 0x208DE, 0x08ED4,
+  0x08F38, 0x285D2, 0x285ED, 0x09094, 0x090F1, 0x09111, 0x2872E, 0x0911B,
+  0x09238, 0x092D7, 0x092D8, 0x0927C, 0x093F9, 0x09415, 0x28BFA, 0x0958B,
+  0x04995, 0x095B7, 0x28D77, 0x049E6, 0x096C3, 0x05DB2, 0x09723, 0x29145,
+  0x2921A, 0x04A6E, 0x04A76, 0x097E0, 0x2940A, 0x04AB2, 0x29496, 0x0980B,
+  0x0980B, 0x09829, 0x295B6, 0x098E2, 0x04B33, 0x09929, 0x099A7, 0x099C2,
+  0x099FE, 0x04BCE, 0x29B30, 0x09B12, 0x09C40, 0x09CFD, 0x04CCE, 0x04CED,
+  0x09D67, 0x2A0CE, 0x04CF8, 0x2A105, 0x2A20E, 0x2A291, 0x09EBB, 0x04D56,
+  0x09EF9, 0x09EFE, 0x09F05, 0x09F0F, 0x09F16, 0x09F3B, 0x2A600,
+};
+
+/* Primary composites sorted by their two characters. */
+static const unicode_composition_t unicode_compositions[] = {
+  { 0x0003C, 0x00338, 0x0226E }, { 0x0003D, 0x00338, 0x02260 },
+  { 0x0003E, 0x00338, 0x0226F }, { 0x00041, 0x00300, 0x000C0 },
+  { 0x00041, 0x00301, 0x000C1 }, { 0x00041, 0x00302, 0x000C2 },
+  { 0x00041, 0x00303, 0x000C3 }, { 0x00041, 0x00304, 0x00100 },
+  { 0x00041, 0x00306, 0x00102 }, { 0x00041, 0x00307, 0x00226 },
+  { 0x00041, 0x00308, 0x000C4 }, { 0x00041, 0x00309, 0x01EA2 },
+  { 0x00041, 0x0030A, 0x000C5 }, { 0x00041, 0x0030C, 0x001CD },
+  { 0x00041, 0x0030F, 0x00200 }, { 0x00041, 0x00311, 0x00202 },
+  { 0x00041, 0x00323, 0x01EA0 }, { 0x00041, 0x00325, 0x01E00 },
+  { 0x00041, 0x00328, 0x00104 }, { 0x00042, 0x00307, 0x01E02 },
+  { 0x00042, 0x00323, 0x01E04 }, { 0x00042, 0x00331, 0x01E06 },
+  { 0x00043, 0x00301, 0x00106 }, { 0x00043, 0x00302, 0x00108 },
+  { 0x00043, 0x00307, 0x0010A }, { 0x00043, 0x0030C, 0x0010C },
+  { 0x00043, 0x00327, 0x000C7 }, { 0x00044, 0x00307, 0x01E0A },
+  { 0x00044, 0x0030C, 0x0010E }, { 0x00044, 0x00323, 0x01E0C },
+  { 0x00044, 0x00327, 0x01E10 }, { 0x00044, 0x0032D, 0x01E12 },
+  { 0x00044, 0x00331, 0x01E0E }, { 0x00045, 0x00300, 0x000C8 },
+  { 0x00045, 0x00301, 0x000C9 }, { 0x00045, 0x00302, 0x000CA },
+  { 0x00045, 0x00303, 0x01EBC }, { 0x00045, 0x00304, 0x00112 },
+  { 0x00045, 0x00306, 0x00114 }, { 0x00045, 0x00307, 0x00116 },
+  { 0x00045, 0x00308, 0x000CB }, { 0x00045, 0x00309, 0x01EBA },
+  { 0x00045, 0x0030C, 0x0011A }, { 0x00045, 0x0030F, 0x00204 },
+  { 0x00045, 0x00311, 0x00206 }, { 0x00045, 0x00323, 0x01EB8 },
+  { 0x00045, 0x00327, 0x00228 }, { 0x00045, 0x00328, 0x00118 },
+  { 0x00045, 0x0032D, 0x01E18 }, { 0x00045, 0x00330, 0x01E1A },
+  { 0x00046, 0x00307, 0x01E1E }, { 0x00047, 0x00301, 0x001F4 },
+  { 0x00047, 0x00302, 0x0011C }, { 0x00047, 0x00304, 0x01E20 },
+  { 0x00047, 0x00306, 0x0011E }, { 0x00047, 0x00307, 0x00120 },
+  { 0x00047, 0x0030C, 0x001E6 }, { 0x00047, 0x00327, 0x00122 },
+  { 0x00048, 0x00302, 0x00124 }, { 0x00048, 0x00307, 0x01E22 },
+  { 0x00048, 0x00308, 0x01E26 }, { 0x00048, 0x0030C, 0x0021E },
+  { 0x00048, 0x00323, 0x01E24 }, { 0x00048, 0x00327, 0x01E28 },
+  { 0x00048, 0x0032E, 0x01E2A }, { 0x00049, 0x00300, 0x000CC },
+  { 0x00049, 0x00301, 0x000CD }, { 0x00049, 0x00302, 0x000CE },
+  { 0x00049, 0x00303, 0x00128 }, { 0x00049, 0x00304, 0x0012A },
+  { 0x00049, 0x00306, 0x0012C }, { 0x00049, 0x00307, 0x00130 },
+  { 0x00049, 0x00308, 0x000CF }, { 0x00049, 0x00309, 0x01EC8 },
+  { 0x00049, 0x0030C, 0x001CF }, { 0x00049, 0x0030F, 0x00208 },
+  { 0x00049, 0x00311, 0x0020A }, { 0x00049, 0x00323, 0x01ECA },
+  { 0x00049, 0x00328, 0x0012E }, { 0x00049, 0x00330, 0x01E2C },
+  { 0x0004A, 0x00302, 0x00134 }, { 0x0004B, 0x00301, 0x01E30 },
+  { 0x0004B, 0x0030C, 0x001E8 }, { 0x0004B, 0x00323, 0x01E32 },
+  { 0x0004B, 0x00327, 0x00136 }, { 0x0004B, 0x00331, 0x01E34 },
+  { 0x0004C, 0x00301, 0x00139 }, { 0x0004C, 0x0030C, 0x0013D },
+  { 0x0004C, 0x00323, 0x01E36 }, { 0x0004C, 0x00327, 0x0013B },
+  { 0x0004C, 0x0032D, 0x01E3C }, { 0x0004C, 0x00331, 0x01E3A },
+  { 0x0004D, 0x00301, 0x01E3E }, { 0x0004D, 0x00307, 0x01E40 },
+  { 0x0004D, 0x00323, 0x01E42 }, { 0x0004E, 0x00300, 0x001F8 },
+  { 0x0004E, 0x00301, 0x00143 }, { 0x0004E, 0x00303, 0x000D1 },
+  { 0x0004E, 0x00307, 0x01E44 }, { 0x0004E, 0x0030C, 0x00147 },
+  { 0x0004E, 0x00323, 0x01E46 }, { 0x0004E, 0x00327, 0x00145 },
+  { 0x0004E, 0x0032D, 0x01E4A }, { 0x0004E, 0x00331, 0x01E48 },
+  { 0x0004F, 0x00300, 0x000D2 }, { 0x0004F, 0x00301, 0x000D3 },
+  { 0x0004F, 0x00302, 0x000D4 }, { 0x0004F, 0x00303, 0x000D5 },
+  { 0x0004F, 0x00304, 0x0014C }, { 0x0004F, 0x00306, 0x0014E },
+  { 0x0004F, 0x00307, 0x0022E }, { 0x0004F, 0x00308, 0x000D6 },
+  { 0x0004F, 0x00309, 0x01ECE }, { 0x0004F, 0x0030B, 0x00150 },
+  { 0x0004F, 0x0030C, 0x001D1 }, { 0x0004F, 0x0030F, 0x0020C },
+  { 0x0004F, 0x00311, 0x0020E }, { 0x0004F, 0x0031B, 0x001A0 },
+  { 0x0004F, 0x00323, 0x01ECC }, { 0x0004F, 0x00328, 0x001EA },
+  { 0x00050, 0x00301, 0x01E54 }, { 0x00050, 0x00307, 0x01E56 },
+  { 0x00052, 0x00301, 0x00154 }, { 0x00052, 0x00307, 0x01E58 },
+  { 0x00052, 0x0030C, 0x00158 }, { 0x00052, 0x0030F, 0x00210 },
+  { 0x00052, 0x00311, 0x00212 }, { 0x00052, 0x00323, 0x01E5A },
+  { 0x00052, 0x00327, 0x00156 }, { 0x00052, 0x00331, 0x01E5E },
+  { 0x00053, 0x00301, 0x0015A }, { 0x00053, 0x00302, 0x0015C },
+  { 0x00053, 0x00307, 0x01E60 }, { 0x00053, 0x0030C, 0x00160 },
+  { 0x00053, 0x00323, 0x01E62 }, { 0x00053, 0x00326, 0x00218 },
+  { 0x00053, 0x00327, 0x0015E }, { 0x00054, 0x00307, 0x01E6A },
+  { 0x00054, 0x0030C, 0x00164 }, { 0x00054, 0x00323, 0x01E6C },
+  { 0x00054, 0x00326, 0x0021A }, { 0x00054, 0x00327, 0x00162 },
+  { 0x00054, 0x0032D, 0x01E70 }, { 0x00054, 0x00331, 0x01E6E },
+  { 0x00055, 0x00300, 0x000D9 }, { 0x00055, 0x00301, 0x000DA },
+  { 0x00055, 0x00302, 0x000DB }, { 0x00055, 0x00303, 0x00168 },
+  { 0x00055, 0x00304, 0x0016A }, { 0x00055, 0x00306, 0x0016C },
+  { 0x00055, 0x00308, 0x000DC }, { 0x00055, 0x00309, 0x01EE6 },
+  { 0x00055, 0x0030A, 0x0016E }, { 0x00055, 0x0030B, 0x00170 },
+  { 0x00055, 0x0030C, 0x001D3 }, { 0x00055, 0x0030F, 0x00214 },
+  { 0x00055, 0x00311, 0x00216 }, { 0x00055, 0x0031B, 0x001AF },
+  { 0x00055, 0x00323, 0x01EE4 }, { 0x00055, 0x00324, 0x01E72 },
+  { 0x00055, 0x00328, 0x00172 }, { 0x00055, 0x0032D, 0x01E76 },
+  { 0x00055, 0x00330, 0x01E74 }, { 0x00056, 0x00303, 0x01E7C },
+  { 0x00056, 0x00323, 0x01E7E }, { 0x00057, 0x00300, 0x01E80 },
+  { 0x00057, 0x00301, 0x01E82 }, { 0x00057, 0x00302, 0x00174 },
+  { 0x00057, 0x00307, 0x01E86 }, { 0x00057, 0x00308, 0x01E84 },
+  { 0x00057, 0x00323, 0x01E88 }, { 0x00058, 0x00307, 0x01E8A },
+  { 0x00058, 0x00308, 0x01E8C }, { 0x00059, 0x00300, 0x01EF2 },
+  { 0x00059, 0x00301, 0x000DD }, { 0x00059, 0x00302, 0x00176 },
+  { 0x00059, 0x00303, 0x01EF8 }, { 0x00059, 0x00304, 0x00232 },
+  { 0x00059, 0x00307, 0x01E8E }, { 0x00059, 0x00308, 0x00178 },
+  { 0x00059, 0x00309, 0x01EF6 }, { 0x00059, 0x00323, 0x01EF4 },
+  { 0x0005A, 0x00301, 0x00179 }, { 0x0005A, 0x00302, 0x01E90 },
+  { 0x0005A, 0x00307, 0x0017B }, { 0x0005A, 0x0030C, 0x0017D },
+  { 0x0005A, 0x00323, 0x01E92 }, { 0x0005A, 0x00331, 0x01E94 },
+  { 0x00061, 0x00300, 0x000E0 }, { 0x00061, 0x00301, 0x000E1 },
+  { 0x00061, 0x00302, 0x000E2 }, { 0x00061, 0x00303, 0x000E3 },
+  { 0x00061, 0x00304, 0x00101 }, { 0x00061, 0x00306, 0x00103 },
+  { 0x00061, 0x00307, 0x00227 }, { 0x00061, 0x00308, 0x000E4 },
+  { 0x00061, 0x00309, 0x01EA3 }, { 0x00061, 0x0030A, 0x000E5 },
+  { 0x00061, 0x0030C, 0x001CE }, { 0x00061, 0x0030F, 0x00201 },
+  { 0x00061, 0x00311, 0x00203 }, { 0x00061, 0x00323, 0x01EA1 },
+  { 0x00061, 0x00325, 0x01E01 }, { 0x00061, 0x00328, 0x00105 },
+  { 0x00062, 0x00307, 0x01E03 }, { 0x00062, 0x00323, 0x01E05 },
+  { 0x00062, 0x00331, 0x01E07 }, { 0x00063, 0x00301, 0x00107 },
+  { 0x00063, 0x00302, 0x00109 }, { 0x00063, 0x00307, 0x0010B },
+  { 0x00063, 0x0030C, 0x0010D }, { 0x00063, 0x00327, 0x000E7 },
+  { 0x00064, 0x00307, 0x01E0B }, { 0x00064, 0x0030C, 0x0010F },
+  { 0x00064, 0x00323, 0x01E0D }, { 0x00064, 0x00327, 0x01E11 },
+  { 0x00064, 0x0032D, 0x01E13 }, { 0x00064, 0x00331, 0x01E0F },
+  { 0x00065, 0x00300, 0x000E8 }, { 0x00065, 0x00301, 0x000E9 },
+  { 0x00065, 0x00302, 0x000EA }, { 0x00065, 0x00303, 0x01EBD },
+  { 0x00065, 0x00304, 0x00113 }, { 0x00065, 0x00306, 0x00115 },
+  { 0x00065, 0x00307, 0x00117 }, { 0x00065, 0x00308, 0x000EB },
+  { 0x00065, 0x00309, 0x01EBB }, { 0x00065, 0x0030C, 0x0011B },
+  { 0x00065, 0x0030F, 0x00205 }, { 0x00065, 0x00311, 0x00207 },
+  { 0x00065, 0x00323, 0x01EB9 }, { 0x00065, 0x00327, 0x00229 },
+  { 0x00065, 0x00328, 0x00119 }, { 0x00065, 0x0032D, 0x01E19 },
+  { 0x00065, 0x00330, 0x01E1B }, { 0x00066, 0x00307, 0x01E1F },
+  { 0x00067, 0x00301, 0x001F5 }, { 0x00067, 0x00302, 0x0011D },
+  { 0x00067, 0x00304, 0x01E21 }, { 0x00067, 0x00306, 0x0011F },
+  { 0x00067, 0x00307, 0x00121 }, { 0x00067, 0x0030C, 0x001E7 },
+  { 0x00067, 0x00327, 0x00123 }, { 0x00068, 0x00302, 0x00125 },
+  { 0x00068, 0x00307, 0x01E23 }, { 0x00068, 0x00308, 0x01E27 },
+  { 0x00068, 0x0030C, 0x0021F }, { 0x00068, 0x00323, 0x01E25 },
+  { 0x00068, 0x00327, 0x01E29 }, { 0x00068, 0x0032E, 0x01E2B },
+  { 0x00068, 0x00331, 0x01E96 }, { 0x00069, 0x00300, 0x000EC },
+  { 0x00069, 0x00301, 0x000ED }, { 0x00069, 0x00302, 0x000EE },
+  { 0x00069, 0x00303, 0x00129 }, { 0x00069, 0x00304, 0x0012B },
+  { 0x00069, 0x00306, 0x0012D }, { 0x00069, 0x00308, 0x000EF },
+  { 0x00069, 0x00309, 0x01EC9 }, { 0x00069, 0x0030C, 0x001D0 },
+  { 0x00069, 0x0030F, 0x00209 }, { 0x00069, 0x00311, 0x0020B },
+  { 0x00069, 0x00323, 0x01ECB }, { 0x00069, 0x00328, 0x0012F },
+  { 0x00069, 0x00330, 0x01E2D }, { 0x0006A, 0x00302, 0x00135 },
+  { 0x0006A, 0x0030C, 0x001F0 }, { 0x0006B, 0x00301, 0x01E31 },
+  { 0x0006B, 0x0030C, 0x001E9 }, { 0x0006B, 0x00323, 0x01E33 },
+  { 0x0006B, 0x00327, 0x00137 }, { 0x0006B, 0x00331, 0x01E35 },
+  { 0x0006C, 0x00301, 0x0013A }, { 0x0006C, 0x0030C, 0x0013E },
+  { 0x0006C, 0x00323, 0x01E37 }, { 0x0006C, 0x00327, 0x0013C },
+  { 0x0006C, 0x0032D, 0x01E3D }, { 0x0006C, 0x00331, 0x01E3B },
+  { 0x0006D, 0x00301, 0x01E3F }, { 0x0006D, 0x00307, 0x01E41 },
+  { 0x0006D, 0x00323, 0x01E43 }, { 0x0006E, 0x00300, 0x001F9 },
+  { 0x0006E, 0x00301, 0x00144 }, { 0x0006E, 0x00303, 0x000F1 },
+  { 0x0006E, 0x00307, 0x01E45 }, { 0x0006E, 0x0030C, 0x00148 },
+  { 0x0006E, 0x00323, 0x01E47 }, { 0x0006E, 0x00327, 0x00146 },
+  { 0x0006E, 0x0032D, 0x01E4B }, { 0x0006E, 0x00331, 0x01E49 },
+  { 0x0006F, 0x00300, 0x000F2 }, { 0x0006F, 0x00301, 0x000F3 },
+  { 0x0006F, 0x00302, 0x000F4 }, { 0x0006F, 0x00303, 0x000F5 },
+  { 0x0006F, 0x00304, 0x0014D }, { 0x0006F, 0x00306, 0x0014F },
+  { 0x0006F, 0x00307, 0x0022F }, { 0x0006F, 0x00308, 0x000F6 },
+  { 0x0006F, 0x00309, 0x01ECF }, { 0x0006F, 0x0030B, 0x00151 },
+  { 0x0006F, 0x0030C, 0x001D2 }, { 0x0006F, 0x0030F, 0x0020D },
+  { 0x0006F, 0x00311, 0x0020F }, { 0x0006F, 0x0031B, 0x001A1 },
+  { 0x0006F, 0x00323, 0x01ECD }, { 0x0006F, 0x00328, 0x001EB },
+  { 0x00070, 0x00301, 0x01E55 }, { 0x00070, 0x00307, 0x01E57 },
+  { 0x00072, 0x00301, 0x00155 }, { 0x00072, 0x00307, 0x01E59 },
+  { 0x00072, 0x0030C, 0x00159 }, { 0x00072, 0x0030F, 0x00211 },
+  { 0x00072, 0x00311, 0x00213 }, { 0x00072, 0x00323, 0x01E5B },
+  { 0x00072, 0x00327, 0x00157 }, { 0x00072, 0x00331, 0x01E5F },
+  { 0x00073, 0x00301, 0x0015B }, { 0x00073, 0x00302, 0x0015D },
+  { 0x00073, 0x00307, 0x01E61 }, { 0x00073, 0x0030C, 0x00161 },
+  { 0x00073, 0x00323, 0x01E63 }, { 0x00073, 0x00326, 0x00219 },
+  { 0x00073, 0x00327, 0x0015F }, { 0x00074, 0x00307, 0x01E6B },
+  { 0x00074, 0x00308, 0x01E97 }, { 0x00074, 0x0030C, 0x00165 },
+  { 0x00074, 0x00323, 0x01E6D }, { 0x00074, 0x00326, 0x0021B },
+  { 0x00074, 0x00327, 0x00163 }, { 0x00074, 0x0032D, 0x01E71 },
+  { 0x00074, 0x00331, 0x01E6F }, { 0x00075, 0x00300, 0x000F9 },
+  { 0x00075, 0x00301, 0x000FA }, { 0x00075, 0x00302, 0x000FB },
+  { 0x00075, 0x00303, 0x00169 }, { 0x00075, 0x00304, 0x0016B },
+  { 0x00075, 0x00306, 0x0016D }, { 0x00075, 0x00308, 0x000FC },
+  { 0x00075, 0x00309, 0x01EE7 }, { 0x00075, 0x0030A, 0x0016F },
+  { 0x00075, 0x0030B, 0x00171 }, { 0x00075, 0x0030C, 0x001D4 },
+  { 0x00075, 0x0030F, 0x00215 }, { 0x00075, 0x00311, 0x00217 },
+  { 0x00075, 0x0031B, 0x001B0 }, { 0x00075, 0x00323, 0x01EE5 },
+  { 0x00075, 0x00324, 0x01E73 }, { 0x00075, 0x00328, 0x00173 },
+  { 0x00075, 0x0032D, 0x01E77 }, { 0x00075, 0x00330, 0x01E75 },
+  { 0x00076, 0x00303, 0x01E7D }, { 0x00076, 0x00323, 0x01E7F },
+  { 0x00077, 0x00300, 0x01E81 }, { 0x00077, 0x00301, 0x01E83 },
+  { 0x00077, 0x00302, 0x00175 }, { 0x00077, 0x00307, 0x01E87 },
+  { 0x00077, 0x00308, 0x01E85 }, { 0x00077, 0x0030A, 0x01E98 },
+  { 0x00077, 0x00323, 0x01E89 }, { 0x00078, 0x00307, 0x01E8B },
+  { 0x00078, 0x00308, 0x01E8D }, { 0x00079, 0x00300, 0x01EF3 },
+  { 0x00079, 0x00301, 0x000FD }, { 0x00079, 0x00302, 0x00177 },
+  { 0x00079, 0x00303, 0x01EF9 }, { 0x00079, 0x00304, 0x00233 },
+  { 0x00079, 0x00307, 0x01E8F }, { 0x00079, 0x00308, 0x000FF },
+  { 0x00079, 0x00309, 0x01EF7 }, { 0x00079, 0x0030A, 0x01E99 },
+  { 0x00079, 0x00323, 0x01EF5 }, { 0x0007A, 0x00301, 0x0017A },
+  { 0x0007A, 0x00302, 0x01E91 }, { 0x0007A, 0x00307, 0x0017C },
+  { 0x0007A, 0x0030C, 0x0017E }, { 0x0007A, 0x00323, 0x01E93 },
+  { 0x0007A, 0x00331, 0x01E95 }, { 0x000A8, 0x00300, 0x01FED },
+  { 0x000A8, 0x00301, 0x00385 }, { 0x000A8, 0x00342, 0x01FC1 },
+  { 0x000C2, 0x00300, 0x01EA6 }, { 0x000C2, 0x00301, 0x01EA4 },
+  { 0x000C2, 0x00303, 0x01EAA }, { 0x000C2, 0x00309, 0x01EA8 },
+  { 0x000C4, 0x00304, 0x001DE }, { 0x000C5, 0x00301, 0x001FA },
+  { 0x000C6, 0x00301, 0x001FC }, { 0x000C6, 0x00304, 0x001E2 },
+  { 0x000C7, 0x00301, 0x01E08 }, { 0x000CA, 0x00300, 0x01EC0 },
+  { 0x000CA, 0x00301, 0x01EBE }, { 0x000CA, 0x00303, 0x01EC4 },
+  { 0x000CA, 0x00309, 0x01EC2 }, { 0x000CF, 0x00301, 0x01E2E },
+  { 0x000D4, 0x00300, 0x01ED2 }, { 0x000D4, 0x00301, 0x01ED0 },
+  { 0x000D4, 0x00303, 0x01ED6 }, { 0x000D4, 0x00309, 0x01ED4 },
+  { 0x000D5, 0x00301, 0x01E4C }, { 0x000D5, 0x00304, 0x0022C },
+  { 0x000D5, 0x00308, 0x01E4E }, { 0x000D6, 0x00304, 0x0022A },
+  { 0x000D8, 0x00301, 0x001FE }, { 0x000DC, 0x00300, 0x001DB },
+  { 0x000DC, 0x00301, 0x001D7 }, { 0x000DC, 0x00304, 0x001D5 },
+  { 0x000DC, 0x0030C, 0x001D9 }, { 0x000E2, 0x00300, 0x01EA7 },
+  { 0x000E2, 0x00301, 0x01EA5 }, { 0x000E2, 0x00303, 0x01EAB },
+  { 0x000E2, 0x00309, 0x01EA9 }, { 0x000E4, 0x00304, 0x001DF },
+  { 0x000E5, 0x00301, 0x001FB }, { 0x000E6, 0x00301, 0x001FD },
+  { 0x000E6, 0x00304, 0x001E3 }, { 0x000E7, 0x00301, 0x01E09 },
+  { 0x000EA, 0x00300, 0x01EC1 }, { 0x000EA, 0x00301, 0x01EBF },
+  { 0x000EA, 0x00303, 0x01EC5 }, { 0x000EA, 0x00309, 0x01EC3 },
+  { 0x000EF, 0x00301, 0x01E2F }, { 0x000F4, 0x00300, 0x01ED3 },
+  { 0x000F4, 0x00301, 0x01ED1 }, { 0x000F4, 0x00303, 0x01ED7 },
+  { 0x000F4, 0x00309, 0x01ED5 }, { 0x000F5, 0x00301, 0x01E4D },
+  { 0x000F5, 0x00304, 0x0022D }, { 0x000F5, 0x00308, 0x01E4F },
+  { 0x000F6, 0x00304, 0x0022B }, { 0x000F8, 0x00301, 0x001FF },
+  { 0x000FC, 0x00300, 0x001DC }, { 0x000FC, 0x00301, 0x001D8 },
+  { 0x000FC, 0x00304, 0x001D6 }, { 0x000FC, 0x0030C, 0x001DA },
+  { 0x00102, 0x00300, 0x01EB0 }, { 0x00102, 0x00301, 0x01EAE },
+  { 0x00102, 0x00303, 0x01EB4 }, { 0x00102, 0x00309, 0x01EB2 },
+  { 0x00103, 0x00300, 0x01EB1 }, { 0x00103, 0x00301, 0x01EAF },
+  { 0x00103, 0x00303, 0x01EB5 }, { 0x00103, 0x00309, 0x01EB3 },
+  { 0x00112, 0x00300, 0x01E14 }, { 0x00112, 0x00301, 0x01E16 },
+  { 0x00113, 0x00300, 0x01E15 }, { 0x00113, 0x00301, 0x01E17 },
+  { 0x0014C, 0x00300, 0x01E50 }, { 0x0014C, 0x00301, 0x01E52 },
+  { 0x0014D, 0x00300, 0x01E51 }, { 0x0014D, 0x00301, 0x01E53 },
+  { 0x0015A, 0x00307, 0x01E64 }, { 0x0015B, 0x00307, 0x01E65 },
+  { 0x00160, 0x00307, 0x01E66 }, { 0x00161, 0x00307, 0x01E67 },
+  { 0x00168, 0x00301, 0x01E78 }, { 0x00169, 0x00301, 0x01E79 },
+  { 0x0016A, 0x00308, 0x01E7A }, { 0x0016B, 0x00308, 0x01E7B },
+  { 0x0017F, 0x00307, 0x01E9B }, { 0x001A0, 0x00300, 0x01EDC },
+  { 0x001A0, 0x00301, 0x01EDA }, { 0x001A0, 0x00303, 0x01EE0 },
+  { 0x001A0, 0x00309, 0x01EDE }, { 0x001A0, 0x00323, 0x01EE2 },
+  { 0x001A1, 0x00300, 0x01EDD }, { 0x001A1, 0x00301, 0x01EDB },
+  { 0x001A1, 0x00303, 0x01EE1 }, { 0x001A1, 0x00309, 0x01EDF },
+  { 0x001A1, 0x00323, 0x01EE3 }, { 0x001AF, 0x00300, 0x01EEA },
+  { 0x001AF, 0x00301, 0x01EE8 }, { 0x001AF, 0x00303, 0x01EEE },
+  { 0x001AF, 0x00309, 0x01EEC }, { 0x001AF, 0x00323, 0x01EF0 },
+  { 0x001B0, 0x00300, 0x01EEB }, { 0x001B0, 0x00301, 0x01EE9 },
+  { 0x001B0, 0x00303, 0x01EEF }, { 0x001B0, 0x00309, 0x01EED },
+  { 0x001B0, 0x00323, 0x01EF1 }, { 0x001B7, 0x0030C, 0x001EE },
+  { 0x001EA, 0x00304, 0x001EC }, { 0x001EB, 0x00304, 0x001ED },
+  { 0x00226, 0x00304, 0x001E0 }, { 0x00227, 0x00304, 0x001E1 },
+  { 0x00228, 0x00306, 0x01E1C }, { 0x00229, 0x00306, 0x01E1D },
+  { 0x0022E, 0x00304, 0x00230 }, { 0x0022F, 0x00304, 0x00231 },
+  { 0x00292, 0x0030C, 0x001EF }, { 0x00391, 0x00300, 0x01FBA },
+  { 0x00391, 0x00301, 0x00386 }, { 0x00391, 0x00304, 0x01FB9 },
+  { 0x00391, 0x00306, 0x01FB8 }, { 0x00391, 0x00313, 0x01F08 },
+  { 0x00391, 0x00314, 0x01F09 }, { 0x00391, 0x00345, 0x01FBC },
+  { 0x00395, 0x00300, 0x01FC8 }, { 0x00395, 0x00301, 0x00388 },
+  { 0x00395, 0x00313, 0x01F18 }, { 0x00395, 0x00314, 0x01F19 },
+  { 0x00397, 0x00300, 0x01FCA }, { 0x00397, 0x00301, 0x00389 },
+  { 0x00397, 0x00313, 0x01F28 }, { 0x00397, 0x00314, 0x01F29 },
+  { 0x00397, 0x00345, 0x01FCC }, { 0x00399, 0x00300, 0x01FDA },
+  { 0x00399, 0x00301, 0x0038A }, { 0x00399, 0x00304, 0x01FD9 },
+  { 0x00399, 0x00306, 0x01FD8 }, { 0x00399, 0x00308, 0x003AA },
+  { 0x00399, 0x00313, 0x01F38 }, { 0x00399, 0x00314, 0x01F39 },
+  { 0x0039F, 0x00300, 0x01FF8 }, { 0x0039F, 0x00301, 0x0038C },
+  { 0x0039F, 0x00313, 0x01F48 }, { 0x0039F, 0x00314, 0x01F49 },
+  { 0x003A1, 0x00314, 0x01FEC }, { 0x003A5, 0x00300, 0x01FEA },
+  { 0x003A5, 0x00301, 0x0038E }, { 0x003A5, 0x00304, 0x01FE9 },
+  { 0x003A5, 0x00306, 0x01FE8 }, { 0x003A5, 0x00308, 0x003AB },
+  { 0x003A5, 0x00314, 0x01F59 }, { 0x003A9, 0x00300, 0x01FFA },
+  { 0x003A9, 0x00301, 0x0038F }, { 0x003A9, 0x00313, 0x01F68 },
+  { 0x003A9, 0x00314, 0x01F69 }, { 0x003A9, 0x00345, 0x01FFC },
+  { 0x003AC, 0x00345, 0x01FB4 }, { 0x003AE, 0x00345, 0x01FC4 },
+  { 0x003B1, 0x00300, 0x01F70 }, { 0x003B1, 0x00301, 0x003AC },
+  { 0x003B1, 0x00304, 0x01FB1 }, { 0x003B1, 0x00306, 0x01FB0 },
+  { 0x003B1, 0x00313, 0x01F00 }, { 0x003B1, 0x00314, 0x01F01 },
+  { 0x003B1, 0x00342, 0x01FB6 }, { 0x003B1, 0x00345, 0x01FB3 },
+  { 0x003B5, 0x00300, 0x01F72 }, { 0x003B5, 0x00301, 0x003AD },
+  { 0x003B5, 0x00313, 0x01F10 }, { 0x003B5, 0x00314, 0x01F11 },
+  { 0x003B7, 0x00300, 0x01F74 }, { 0x003B7, 0x00301, 0x003AE },
+  { 0x003B7, 0x00313, 0x01F20 }, { 0x003B7, 0x00314, 0x01F21 },
+  { 0x003B7, 0x00342, 0x01FC6 }, { 0x003B7, 0x00345, 0x01FC3 },
+  { 0x003B9, 0x00300, 0x01F76 }, { 0x003B9, 0x00301, 0x003AF },
+  { 0x003B9, 0x00304, 0x01FD1 }, { 0x003B9, 0x00306, 0x01FD0 },
+  { 0x003B9, 0x00308, 0x003CA }, { 0x003B9, 0x00313, 0x01F30 },
+  { 0x003B9, 0x00314, 0x01F31 }, { 0x003B9, 0x00342, 0x01FD6 },
+  { 0x003BF, 0x00300, 0x01F78 }, { 0x003BF, 0x00301, 0x003CC },
+  { 0x003BF, 0x00313, 0x01F40 }, { 0x003BF, 0x00314, 0x01F41 },
+  { 0x003C1, 0x00313, 0x01FE4 }, { 0x003C1, 0x00314, 0x01FE5 },
+  { 0x003C5, 0x00300, 0x01F7A }, { 0x003C5, 0x00301, 0x003CD },
+  { 0x003C5, 0x00304, 0x01FE1 }, { 0x003C5, 0x00306, 0x01FE0 },
+  { 0x003C5, 0x00308, 0x003CB }, { 0x003C5, 0x00313, 0x01F50 },
+  { 0x003C5, 0x00314, 0x01F51 }, { 0x003C5, 0x00342, 0x01FE6 },
+  { 0x003C9, 0x00300, 0x01F7C }, { 0x003C9, 0x00301, 0x003CE },
+  { 0x003C9, 0x00313, 0x01F60 }, { 0x003C9, 0x00314, 0x01F61 },
+  { 0x003C9, 0x00342, 0x01FF6 }, { 0x003C9, 0x00345, 0x01FF3 },
+  { 0x003CA, 0x00300, 0x01FD2 }, { 0x003CA, 0x00301, 0x00390 },
+  { 0x003CA, 0x00342, 0x01FD7 }, { 0x003CB, 0x00300, 0x01FE2 },
+  { 0x003CB, 0x00301, 0x003B0 }, { 0x003CB, 0x00342, 0x01FE7 },
+  { 0x003CE, 0x00345, 0x01FF4 }, { 0x003D2, 0x00301, 0x003D3 },
+  { 0x003D2, 0x00308, 0x003D4 }, { 0x00406, 0x00308, 0x00407 },
+  { 0x00410, 0x00306, 0x004D0 }, { 0x00410, 0x00308, 0x004D2 },
+  { 0x00413, 0x00301, 0x00403 }, { 0x00415, 0x00300, 0x00400 },
+  { 0x00415, 0x00306, 0x004D6 }, { 0x00415, 0x00308, 0x00401 },
+  { 0x00416, 0x00306, 0x004C1 }, { 0x00416, 0x00308, 0x004DC },
+  { 0x00417, 0x00308, 0x004DE }, { 0x00418, 0x00300, 0x0040D },
+  { 0x00418, 0x00304, 0x004E2 }, { 0x00418, 0x00306, 0x00419 },
+  { 0x00418, 0x00308, 0x004E4 }, { 0x0041A, 0x00301, 0x0040C },
+  { 0x0041E, 0x00308, 0x004E6 }, { 0x00423, 0x00304, 0x004EE },
+  { 0x00423, 0x00306, 0x0040E }, { 0x00423, 0x00308, 0x004F0 },
+  { 0x00423, 0x0030B, 0x004F2 }, { 0x00427, 0x00308, 0x004F4 },
+  { 0x0042B, 0x00308, 0x004F8 }, { 0x0042D, 0x00308, 0x004EC },
+  { 0x00430, 0x00306, 0x004D1 }, { 0x00430, 0x00308, 0x004D3 },
+  { 0x00433, 0x00301, 0x00453 }, { 0x00435, 0x00300, 0x00450 },
+  { 0x00435, 0x00306, 0x004D7 }, { 0x00435, 0x00308, 0x00451 },
+  { 0x00436, 0x00306, 0x004C2 }, { 0x00436, 0x00308, 0x004DD },
+  { 0x00437, 0x00308, 0x004DF }, { 0x00438, 0x00300, 0x0045D },
+  { 0x00438, 0x00304, 0x004E3 }, { 0x00438, 0x00306, 0x00439 },
+  { 0x00438, 0x00308, 0x004E5 }, { 0x0043A, 0x00301, 0x0045C },
+  { 0x0043E, 0x00308, 0x004E7 }, { 0x00443, 0x00304, 0x004EF },
+  { 0x00443, 0x00306, 0x0045E }, { 0x00443, 0x00308, 0x004F1 },
+  { 0x00443, 0x0030B, 0x004F3 }, { 0x00447, 0x00308, 0x004F5 },
+  { 0x0044B, 0x00308, 0x004F9 }, { 0x0044D, 0x00308, 0x004ED },
+  { 0x00456, 0x00308, 0x00457 }, { 0x00474, 0x0030F, 0x00476 },
+  { 0x00475, 0x0030F, 0x00477 }, { 0x004D8, 0x00308, 0x004DA },
+  { 0x004D9, 0x00308, 0x004DB }, { 0x004E8, 0x00308, 0x004EA },
+  { 0x004E9, 0x00308, 0x004EB }, { 0x00627, 0x00653, 0x00622 },
+  { 0x00627, 0x00654, 0x00623 }, { 0x00627, 0x00655, 0x00625 },
+  { 0x00648, 0x00654, 0x00624 }, { 0x0064A, 0x00654, 0x00626 },
+  { 0x006C1, 0x00654, 0x006C2 }, { 0x006D2, 0x00654, 0x006D3 },
+  { 0x006D5, 0x00654, 0x006C0 }, { 0x00928, 0x0093C, 0x00929 },
+  { 0x00930, 0x0093C, 0x00931 }, { 0x00933, 0x0093C, 0x00934 },
+  { 0x009C7, 0x009BE, 0x009CB }, { 0x009C7, 0x009D7, 0x009CC },
+  { 0x00B47, 0x00B3E, 0x00B4B }, { 0x00B47, 0x00B56, 0x00B48 },
+  { 0x00B47, 0x00B57, 0x00B4C }, { 0x00B92, 0x00BD7, 0x00B94 },
+  { 0x00BC6, 0x00BBE, 0x00BCA }, { 0x00BC6, 0x00BD7, 0x00BCC },
+  { 0x00BC7, 0x00BBE, 0x00BCB }, { 0x00C46, 0x00C56, 0x00C48 },
+  { 0x00CBF, 0x00CD5, 0x00CC0 }, { 0x00CC6, 0x00CC2, 0x00CCA },
+  { 0x00CC6, 0x00CD5, 0x00CC7 }, { 0x00CC6, 0x00CD6, 0x00CC8 },
+  { 0x00CCA, 0x00CD5, 0x00CCB }, { 0x00D46, 0x00D3E, 0x00D4A },
+  { 0x00D46, 0x00D57, 0x00D4C }, { 0x00D47, 0x00D3E, 0x00D4B },
+  { 0x00DD9, 0x00DCA, 0x00DDA }, { 0x00DD9, 0x00DCF, 0x00DDC },
+  { 0x00DD9, 0x00DDF, 0x00DDE }, { 0x00DDC, 0x00DCA, 0x00DDD },
+  { 0x01025, 0x0102E, 0x01026 }, { 0x01B05, 0x01B35, 0x01B06 },
+  { 0x01B07, 0x01B35, 0x01B08 }, { 0x01B09, 0x01B35, 0x01B0A },
+  { 0x01B0B, 0x01B35, 0x01B0C }, { 0x01B0D, 0x01B35, 0x01B0E },
+  { 0x01B11, 0x01B35, 0x01B12 }, { 0x01B3A, 0x01B35, 0x01B3B },
+  { 0x01B3C, 0x01B35, 0x01B3D }, { 0x01B3E, 0x01B35, 0x01B40 },
+  { 0x01B3F, 0x01B35, 0x01B41 }, { 0x01B42, 0x01B35, 0x01B43 },
+  { 0x01E36, 0x00304, 0x01E38 }, { 0x01E37, 0x00304, 0x01E39 },
+  { 0x01E5A, 0x00304, 0x01E5C }, { 0x01E5B, 0x00304, 0x01E5D },
+  { 0x01E62, 0x00307, 0x01E68 }, { 0x01E63, 0x00307, 0x01E69 },
+  { 0x01EA0, 0x00302, 0x01EAC }, { 0x01EA0, 0x00306, 0x01EB6 },
+  { 0x01EA1, 0x00302, 0x01EAD }, { 0x01EA1, 0x00306, 0x01EB7 },
+  { 0x01EB8, 0x00302, 0x01EC6 }, { 0x01EB9, 0x00302, 0x01EC7 },
+  { 0x01ECC, 0x00302, 0x01ED8 }, { 0x01ECD, 0x00302, 0x01ED9 },
+  { 0x01F00, 0x00300, 0x01F02 }, { 0x01F00, 0x00301, 0x01F04 },
+  { 0x01F00, 0x00342, 0x01F06 }, { 0x01F00, 0x00345, 0x01F80 },
+  { 0x01F01, 0x00300, 0x01F03 }, { 0x01F01, 0x00301, 0x01F05 },
+  { 0x01F01, 0x00342, 0x01F07 }, { 0x01F01, 0x00345, 0x01F81 },
+  { 0x01F02, 0x00345, 0x01F82 }, { 0x01F03, 0x00345, 0x01F83 },
+  { 0x01F04, 0x00345, 0x01F84 }, { 0x01F05, 0x00345, 0x01F85 },
+  { 0x01F06, 0x00345, 0x01F86 }, { 0x01F07, 0x00345, 0x01F87 },
+  { 0x01F08, 0x00300, 0x01F0A }, { 0x01F08, 0x00301, 0x01F0C },
+  { 0x01F08, 0x00342, 0x01F0E }, { 0x01F08, 0x00345, 0x01F88 },
+  { 0x01F09, 0x00300, 0x01F0B }, { 0x01F09, 0x00301, 0x01F0D },
+  { 0x01F09, 0x00342, 0x01F0F }, { 0x01F09, 0x00345, 0x01F89 },
+  { 0x01F0A, 0x00345, 0x01F8A }, { 0x01F0B, 0x00345, 0x01F8B },
+  { 0x01F0C, 0x00345, 0x01F8C }, { 0x01F0D, 0x00345, 0x01F8D },
+  { 0x01F0E, 0x00345, 0x01F8E }, { 0x01F0F, 0x00345, 0x01F8F },
+  { 0x01F10, 0x00300, 0x01F12 }, { 0x01F10, 0x00301, 0x01F14 },
+  { 0x01F11, 0x00300, 0x01F13 }, { 0x01F11, 0x00301, 0x01F15 },
+  { 0x01F18, 0x00300, 0x01F1A }, { 0x01F18, 0x00301, 0x01F1C },
+  { 0x01F19, 0x00300, 0x01F1B }, { 0x01F19, 0x00301, 0x01F1D },
+  { 0x01F20, 0x00300, 0x01F22 }, { 0x01F20, 0x00301, 0x01F24 },
+  { 0x01F20, 0x00342, 0x01F26 }, { 0x01F20, 0x00345, 0x01F90 },
+  { 0x01F21, 0x00300, 0x01F23 }, { 0x01F21, 0x00301, 0x01F25 },
+  { 0x01F21, 0x00342, 0x01F27 }, { 0x01F21, 0x00345, 0x01F91 },
+  { 0x01F22, 0x00345, 0x01F92 }, { 0x01F23, 0x00345, 0x01F93 },
+  { 0x01F24, 0x00345, 0x01F94 }, { 0x01F25, 0x00345, 0x01F95 },
+  { 0x01F26, 0x00345, 0x01F96 }, { 0x01F27, 0x00345, 0x01F97 },
+  { 0x01F28, 0x00300, 0x01F2A }, { 0x01F28, 0x00301, 0x01F2C },
+  { 0x01F28, 0x00342, 0x01F2E }, { 0x01F28, 0x00345, 0x01F98 },
+  { 0x01F29, 0x00300, 0x01F2B }, { 0x01F29, 0x00301, 0x01F2D },
+  { 0x01F29, 0x00342, 0x01F2F }, { 0x01F29, 0x00345, 0x01F99 },
+  { 0x01F2A, 0x00345, 0x01F9A }, { 0x01F2B, 0x00345, 0x01F9B },
+  { 0x01F2C, 0x00345, 0x01F9C }, { 0x01F2D, 0x00345, 0x01F9D },
+  { 0x01F2E, 0x00345, 0x01F9E }, { 0x01F2F, 0x00345, 0x01F9F },
+  { 0x01F30, 0x00300, 0x01F32 }, { 0x01F30, 0x00301, 0x01F34 },
+  { 0x01F30, 0x00342, 0x01F36 }, { 0x01F31, 0x00300, 0x01F33 },
+  { 0x01F31, 0x00301, 0x01F35 }, { 0x01F31, 0x00342, 0x01F37 },
+  { 0x01F38, 0x00300, 0x01F3A }, { 0x01F38, 0x00301, 0x01F3C },
+  { 0x01F38, 0x00342, 0x01F3E }, { 0x01F39, 0x00300, 0x01F3B },
+  { 0x01F39, 0x00301, 0x01F3D }, { 0x01F39, 0x00342, 0x01F3F },
+  { 0x01F40, 0x00300, 0x01F42 }, { 0x01F40, 0x00301, 0x01F44 },
+  { 0x01F41, 0x00300, 0x01F43 }, { 0x01F41, 0x00301, 0x01F45 },
+  { 0x01F48, 0x00300, 0x01F4A }, { 0x01F48, 0x00301, 0x01F4C },
+  { 0x01F49, 0x00300, 0x01F4B }, { 0x01F49, 0x00301, 0x01F4D },
+  { 0x01F50, 0x00300, 0x01F52 }, { 0x01F50, 0x00301, 0x01F54 },
+  { 0x01F50, 0x00342, 0x01F56 }, { 0x01F51, 0x00300, 0x01F53 },
+  { 0x01F51, 0x00301, 0x01F55 }, { 0x01F51, 0x00342, 0x01F57 },
+  { 0x01F59, 0x00300, 0x01F5B }, { 0x01F59, 0x00301, 0x01F5D },
+  { 0x01F59, 0x00342, 0x01F5F }, { 0x01F60, 0x00300, 0x01F62 },
+  { 0x01F60, 0x00301, 0x01F64 }, { 0x01F60, 0x00342, 0x01F66 },
+  { 0x01F60, 0x00345, 0x01FA0 }, { 0x01F61, 0x00300, 0x01F63 },
+  { 0x01F61, 0x00301, 0x01F65 }, { 0x01F61, 0x00342, 0x01F67 },
+  { 0x01F61, 0x00345, 0x01FA1 }, { 0x01F62, 0x00345, 0x01FA2 },
+  { 0x01F63, 0x00345, 0x01FA3 }, { 0x01F64, 0x00345, 0x01FA4 },
+  { 0x01F65, 0x00345, 0x01FA5 }, { 0x01F66, 0x00345, 0x01FA6 },
+  { 0x01F67, 0x00345, 0x01FA7 }, { 0x01F68, 0x00300, 0x01F6A },
+  { 0x01F68, 0x00301, 0x01F6C }, { 0x01F68, 0x00342, 0x01F6E },
+  { 0x01F68, 0x00345, 0x01FA8 }, { 0x01F69, 0x00300, 0x01F6B },
+  { 0x01F69, 0x00301, 0x01F6D }, { 0x01F69, 0x00342, 0x01F6F },
+  { 0x01F69, 0x00345, 0x01FA9 }, { 0x01F6A, 0x00345, 0x01FAA },
+  { 0x01F6B, 0x00345, 0x01FAB }, { 0x01F6C, 0x00345, 0x01FAC },
+  { 0x01F6D, 0x00345, 0x01FAD }, { 0x01F6E, 0x00345, 0x01FAE },
+  { 0x01F6F, 0x00345, 0x01FAF }, { 0x01F70, 0x00345, 0x01FB2 },
+  { 0x01F74, 0x00345, 0x01FC2 }, { 0x01F7C, 0x00345, 0x01FF2 },
+  { 0x01FB6, 0x00345, 0x01FB7 }, { 0x01FBF, 0x00300, 0x01FCD },
+  { 0x01FBF, 0x00301, 0x01FCE }, { 0x01FBF, 0x00342, 0x01FCF },
+  { 0x01FC6, 0x00345, 0x01FC7 }, { 0x01FF6, 0x00345, 0x01FF7 },
+  { 0x01FFE, 0x00300, 0x01FDD }, { 0x01FFE, 0x00301, 0x01FDE },
+  { 0x01FFE, 0x00342, 0x01FDF }, { 0x02190, 0x00338, 0x0219A },
+  { 0x02192, 0x00338, 0x0219B }, { 0x02194, 0x00338, 0x021AE },
+  { 0x021D0, 0x00338, 0x021CD }, { 0x021D2, 0x00338, 0x021CF },
+  { 0x021D4, 0x00338, 0x021CE }, { 0x02203, 0x00338, 0x02204 },
+  { 0x02208, 0x00338, 0x02209 }, { 0x0220B, 0x00338, 0x0220C },
+  { 0x02223, 0x00338, 0x02224 }, { 0x02225, 0x00338, 0x02226 },
+  { 0x0223C, 0x00338, 0x02241 }, { 0x02243, 0x00338, 0x02244 },
+  { 0x02245, 0x00338, 0x02247 }, { 0x02248, 0x00338, 0x02249 },
+  { 0x0224D, 0x00338, 0x0226D }, { 0x02261, 0x00338, 0x02262 },
+  { 0x02264, 0x00338, 0x02270 }, { 0x02265, 0x00338, 0x02271 },
+  { 0x02272, 0x00338, 0x02274 }, { 0x02273, 0x00338, 0x02275 },
+  { 0x02276, 0x00338, 0x02278 }, { 0x02277, 0x00338, 0x02279 },
+  { 0x0227A, 0x00338, 0x02280 }, { 0x0227B, 0x00338, 0x02281 },
+  { 0x0227C, 0x00338, 0x022E0 }, { 0x0227D, 0x00338, 0x022E1 },
+  { 0x02282, 0x00338, 0x02284 }, { 0x02283, 0x00338, 0x02285 },
+  { 0x02286, 0x00338, 0x02288 }, { 0x02287, 0x00338, 0x02289 },
+  { 0x02291, 0x00338, 0x022E2 }, { 0x02292, 0x00338, 0x022E3 },
+  { 0x022A2, 0x00338, 0x022AC }, { 0x022A8, 0x00338, 0x022AD },
+  { 0x022A9, 0x00338, 0x022AE }, { 0x022AB, 0x00338, 0x022AF },
+  { 0x022B2, 0x00338, 0x022EA }, { 0x022B3, 0x00338, 0x022EB },
+  { 0x022B4, 0x00338, 0x022EC }, { 0x022B5, 0x00338, 0x022ED },
+  { 0x03046, 0x03099, 0x03094 }, { 0x0304B, 0x03099, 0x0304C },
+  { 0x0304D, 0x03099, 0x0304E }, { 0x0304F, 0x03099, 0x03050 },
+  { 0x03051, 0x03099, 0x03052 }, { 0x03053, 0x03099, 0x03054 },
+  { 0x03055, 0x03099, 0x03056 }, { 0x03057, 0x03099, 0x03058 },
+  { 0x03059, 0x03099, 0x0305A }, { 0x0305B, 0x03099, 0x0305C },
+  { 0x0305D, 0x03099, 0x0305E }, { 0x0305F, 0x03099, 0x03060 },
+  { 0x03061, 0x03099, 0x03062 }, { 0x03064, 0x03099, 0x03065 },
+  { 0x03066, 0x03099, 0x03067 }, { 0x03068, 0x03099, 0x03069 },
+  { 0x0306F, 0x03099, 0x03070 }, { 0x0306F, 0x0309A, 0x03071 },
+  { 0x03072, 0x03099, 0x03073 }, { 0x03072, 0x0309A, 0x03074 },
+  { 0x03075, 0x03099, 0x03076 }, { 0x03075, 0x0309A, 0x03077 },
+  { 0x03078, 0x03099, 0x03079 }, { 0x03078, 0x0309A, 0x0307A },
+  { 0x0307B, 0x03099, 0x0307C }, { 0x0307B, 0x0309A, 0x0307D },
+  { 0x0309D, 0x03099, 0x0309E }, { 0x030A6, 0x03099, 0x030F4 },
+  { 0x030AB, 0x03099, 0x030AC }, { 0x030AD, 0x03099, 0x030AE },
+  { 0x030AF, 0x03099, 0x030B0 }, { 0x030B1, 0x03099, 0x030B2 },
+  { 0x030B3, 0x03099, 0x030B4 }, { 0x030B5, 0x03099, 0x030B6 },
+  { 0x030B7, 0x03099, 0x030B8 }, { 0x030B9, 0x03099, 0x030BA },
+  { 0x030BB, 0x03099, 0x030BC }, { 0x030BD, 0x03099, 0x030BE },
+  { 0x030BF, 0x03099, 0x030C0 }, { 0x030C1, 0x03099, 0x030C2 },
+  { 0x030C4, 0x03099, 0x030C5 }, { 0x030C6, 0x03099, 0x030C7 },
+  { 0x030C8, 0x03099, 0x030C9 }, { 0x030CF, 0x03099, 0x030D0 },
+  { 0x030CF, 0x0309A, 0x030D1 }, { 0x030D2, 0x03099, 0x030D3 },
+  { 0x030D2, 0x0309A, 0x030D4 }, { 0x030D5, 0x03099, 0x030D6 },
+  { 0x030D5, 0x0309A, 0x030D7 }, { 0x030D8, 0x03099, 0x030D9 },
+  { 0x030D8, 0x0309A, 0x030DA }, { 0x030DB, 0x03099, 0x030DC },
+  { 0x030DB, 0x0309A, 0x030DD }, { 0x030EF, 0x03099, 0x030F7 },
+  { 0x030F0, 0x03099, 0x030F8 }, { 0x030F1, 0x03099, 0x030F9 },
+  { 0x030F2, 0x03099, 0x030FA }, { 0x030FD, 0x03099, 0x030FE },
+  { 0x11099, 0x110BA, 0x1109A }, { 0x1109B, 0x110BA, 0x1109C },
+  { 0x110A5, 0x110BA, 0x110AB }, { 0x11131, 0x11127, 0x1112E },
+  { 0x11132, 0x11127, 0x1112F }, { 0x11347, 0x1133E, 0x1134B },
+  { 0x11347, 0x11357, 0x1134C }, { 0x114B9, 0x114B0, 0x114BC },
+  { 0x114B9, 0x114BA, 0x114BB }, { 0x114B9, 0x114BD, 0x114BE },
+  { 0x115B8, 0x115AF, 0x115BA }, { 0x115B9, 0x115AF, 0x115BB },
+  { 0x11935, 0x11930, 0x11938 },
+};
+